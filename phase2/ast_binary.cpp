@@ -0,0 +1,191 @@
+#include "ast_binary.h"
+#include "mapped_file.h"
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Deduplicating string pool; node names repeat constantly.
+struct StringPool {
+    string bytes;
+    unordered_map<string, uint32_t> offsets;
+
+    uint32_t add(const string& s) {
+        auto it = offsets.find(s);
+        if (it != offsets.end()) return it->second;
+        uint32_t offset = bytes.size();
+        bytes += s;
+        offsets.emplace(s, offset);
+        return offset;
+    }
+};
+
+} // namespace
+
+bool saveAstBinary(const shared_ptr<ParseTreeNode>& root, const string& path, string& error) {
+    vector<AstNodeRecord> records;
+    StringPool pool;
+
+    // Breadth-first, so each node's children get consecutive indices
+    vector<const ParseTreeNode*> order;
+    if (root) order.push_back(root.get());
+    for (size_t i = 0; i < order.size(); i++) {
+        const ParseTreeNode* node = order[i];
+        AstNodeRecord record;
+        record.nameOffset = pool.add(node->name);
+        record.nameLength = node->name.size();
+        record.valueOffset = pool.add(node->value);
+        record.valueLength = node->value.size();
+        record.firstChild = order.size();
+        record.childCount = 0;
+        record.sourceStart = node->sourceStart;
+        record.sourceEnd = node->sourceEnd;
+        for (const auto& child : node->children) {
+            if (!child) continue;
+            order.push_back(child.get());
+            record.childCount++;
+        }
+        records.push_back(record);
+    }
+    if (order.size() >= AST_NO_NODE || pool.bytes.size() > UINT32_MAX) {
+        error = "tree too large for the binary format";
+        return false;
+    }
+
+    AstFileHeader header;
+    memcpy(header.magic, AST_MAGIC, sizeof(header.magic));
+    header.version = AST_FORMAT_VERSION;
+    header.byteOrder = AST_BYTE_ORDER_MARK;
+    header.nodeCount = records.size();
+    header.rootIndex = records.empty() ? AST_NO_NODE : 0;
+    header.nodesOffset = sizeof(AstFileHeader);
+    header.stringsOffset = header.nodesOffset + records.size() * sizeof(AstNodeRecord);
+    header.stringsSize = pool.bytes.size();
+    header.fileSize = header.stringsOffset + header.stringsSize;
+
+    vector<char> buffer(header.fileSize);
+    memcpy(buffer.data(), &header, sizeof(header));
+    if (!records.empty()) {
+        memcpy(buffer.data() + header.nodesOffset, records.data(), records.size() * sizeof(AstNodeRecord));
+    }
+    memcpy(buffer.data() + header.stringsOffset, pool.bytes.data(), pool.bytes.size());
+
+    string temporary = path + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (!file) {
+        error = "cannot open " + temporary + " for writing";
+        return false;
+    }
+    setvbuf(file, nullptr, _IONBF, 0);
+    bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    written = fclose(file) == 0 && written;
+    if (!written || !replace_file(temporary, path)) {
+        remove(temporary.c_str());
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+AstView::~AstView() {
+    close();
+}
+
+void AstView::close() {
+    unmap_file(data, length);
+    data = nullptr;
+    length = 0;
+    header = nullptr;
+    nodes = nullptr;
+    strings = nullptr;
+}
+
+bool AstView::open(const string& path, string& error) {
+    close();
+    MapStatus status = map_file(path, data, length);
+    if (status != MapStatus::OK) {
+        error = (status == MapStatus::CANNOT_OPEN ? "cannot open " : "cannot map ") + path;
+        return false;
+    }
+    if (length < sizeof(AstFileHeader)) {
+        close();
+        error = path + " is not an AST file";
+        return false;
+    }
+    header = reinterpret_cast<const AstFileHeader*>(data);
+
+    if (memcmp(header->magic, AST_MAGIC, sizeof(AST_MAGIC)) != 0) {
+        error = path + " is not an AST file";
+    } else if (header->byteOrder != AST_BYTE_ORDER_MARK) {
+        error = path + " was written on a machine with a different byte order";
+    } else if (header->version != AST_FORMAT_VERSION) {
+        error = path + " has format version " + to_string(header->version)
+              + ", expected " + to_string(AST_FORMAT_VERSION);
+    } else if (header->fileSize != length
+            || header->nodesOffset % alignof(AstNodeRecord) != 0
+            || header->nodesOffset + (uint64_t)header->nodeCount * sizeof(AstNodeRecord) > header->stringsOffset
+            || header->stringsOffset + header->stringsSize > length
+            || (header->nodeCount == 0 ? header->rootIndex != AST_NO_NODE : header->rootIndex >= header->nodeCount)) {
+        error = path + " is truncated or corrupt";
+    } else {
+        nodes = reinterpret_cast<const AstNodeRecord*>(data + header->nodesOffset);
+        strings = data + header->stringsOffset;
+        return true;
+    }
+    close();
+    return false;
+}
+
+bool AstView::validate(string& error) const {
+    if (!header) {
+        error = "no AST file is open";
+        return false;
+    }
+    // Breadth-first layout: children come after their parent and the child
+    // ranges of successive nodes are adjacent, which rules out cycles
+    if (header->nodeCount > 0 && header->rootIndex != 0) {
+        error = "root is not the first node";
+        return false;
+    }
+    uint64_t nextChild = header->nodeCount == 0 ? 0 : 1;
+    for (uint32_t i = 0; i < header->nodeCount; i++) {
+        const AstNodeRecord& n = nodes[i];
+        if ((uint64_t)n.nameOffset + n.nameLength > header->stringsSize
+                || (uint64_t)n.valueOffset + n.valueLength > header->stringsSize) {
+            error = "node " + to_string(i) + " has a string outside the pool";
+            return false;
+        }
+        if (n.firstChild != nextChild || (uint64_t)n.firstChild + n.childCount > header->nodeCount) {
+            error = "node " + to_string(i) + " has an invalid child range";
+            return false;
+        }
+        nextChild += n.childCount;
+    }
+    if (nextChild != header->nodeCount) {
+        error = "file contains unreachable nodes";
+        return false;
+    }
+    return true;
+}
+
+shared_ptr<ParseTreeNode> AstView::materialize() const {
+    if (root() == AST_NO_NODE) return nullptr;
+    vector<shared_ptr<ParseTreeNode>> built(size());
+    for (uint32_t i = 0; i < size(); i++) {
+        built[i] = make_node(string(name(i)), string(value(i)));
+        built[i]->sourceStart = nodes[i].sourceStart;
+        built[i]->sourceEnd = nodes[i].sourceEnd;
+    }
+    for (uint32_t i = 0; i < size(); i++) {
+        const AstNodeRecord& n = nodes[i];
+        built[i]->children.reserve(n.childCount);
+        for (uint32_t c = 0; c < n.childCount; c++) {
+            built[i]->addChild(built[n.firstChild + c]);
+        }
+    }
+    return built[root()];
+}
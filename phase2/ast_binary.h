@@ -0,0 +1,93 @@
+#ifndef AST_BINARY_H
+#define AST_BINARY_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Binary parse tree format, loaded by mapping the file read-only.
+//
+//   header | node records | string pool
+//
+// Every position is an offset from the start of the file, so a mapping can be
+// placed anywhere and shared between processes. Nodes are stored breadth
+// first: the children of a node are the childCount records starting at
+// firstChild. Names and values live in a deduplicated string pool and are not
+// NUL terminated. Integers are in the byte order of the writer; a reader with
+// a different byte order rejects the file.
+const char AST_MAGIC[8] = {'P', 'Y', 'A', 'S', 'T', 'B', 'I', 'N'};
+const uint32_t AST_FORMAT_VERSION = 1;
+const uint32_t AST_BYTE_ORDER_MARK = 0x01020304;
+const uint32_t AST_NO_OFFSET = UINT32_MAX;   // source offset not recorded
+const uint32_t AST_NO_NODE = UINT32_MAX;     // root of an empty tree
+
+struct AstFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t nodeCount;
+    uint32_t rootIndex;
+    uint64_t nodesOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t fileSize;
+};
+
+struct AstNodeRecord {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t valueOffset;
+    uint32_t valueLength;
+    uint32_t firstChild;
+    uint32_t childCount;
+    uint32_t sourceStart;   // byte offsets into the source, AST_NO_OFFSET if unknown
+    uint32_t sourceEnd;
+};
+
+static_assert(sizeof(AstFileHeader) == 56, "AstFileHeader layout is part of the file format");
+static_assert(sizeof(AstNodeRecord) == 32, "AstNodeRecord layout is part of the file format");
+static_assert(AST_NO_OFFSET == NO_SOURCE_OFFSET, "source ranges are stored as they are in memory");
+
+// Serializes the tree into memory and writes it with one write call. The file
+// is written under a temporary name and renamed, so readers never map a
+// partial file.
+bool saveAstBinary(const shared_ptr<ParseTreeNode>& root, const string& path, string& error);
+
+// Read-only view of a mapped AST file. open() checks the header only; the
+// records are read in place. Call validate() before trusting a file from
+// elsewhere.
+class AstView {
+public:
+    AstView() = default;
+    ~AstView();
+    AstView(const AstView&) = delete;
+    AstView& operator=(const AstView&) = delete;
+
+    bool open(const string& path, string& error);
+    void close();
+    bool validate(string& error) const;
+
+    uint32_t size() const { return header ? header->nodeCount : 0; }
+    uint32_t root() const { return header ? header->rootIndex : AST_NO_NODE; }
+    const AstNodeRecord& node(uint32_t index) const { return nodes[index]; }
+    std::string_view name(uint32_t index) const {
+        return std::string_view(strings + nodes[index].nameOffset, nodes[index].nameLength);
+    }
+    std::string_view value(uint32_t index) const {
+        return std::string_view(strings + nodes[index].valueOffset, nodes[index].valueLength);
+    }
+
+    // Rebuilds a pointer tree for code that works on ParseTreeNode.
+    shared_ptr<ParseTreeNode> materialize() const;
+
+private:
+    const char* data = nullptr;
+    size_t length = 0;
+    const AstFileHeader* header = nullptr;
+    const AstNodeRecord* nodes = nullptr;
+    const char* strings = nullptr;
+};
+
+#endif // AST_BINARY_H
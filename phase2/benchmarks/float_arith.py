@@ -0,0 +1,21 @@
+# Float arithmetic: a Leibniz series and a Newton square root.
+def leibniz(n):
+    total = 0.0
+    sign = 1.0
+    for k in range(n):
+        total += sign / (2 * k + 1)
+        sign = -sign
+    return 4 * total
+
+def newton(x, steps):
+    guess = x / 2
+    for i in range(steps):
+        guess = (guess + x / guess) / 2
+    return guess
+
+s = 0.0
+for i in range(1, 2000):
+    root = newton(i * 1.5, 20)
+    s += root
+print(leibniz(500000))
+print(s)
@@ -0,0 +1,10 @@
+# Integer arithmetic: multiply, modulo, shifts and floor division.
+def mix(n):
+    h = 17
+    for i in range(n):
+        h = (h * 31 + i) % 1000000007
+        h = h ^ (h >> 7)
+        h = h + (h << 3) // 5
+    return h
+
+print(mix(300000))
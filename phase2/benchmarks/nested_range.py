@@ -0,0 +1,10 @@
+# Nested for-range loops over locals inside a function.
+def grid(n):
+    count = 0
+    for i in range(n):
+        for j in range(n):
+            if (i ^ j) & 1:
+                count += i * j
+    return count
+
+print(grid(700))
@@ -0,0 +1,105 @@
+# Parser benchmark: 100 assignments of 40-deep parenthesized arithmetic.
+#   printf '2\nbenchmarks/parser/deep_arith.py\n' | ./parserWtree --bench=20
+a = 1
+b = 2
+x0 = (((((((((((((((((((((((((((((((((((((((a - 1) - 2) / 3) + 4) * b - 4 - 6) / 6) + 7) - 8) / 9) * b - 9 - 11) / 11) - 12) + 13) - 14) * b - 14 - 16) - 16) - 17) / 18) / 19) * b - 19 * 21) - 21) + 22) + 23) * 24) * b - 24 + 26) + 26) + 27) / 28) * 29) * b - 29 * 31) / 31) / 32) - 33) + 34) * b - 34 * 36) - 36) / 37) / 38) - 39) * b - 39 + 41
+x1 = (((((((((((((((((((((((((((((((((((((((a + 1) + 2) - 3) + 4) * b - 4 + 6) / 6) - 7) * 8) + 9) * b - 9 * 11) + 11) / 12) + 13) / 14) * b - 14 / 16) + 16) + 17) * 18) + 19) * b - 19 - 21) + 21) - 22) * 23) * 24) * b - 24 / 26) * 26) / 27) / 28) + 29) * b - 29 + 31) - 31) + 32) + 33) / 34) * b - 34 + 36) - 36) + 37) + 38) / 39) * b - 39 + 41
+x2 = (((((((((((((((((((((((((((((((((((((((a * 1) / 2) - 3) + 4) * b - 4 * 6) - 6) + 7) + 8) + 9) * b - 9 + 11) / 11) + 12) * 13) / 14) * b - 14 * 16) / 16) + 17) + 18) + 19) * b - 19 - 21) / 21) - 22) * 23) - 24) * b - 24 - 26) / 26) / 27) * 28) + 29) * b - 29 + 31) - 31) + 32) + 33) - 34) * b - 34 / 36) - 36) * 37) + 38) - 39) * b - 39 * 41
+x3 = (((((((((((((((((((((((((((((((((((((((a * 1) / 2) / 3) - 4) * b - 4 / 6) - 6) + 7) + 8) + 9) * b - 9 + 11) - 11) - 12) + 13) - 14) * b - 14 - 16) + 16) - 17) - 18) + 19) * b - 19 + 21) / 21) / 22) + 23) / 24) * b - 24 - 26) * 26) - 27) - 28) + 29) * b - 29 + 31) * 31) * 32) / 33) - 34) * b - 34 / 36) / 36) * 37) * 38) * 39) * b - 39 * 41
+x4 = (((((((((((((((((((((((((((((((((((((((a / 1) + 2) * 3) / 4) * b - 4 + 6) + 6) * 7) - 8) * 9) * b - 9 - 11) - 11) * 12) / 13) + 14) * b - 14 * 16) - 16) / 17) * 18) + 19) * b - 19 + 21) + 21) + 22) + 23) + 24) * b - 24 - 26) / 26) + 27) * 28) + 29) * b - 29 / 31) / 31) / 32) - 33) / 34) * b - 34 * 36) * 36) + 37) / 38) + 39) * b - 39 * 41
+x5 = (((((((((((((((((((((((((((((((((((((((a / 1) - 2) * 3) - 4) * b - 4 + 6) * 6) - 7) * 8) - 9) * b - 9 / 11) + 11) / 12) + 13) / 14) * b - 14 / 16) * 16) - 17) / 18) / 19) * b - 19 / 21) - 21) - 22) + 23) * 24) * b - 24 + 26) - 26) - 27) + 28) + 29) * b - 29 * 31) - 31) / 32) + 33) - 34) * b - 34 * 36) / 36) / 37) / 38) - 39) * b - 39 * 41
+x6 = (((((((((((((((((((((((((((((((((((((((a - 1) + 2) - 3) / 4) * b - 4 * 6) / 6) + 7) / 8) + 9) * b - 9 * 11) - 11) * 12) / 13) * 14) * b - 14 * 16) + 16) * 17) / 18) + 19) * b - 19 + 21) * 21) - 22) * 23) * 24) * b - 24 - 26) - 26) + 27) * 28) / 29) * b - 29 + 31) - 31) + 32) - 33) / 34) * b - 34 / 36) - 36) - 37) + 38) / 39) * b - 39 / 41
+x7 = (((((((((((((((((((((((((((((((((((((((a * 1) + 2) * 3) / 4) * b - 4 * 6) / 6) / 7) - 8) + 9) * b - 9 / 11) * 11) - 12) - 13) - 14) * b - 14 - 16) * 16) + 17) * 18) / 19) * b - 19 + 21) - 21) * 22) * 23) * 24) * b - 24 / 26) / 26) * 27) * 28) / 29) * b - 29 * 31) / 31) / 32) * 33) * 34) * b - 34 * 36) / 36) * 37) / 38) / 39) * b - 39 * 41
+x8 = (((((((((((((((((((((((((((((((((((((((a * 1) + 2) * 3) / 4) * b - 4 * 6) - 6) - 7) - 8) / 9) * b - 9 - 11) + 11) + 12) * 13) - 14) * b - 14 - 16) / 16) * 17) + 18) / 19) * b - 19 * 21) - 21) * 22) / 23) - 24) * b - 24 + 26) / 26) - 27) + 28) + 29) * b - 29 * 31) * 31) - 32) * 33) / 34) * b - 34 / 36) * 36) + 37) + 38) + 39) * b - 39 * 41
+x9 = (((((((((((((((((((((((((((((((((((((((a * 1) + 2) / 3) + 4) * b - 4 * 6) + 6) * 7) + 8) * 9) * b - 9 / 11) * 11) * 12) / 13) * 14) * b - 14 / 16) * 16) * 17) * 18) - 19) * b - 19 * 21) * 21) / 22) + 23) * 24) * b - 24 + 26) + 26) * 27) + 28) + 29) * b - 29 + 31) / 31) - 32) / 33) + 34) * b - 34 / 36) + 36) / 37) - 38) - 39) * b - 39 / 41
+x10 = (((((((((((((((((((((((((((((((((((((((a * 1) / 2) + 3) * 4) * b - 4 - 6) + 6) + 7) + 8) + 9) * b - 9 * 11) - 11) - 12) * 13) * 14) * b - 14 + 16) - 16) - 17) + 18) * 19) * b - 19 / 21) - 21) - 22) - 23) * 24) * b - 24 - 26) + 26) + 27) + 28) / 29) * b - 29 + 31) + 31) / 32) * 33) - 34) * b - 34 * 36) * 36) + 37) / 38) * 39) * b - 39 - 41
+x11 = (((((((((((((((((((((((((((((((((((((((a / 1) * 2) + 3) * 4) * b - 4 + 6) * 6) / 7) / 8) / 9) * b - 9 * 11) - 11) - 12) + 13) * 14) * b - 14 / 16) * 16) - 17) + 18) - 19) * b - 19 - 21) + 21) + 22) * 23) / 24) * b - 24 - 26) - 26) - 27) * 28) * 29) * b - 29 + 31) - 31) * 32) / 33) - 34) * b - 34 * 36) - 36) - 37) * 38) - 39) * b - 39 / 41
+x12 = (((((((((((((((((((((((((((((((((((((((a / 1) * 2) + 3) / 4) * b - 4 * 6) + 6) + 7) + 8) / 9) * b - 9 * 11) - 11) + 12) * 13) + 14) * b - 14 / 16) * 16) - 17) * 18) + 19) * b - 19 + 21) - 21) * 22) - 23) / 24) * b - 24 * 26) + 26) * 27) / 28) * 29) * b - 29 / 31) + 31) / 32) * 33) / 34) * b - 34 - 36) * 36) * 37) / 38) - 39) * b - 39 + 41
+x13 = (((((((((((((((((((((((((((((((((((((((a + 1) - 2) / 3) * 4) * b - 4 / 6) - 6) * 7) + 8) * 9) * b - 9 + 11) - 11) + 12) - 13) + 14) * b - 14 * 16) / 16) / 17) + 18) / 19) * b - 19 / 21) / 21) * 22) / 23) - 24) * b - 24 * 26) * 26) / 27) - 28) - 29) * b - 29 / 31) - 31) - 32) / 33) + 34) * b - 34 - 36) - 36) + 37) + 38) - 39) * b - 39 - 41
+x14 = (((((((((((((((((((((((((((((((((((((((a / 1) / 2) / 3) * 4) * b - 4 / 6) - 6) - 7) * 8) + 9) * b - 9 - 11) - 11) / 12) + 13) / 14) * b - 14 - 16) / 16) / 17) - 18) * 19) * b - 19 - 21) / 21) * 22) * 23) * 24) * b - 24 + 26) * 26) + 27) / 28) / 29) * b - 29 - 31) - 31) / 32) + 33) / 34) * b - 34 - 36) - 36) * 37) - 38) - 39) * b - 39 + 41
+x15 = (((((((((((((((((((((((((((((((((((((((a / 1) / 2) / 3) / 4) * b - 4 * 6) + 6) + 7) / 8) - 9) * b - 9 * 11) + 11) / 12) / 13) - 14) * b - 14 * 16) - 16) * 17) * 18) + 19) * b - 19 + 21) / 21) / 22) * 23) * 24) * b - 24 * 26) / 26) * 27) / 28) / 29) * b - 29 * 31) + 31) / 32) / 33) * 34) * b - 34 - 36) / 36) * 37) / 38) * 39) * b - 39 * 41
+x16 = (((((((((((((((((((((((((((((((((((((((a / 1) / 2) - 3) / 4) * b - 4 * 6) + 6) / 7) + 8) / 9) * b - 9 / 11) / 11) * 12) * 13) * 14) * b - 14 * 16) + 16) / 17) - 18) / 19) * b - 19 / 21) - 21) - 22) - 23) * 24) * b - 24 - 26) / 26) + 27) * 28) - 29) * b - 29 - 31) * 31) / 32) / 33) + 34) * b - 34 / 36) * 36) * 37) + 38) / 39) * b - 39 - 41
+x17 = (((((((((((((((((((((((((((((((((((((((a + 1) + 2) / 3) + 4) * b - 4 / 6) / 6) + 7) + 8) / 9) * b - 9 - 11) / 11) + 12) - 13) / 14) * b - 14 * 16) / 16) - 17) * 18) + 19) * b - 19 + 21) / 21) * 22) + 23) / 24) * b - 24 / 26) - 26) + 27) - 28) * 29) * b - 29 * 31) + 31) - 32) * 33) + 34) * b - 34 + 36) + 36) + 37) - 38) / 39) * b - 39 - 41
+x18 = (((((((((((((((((((((((((((((((((((((((a - 1) + 2) - 3) - 4) * b - 4 / 6) + 6) + 7) * 8) / 9) * b - 9 + 11) - 11) + 12) - 13) - 14) * b - 14 - 16) * 16) - 17) * 18) - 19) * b - 19 + 21) - 21) * 22) * 23) / 24) * b - 24 - 26) - 26) * 27) * 28) * 29) * b - 29 * 31) + 31) + 32) - 33) - 34) * b - 34 * 36) / 36) / 37) - 38) + 39) * b - 39 * 41
+x19 = (((((((((((((((((((((((((((((((((((((((a / 1) * 2) / 3) / 4) * b - 4 - 6) / 6) / 7) - 8) - 9) * b - 9 / 11) - 11) + 12) / 13) - 14) * b - 14 + 16) / 16) * 17) - 18) - 19) * b - 19 + 21) / 21) - 22) + 23) - 24) * b - 24 / 26) * 26) + 27) + 28) - 29) * b - 29 / 31) / 31) * 32) * 33) + 34) * b - 34 - 36) / 36) + 37) / 38) / 39) * b - 39 + 41
+x20 = (((((((((((((((((((((((((((((((((((((((a / 1) * 2) - 3) * 4) * b - 4 - 6) / 6) + 7) - 8) / 9) * b - 9 / 11) - 11) / 12) - 13) / 14) * b - 14 / 16) / 16) * 17) / 18) - 19) * b - 19 / 21) / 21) - 22) - 23) * 24) * b - 24 + 26) - 26) / 27) + 28) - 29) * b - 29 * 31) * 31) / 32) / 33) * 34) * b - 34 - 36) - 36) / 37) / 38) + 39) * b - 39 - 41
+x21 = (((((((((((((((((((((((((((((((((((((((a - 1) * 2) + 3) - 4) * b - 4 / 6) + 6) - 7) / 8) * 9) * b - 9 * 11) * 11) / 12) + 13) + 14) * b - 14 - 16) / 16) - 17) - 18) - 19) * b - 19 * 21) / 21) / 22) / 23) / 24) * b - 24 * 26) * 26) - 27) - 28) * 29) * b - 29 * 31) + 31) - 32) / 33) - 34) * b - 34 + 36) - 36) + 37) / 38) * 39) * b - 39 + 41
+x22 = (((((((((((((((((((((((((((((((((((((((a * 1) * 2) + 3) * 4) * b - 4 * 6) - 6) / 7) - 8) / 9) * b - 9 - 11) - 11) - 12) * 13) * 14) * b - 14 / 16) / 16) - 17) - 18) * 19) * b - 19 / 21) + 21) / 22) * 23) * 24) * b - 24 / 26) - 26) + 27) * 28) + 29) * b - 29 / 31) - 31) - 32) - 33) + 34) * b - 34 / 36) * 36) * 37) / 38) / 39) * b - 39 * 41
+x23 = (((((((((((((((((((((((((((((((((((((((a + 1) - 2) * 3) - 4) * b - 4 * 6) + 6) + 7) - 8) * 9) * b - 9 - 11) + 11) / 12) + 13) + 14) * b - 14 / 16) * 16) * 17) * 18) / 19) * b - 19 * 21) / 21) / 22) + 23) + 24) * b - 24 + 26) / 26) * 27) + 28) / 29) * b - 29 + 31) / 31) * 32) / 33) / 34) * b - 34 / 36) * 36) - 37) - 38) - 39) * b - 39 * 41
+x24 = (((((((((((((((((((((((((((((((((((((((a + 1) - 2) + 3) * 4) * b - 4 * 6) - 6) + 7) * 8) - 9) * b - 9 + 11) / 11) + 12) + 13) - 14) * b - 14 * 16) + 16) / 17) + 18) * 19) * b - 19 / 21) / 21) - 22) + 23) + 24) * b - 24 - 26) * 26) / 27) * 28) - 29) * b - 29 + 31) * 31) / 32) * 33) - 34) * b - 34 + 36) - 36) - 37) / 38) / 39) * b - 39 - 41
+x25 = (((((((((((((((((((((((((((((((((((((((a + 1) - 2) - 3) + 4) * b - 4 * 6) / 6) + 7) + 8) + 9) * b - 9 - 11) + 11) + 12) - 13) * 14) * b - 14 + 16) / 16) * 17) / 18) * 19) * b - 19 * 21) - 21) * 22) / 23) + 24) * b - 24 * 26) - 26) + 27) * 28) * 29) * b - 29 * 31) + 31) * 32) * 33) + 34) * b - 34 + 36) + 36) - 37) / 38) - 39) * b - 39 * 41
+x26 = (((((((((((((((((((((((((((((((((((((((a * 1) * 2) + 3) / 4) * b - 4 / 6) / 6) - 7) - 8) - 9) * b - 9 * 11) / 11) / 12) * 13) / 14) * b - 14 - 16) - 16) - 17) / 18) - 19) * b - 19 * 21) / 21) - 22) * 23) + 24) * b - 24 - 26) - 26) - 27) / 28) + 29) * b - 29 / 31) + 31) - 32) / 33) - 34) * b - 34 * 36) + 36) - 37) / 38) + 39) * b - 39 - 41
+x27 = (((((((((((((((((((((((((((((((((((((((a + 1) - 2) * 3) * 4) * b - 4 / 6) * 6) / 7) * 8) * 9) * b - 9 * 11) - 11) * 12) - 13) - 14) * b - 14 * 16) * 16) * 17) + 18) + 19) * b - 19 + 21) - 21) - 22) / 23) - 24) * b - 24 + 26) / 26) - 27) / 28) + 29) * b - 29 - 31) * 31) + 32) - 33) / 34) * b - 34 - 36) * 36) + 37) / 38) * 39) * b - 39 * 41
+x28 = (((((((((((((((((((((((((((((((((((((((a - 1) + 2) - 3) - 4) * b - 4 / 6) / 6) - 7) * 8) / 9) * b - 9 * 11) + 11) + 12) + 13) - 14) * b - 14 - 16) / 16) - 17) + 18) + 19) * b - 19 * 21) * 21) / 22) - 23) + 24) * b - 24 * 26) / 26) + 27) * 28) - 29) * b - 29 / 31) / 31) / 32) * 33) - 34) * b - 34 - 36) * 36) - 37) + 38) * 39) * b - 39 / 41
+x29 = (((((((((((((((((((((((((((((((((((((((a - 1) * 2) / 3) * 4) * b - 4 - 6) / 6) / 7) / 8) - 9) * b - 9 - 11) - 11) * 12) / 13) * 14) * b - 14 / 16) + 16) + 17) - 18) * 19) * b - 19 / 21) - 21) / 22) - 23) * 24) * b - 24 * 26) / 26) / 27) + 28) - 29) * b - 29 + 31) - 31) - 32) - 33) / 34) * b - 34 * 36) - 36) + 37) + 38) - 39) * b - 39 * 41
+x30 = (((((((((((((((((((((((((((((((((((((((a * 1) * 2) * 3) * 4) * b - 4 - 6) / 6) / 7) - 8) / 9) * b - 9 * 11) / 11) * 12) - 13) + 14) * b - 14 / 16) * 16) + 17) / 18) - 19) * b - 19 + 21) * 21) - 22) - 23) + 24) * b - 24 * 26) + 26) - 27) + 28) / 29) * b - 29 / 31) - 31) - 32) * 33) - 34) * b - 34 * 36) * 36) - 37) / 38) - 39) * b - 39 + 41
+x31 = (((((((((((((((((((((((((((((((((((((((a + 1) + 2) * 3) / 4) * b - 4 * 6) - 6) - 7) + 8) / 9) * b - 9 - 11) * 11) / 12) * 13) * 14) * b - 14 / 16) - 16) * 17) - 18) - 19) * b - 19 / 21) * 21) - 22) - 23) - 24) * b - 24 - 26) + 26) * 27) * 28) * 29) * b - 29 / 31) * 31) - 32) / 33) * 34) * b - 34 * 36) / 36) - 37) * 38) / 39) * b - 39 * 41
+x32 = (((((((((((((((((((((((((((((((((((((((a / 1) + 2) + 3) / 4) * b - 4 - 6) - 6) - 7) - 8) - 9) * b - 9 / 11) + 11) * 12) * 13) + 14) * b - 14 - 16) * 16) / 17) - 18) * 19) * b - 19 / 21) * 21) + 22) * 23) + 24) * b - 24 / 26) * 26) - 27) * 28) / 29) * b - 29 / 31) * 31) - 32) * 33) / 34) * b - 34 - 36) + 36) * 37) + 38) / 39) * b - 39 / 41
+x33 = (((((((((((((((((((((((((((((((((((((((a * 1) / 2) - 3) / 4) * b - 4 - 6) + 6) * 7) / 8) + 9) * b - 9 + 11) * 11) / 12) + 13) / 14) * b - 14 * 16) / 16) - 17) / 18) / 19) * b - 19 - 21) / 21) + 22) + 23) + 24) * b - 24 / 26) - 26) + 27) * 28) * 29) * b - 29 * 31) * 31) * 32) - 33) - 34) * b - 34 - 36) + 36) * 37) - 38) - 39) * b - 39 * 41
+x34 = (((((((((((((((((((((((((((((((((((((((a * 1) * 2) * 3) - 4) * b - 4 + 6) + 6) / 7) + 8) + 9) * b - 9 - 11) / 11) - 12) - 13) / 14) * b - 14 / 16) * 16) / 17) - 18) - 19) * b - 19 * 21) * 21) * 22) + 23) / 24) * b - 24 - 26) + 26) * 27) / 28) * 29) * b - 29 / 31) - 31) + 32) * 33) + 34) * b - 34 - 36) - 36) + 37) / 38) * 39) * b - 39 / 41
+x35 = (((((((((((((((((((((((((((((((((((((((a + 1) - 2) + 3) / 4) * b - 4 + 6) + 6) * 7) + 8) * 9) * b - 9 * 11) + 11) + 12) / 13) + 14) * b - 14 + 16) / 16) * 17) - 18) * 19) * b - 19 / 21) * 21) / 22) / 23) + 24) * b - 24 / 26) + 26) + 27) / 28) * 29) * b - 29 / 31) / 31) - 32) * 33) / 34) * b - 34 + 36) + 36) / 37) + 38) / 39) * b - 39 / 41
+x36 = (((((((((((((((((((((((((((((((((((((((a - 1) / 2) * 3) - 4) * b - 4 * 6) + 6) * 7) + 8) - 9) * b - 9 + 11) * 11) / 12) - 13) + 14) * b - 14 * 16) * 16) * 17) / 18) * 19) * b - 19 + 21) * 21) - 22) * 23) - 24) * b - 24 + 26) * 26) / 27) * 28) / 29) * b - 29 / 31) + 31) / 32) - 33) * 34) * b - 34 + 36) - 36) * 37) - 38) * 39) * b - 39 / 41
+x37 = (((((((((((((((((((((((((((((((((((((((a / 1) - 2) * 3) + 4) * b - 4 - 6) - 6) * 7) * 8) + 9) * b - 9 * 11) - 11) / 12) / 13) - 14) * b - 14 * 16) + 16) * 17) - 18) - 19) * b - 19 + 21) / 21) / 22) / 23) + 24) * b - 24 / 26) / 26) / 27) + 28) + 29) * b - 29 / 31) - 31) - 32) - 33) / 34) * b - 34 - 36) - 36) * 37) / 38) - 39) * b - 39 + 41
+x38 = (((((((((((((((((((((((((((((((((((((((a - 1) - 2) * 3) / 4) * b - 4 + 6) / 6) + 7) + 8) / 9) * b - 9 * 11) + 11) - 12) * 13) * 14) * b - 14 - 16) + 16) + 17) + 18) + 19) * b - 19 + 21) + 21) * 22) + 23) + 24) * b - 24 - 26) * 26) + 27) * 28) - 29) * b - 29 / 31) - 31) + 32) * 33) + 34) * b - 34 - 36) / 36) + 37) / 38) + 39) * b - 39 / 41
+x39 = (((((((((((((((((((((((((((((((((((((((a + 1) * 2) + 3) + 4) * b - 4 + 6) - 6) + 7) - 8) + 9) * b - 9 - 11) / 11) + 12) - 13) * 14) * b - 14 - 16) + 16) + 17) + 18) + 19) * b - 19 + 21) + 21) * 22) + 23) - 24) * b - 24 - 26) + 26) * 27) * 28) - 29) * b - 29 + 31) + 31) * 32) / 33) - 34) * b - 34 * 36) + 36) - 37) - 38) * 39) * b - 39 - 41
+x40 = (((((((((((((((((((((((((((((((((((((((a / 1) * 2) + 3) / 4) * b - 4 - 6) + 6) + 7) / 8) / 9) * b - 9 + 11) - 11) * 12) + 13) / 14) * b - 14 / 16) - 16) * 17) + 18) - 19) * b - 19 * 21) - 21) / 22) / 23) * 24) * b - 24 / 26) + 26) - 27) / 28) - 29) * b - 29 / 31) - 31) * 32) + 33) / 34) * b - 34 * 36) - 36) * 37) * 38) + 39) * b - 39 / 41
+x41 = (((((((((((((((((((((((((((((((((((((((a * 1) - 2) / 3) + 4) * b - 4 + 6) - 6) + 7) + 8) * 9) * b - 9 + 11) * 11) + 12) + 13) + 14) * b - 14 * 16) - 16) / 17) - 18) * 19) * b - 19 / 21) * 21) / 22) + 23) + 24) * b - 24 + 26) + 26) - 27) / 28) * 29) * b - 29 * 31) - 31) * 32) * 33) * 34) * b - 34 - 36) - 36) - 37) - 38) + 39) * b - 39 * 41
+x42 = (((((((((((((((((((((((((((((((((((((((a / 1) - 2) * 3) + 4) * b - 4 - 6) * 6) - 7) * 8) / 9) * b - 9 + 11) / 11) + 12) - 13) / 14) * b - 14 * 16) * 16) + 17) / 18) / 19) * b - 19 - 21) / 21) + 22) + 23) + 24) * b - 24 + 26) * 26) / 27) / 28) - 29) * b - 29 / 31) * 31) / 32) / 33) + 34) * b - 34 * 36) - 36) - 37) * 38) - 39) * b - 39 / 41
+x43 = (((((((((((((((((((((((((((((((((((((((a - 1) + 2) * 3) * 4) * b - 4 * 6) - 6) + 7) + 8) * 9) * b - 9 / 11) + 11) * 12) / 13) + 14) * b - 14 + 16) * 16) * 17) * 18) - 19) * b - 19 / 21) / 21) - 22) * 23) / 24) * b - 24 / 26) + 26) - 27) * 28) / 29) * b - 29 / 31) / 31) - 32) + 33) - 34) * b - 34 + 36) - 36) - 37) + 38) - 39) * b - 39 - 41
+x44 = (((((((((((((((((((((((((((((((((((((((a / 1) / 2) - 3) - 4) * b - 4 - 6) / 6) * 7) / 8) + 9) * b - 9 * 11) / 11) + 12) - 13) - 14) * b - 14 / 16) - 16) + 17) + 18) + 19) * b - 19 - 21) * 21) - 22) + 23) * 24) * b - 24 / 26) - 26) - 27) - 28) - 29) * b - 29 / 31) - 31) / 32) + 33) + 34) * b - 34 / 36) / 36) - 37) * 38) * 39) * b - 39 / 41
+x45 = (((((((((((((((((((((((((((((((((((((((a / 1) + 2) / 3) * 4) * b - 4 / 6) / 6) + 7) - 8) + 9) * b - 9 + 11) - 11) / 12) / 13) + 14) * b - 14 / 16) * 16) - 17) / 18) / 19) * b - 19 + 21) - 21) / 22) * 23) - 24) * b - 24 * 26) - 26) + 27) / 28) - 29) * b - 29 + 31) * 31) / 32) * 33) - 34) * b - 34 / 36) - 36) - 37) / 38) / 39) * b - 39 - 41
+x46 = (((((((((((((((((((((((((((((((((((((((a * 1) - 2) / 3) + 4) * b - 4 / 6) + 6) + 7) / 8) / 9) * b - 9 - 11) + 11) + 12) * 13) / 14) * b - 14 * 16) + 16) + 17) / 18) + 19) * b - 19 / 21) + 21) + 22) / 23) * 24) * b - 24 + 26) - 26) * 27) + 28) + 29) * b - 29 + 31) + 31) - 32) + 33) + 34) * b - 34 * 36) - 36) - 37) + 38) - 39) * b - 39 - 41
+x47 = (((((((((((((((((((((((((((((((((((((((a * 1) * 2) - 3) - 4) * b - 4 * 6) / 6) + 7) * 8) + 9) * b - 9 + 11) / 11) + 12) * 13) / 14) * b - 14 / 16) + 16) / 17) * 18) / 19) * b - 19 / 21) * 21) + 22) * 23) / 24) * b - 24 * 26) / 26) + 27) - 28) * 29) * b - 29 - 31) - 31) - 32) - 33) + 34) * b - 34 - 36) * 36) - 37) / 38) - 39) * b - 39 * 41
+x48 = (((((((((((((((((((((((((((((((((((((((a / 1) + 2) + 3) + 4) * b - 4 - 6) * 6) + 7) + 8) / 9) * b - 9 + 11) - 11) / 12) * 13) / 14) * b - 14 - 16) + 16) - 17) + 18) / 19) * b - 19 - 21) + 21) / 22) * 23) * 24) * b - 24 * 26) * 26) * 27) / 28) - 29) * b - 29 * 31) / 31) * 32) * 33) - 34) * b - 34 / 36) + 36) / 37) * 38) + 39) * b - 39 * 41
+x49 = (((((((((((((((((((((((((((((((((((((((a - 1) - 2) * 3) + 4) * b - 4 + 6) + 6) * 7) / 8) / 9) * b - 9 / 11) - 11) + 12) * 13) + 14) * b - 14 - 16) - 16) + 17) / 18) / 19) * b - 19 * 21) / 21) * 22) + 23) * 24) * b - 24 - 26) * 26) / 27) - 28) / 29) * b - 29 + 31) / 31) / 32) / 33) * 34) * b - 34 + 36) * 36) - 37) - 38) + 39) * b - 39 * 41
+x50 = (((((((((((((((((((((((((((((((((((((((a - 1) - 2) * 3) - 4) * b - 4 / 6) / 6) + 7) - 8) + 9) * b - 9 + 11) + 11) + 12) + 13) * 14) * b - 14 * 16) / 16) - 17) + 18) - 19) * b - 19 * 21) * 21) * 22) + 23) * 24) * b - 24 - 26) + 26) - 27) + 28) / 29) * b - 29 + 31) + 31) - 32) - 33) - 34) * b - 34 - 36) + 36) + 37) + 38) * 39) * b - 39 * 41
+x51 = (((((((((((((((((((((((((((((((((((((((a / 1) - 2) * 3) / 4) * b - 4 - 6) - 6) * 7) - 8) * 9) * b - 9 - 11) + 11) * 12) * 13) - 14) * b - 14 * 16) + 16) - 17) / 18) - 19) * b - 19 - 21) - 21) + 22) + 23) / 24) * b - 24 / 26) - 26) + 27) + 28) - 29) * b - 29 - 31) + 31) / 32) - 33) * 34) * b - 34 + 36) + 36) - 37) * 38) * 39) * b - 39 / 41
+x52 = (((((((((((((((((((((((((((((((((((((((a / 1) + 2) / 3) / 4) * b - 4 * 6) / 6) * 7) * 8) + 9) * b - 9 - 11) - 11) * 12) * 13) * 14) * b - 14 - 16) - 16) / 17) * 18) - 19) * b - 19 - 21) / 21) * 22) + 23) - 24) * b - 24 + 26) / 26) + 27) / 28) - 29) * b - 29 - 31) - 31) / 32) / 33) / 34) * b - 34 - 36) * 36) / 37) - 38) / 39) * b - 39 * 41
+x53 = (((((((((((((((((((((((((((((((((((((((a + 1) / 2) * 3) * 4) * b - 4 - 6) * 6) + 7) + 8) / 9) * b - 9 / 11) + 11) * 12) + 13) * 14) * b - 14 * 16) - 16) * 17) / 18) + 19) * b - 19 / 21) / 21) * 22) / 23) / 24) * b - 24 + 26) / 26) / 27) * 28) - 29) * b - 29 * 31) * 31) * 32) + 33) * 34) * b - 34 - 36) + 36) - 37) - 38) - 39) * b - 39 + 41
+x54 = (((((((((((((((((((((((((((((((((((((((a * 1) + 2) + 3) + 4) * b - 4 * 6) - 6) / 7) + 8) + 9) * b - 9 * 11) + 11) / 12) - 13) * 14) * b - 14 * 16) / 16) * 17) * 18) + 19) * b - 19 + 21) / 21) / 22) - 23) * 24) * b - 24 * 26) * 26) * 27) * 28) + 29) * b - 29 + 31) * 31) * 32) * 33) - 34) * b - 34 + 36) + 36) / 37) * 38) * 39) * b - 39 * 41
+x55 = (((((((((((((((((((((((((((((((((((((((a - 1) / 2) - 3) * 4) * b - 4 * 6) * 6) / 7) / 8) * 9) * b - 9 / 11) / 11) + 12) + 13) + 14) * b - 14 - 16) * 16) - 17) - 18) / 19) * b - 19 * 21) - 21) * 22) * 23) - 24) * b - 24 * 26) * 26) / 27) * 28) / 29) * b - 29 / 31) + 31) * 32) * 33) * 34) * b - 34 - 36) * 36) - 37) - 38) * 39) * b - 39 * 41
+x56 = (((((((((((((((((((((((((((((((((((((((a * 1) + 2) / 3) - 4) * b - 4 + 6) * 6) - 7) + 8) + 9) * b - 9 * 11) / 11) + 12) + 13) / 14) * b - 14 * 16) / 16) - 17) + 18) + 19) * b - 19 / 21) - 21) + 22) + 23) / 24) * b - 24 * 26) + 26) * 27) - 28) - 29) * b - 29 * 31) * 31) / 32) / 33) + 34) * b - 34 - 36) / 36) + 37) / 38) * 39) * b - 39 / 41
+x57 = (((((((((((((((((((((((((((((((((((((((a - 1) + 2) * 3) / 4) * b - 4 * 6) * 6) - 7) - 8) * 9) * b - 9 - 11) + 11) / 12) + 13) * 14) * b - 14 + 16) / 16) * 17) * 18) / 19) * b - 19 - 21) * 21) + 22) + 23) / 24) * b - 24 / 26) + 26) - 27) + 28) + 29) * b - 29 * 31) / 31) * 32) + 33) / 34) * b - 34 * 36) - 36) * 37) - 38) + 39) * b - 39 * 41
+x58 = (((((((((((((((((((((((((((((((((((((((a + 1) - 2) * 3) + 4) * b - 4 + 6) * 6) * 7) / 8) - 9) * b - 9 / 11) * 11) - 12) / 13) / 14) * b - 14 + 16) * 16) * 17) / 18) * 19) * b - 19 + 21) - 21) * 22) / 23) / 24) * b - 24 + 26) / 26) - 27) - 28) + 29) * b - 29 / 31) * 31) / 32) * 33) - 34) * b - 34 + 36) - 36) / 37) - 38) / 39) * b - 39 - 41
+x59 = (((((((((((((((((((((((((((((((((((((((a * 1) - 2) - 3) / 4) * b - 4 * 6) * 6) - 7) + 8) / 9) * b - 9 * 11) + 11) + 12) / 13) + 14) * b - 14 * 16) / 16) + 17) * 18) / 19) * b - 19 * 21) + 21) / 22) - 23) / 24) * b - 24 / 26) / 26) * 27) + 28) + 29) * b - 29 + 31) + 31) / 32) / 33) / 34) * b - 34 * 36) / 36) - 37) * 38) + 39) * b - 39 + 41
+x60 = (((((((((((((((((((((((((((((((((((((((a - 1) + 2) * 3) * 4) * b - 4 + 6) - 6) - 7) + 8) / 9) * b - 9 / 11) * 11) * 12) + 13) - 14) * b - 14 - 16) - 16) + 17) / 18) - 19) * b - 19 - 21) * 21) - 22) * 23) * 24) * b - 24 + 26) + 26) * 27) / 28) * 29) * b - 29 - 31) / 31) - 32) - 33) + 34) * b - 34 + 36) / 36) + 37) / 38) / 39) * b - 39 - 41
+x61 = (((((((((((((((((((((((((((((((((((((((a + 1) / 2) * 3) + 4) * b - 4 * 6) / 6) / 7) * 8) - 9) * b - 9 / 11) + 11) - 12) + 13) - 14) * b - 14 / 16) + 16) * 17) * 18) * 19) * b - 19 + 21) * 21) * 22) * 23) + 24) * b - 24 + 26) + 26) - 27) + 28) + 29) * b - 29 + 31) + 31) - 32) * 33) - 34) * b - 34 - 36) / 36) * 37) * 38) / 39) * b - 39 * 41
+x62 = (((((((((((((((((((((((((((((((((((((((a - 1) / 2) - 3) / 4) * b - 4 / 6) - 6) - 7) * 8) - 9) * b - 9 + 11) * 11) / 12) + 13) * 14) * b - 14 * 16) + 16) * 17) / 18) - 19) * b - 19 + 21) * 21) / 22) * 23) - 24) * b - 24 / 26) / 26) * 27) / 28) / 29) * b - 29 / 31) + 31) * 32) / 33) * 34) * b - 34 + 36) * 36) - 37) - 38) * 39) * b - 39 * 41
+x63 = (((((((((((((((((((((((((((((((((((((((a - 1) * 2) / 3) / 4) * b - 4 - 6) * 6) / 7) - 8) / 9) * b - 9 * 11) / 11) * 12) / 13) + 14) * b - 14 + 16) * 16) * 17) * 18) * 19) * b - 19 / 21) + 21) - 22) - 23) - 24) * b - 24 - 26) * 26) + 27) - 28) - 29) * b - 29 - 31) - 31) / 32) * 33) * 34) * b - 34 + 36) * 36) + 37) + 38) / 39) * b - 39 - 41
+x64 = (((((((((((((((((((((((((((((((((((((((a + 1) * 2) - 3) / 4) * b - 4 / 6) * 6) * 7) * 8) - 9) * b - 9 * 11) - 11) / 12) * 13) + 14) * b - 14 / 16) - 16) * 17) + 18) - 19) * b - 19 * 21) / 21) * 22) + 23) - 24) * b - 24 - 26) / 26) * 27) - 28) - 29) * b - 29 * 31) + 31) + 32) - 33) + 34) * b - 34 + 36) / 36) / 37) - 38) + 39) * b - 39 * 41
+x65 = (((((((((((((((((((((((((((((((((((((((a + 1) * 2) - 3) * 4) * b - 4 / 6) - 6) + 7) - 8) + 9) * b - 9 / 11) + 11) * 12) + 13) + 14) * b - 14 * 16) - 16) - 17) + 18) / 19) * b - 19 + 21) - 21) - 22) + 23) * 24) * b - 24 * 26) * 26) / 27) / 28) * 29) * b - 29 + 31) - 31) / 32) / 33) + 34) * b - 34 + 36) / 36) - 37) / 38) + 39) * b - 39 + 41
+x66 = (((((((((((((((((((((((((((((((((((((((a - 1) + 2) - 3) + 4) * b - 4 / 6) * 6) * 7) / 8) * 9) * b - 9 / 11) / 11) - 12) - 13) - 14) * b - 14 / 16) / 16) - 17) / 18) + 19) * b - 19 + 21) - 21) - 22) + 23) - 24) * b - 24 - 26) * 26) + 27) / 28) * 29) * b - 29 + 31) / 31) + 32) - 33) * 34) * b - 34 - 36) / 36) * 37) * 38) * 39) * b - 39 - 41
+x67 = (((((((((((((((((((((((((((((((((((((((a - 1) / 2) + 3) + 4) * b - 4 - 6) + 6) / 7) / 8) - 9) * b - 9 + 11) - 11) * 12) * 13) / 14) * b - 14 * 16) - 16) * 17) + 18) * 19) * b - 19 + 21) * 21) * 22) - 23) - 24) * b - 24 / 26) - 26) * 27) / 28) - 29) * b - 29 / 31) - 31) - 32) / 33) / 34) * b - 34 / 36) / 36) + 37) - 38) - 39) * b - 39 * 41
+x68 = (((((((((((((((((((((((((((((((((((((((a / 1) / 2) * 3) + 4) * b - 4 / 6) - 6) - 7) / 8) * 9) * b - 9 * 11) / 11) * 12) * 13) - 14) * b - 14 - 16) - 16) - 17) / 18) - 19) * b - 19 / 21) * 21) + 22) * 23) - 24) * b - 24 + 26) * 26) + 27) - 28) + 29) * b - 29 * 31) / 31) * 32) / 33) * 34) * b - 34 + 36) - 36) + 37) * 38) - 39) * b - 39 - 41
+x69 = (((((((((((((((((((((((((((((((((((((((a + 1) + 2) * 3) + 4) * b - 4 * 6) / 6) * 7) * 8) - 9) * b - 9 / 11) / 11) + 12) * 13) * 14) * b - 14 * 16) * 16) / 17) * 18) * 19) * b - 19 * 21) / 21) / 22) * 23) + 24) * b - 24 / 26) * 26) * 27) - 28) - 29) * b - 29 / 31) - 31) * 32) * 33) - 34) * b - 34 - 36) * 36) * 37) * 38) / 39) * b - 39 / 41
+x70 = (((((((((((((((((((((((((((((((((((((((a * 1) + 2) / 3) * 4) * b - 4 + 6) / 6) + 7) + 8) * 9) * b - 9 * 11) * 11) * 12) * 13) + 14) * b - 14 * 16) * 16) - 17) + 18) / 19) * b - 19 + 21) * 21) / 22) * 23) - 24) * b - 24 / 26) * 26) * 27) / 28) - 29) * b - 29 + 31) * 31) / 32) * 33) * 34) * b - 34 / 36) - 36) + 37) * 38) + 39) * b - 39 + 41
+x71 = (((((((((((((((((((((((((((((((((((((((a / 1) * 2) / 3) - 4) * b - 4 / 6) / 6) + 7) - 8) - 9) * b - 9 - 11) / 11) + 12) / 13) * 14) * b - 14 - 16) + 16) * 17) + 18) + 19) * b - 19 * 21) - 21) - 22) + 23) / 24) * b - 24 / 26) - 26) + 27) + 28) + 29) * b - 29 - 31) / 31) * 32) + 33) * 34) * b - 34 * 36) + 36) / 37) / 38) + 39) * b - 39 * 41
+x72 = (((((((((((((((((((((((((((((((((((((((a + 1) / 2) - 3) - 4) * b - 4 * 6) / 6) + 7) / 8) - 9) * b - 9 * 11) - 11) + 12) - 13) / 14) * b - 14 - 16) * 16) - 17) / 18) - 19) * b - 19 * 21) * 21) * 22) + 23) - 24) * b - 24 + 26) / 26) + 27) * 28) - 29) * b - 29 * 31) / 31) - 32) / 33) / 34) * b - 34 + 36) + 36) * 37) - 38) - 39) * b - 39 / 41
+x73 = (((((((((((((((((((((((((((((((((((((((a * 1) + 2) / 3) / 4) * b - 4 + 6) - 6) * 7) - 8) / 9) * b - 9 + 11) - 11) + 12) * 13) / 14) * b - 14 / 16) / 16) / 17) + 18) + 19) * b - 19 / 21) + 21) * 22) + 23) / 24) * b - 24 / 26) / 26) / 27) / 28) / 29) * b - 29 - 31) / 31) + 32) / 33) + 34) * b - 34 * 36) - 36) * 37) / 38) / 39) * b - 39 + 41
+x74 = (((((((((((((((((((((((((((((((((((((((a * 1) - 2) + 3) - 4) * b - 4 - 6) - 6) / 7) - 8) + 9) * b - 9 / 11) / 11) - 12) / 13) + 14) * b - 14 + 16) * 16) / 17) * 18) / 19) * b - 19 - 21) * 21) - 22) * 23) + 24) * b - 24 + 26) * 26) - 27) / 28) + 29) * b - 29 - 31) + 31) + 32) * 33) + 34) * b - 34 / 36) * 36) + 37) / 38) + 39) * b - 39 / 41
+x75 = (((((((((((((((((((((((((((((((((((((((a / 1) / 2) / 3) / 4) * b - 4 * 6) * 6) + 7) + 8) / 9) * b - 9 / 11) * 11) * 12) * 13) * 14) * b - 14 / 16) / 16) / 17) * 18) + 19) * b - 19 + 21) - 21) - 22) + 23) * 24) * b - 24 * 26) - 26) * 27) + 28) * 29) * b - 29 - 31) * 31) + 32) * 33) - 34) * b - 34 + 36) + 36) * 37) + 38) - 39) * b - 39 - 41
+x76 = (((((((((((((((((((((((((((((((((((((((a - 1) + 2) - 3) + 4) * b - 4 - 6) + 6) / 7) / 8) - 9) * b - 9 / 11) + 11) + 12) / 13) / 14) * b - 14 * 16) - 16) + 17) + 18) - 19) * b - 19 / 21) - 21) - 22) - 23) / 24) * b - 24 + 26) - 26) + 27) * 28) * 29) * b - 29 + 31) - 31) + 32) - 33) * 34) * b - 34 + 36) - 36) * 37) / 38) * 39) * b - 39 / 41
+x77 = (((((((((((((((((((((((((((((((((((((((a * 1) / 2) + 3) - 4) * b - 4 * 6) * 6) * 7) - 8) / 9) * b - 9 - 11) - 11) + 12) / 13) * 14) * b - 14 * 16) - 16) - 17) / 18) / 19) * b - 19 - 21) / 21) * 22) + 23) - 24) * b - 24 * 26) + 26) - 27) + 28) / 29) * b - 29 + 31) / 31) - 32) / 33) / 34) * b - 34 * 36) / 36) * 37) + 38) + 39) * b - 39 - 41
+x78 = (((((((((((((((((((((((((((((((((((((((a * 1) / 2) - 3) - 4) * b - 4 + 6) + 6) * 7) + 8) * 9) * b - 9 + 11) + 11) - 12) * 13) * 14) * b - 14 + 16) + 16) + 17) - 18) - 19) * b - 19 / 21) - 21) / 22) - 23) / 24) * b - 24 * 26) * 26) / 27) / 28) * 29) * b - 29 * 31) - 31) / 32) * 33) - 34) * b - 34 + 36) - 36) + 37) / 38) * 39) * b - 39 * 41
+x79 = (((((((((((((((((((((((((((((((((((((((a + 1) - 2) - 3) / 4) * b - 4 - 6) * 6) * 7) / 8) + 9) * b - 9 + 11) * 11) / 12) + 13) + 14) * b - 14 + 16) - 16) * 17) * 18) / 19) * b - 19 + 21) - 21) - 22) * 23) / 24) * b - 24 / 26) + 26) - 27) - 28) / 29) * b - 29 + 31) / 31) * 32) / 33) - 34) * b - 34 - 36) + 36) + 37) / 38) + 39) * b - 39 + 41
+x80 = (((((((((((((((((((((((((((((((((((((((a - 1) * 2) + 3) * 4) * b - 4 / 6) + 6) * 7) - 8) - 9) * b - 9 * 11) / 11) - 12) + 13) - 14) * b - 14 - 16) - 16) + 17) + 18) - 19) * b - 19 * 21) - 21) * 22) - 23) * 24) * b - 24 - 26) + 26) - 27) / 28) - 29) * b - 29 + 31) - 31) + 32) * 33) * 34) * b - 34 / 36) / 36) / 37) * 38) / 39) * b - 39 * 41
+x81 = (((((((((((((((((((((((((((((((((((((((a / 1) / 2) / 3) * 4) * b - 4 - 6) - 6) / 7) * 8) + 9) * b - 9 / 11) * 11) / 12) - 13) * 14) * b - 14 - 16) / 16) / 17) * 18) - 19) * b - 19 - 21) / 21) / 22) * 23) * 24) * b - 24 * 26) - 26) + 27) * 28) - 29) * b - 29 - 31) * 31) * 32) + 33) * 34) * b - 34 + 36) - 36) - 37) * 38) - 39) * b - 39 - 41
+x82 = (((((((((((((((((((((((((((((((((((((((a * 1) - 2) + 3) / 4) * b - 4 * 6) + 6) - 7) / 8) - 9) * b - 9 * 11) - 11) * 12) / 13) * 14) * b - 14 - 16) + 16) + 17) / 18) / 19) * b - 19 - 21) * 21) + 22) / 23) + 24) * b - 24 + 26) + 26) / 27) * 28) + 29) * b - 29 * 31) - 31) - 32) / 33) / 34) * b - 34 / 36) + 36) / 37) * 38) - 39) * b - 39 - 41
+x83 = (((((((((((((((((((((((((((((((((((((((a + 1) * 2) / 3) / 4) * b - 4 + 6) - 6) / 7) * 8) + 9) * b - 9 - 11) * 11) * 12) / 13) / 14) * b - 14 * 16) + 16) - 17) + 18) + 19) * b - 19 / 21) - 21) * 22) - 23) + 24) * b - 24 * 26) * 26) * 27) / 28) + 29) * b - 29 - 31) + 31) * 32) + 33) + 34) * b - 34 / 36) - 36) * 37) - 38) + 39) * b - 39 * 41
+x84 = (((((((((((((((((((((((((((((((((((((((a - 1) + 2) - 3) * 4) * b - 4 - 6) + 6) / 7) / 8) + 9) * b - 9 * 11) / 11) + 12) * 13) / 14) * b - 14 + 16) + 16) / 17) * 18) * 19) * b - 19 + 21) / 21) + 22) + 23) / 24) * b - 24 - 26) + 26) / 27) + 28) * 29) * b - 29 * 31) / 31) - 32) / 33) + 34) * b - 34 / 36) - 36) / 37) - 38) - 39) * b - 39 * 41
+x85 = (((((((((((((((((((((((((((((((((((((((a - 1) - 2) + 3) / 4) * b - 4 + 6) * 6) - 7) - 8) + 9) * b - 9 / 11) * 11) / 12) - 13) / 14) * b - 14 / 16) * 16) + 17) + 18) + 19) * b - 19 * 21) - 21) / 22) * 23) + 24) * b - 24 * 26) + 26) - 27) * 28) / 29) * b - 29 * 31) / 31) * 32) * 33) + 34) * b - 34 * 36) + 36) - 37) * 38) / 39) * b - 39 - 41
+x86 = (((((((((((((((((((((((((((((((((((((((a / 1) + 2) * 3) - 4) * b - 4 - 6) - 6) * 7) / 8) - 9) * b - 9 * 11) + 11) / 12) * 13) - 14) * b - 14 / 16) / 16) + 17) / 18) * 19) * b - 19 / 21) + 21) + 22) - 23) * 24) * b - 24 / 26) + 26) - 27) * 28) + 29) * b - 29 + 31) - 31) * 32) * 33) * 34) * b - 34 * 36) * 36) * 37) - 38) - 39) * b - 39 + 41
+x87 = (((((((((((((((((((((((((((((((((((((((a / 1) * 2) + 3) - 4) * b - 4 / 6) + 6) + 7) * 8) - 9) * b - 9 + 11) - 11) * 12) / 13) - 14) * b - 14 + 16) / 16) * 17) * 18) + 19) * b - 19 + 21) + 21) - 22) + 23) / 24) * b - 24 * 26) / 26) - 27) - 28) - 29) * b - 29 + 31) / 31) - 32) - 33) * 34) * b - 34 / 36) / 36) - 37) - 38) + 39) * b - 39 / 41
+x88 = (((((((((((((((((((((((((((((((((((((((a / 1) - 2) + 3) * 4) * b - 4 - 6) + 6) * 7) - 8) * 9) * b - 9 / 11) * 11) + 12) * 13) / 14) * b - 14 / 16) + 16) - 17) / 18) * 19) * b - 19 + 21) - 21) * 22) - 23) - 24) * b - 24 * 26) * 26) + 27) + 28) + 29) * b - 29 / 31) / 31) - 32) - 33) + 34) * b - 34 / 36) / 36) + 37) + 38) + 39) * b - 39 * 41
+x89 = (((((((((((((((((((((((((((((((((((((((a * 1) / 2) + 3) + 4) * b - 4 / 6) + 6) - 7) - 8) * 9) * b - 9 - 11) - 11) * 12) - 13) - 14) * b - 14 + 16) + 16) * 17) / 18) / 19) * b - 19 * 21) - 21) + 22) - 23) / 24) * b - 24 - 26) * 26) + 27) * 28) - 29) * b - 29 / 31) * 31) / 32) + 33) + 34) * b - 34 * 36) - 36) - 37) + 38) / 39) * b - 39 - 41
+x90 = (((((((((((((((((((((((((((((((((((((((a - 1) - 2) - 3) * 4) * b - 4 - 6) * 6) + 7) / 8) - 9) * b - 9 * 11) / 11) + 12) + 13) - 14) * b - 14 + 16) - 16) + 17) + 18) - 19) * b - 19 + 21) * 21) + 22) - 23) * 24) * b - 24 + 26) * 26) - 27) / 28) / 29) * b - 29 / 31) * 31) - 32) * 33) * 34) * b - 34 - 36) * 36) / 37) / 38) + 39) * b - 39 - 41
+x91 = (((((((((((((((((((((((((((((((((((((((a - 1) - 2) * 3) + 4) * b - 4 * 6) + 6) / 7) + 8) / 9) * b - 9 + 11) - 11) * 12) + 13) + 14) * b - 14 + 16) + 16) - 17) * 18) * 19) * b - 19 - 21) - 21) - 22) * 23) * 24) * b - 24 / 26) + 26) + 27) + 28) * 29) * b - 29 / 31) / 31) + 32) + 33) - 34) * b - 34 * 36) + 36) + 37) - 38) * 39) * b - 39 + 41
+x92 = (((((((((((((((((((((((((((((((((((((((a * 1) - 2) + 3) * 4) * b - 4 - 6) * 6) * 7) / 8) + 9) * b - 9 + 11) / 11) + 12) * 13) - 14) * b - 14 / 16) / 16) + 17) / 18) * 19) * b - 19 + 21) + 21) - 22) * 23) + 24) * b - 24 * 26) - 26) - 27) + 28) - 29) * b - 29 - 31) / 31) / 32) - 33) / 34) * b - 34 * 36) - 36) - 37) / 38) - 39) * b - 39 / 41
+x93 = (((((((((((((((((((((((((((((((((((((((a / 1) - 2) * 3) - 4) * b - 4 - 6) - 6) * 7) / 8) - 9) * b - 9 - 11) * 11) / 12) - 13) / 14) * b - 14 / 16) * 16) + 17) - 18) - 19) * b - 19 + 21) * 21) + 22) - 23) + 24) * b - 24 * 26) + 26) + 27) + 28) * 29) * b - 29 / 31) - 31) * 32) * 33) + 34) * b - 34 + 36) - 36) - 37) / 38) + 39) * b - 39 - 41
+x94 = (((((((((((((((((((((((((((((((((((((((a - 1) * 2) * 3) * 4) * b - 4 + 6) + 6) + 7) + 8) + 9) * b - 9 + 11) / 11) - 12) - 13) * 14) * b - 14 * 16) + 16) + 17) - 18) * 19) * b - 19 / 21) / 21) - 22) * 23) - 24) * b - 24 + 26) + 26) - 27) - 28) * 29) * b - 29 * 31) * 31) + 32) / 33) * 34) * b - 34 + 36) + 36) / 37) * 38) * 39) * b - 39 * 41
+x95 = (((((((((((((((((((((((((((((((((((((((a / 1) * 2) * 3) * 4) * b - 4 + 6) + 6) / 7) / 8) - 9) * b - 9 - 11) * 11) - 12) + 13) * 14) * b - 14 - 16) * 16) / 17) * 18) * 19) * b - 19 - 21) - 21) * 22) + 23) / 24) * b - 24 - 26) + 26) - 27) + 28) * 29) * b - 29 * 31) / 31) - 32) * 33) / 34) * b - 34 / 36) * 36) / 37) * 38) + 39) * b - 39 * 41
+x96 = (((((((((((((((((((((((((((((((((((((((a / 1) * 2) + 3) / 4) * b - 4 - 6) + 6) - 7) * 8) + 9) * b - 9 - 11) + 11) / 12) + 13) + 14) * b - 14 * 16) / 16) + 17) / 18) * 19) * b - 19 * 21) / 21) - 22) * 23) / 24) * b - 24 + 26) + 26) * 27) * 28) + 29) * b - 29 / 31) / 31) + 32) - 33) - 34) * b - 34 / 36) / 36) - 37) * 38) / 39) * b - 39 - 41
+x97 = (((((((((((((((((((((((((((((((((((((((a - 1) / 2) / 3) * 4) * b - 4 - 6) / 6) - 7) + 8) + 9) * b - 9 * 11) * 11) + 12) - 13) * 14) * b - 14 + 16) + 16) - 17) / 18) + 19) * b - 19 - 21) + 21) * 22) + 23) / 24) * b - 24 / 26) - 26) / 27) - 28) + 29) * b - 29 - 31) * 31) / 32) * 33) / 34) * b - 34 - 36) * 36) * 37) / 38) - 39) * b - 39 * 41
+x98 = (((((((((((((((((((((((((((((((((((((((a / 1) - 2) / 3) / 4) * b - 4 + 6) - 6) * 7) - 8) + 9) * b - 9 / 11) * 11) + 12) * 13) / 14) * b - 14 - 16) * 16) * 17) + 18) - 19) * b - 19 - 21) - 21) + 22) - 23) + 24) * b - 24 * 26) * 26) + 27) * 28) * 29) * b - 29 + 31) - 31) * 32) - 33) / 34) * b - 34 * 36) * 36) * 37) * 38) + 39) * b - 39 * 41
+x99 = (((((((((((((((((((((((((((((((((((((((a - 1) / 2) / 3) - 4) * b - 4 - 6) - 6) * 7) + 8) * 9) * b - 9 * 11) * 11) + 12) / 13) / 14) * b - 14 * 16) / 16) - 17) / 18) * 19) * b - 19 / 21) * 21) + 22) - 23) - 24) * b - 24 - 26) * 26) - 27) - 28) * 29) * b - 29 - 31) + 31) * 32) / 33) / 34) * b - 34 / 36) * 36) - 37) + 38) - 39) * b - 39 * 41
+print(x0 + x99)
@@ -0,0 +1,232 @@
+#include "bytecode.h"
+#include <cstdio>
+
+using namespace std;
+
+const char* opcode_name(Opcode op) {
+    static const char* const names[] = {
+#define X(name, operand) #name,
+        OPCODES(X)
+#undef X
+    };
+    return names[(size_t)op];
+}
+
+OperandKind opcode_operand(Opcode op) {
+    static const OperandKind operands[] = {
+#define X(name, operand) OperandKind::operand,
+        OPCODES(X)
+#undef X
+    };
+    return operands[(size_t)op];
+}
+
+int stack_effect(const BytecodeModule& module, Opcode op, uint32_t operand, bool jumped) {
+    switch (op) {
+        case Opcode::NOP:
+        case Opcode::ROT_TWO:
+        case Opcode::ROT_THREE:
+        case Opcode::DELETE_FAST:
+        case Opcode::DELETE_DEREF:
+        case Opcode::DELETE_GLOBAL:
+        case Opcode::DELETE_NAME:
+        case Opcode::LOAD_ATTR:
+        case Opcode::UNARY_NEGATIVE:
+        case Opcode::UNARY_POSITIVE:
+        case Opcode::UNARY_INVERT:
+        case Opcode::UNARY_NOT:
+        case Opcode::JUMP:
+        case Opcode::GET_ITER:
+        case Opcode::YIELD_VALUE:           // the value out, the sent value in
+        case Opcode::CHECK_EXC_MATCH:       // the type out, the result in; the exception stays
+            return 0;
+        case Opcode::DUP_TOP:
+        case Opcode::LOAD_CONST:
+        case Opcode::LOAD_SMALL_INT:
+        case Opcode::LOAD_NONE:
+        case Opcode::LOAD_TRUE:
+        case Opcode::LOAD_FALSE:
+        case Opcode::LOAD_FAST:
+        case Opcode::LOAD_DEREF:
+        case Opcode::LOAD_CLOSURE:
+        case Opcode::LOAD_GLOBAL:
+        case Opcode::LOAD_NAME:
+        case Opcode::IMPORT_NAME:
+        case Opcode::IMPORT_FROM:           // the module stays
+            return 1;
+        case Opcode::STORE_ATTR:
+        case Opcode::DELETE_SUBSCR:
+        case Opcode::MAP_ADD:
+            return -2;
+        case Opcode::STORE_SUBSCR:
+            return -3;
+        case Opcode::JUMP_IF_FALSE_OR_POP:
+        case Opcode::JUMP_IF_TRUE_OR_POP:
+            return jumped ? 0 : -1;
+        case Opcode::FOR_ITER:
+            return jumped ? -1 : 1;
+        case Opcode::BUILD_LIST: return 1 - (int)operand;
+        case Opcode::BUILD_MAP: return 1 - 2 * (int)operand;
+        case Opcode::CALL: return -(int)operand;
+        case Opcode::BUILD_CLASS: return -(int)operand;     // the body in, the class out, and the base
+        case Opcode::MAKE_FUNCTION: {
+            const CodeObject& code = module.code[operand];
+            return 1 - (int)code.defaultCount - (int)code.freeNames.size();
+        }
+        default:
+            // Stores, POP_TOP, binary operators, conditional pops, returns,
+            // RERAISE, LIST_APPEND, DELETE_ATTR and IMPORT_STAR take one
+            return -1;
+    }
+}
+
+// The table starts at firstLine, offset 0; each pair moves the offset
+// forward and the line by a zigzag-encoded delta.
+int CodeObject::lineAt(uint32_t offset) const {
+    int line = firstLine;
+    uint32_t at = 0;
+    const uint8_t* p = lineTable.data();
+    const uint8_t* end = p + lineTable.size();
+    while (p < end) {
+        uint32_t next = at + read_varint(p);
+        uint32_t delta = read_varint(p);
+        if (next > offset) break;
+        at = next;
+        line += (delta & 1) ? -(int)(delta >> 1) - 1 : (int)(delta >> 1);
+    }
+    return line;
+}
+
+static void append_list(string& out, const char* label, const vector<string>& names) {
+    if (names.empty()) return;
+    out += "  ";
+    out += label;
+    out += ':';
+    for (size_t i = 0; i < names.size(); i++) {
+        out += ' ';
+        out += to_string(i);
+        out += '=';
+        out += names[i];
+    }
+    out += '\n';
+}
+
+// What an operand refers to, for the listing; empty if it is just a number.
+static string operand_note(const BytecodeModule& module, const CodeObject& code, Opcode op, uint32_t operand) {
+    auto name = [](const vector<string>& names, uint32_t i) { return i < names.size() ? names[i] : string("?"); };
+    switch (op) {
+        case Opcode::LOAD_CONST:
+            return operand < code.constants.size() ? constant_repr(code.constants[operand]) : "?";
+        case Opcode::LOAD_FAST:
+        case Opcode::STORE_FAST:
+        case Opcode::DELETE_FAST:
+            return name(code.localNames, operand);
+        case Opcode::LOAD_DEREF:
+        case Opcode::STORE_DEREF:
+        case Opcode::DELETE_DEREF:
+        case Opcode::LOAD_CLOSURE:
+            return operand < code.cellNames.size() ? code.cellNames[operand]
+                                                   : name(code.freeNames, operand - code.cellNames.size());
+        case Opcode::LOAD_GLOBAL:
+        case Opcode::STORE_GLOBAL:
+        case Opcode::DELETE_GLOBAL:
+            return name(module.globalNames, operand);
+        case Opcode::LOAD_NAME:
+        case Opcode::STORE_NAME:
+        case Opcode::DELETE_NAME:
+        case Opcode::LOAD_ATTR:
+        case Opcode::STORE_ATTR:
+        case Opcode::DELETE_ATTR:
+        case Opcode::IMPORT_NAME:
+        case Opcode::IMPORT_FROM:
+            return name(code.names, operand);
+        case Opcode::MAKE_FUNCTION:
+            return operand < module.code.size() ? "code " + module.code[operand].name : "?";
+        default:
+            return "";
+    }
+}
+
+static void disassemble_code(const BytecodeModule& module, const CodeObject& code, size_t index, string& out) {
+    out += "\ncode ";
+    out += to_string(index);
+    out += ' ';
+    out += code.name;
+    out += " (";
+    out += scope_kind_name(code.kind);
+    if (code.flags & CODE_GENERATOR) out += ", generator";
+    out += "): ";
+    out += to_string(code.argCount) + " args (" + to_string(code.defaultCount) + " defaults), ";
+    out += to_string(code.localNames.size()) + " locals, stack " + to_string(code.maxStack) + ", ";
+    out += to_string(code.code.size()) + " bytes\n";
+    if (!code.constants.empty()) {
+        out += "  constants:";
+        for (size_t i = 0; i < code.constants.size(); i++) {
+            out += ' ' + to_string(i) + '=' + constant_repr(code.constants[i]);
+        }
+        out += '\n';
+    }
+    append_list(out, "locals", code.localNames);
+    append_list(out, "cells", code.cellNames);
+    append_list(out, "free", code.freeNames);
+    append_list(out, "names", code.names);
+
+    const uint8_t* begin = code.code.data();
+    const uint8_t* pc = begin;
+    const uint8_t* end = begin + code.code.size();
+    int lastLine = -1;
+    char prefix[32];
+    while (pc < end) {
+        uint32_t offset = pc - begin;
+        Opcode op = (Opcode)*pc++;
+        int line = code.lineAt(offset);
+        if (line != lastLine) {
+            snprintf(prefix, sizeof prefix, "%6d ", line);
+            lastLine = line;
+        } else {
+            snprintf(prefix, sizeof prefix, "       ");
+        }
+        out += prefix;
+        snprintf(prefix, sizeof prefix, "%6u  ", offset);
+        out += prefix;
+        if ((size_t)op >= OPCODE_COUNT) {
+            out += "<bad opcode " + to_string((int)op) + ">\n";
+            break;
+        }
+        out += opcode_name(op);
+        switch (opcode_operand(op)) {
+            case OperandKind::NONE: break;
+            case OperandKind::INT16: out += ' ' + to_string(read_int16(pc)); break;
+            case OperandKind::JUMP: out += " -> " + to_string(read_varint(pc)); break;
+            case OperandKind::UINT: {
+                uint32_t operand = read_varint(pc);
+                out += ' ' + to_string(operand);
+                string note = operand_note(module, code, op, operand);
+                if (!note.empty()) out += " (" + note + ")";
+                break;
+            }
+        }
+        out += '\n';
+    }
+    for (const ExceptionHandler& handler : code.handlers) {
+        out += "  handler [" + to_string(handler.start) + ", " + to_string(handler.end) + ") -> " +
+               to_string(handler.handler) + ", depth " + to_string(handler.depth) + '\n';
+    }
+}
+
+void disassemble(const BytecodeModule& module, ostream& out) {
+    string text;
+    for (size_t i = 0; i < module.code.size(); i++) {
+        disassemble_code(module, module.code[i], i, text);
+        if (text.size() >= (1 << 20)) {
+            out << text;
+            text.clear();
+        }
+    }
+    if (!module.globalNames.empty()) {
+        text += "\nglobals:";
+        for (size_t i = 0; i < module.globalNames.size(); i++) text += ' ' + to_string(i) + '=' + module.globalNames[i];
+        text += '\n';
+    }
+    out << text;
+}
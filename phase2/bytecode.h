@@ -0,0 +1,164 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include "constant_folding.h"
+#include "scope_tree.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Stack-machine bytecode for the grammar's Python subset. An instruction is
+// a 1-byte opcode followed by at most one operand:
+//
+//   NONE    no operand
+//   UINT    unsigned LEB128 varint: slot, pool index, count or code index
+//   INT16   signed 16-bit, little endian (LOAD_SMALL_INT)
+//   JUMP    varint absolute offset of the target in the same code object
+//
+// Most operands are below 128 and take one byte. Jumps are sized by the
+// assembler, which grows them until every target fits (see
+// BytecodeCompiler).
+//
+// Names are resolved at compile time from the scope tree. Function locals
+// live in numbered slots (LOAD_FAST); locals captured by inner functions
+// live in cells (LOAD_DEREF), numbered own cells first, then the cells the
+// function captured itself. Module-level names, builtins and names nothing
+// binds are global slots of the module (LOAD_GLOBAL), and an unbound global
+// slot falls back to the builtin of the same name. Class bodies keep their
+// names in a namespace (LOAD_NAME), as in Python.
+#define OPCODES(X) \
+    X(NOP, NONE) X(POP_TOP, NONE) X(DUP_TOP, NONE) X(ROT_TWO, NONE) X(ROT_THREE, NONE) \
+    X(LOAD_CONST, UINT) X(LOAD_SMALL_INT, INT16) X(LOAD_NONE, NONE) X(LOAD_TRUE, NONE) X(LOAD_FALSE, NONE) \
+    X(LOAD_FAST, UINT) X(STORE_FAST, UINT) X(DELETE_FAST, UINT) \
+    X(LOAD_DEREF, UINT) X(STORE_DEREF, UINT) X(DELETE_DEREF, UINT) X(LOAD_CLOSURE, UINT) \
+    X(LOAD_GLOBAL, UINT) X(STORE_GLOBAL, UINT) X(DELETE_GLOBAL, UINT) \
+    X(LOAD_NAME, UINT) X(STORE_NAME, UINT) X(DELETE_NAME, UINT) \
+    X(LOAD_ATTR, UINT) X(STORE_ATTR, UINT) X(DELETE_ATTR, UINT) \
+    X(BINARY_SUBSCR, NONE) X(STORE_SUBSCR, NONE) X(DELETE_SUBSCR, NONE) \
+    X(BINARY_ADD, NONE) X(BINARY_SUBTRACT, NONE) X(BINARY_MULTIPLY, NONE) X(BINARY_TRUE_DIVIDE, NONE) \
+    X(BINARY_FLOOR_DIVIDE, NONE) X(BINARY_MODULO, NONE) X(BINARY_POWER, NONE) \
+    X(BINARY_LSHIFT, NONE) X(BINARY_RSHIFT, NONE) X(BINARY_AND, NONE) X(BINARY_OR, NONE) X(BINARY_XOR, NONE) \
+    X(INPLACE_ADD, NONE) \
+    X(COMPARE_EQ, NONE) X(COMPARE_NE, NONE) X(COMPARE_LT, NONE) X(COMPARE_LE, NONE) \
+    X(COMPARE_GT, NONE) X(COMPARE_GE, NONE) X(COMPARE_IN, NONE) X(COMPARE_NOT_IN, NONE) \
+    X(COMPARE_IS, NONE) X(COMPARE_IS_NOT, NONE) \
+    X(UNARY_NEGATIVE, NONE) X(UNARY_POSITIVE, NONE) X(UNARY_INVERT, NONE) X(UNARY_NOT, NONE) \
+    X(JUMP, JUMP) X(POP_JUMP_IF_FALSE, JUMP) X(POP_JUMP_IF_TRUE, JUMP) \
+    X(JUMP_IF_FALSE_OR_POP, JUMP) X(JUMP_IF_TRUE_OR_POP, JUMP) \
+    X(GET_ITER, NONE) X(FOR_ITER, JUMP) \
+    X(BUILD_LIST, UINT) X(LIST_APPEND, NONE) X(BUILD_MAP, UINT) X(MAP_ADD, NONE) \
+    X(CALL, UINT) X(RETURN_VALUE, NONE) X(YIELD_VALUE, NONE) \
+    X(MAKE_FUNCTION, UINT) X(BUILD_CLASS, UINT) \
+    X(CHECK_EXC_MATCH, NONE) X(RERAISE, NONE) \
+    X(IMPORT_NAME, UINT) X(IMPORT_FROM, UINT) X(IMPORT_STAR, NONE)
+
+enum class Opcode : uint8_t {
+#define X(name, operand) name,
+    OPCODES(X)
+#undef X
+};
+
+const size_t OPCODE_COUNT = 0
+#define X(name, operand) + 1
+    OPCODES(X)
+#undef X
+    ;
+
+enum class OperandKind : uint8_t { NONE, UINT, INT16, JUMP };
+
+const char* opcode_name(Opcode op);
+OperandKind opcode_operand(Opcode op);
+
+inline bool is_jump(Opcode op) { return opcode_operand(op) == OperandKind::JUMP; }
+
+// --- operand encoding ---
+
+inline size_t varint_size(uint32_t value) {
+    size_t size = 1;
+    for (; value >= 0x80; value >>= 7) size++;
+    return size;
+}
+
+inline void write_varint(std::vector<uint8_t>& out, uint32_t value) {
+    for (; value >= 0x80; value >>= 7) out.push_back((uint8_t)(value | 0x80));
+    out.push_back((uint8_t)value);
+}
+
+// Advances pc past the varint.
+inline uint32_t read_varint(const uint8_t*& pc) {
+    uint32_t value = *pc++;
+    if (value < 0x80) return value;
+    value &= 0x7f;
+    for (int shift = 7;; shift += 7) {
+        uint32_t byte = *pc++;
+        value |= (byte & 0x7f) << shift;
+        if (byte < 0x80) return value;
+    }
+}
+
+inline int16_t read_int16(const uint8_t*& pc) {
+    int16_t value = (int16_t)(pc[0] | (pc[1] << 8));
+    pc += 2;
+    return value;
+}
+
+// --- code objects ---
+
+// A try block: an exception raised at an offset in [start, end) truncates
+// the operand stack to depth values, pushes the exception and continues at
+// handler. Entries are ordered innermost first, so the first match wins.
+struct ExceptionHandler {
+    uint32_t start, end;
+    uint32_t handler;
+    uint32_t depth;
+};
+
+enum CodeFlag : uint8_t {
+    CODE_GENERATOR = 1,     // contains yield
+    CODE_HAS_BASE = 2,      // class body: the class names a base
+};
+
+// Compiled body of the module, a class or a function.
+struct CodeObject {
+    std::string name;                       // "<module>", class or function name
+    ScopeKind kind = ScopeKind::MODULE;
+    uint8_t flags = 0;
+    int firstLine = 0;
+    uint32_t argCount = 0;                  // parameters: locals 0 .. argCount-1
+    uint32_t defaultCount = 0;              // trailing parameters with a default
+    uint32_t maxStack = 0;                  // deepest operand stack the code reaches
+    std::vector<std::string> localNames;    // by fast slot
+    std::vector<std::string> cellNames;     // locals inner functions capture
+    std::vector<int32_t> cellArguments;     // by cell: parameter copied in on entry, or -1
+    std::vector<std::string> freeNames;     // cells captured from enclosing functions
+    std::vector<ConstantValue> constants;
+    std::vector<std::string> names;         // attributes, class body names, imports
+    std::vector<uint8_t> code;
+    std::vector<uint8_t> lineTable;         // (offset delta, line delta) varint pairs, see lineAt
+    std::vector<ExceptionHandler> handlers;
+
+    // Source line of the instruction at offset.
+    int lineAt(uint32_t offset) const;
+
+    size_t derefCount() const { return cellNames.size() + freeNames.size(); }
+};
+
+// Code objects are numbered like the scope tree's scopes, so the module body
+// is code[0] and MAKE_FUNCTION's operand is a scope index.
+struct BytecodeModule {
+    std::vector<CodeObject> code;
+    std::vector<std::string> globalNames;   // by global slot
+};
+
+// Values an instruction pushes minus those it pops, when it falls through
+// (jumped = false) or takes its jump. FOR_ITER pushes the next item or, at
+// the end, pops the iterator and jumps. MAKE_FUNCTION pops the defaults and
+// closure cells of the code object it names, so module must hold it.
+int stack_effect(const BytecodeModule& module, Opcode op, uint32_t operand, bool jumped);
+
+// Human-readable listing of every code object: constants, slots, then one
+// instruction per line with its offset, line and resolved operand.
+void disassemble(const BytecodeModule& module, std::ostream& out);
+
+#endif // BYTECODE_H
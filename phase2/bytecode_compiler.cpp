@@ -0,0 +1,1323 @@
+#include "bytecode_compiler.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+// Lists and dicts up to this many items are built from the stack in one
+// instruction; the rest of a longer literal is appended item by item, so it
+// does not need a deep stack.
+const uint32_t MAX_BUILD_ITEMS = 32;
+
+static const ParseTreeNode* child(const ParseTreeNode& node, size_t i) {
+    return i < node.children.size() ? node.children[i].get() : nullptr;
+}
+
+static const ParseTreeNode* find_child(const ParseTreeNode& node, NodeKind kind) {
+    for (const auto& c : node.children) {
+        if (c && c->kind == kind) return c.get();
+    }
+    return nullptr;
+}
+
+static bool is_comparison(const string& op) {
+    return op == "==" || op == "!=" || op == "<" || op == "<=" || op == ">" || op == ">=" ||
+           op == "in" || op == "not in" || op == "is" || op == "is not";
+}
+
+static bool binary_opcode(const string& op, Opcode& code) {
+    static const unordered_map<string, Opcode> opcodes = {
+        {"+", Opcode::BINARY_ADD}, {"-", Opcode::BINARY_SUBTRACT}, {"*", Opcode::BINARY_MULTIPLY},
+        {"/", Opcode::BINARY_TRUE_DIVIDE}, {"//", Opcode::BINARY_FLOOR_DIVIDE}, {"%", Opcode::BINARY_MODULO},
+        {"**", Opcode::BINARY_POWER}, {"<<", Opcode::BINARY_LSHIFT}, {">>", Opcode::BINARY_RSHIFT},
+        {"&", Opcode::BINARY_AND}, {"|", Opcode::BINARY_OR}, {"^", Opcode::BINARY_XOR},
+        {"==", Opcode::COMPARE_EQ}, {"!=", Opcode::COMPARE_NE}, {"<", Opcode::COMPARE_LT},
+        {"<=", Opcode::COMPARE_LE}, {">", Opcode::COMPARE_GT}, {">=", Opcode::COMPARE_GE},
+        {"in", Opcode::COMPARE_IN}, {"not in", Opcode::COMPARE_NOT_IN},
+        {"is", Opcode::COMPARE_IS}, {"is not", Opcode::COMPARE_IS_NOT},
+    };
+    auto it = opcodes.find(op);
+    if (it == opcodes.end()) return false;
+    code = it->second;
+    return true;
+}
+
+static void append_utf8(string& out, uint32_t c) {
+    if (c < 0x80) {
+        out += (char)c;
+    } else if (c < 0x800) {
+        out += (char)(0xc0 | (c >> 6));
+        out += (char)(0x80 | (c & 0x3f));
+    } else if (c < 0x10000) {
+        out += (char)(0xe0 | (c >> 12));
+        out += (char)(0x80 | ((c >> 6) & 0x3f));
+        out += (char)(0x80 | (c & 0x3f));
+    } else {
+        out += (char)(0xf0 | (c >> 18));
+        out += (char)(0x80 | ((c >> 12) & 0x3f));
+        out += (char)(0x80 | ((c >> 6) & 0x3f));
+        out += (char)(0x80 | (c & 0x3f));
+    }
+}
+
+// Reads up to maxDigits digits of base at text[i], advancing i.
+static uint32_t read_digits(const string& text, size_t& i, int base, int maxDigits) {
+    uint32_t value = 0;
+    for (int n = 0; n < maxDigits && i < text.size(); n++, i++) {
+        char c = text[i];
+        int digit = isdigit((unsigned char)c) ? c - '0' : isxdigit((unsigned char)c) ? tolower(c) - 'a' + 10 : 99;
+        if (digit >= base) break;
+        value = value * base + digit;
+    }
+    return value;
+}
+
+// The value of a string literal's text, with escapes decoded as in Python;
+// unknown escapes keep their backslash.
+static string decode_string(const string& text) {
+    string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            out += text[i];
+            continue;
+        }
+        char c = text[++i];
+        switch (c) {
+            case '\n': break;       // line continuation
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'a': out += '\a'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'v': out += '\v'; break;
+            case '\\': case '\'': case '"': out += c; break;
+            case 'x': case 'u': case 'U': {
+                size_t start = ++i;
+                int digits = c == 'x' ? 2 : c == 'u' ? 4 : 8;
+                uint32_t value = read_digits(text, i, 16, digits);
+                if (i - start != (size_t)digits) {
+                    out += '\\';
+                    i = start - 1;
+                    out += c;
+                    break;
+                }
+                append_utf8(out, value);
+                i--;
+                break;
+            }
+            default:
+                if (c >= '0' && c <= '7') {
+                    append_utf8(out, read_digits(text, i, 8, 3));
+                    i--;
+                } else {
+                    out += '\\';
+                    out += c;
+                }
+                break;
+        }
+    }
+    return out;
+}
+
+// Text of the string whose quotes are at children[begin] and the next
+// STRING_QUOTE; a triple-quoted string is split across several literals.
+static string string_text(const ParseTreeNode& node, size_t begin, size_t* end = nullptr) {
+    string text;
+    size_t i = begin + 1;
+    for (; i < node.children.size() && node.children[i]->kind != NodeKind::STRING_QUOTE; i++) {
+        if (node.children[i]->kind == NodeKind::STRING_LITERAL) text += node.children[i]->value;
+    }
+    if (end) *end = i;
+    return decode_string(text);
+}
+
+struct BytecodeCompiler::Emitter {
+    struct Instruction {
+        Opcode op;
+        uint32_t operand;       // a label for jumps
+        int line;
+    };
+
+    // A try block's protected range, in labels. Unwinding for break,
+    // continue and return closes the range before the code it emits, so a
+    // try covers a list of ranges.
+    struct Range {
+        uint32_t start, end, handler;
+        uint32_t depth;
+    };
+
+    enum class BlockKind { LOOP, TRY, FINALLY, FINALLY_EXCEPTION };
+
+    // What break, continue and return leave on the way out.
+    struct Block {
+        BlockKind kind;
+        uint32_t continueLabel = 0, breakLabel = 0;     // LOOP
+        bool holdsIterator = false;                     // LOOP: a for loop's iterator is on the stack
+        uint32_t handler = 0, start = 0, depth = 0;     // TRY: where its open range began
+        const ParseTreeNode* finallyBody = nullptr;     // FINALLY
+    };
+
+    // The code object being emitted.
+    struct Unit {
+        uint32_t scope = 0;
+        CodeObject code;
+        vector<Instruction> instructions;
+        vector<uint32_t> labels;                    // by label: instruction it is bound to
+        vector<Range> ranges;
+        vector<Block> blocks;
+        unordered_map<int32_t, uint32_t> slotOf;    // symbol -> fast slot
+        unordered_map<int32_t, uint32_t> derefOf;   // symbol -> cell index
+        unordered_map<string, uint32_t> constantIndex;
+        unordered_map<string, uint32_t> nameIndex;
+        uint32_t stackBase = 0;     // values held below the statement being emitted
+        int line = 0;
+    };
+
+    BytecodeCompiler& compiler;
+    const ScopeTree& tree;
+    vector<pair<uint32_t, int>> lineStarts;     // (offset, line) of each token
+    unordered_map<const ParseTreeNode*, uint32_t> scopeOf;
+    vector<vector<int32_t>> freeSymbols;        // by scope: symbols captured from enclosing functions
+    vector<bool> captured;                      // by symbol: lives in a cell
+    unordered_map<string, uint32_t> globalSlot;
+    Unit* unit = nullptr;
+
+    Emitter(BytecodeCompiler& compiler, const ScopeTree& tree, const vector<Token>& tokens)
+        : compiler(compiler), tree(tree) {
+        for (const Token& token : tokens) {
+            if (token.offset >= 0) lineStarts.push_back({(uint32_t)token.offset, token.line});
+        }
+        for (uint32_t s = 0; s < tree.scopes().size(); s++) scopeOf[tree.scopes()[s].node] = s;
+
+        // A name read from an enclosing function lives in a cell there, and
+        // every scope between passes the cell on
+        freeSymbols.resize(tree.scopes().size());
+        captured.assign(tree.symbols().size(), false);
+        unordered_set<uint64_t> passed;
+        for (const NameReference& ref : tree.references()) {
+            if (ref.resolution != NameResolution::ENCLOSING || ref.symbol < 0) continue;
+            uint32_t owner = tree.symbols()[ref.symbol].scope;
+            captured[ref.symbol] = true;
+            for (int32_t s = ref.scope; s >= 0 && (uint32_t)s != owner; s = tree.scopes()[s].parent) {
+                if (passed.insert(pack_key(s, ref.symbol)).second) freeSymbols[s].push_back(ref.symbol);
+            }
+        }
+
+        // Module-level names first, so their slots follow the symbol order
+        const Scope& module = tree.scopes()[0];
+        for (uint32_t i = module.symbolBegin; i < module.symbolEnd; i++) global(tree.symbols()[i].name);
+    }
+
+    int lineOf(const ParseTreeNode& node) const {
+        if (node.sourceStart == NO_SOURCE_OFFSET || lineStarts.empty()) return unit ? unit->line : 0;
+        auto it = upper_bound(lineStarts.begin(), lineStarts.end(), make_pair(node.sourceStart, INT32_MAX));
+        return it == lineStarts.begin() ? lineStarts.front().second : prev(it)->second;
+    }
+
+    void error(const ParseTreeNode* node, const string& message) {
+        compiler.errorList.push_back({node ? lineOf(*node) : unit->line, message});
+    }
+
+    // --- pools and slots ---
+
+    uint32_t global(const string& name) {
+        auto inserted = globalSlot.insert({name, (uint32_t)compiler.result.globalNames.size()});
+        if (inserted.second) compiler.result.globalNames.push_back(name);
+        return inserted.first->second;
+    }
+
+    uint32_t nameIndex(const string& name) {
+        auto inserted = unit->nameIndex.insert({name, (uint32_t)unit->code.names.size()});
+        if (inserted.second) unit->code.names.push_back(name);
+        return inserted.first->second;
+    }
+
+    uint32_t constant(const ConstantValue& value) {
+        // Keyed by kind and exact bits: 1, 1.0 and True stay apart, as do 0.0 and -0.0
+        string key(1, (char)value.kind);
+        switch (value.kind) {
+            case ConstantValue::INT:
+            case ConstantValue::BOOL: key.append((const char*)&value.intValue, sizeof value.intValue); break;
+            case ConstantValue::FLOAT: key.append((const char*)&value.floatValue, sizeof value.floatValue); break;
+            case ConstantValue::STR: key += value.text; break;
+            case ConstantValue::NONE: break;
+        }
+        auto inserted = unit->constantIndex.insert({key, (uint32_t)unit->code.constants.size()});
+        if (inserted.second) unit->code.constants.push_back(value);
+        return inserted.first->second;
+    }
+
+    // --- emitting ---
+
+    void emit(Opcode op, uint32_t operand = 0) {
+        unit->instructions.push_back({op, operand, unit->line});
+    }
+
+    uint32_t newLabel() {
+        unit->labels.push_back(UINT32_MAX);
+        return unit->labels.size() - 1;
+    }
+
+    void bind(uint32_t label) { unit->labels[label] = unit->instructions.size(); }
+
+    uint32_t here() {
+        uint32_t label = newLabel();
+        bind(label);
+        return label;
+    }
+
+    void setLine(const ParseTreeNode& node) {
+        if (node.sourceStart != NO_SOURCE_OFFSET) unit->line = lineOf(node);
+    }
+
+    enum class Access { LOAD, STORE, DELETE };
+
+    void name(const ParseTreeNode& leaf, Access access) {
+        static const Opcode fast[] = {Opcode::LOAD_FAST, Opcode::STORE_FAST, Opcode::DELETE_FAST};
+        static const Opcode deref[] = {Opcode::LOAD_DEREF, Opcode::STORE_DEREF, Opcode::DELETE_DEREF};
+        static const Opcode named[] = {Opcode::LOAD_NAME, Opcode::STORE_NAME, Opcode::DELETE_NAME};
+        static const Opcode globals[] = {Opcode::LOAD_GLOBAL, Opcode::STORE_GLOBAL, Opcode::DELETE_GLOBAL};
+        size_t a = (size_t)access;
+        int32_t symbol;
+        NameResolution resolution = tree.resolve(unit->scope, leaf.value, symbol);
+        if (resolution == NameResolution::LOCAL || resolution == NameResolution::ENCLOSING) {
+            if (unit->code.kind == ScopeKind::CLASS && resolution == NameResolution::LOCAL) {
+                emit(named[a], nameIndex(leaf.value));
+                return;
+            }
+            auto cell = unit->derefOf.find(symbol);
+            if (cell != unit->derefOf.end()) {
+                emit(deref[a], cell->second);
+                return;
+            }
+            auto slot = unit->slotOf.find(symbol);
+            if (slot != unit->slotOf.end()) {
+                emit(fast[a], slot->second);
+                return;
+            }
+        }
+        emit(globals[a], global(leaf.value));
+    }
+
+    // --- code objects ---
+
+    void compileScope(uint32_t s) {
+        const Scope& scope = tree.scopes()[s];
+        Unit u;
+        u.scope = s;
+        u.code.kind = scope.kind;
+        u.code.name = scope.kind == ScopeKind::MODULE ? "<module>" : scope.name;
+        Unit* saved = unit;
+        unit = &u;
+        u.line = u.code.firstLine = lineOf(*scope.node);
+
+        const ParseTreeNode* body = scope.node;
+        if (scope.kind != ScopeKind::MODULE) {
+            if (scope.kind == ScopeKind::FUNCTION) parameters(*scope.node);
+            for (int32_t symbol : freeSymbols[s]) {
+                u.derefOf[symbol] = u.code.derefCount();
+                u.code.freeNames.push_back(tree.symbols()[symbol].name);
+            }
+            body = find_child(*scope.node, NodeKind::statement_list);
+            if (!body && find_child(*scope.node, NodeKind::lazy_body)) {
+                error(scope.node, "body of " + scope.name + " was not parsed; expand lazy bodies first");
+            }
+            if (!body) body = find_child(*scope.node, NodeKind::statement);     // def f(): return 1
+        }
+        bool terminated = body && statement(*body);
+        if (!terminated) {
+            emit(Opcode::LOAD_NONE);
+            emit(Opcode::RETURN_VALUE);
+        }
+        assemble();
+        compiler.instructions += u.instructions.size();
+        compiler.result.code[s] = move(u.code);
+        unit = saved;
+    }
+
+    // Parameters take the first slots, in order; cells follow the other
+    // locals, and a parameter that is captured is copied into its cell.
+    void parameters(const ParseTreeNode& funcDef) {
+        CodeObject& code = unit->code;
+        unordered_map<int32_t, uint32_t> parameterSlot;
+        if (const ParseTreeNode* list = find_child(funcDef, NodeKind::param_list)) {
+            for (const auto& param : list->children) {
+                if (!param || param->kind != NodeKind::param) continue;
+                const ParseTreeNode* leaf = child(*param, 0);
+                if (!leaf) continue;
+                int32_t symbol = tree.lookup(unit->scope, leaf->value);
+                if (parameterSlot.count(symbol)) {
+                    error(leaf, "duplicate argument '" + leaf->value + "' in function definition");
+                }
+                parameterSlot[symbol] = code.localNames.size();
+                unit->slotOf[symbol] = code.localNames.size();
+                code.localNames.push_back(leaf->value);
+                code.argCount++;
+                if (child(*param, 2)) {
+                    code.defaultCount++;
+                } else if (code.defaultCount > 0) {
+                    error(leaf, "parameter without a default follows parameter with a default");
+                }
+            }
+        }
+        const Scope& scope = tree.scopes()[unit->scope];
+        for (uint32_t symbol = scope.symbolBegin; symbol < scope.symbolEnd; symbol++) {
+            const string& name = tree.symbols()[symbol].name;
+            if (captured[symbol]) {
+                auto parameter = parameterSlot.find(symbol);
+                unit->derefOf[symbol] = code.cellNames.size();
+                code.cellNames.push_back(name);
+                code.cellArguments.push_back(parameter == parameterSlot.end() ? -1 : (int32_t)parameter->second);
+            } else if (!unit->slotOf.count(symbol)) {
+                unit->slotOf[symbol] = code.localNames.size();
+                code.localNames.push_back(name);
+            }
+        }
+    }
+
+    // Pushes the cells scope s captures, for MAKE_FUNCTION.
+    void closure(uint32_t s) {
+        for (int32_t symbol : freeSymbols[s]) {
+            auto cell = unit->derefOf.find(symbol);
+            if (cell == unit->derefOf.end()) {
+                error(nullptr, "internal error: no cell for " + tree.symbols()[symbol].name);
+                emit(Opcode::LOAD_NONE);
+                continue;
+            }
+            emit(Opcode::LOAD_CLOSURE, cell->second);
+        }
+    }
+
+    // --- assembly ---
+
+    void assemble() {
+        Unit& u = *unit;
+        CodeObject& code = u.code;
+        const vector<Instruction>& in = u.instructions;
+        size_t n = in.size();
+
+        // Jumps start at one operand byte and grow until their targets fit;
+        // sizes only grow, so this settles
+        vector<uint8_t> size(n);
+        for (size_t i = 0; i < n; i++) {
+            switch (opcode_operand(in[i].op)) {
+                case OperandKind::NONE: size[i] = 1; break;
+                case OperandKind::INT16: size[i] = 3; break;
+                case OperandKind::UINT: size[i] = 1 + varint_size(in[i].operand); break;
+                case OperandKind::JUMP: size[i] = 2; break;
+            }
+        }
+        vector<uint32_t> offset(n + 1);
+        for (bool grew = true; grew;) {
+            for (size_t i = 0; i < n; i++) offset[i + 1] = offset[i] + size[i];
+            grew = false;
+            for (size_t i = 0; i < n; i++) {
+                if (!is_jump(in[i].op)) continue;
+                uint8_t needed = 1 + varint_size(offset[u.labels[in[i].operand]]);
+                if (needed > size[i]) {
+                    size[i] = needed;
+                    grew = true;
+                }
+            }
+        }
+
+        code.code.reserve(offset[n]);
+        int line = code.firstLine;
+        uint32_t lineOffset = 0;
+        for (size_t i = 0; i < n; i++) {
+            const Instruction& instruction = in[i];
+            if (instruction.line != line) {
+                int delta = instruction.line - line;
+                write_varint(code.lineTable, offset[i] - lineOffset);
+                write_varint(code.lineTable, delta < 0 ? ((uint32_t)(-delta - 1) << 1) | 1 : (uint32_t)delta << 1);
+                line = instruction.line;
+                lineOffset = offset[i];
+            }
+            code.code.push_back((uint8_t)instruction.op);
+            switch (opcode_operand(instruction.op)) {
+                case OperandKind::NONE: break;
+                case OperandKind::INT16:
+                    code.code.push_back((uint8_t)instruction.operand);
+                    code.code.push_back((uint8_t)(instruction.operand >> 8));
+                    break;
+                case OperandKind::UINT: write_varint(code.code, instruction.operand); break;
+                case OperandKind::JUMP: {
+                    // Padded to the size the jump was given
+                    uint32_t target = offset[u.labels[instruction.operand]];
+                    size_t end = code.code.size() + size[i] - 1;
+                    for (; code.code.size() + 1 < end; target >>= 7) code.code.push_back((uint8_t)((target & 0x7f) | 0x80));
+                    code.code.push_back((uint8_t)target);
+                    break;
+                }
+            }
+        }
+
+        for (const Range& range : u.ranges) {
+            uint32_t start = offset[u.labels[range.start]], end = offset[u.labels[range.end]];
+            if (start < end) code.handlers.push_back({start, end, offset[u.labels[range.handler]], range.depth});
+        }
+        // Ranges nest, so the innermost one containing an offset starts last
+        // and, among those starting together, ends first
+        stable_sort(code.handlers.begin(), code.handlers.end(), [](const ExceptionHandler& a, const ExceptionHandler& b) {
+            return a.start != b.start ? a.start > b.start : a.end < b.end;
+        });
+
+        code.maxStack = maxStack(offset);
+    }
+
+    // Follows every path from the entry and the handlers, checking that paths
+    // meet with the same depth.
+    uint32_t maxStack(const vector<uint32_t>& offset) {
+        const vector<Instruction>& in = unit->instructions;
+        size_t n = in.size();
+        vector<int> depth(n + 1, -1);
+        vector<size_t> pending;
+        int deepest = 0;
+        auto reach = [&](size_t i, int d) {
+            if (d < 0) {
+                error(nullptr, "internal error: stack underflow in " + unit->code.name);
+                return;
+            }
+            deepest = max(deepest, d);
+            if (depth[i] < 0) {
+                depth[i] = d;
+                pending.push_back(i);
+            } else if (depth[i] != d) {
+                error(nullptr, "internal error: stack depths differ at offset " + to_string(offset[i]) +
+                               " in " + unit->code.name);
+            }
+        };
+        reach(0, 0);
+        for (const Range& range : unit->ranges) {
+            if (unit->labels[range.start] < unit->labels[range.end]) reach(unit->labels[range.handler], range.depth + 1);
+        }
+        while (!pending.empty()) {
+            size_t i = pending.back();
+            pending.pop_back();
+            if (i == n) continue;
+            const Instruction& instruction = in[i];
+            Opcode op = instruction.op;
+            if (is_jump(op)) reach(unit->labels[instruction.operand], depth[i] + stack_effect(compiler.result, op, instruction.operand, true));
+            if (op != Opcode::JUMP && op != Opcode::RETURN_VALUE && op != Opcode::RERAISE) {
+                reach(i + 1, depth[i] + stack_effect(compiler.result, op, instruction.operand, false));
+            }
+        }
+        return deepest;
+    }
+
+    // --- statements ---
+
+    // Each returns true if control never continues past the statement; the
+    // rest of the block is then left out.
+    bool statements(const ParseTreeNode& list) {
+        for (const auto& c : list.children) {
+            if (c && statement(*c)) return true;
+        }
+        return false;
+    }
+
+    bool statement(const ParseTreeNode& node) {
+        setLine(node);
+        switch (node.kind) {
+            case NodeKind::program:
+            case NodeKind::statement:
+            case NodeKind::statement_list:
+            case NodeKind::loop_statement:
+            case NodeKind::loop_statement_list:
+                return statements(node);
+            case NodeKind::assignment:
+                expression(child(node, 2));
+                target(child(node, 0));
+                return false;
+            case NodeKind::augmented_assignment: augmentedAssignment(node); return false;
+            case NodeKind::return_stmt: return returnStatement(node);
+            case NodeKind::yield_stmt: yieldStatement(node); return false;
+            case NodeKind::break_stmt: return loopExit(node, true);
+            case NodeKind::continue_stmt: return loopExit(node, false);
+            case NodeKind::del_stmt: deletion(node); return false;
+            case NodeKind::if_stmt: return ifStatement(node);
+            case NodeKind::while_stmt: whileStatement(node); return false;
+            case NodeKind::for_stmt: forStatement(node); return false;
+            case NodeKind::func_def: functionDefinition(node); return false;
+            case NodeKind::class_def: classDefinition(node); return false;
+            case NodeKind::try_stmt: return tryStatement(node);
+            case NodeKind::import_stmt: importStatement(node); return false;
+            case NodeKind::func_call:
+                call(node);
+                emit(Opcode::POP_TOP);
+                return false;
+            case NodeKind::lazy_body:
+                error(&node, "function body was not parsed; expand lazy bodies first");
+                return false;
+            default:
+                return false;
+        }
+    }
+
+    // a = v, a[i] = v, a.b.c = v and a[i].b = v; the value is on the stack.
+    void target(const ParseTreeNode* node) {
+        const ParseTreeNode* primary = node ? child(*node, 0) : nullptr;
+        const ParseTreeNode* leaf = primary ? child(*primary, 0) : nullptr;
+        if (!leaf) {
+            error(node, "invalid assignment target");
+            emit(Opcode::POP_TOP);
+            return;
+        }
+        const ParseTreeNode* index = find_child(*primary, NodeKind::expression);
+        vector<const ParseTreeNode*> attributes;
+        for (const ParseTreeNode* tail = child(*node, 1); tail && tail->children.size() >= 2; tail = child(*tail, 2)) {
+            attributes.push_back(child(*tail, 1));
+        }
+        if (!index && attributes.empty()) {
+            name(*leaf, Access::STORE);
+            return;
+        }
+        name(*leaf, Access::LOAD);
+        if (index) {
+            expression(index);
+            if (attributes.empty()) {
+                emit(Opcode::STORE_SUBSCR);
+                return;
+            }
+            emit(Opcode::BINARY_SUBSCR);
+        }
+        for (size_t i = 0; i + 1 < attributes.size(); i++) emit(Opcode::LOAD_ATTR, nameIndex(attributes[i]->value));
+        emit(Opcode::STORE_ATTR, nameIndex(attributes.back()->value));
+    }
+
+    void augmentedAssignment(const ParseTreeNode& node) {
+        const ParseTreeNode* leaf = child(node, 0);
+        const ParseTreeNode* op = child(node, 1);
+        Opcode code;
+        if (!leaf || !op || op->value.size() < 2 || !binary_opcode(op->value.substr(0, op->value.size() - 1), code)) {
+            error(&node, "invalid augmented assignment");
+            return;
+        }
+        name(*leaf, Access::LOAD);
+        expression(child(node, 2));
+        emit(op->value == "+=" ? Opcode::INPLACE_ADD : code);   // list += extends in place
+        name(*leaf, Access::STORE);
+    }
+
+    bool returnStatement(const ParseTreeNode& node) {
+        if (unit->code.kind != ScopeKind::FUNCTION) {
+            error(&node, "'return' outside function");
+            return false;
+        }
+        expression(child(node, 1));
+        unit->stackBase++;
+        vector<size_t> suspended = unwind(0, true);
+        unit->stackBase--;
+        emit(Opcode::RETURN_VALUE);
+        resume(suspended);
+        return true;
+    }
+
+    void yieldStatement(const ParseTreeNode& node) {
+        if (unit->code.kind != ScopeKind::FUNCTION) {
+            error(&node, "'yield' outside function");
+            return;
+        }
+        unit->code.flags |= CODE_GENERATOR;
+        if (const ParseTreeNode* value = find_child(node, NodeKind::expression)) {
+            expression(value);
+        } else {
+            emit(Opcode::LOAD_NONE);
+        }
+        emit(Opcode::YIELD_VALUE);
+        emit(Opcode::POP_TOP);
+    }
+
+    bool loopExit(const ParseTreeNode& node, bool isBreak) {
+        size_t loop = unit->blocks.size();
+        while (loop > 0 && unit->blocks[loop - 1].kind != BlockKind::LOOP) loop--;
+        if (loop == 0) {
+            error(&node, isBreak ? "'break' outside loop" : "'continue' not properly in loop");
+            return false;
+        }
+        vector<size_t> suspended = unwind(loop, false);
+        const Block& block = unit->blocks[loop - 1];
+        if (isBreak && block.holdsIterator) emit(Opcode::POP_TOP);
+        emit(Opcode::JUMP, isBreak ? block.breakLabel : block.continueLabel);
+        resume(suspended);
+        return true;
+    }
+
+    // Leaves the blocks from the innermost down to index keep: closes their
+    // protected ranges, runs finally bodies and drops a pending exception.
+    // A return leaves the stack to RETURN_VALUE. Returns the blocks whose
+    // ranges resume() reopens after the jump.
+    vector<size_t> unwind(size_t keep, bool forReturn) {
+        vector<size_t> suspended;
+        for (size_t i = unit->blocks.size(); i-- > keep;) {
+            switch (unit->blocks[i].kind) {
+                case BlockKind::LOOP:
+                    break;
+                case BlockKind::TRY:
+                    closeRange(unit->blocks[i]);
+                    suspended.push_back(i);
+                    break;
+                case BlockKind::FINALLY: {
+                    // The copy runs outside this try and everything inside it
+                    vector<Block> inner(unit->blocks.begin() + i, unit->blocks.end());
+                    unit->blocks.resize(i);
+                    statements(*inner.front().finallyBody);
+                    unit->blocks.insert(unit->blocks.end(), inner.begin(), inner.end());
+                    break;
+                }
+                case BlockKind::FINALLY_EXCEPTION:
+                    if (!forReturn) emit(Opcode::POP_TOP);
+                    break;
+            }
+        }
+        return suspended;
+    }
+
+    void resume(const vector<size_t>& suspended) {
+        for (size_t i : suspended) unit->blocks[i].start = here();
+    }
+
+    void closeRange(const Block& block) {
+        unit->ranges.push_back({block.start, here(), block.handler, block.depth});
+    }
+
+    void pushTry(uint32_t handler) {
+        Block block{BlockKind::TRY};
+        block.handler = handler;
+        block.start = here();
+        block.depth = unit->stackBase;
+        unit->blocks.push_back(block);
+    }
+
+    void popTry() {
+        closeRange(unit->blocks.back());
+        unit->blocks.pop_back();
+    }
+
+    void deletion(const ParseTreeNode& node) {
+        const ParseTreeNode* target = find_child(node, NodeKind::del_target);
+        const ParseTreeNode* leaf = target ? child(*target, 0) : nullptr;
+        if (!leaf) {
+            error(&node, "invalid del target");
+            return;
+        }
+        if (target->children.size() == 1) {
+            name(*leaf, Access::DELETE);
+            return;
+        }
+        name(*leaf, Access::LOAD);
+        if (const ParseTreeNode* index = find_child(*target, NodeKind::expression)) {
+            expression(index);
+            emit(Opcode::DELETE_SUBSCR);
+        } else if (const ParseTreeNode* attribute = child(*target, 2)) {
+            emit(Opcode::DELETE_ATTR, nameIndex(attribute->value));
+        } else {
+            error(&node, "invalid del target");
+            emit(Opcode::POP_TOP);
+        }
+    }
+
+    bool ifStatement(const ParseTreeNode& node) {
+        vector<pair<const ParseTreeNode*, const ParseTreeNode*>> clauses = {
+            {child(node, 1), find_child(node, NodeKind::statement_list)}};
+        const ParseTreeNode* elseBody = nullptr;
+        for (const auto& c : node.children) {
+            if (!c || c->children.empty()) continue;
+            if (c->kind == NodeKind::elif_stmt) clauses.push_back({child(*c, 1), find_child(*c, NodeKind::statement_list)});
+            if (c->kind == NodeKind::else_part) elseBody = find_child(*c, NodeKind::statement_list);
+        }
+        uint32_t end = newLabel();
+        bool terminated = elseBody != nullptr;
+        for (size_t i = 0; i < clauses.size(); i++) {
+            uint32_t next = newLabel();
+            if (clauses[i].first) setLine(*clauses[i].first);
+            jumpIf(clauses[i].first, false, next);
+            bool clauseEnds = clauses[i].second && statements(*clauses[i].second);
+            terminated = terminated && clauseEnds;
+            if (!clauseEnds && (elseBody || i + 1 < clauses.size())) emit(Opcode::JUMP, end);
+            bind(next);
+        }
+        if (elseBody) statements(*elseBody);
+        bind(end);
+        return terminated;
+    }
+
+    static bool alwaysTrue(const ParseTreeNode* node) {
+        while (node && (node->kind == NodeKind::expression || node->kind == NodeKind::factor) && node->children.size() == 1) {
+            node = node->children[0].get();
+        }
+        if (!node) return false;
+        if (node->kind == NodeKind::KEYWORD) return node->value == "True";
+        NumericLiteral literal;
+        return node->kind == NodeKind::NUMBER && decodeNumber(node->value, literal) &&
+               (literal.kind == NumericLiteral::INT ? literal.intValue != 0 || literal.overflowed : literal.floatValue != 0);
+    }
+
+    // The test is at the bottom, so an iteration takes one jump; the
+    // condition is also emitted once at the top to skip the loop.
+    void whileStatement(const ParseTreeNode& node) {
+        const ParseTreeNode* condition = child(node, 1);
+        bool forever = alwaysTrue(condition);
+        uint32_t body = newLabel(), test = newLabel(), exit = newLabel();
+        if (!forever) jumpIf(condition, false, exit);
+        bind(body);
+        Block loop{BlockKind::LOOP};
+        loop.continueLabel = test;
+        loop.breakLabel = exit;
+        unit->blocks.push_back(loop);
+        if (const ParseTreeNode* list = find_child(node, NodeKind::loop_statement_list)) statements(*list);
+        unit->blocks.pop_back();
+        bind(test);
+        if (condition) setLine(*condition);
+        if (forever) {
+            emit(Opcode::JUMP, body);
+        } else {
+            jumpIf(condition, true, body);
+        }
+        bind(exit);
+    }
+
+    void forStatement(const ParseTreeNode& node) {
+        expression(child(node, 3));
+        emit(Opcode::GET_ITER);
+        uint32_t top = here(), exit = newLabel();
+        emit(Opcode::FOR_ITER, exit);
+        if (const ParseTreeNode* leaf = child(node, 1)) name(*leaf, Access::STORE);
+        Block loop{BlockKind::LOOP};
+        loop.continueLabel = top;
+        loop.breakLabel = exit;
+        loop.holdsIterator = true;
+        unit->blocks.push_back(loop);
+        unit->stackBase++;
+        if (const ParseTreeNode* list = find_child(node, NodeKind::loop_statement_list)) statements(*list);
+        unit->stackBase--;
+        unit->blocks.pop_back();
+        emit(Opcode::JUMP, top);
+        bind(exit);
+    }
+
+    // Defaults are evaluated in the enclosing scope, then the cells the
+    // function captures are pushed for MAKE_FUNCTION.
+    void functionDefinition(const ParseTreeNode& node) {
+        auto scope = scopeOf.find(&node);
+        const ParseTreeNode* leaf = child(node, 1);
+        if (scope == scopeOf.end() || !leaf) {
+            error(&node, "function definition is not in the scope tree");
+            return;
+        }
+        if (const ParseTreeNode* list = find_child(node, NodeKind::param_list)) {
+            for (const auto& param : list->children) {
+                if (param && param->kind == NodeKind::param && child(*param, 2)) expression(child(*param, 2));
+            }
+        }
+        compileScope(scope->second);
+        closure(scope->second);
+        emit(Opcode::MAKE_FUNCTION, scope->second);
+        name(*leaf, Access::STORE);
+    }
+
+    void classDefinition(const ParseTreeNode& node) {
+        auto scope = scopeOf.find(&node);
+        const ParseTreeNode* leaf = child(node, 1);
+        if (scope == scopeOf.end() || !leaf) {
+            error(&node, "class definition is not in the scope tree");
+            return;
+        }
+        const ParseTreeNode* bases = find_child(node, NodeKind::class_inheritance_opt);
+        const ParseTreeNode* base = bases ? find_child(*bases, NodeKind::IDENTIFIER) : nullptr;
+        if (base) name(*base, Access::LOAD);
+        compileScope(scope->second);
+        if (base) compiler.result.code[scope->second].flags |= CODE_HAS_BASE;
+        closure(scope->second);
+        emit(Opcode::MAKE_FUNCTION, scope->second);
+        emit(Opcode::BUILD_CLASS, base ? 1 : 0);
+        name(*leaf, Access::STORE);
+    }
+
+    // try:            protected by the except handler, then by the finally one
+    //     body
+    // except T as e:  the exception is on the stack; CHECK_EXC_MATCH tests T
+    //     handler     and RERAISE passes on one no clause takes
+    // finally:        a copy on the normal path, and one that runs with the
+    //     body        exception pending and reraises it
+    bool tryStatement(const ParseTreeNode& node) {
+        const ParseTreeNode* body = find_child(node, NodeKind::statement_list);
+        vector<const ParseTreeNode*> clauses;
+        if (const ParseTreeNode* list = find_child(node, NodeKind::except_clauses)) {
+            for (const auto& c : list->children) {
+                if (c && c->kind == NodeKind::except_clause) clauses.push_back(c.get());
+            }
+        }
+        const ParseTreeNode* finally = find_child(node, NodeKind::finally_clause);
+        const ParseTreeNode* finallyBody = finally ? find_child(*finally, NodeKind::statement_list) : nullptr;
+        if (clauses.empty() && !finallyBody) return body && statements(*body);
+
+        uint32_t exceptHandler = newLabel(), finallyHandler = newLabel(), normalExit = newLabel(), exit = newLabel();
+        if (finallyBody) {
+            Block block{BlockKind::FINALLY};
+            block.finallyBody = finallyBody;
+            unit->blocks.push_back(block);
+            pushTry(finallyHandler);
+        }
+        bool terminated = true;
+        if (!clauses.empty()) pushTry(exceptHandler);
+        bool bodyEnds = body && statements(*body);
+        terminated = bodyEnds;
+        if (!clauses.empty()) {
+            popTry();
+            if (!bodyEnds) emit(Opcode::JUMP, normalExit);
+            bind(exceptHandler);
+            bool matchesAll = false;
+            for (const ParseTreeNode* clause : clauses) {
+                setLine(*clause);
+                const ParseTreeNode* type = find_child(*clause, NodeKind::expression);
+                const ParseTreeNode* as = nullptr;
+                for (size_t i = 1; i < clause->children.size(); i++) {
+                    if (clause->children[i]->kind == NodeKind::IDENTIFIER && clause->children[i - 1]->value == "as") {
+                        as = clause->children[i].get();
+                    }
+                }
+                uint32_t next = newLabel();
+                if (type) {
+                    expression(type);
+                    emit(Opcode::CHECK_EXC_MATCH);
+                    emit(Opcode::POP_JUMP_IF_FALSE, next);
+                }
+                if (as) {
+                    name(*as, Access::STORE);
+                } else {
+                    emit(Opcode::POP_TOP);
+                }
+                const ParseTreeNode* handlerBody = find_child(*clause, NodeKind::statement_list);
+                bool handlerEnds = handlerBody && statements(*handlerBody);
+                terminated = terminated && handlerEnds;
+                if (!handlerEnds) emit(Opcode::JUMP, normalExit);
+                bind(next);
+                if (!type) {
+                    matchesAll = true;
+                    break;      // later clauses are unreachable
+                }
+            }
+            if (!matchesAll) {
+                emit(Opcode::RERAISE);
+                terminated = false;     // an exception is not "falling through", but it leaves
+            }
+        }
+        if (!finallyBody) {
+            bind(normalExit);
+            bind(exit);
+            return false;
+        }
+
+        popTry();
+        unit->blocks.pop_back();
+        bind(normalExit);
+        bool finallyEnds = statements(*finallyBody);
+        if (!finallyEnds) emit(Opcode::JUMP, exit);
+
+        bind(finallyHandler);
+        unit->blocks.push_back(Block{BlockKind::FINALLY_EXCEPTION});
+        unit->stackBase++;
+        if (!statements(*finallyBody)) emit(Opcode::RERAISE);
+        unit->stackBase--;
+        unit->blocks.pop_back();
+        bind(exit);
+        return finallyEnds;
+    }
+
+    void importStatement(const ParseTreeNode& node) {
+        vector<const ParseTreeNode*> items;
+        for (const auto& c : node.children) {
+            if (c && c->kind == NodeKind::import_item) items.push_back(c.get());
+            if (c && c->kind == NodeKind::import_tail) {
+                for (const auto& item : c->children) {
+                    if (item && item->kind == NodeKind::import_item) items.push_back(item.get());
+                }
+            }
+        }
+        bool from = !node.children.empty() && node.children[0]->value == "from";
+        if (from) {
+            const ParseTreeNode* module = child(node, 1);
+            if (!module || module->kind != NodeKind::IDENTIFIER) {
+                error(&node, "invalid import");
+                return;
+            }
+            emit(Opcode::IMPORT_NAME, nameIndex(module->value));
+        }
+        for (const ParseTreeNode* item : items) {
+            const ParseTreeNode* imported = child(*item, 0);
+            if (!imported) continue;
+            const ParseTreeNode* alias = find_child(*item, NodeKind::import_alias_opt);
+            const ParseTreeNode* aliasName = alias ? find_child(*alias, NodeKind::IDENTIFIER) : nullptr;
+            if (imported->value == "*") {
+                if (!from) {
+                    error(item, "'import *' needs a module: use 'from module import *'");
+                } else if (unit->code.kind != ScopeKind::MODULE) {
+                    error(item, "'import *' only allowed at module level");
+                } else {
+                    emit(Opcode::IMPORT_STAR);
+                    return;
+                }
+                continue;
+            }
+            if (from) {
+                emit(Opcode::IMPORT_FROM, nameIndex(imported->value));
+            } else {
+                emit(Opcode::IMPORT_NAME, nameIndex(imported->value));
+            }
+            name(aliasName ? *aliasName : *imported, Access::STORE);
+        }
+        if (from) emit(Opcode::POP_TOP);
+    }
+
+    // --- expressions ---
+
+    // Jumps to label if the truth of node is whenTrue, otherwise falls
+    // through; and/or/not become jumps instead of values.
+    void jumpIf(const ParseTreeNode* node, bool whenTrue, uint32_t label) {
+        while (node && ((node->kind == NodeKind::expression && node->children.size() == 1) ||
+                        (node->kind == NodeKind::factor && node->children.size() == 3 &&
+                         node->children[0]->kind == NodeKind::DELIMITER))) {
+            node = child(*node, node->kind == NodeKind::expression ? 0 : 1);
+        }
+        if (node && node->kind == NodeKind::unary_expr && child(*node, 0) && child(*node, 0)->value == "not") {
+            jumpIf(child(*node, 1), !whenTrue, label);
+            return;
+        }
+        const ParseTreeNode* op = node && node->kind == NodeKind::binary_expr ? child(*node, 1) : nullptr;
+        if (op && (op->value == "and" || op->value == "or")) {
+            // a and b and c nests on the left; its operands are taken in a
+            // loop. An operand that settles the result jumps to label,
+            // otherwise a settling operand skips the rest.
+            vector<const ParseTreeNode*> operands;
+            const ParseTreeNode* left = node;
+            while (left && left->kind == NodeKind::binary_expr && left->children.size() == 3 &&
+                   left->children[1]->value == op->value) {
+                operands.push_back(child(*left, 2));
+                left = child(*left, 0);
+            }
+            operands.push_back(left);
+            reverse(operands.begin(), operands.end());
+            bool settles = op->value == "or";
+            if (settles == whenTrue) {
+                for (const ParseTreeNode* operand : operands) jumpIf(operand, whenTrue, label);
+            } else {
+                uint32_t skip = newLabel();
+                for (size_t i = 0; i + 1 < operands.size(); i++) jumpIf(operands[i], !whenTrue, skip);
+                jumpIf(operands.back(), whenTrue, label);
+                bind(skip);
+            }
+            return;
+        }
+        if (node && node->kind == NodeKind::factor && node->children.size() == 1 &&
+            node->children[0]->kind == NodeKind::KEYWORD) {
+            const string& value = node->children[0]->value;
+            if (value == "True" || value == "False" || value == "None") {
+                if ((value == "True") == whenTrue) emit(Opcode::JUMP, label);
+                return;
+            }
+        }
+        expression(node);
+        emit(whenTrue ? Opcode::POP_JUMP_IF_TRUE : Opcode::POP_JUMP_IF_FALSE, label);
+    }
+
+    void expression(const ParseTreeNode* node) {
+        if (!node) {
+            error(nullptr, "missing expression");
+            emit(Opcode::LOAD_NONE);
+            return;
+        }
+        switch (node->kind) {
+            case NodeKind::expression: {
+                const ParseTreeNode* inlineIf = child(*node, 1);
+                if (!inlineIf || inlineIf->kind != NodeKind::inline_if_else) {
+                    expression(child(*node, 0));
+                    return;
+                }
+                // value if condition else other
+                uint32_t other = newLabel(), end = newLabel();
+                jumpIf(child(*inlineIf, 1), false, other);
+                expression(child(*node, 0));
+                emit(Opcode::JUMP, end);
+                bind(other);
+                expression(child(*inlineIf, 3));
+                bind(end);
+                return;
+            }
+            case NodeKind::factor: {
+                const ParseTreeNode* first = child(*node, 0);
+                if (!first) break;
+                if (first->kind == NodeKind::DELIMITER) {
+                    expression(child(*node, 1));
+                } else if (first->kind == NodeKind::STRING_QUOTE) {
+                    stringConstant(string_text(*node, 0));
+                } else {
+                    expression(first);
+                }
+                return;
+            }
+            case NodeKind::binary_expr: binary(*node); return;
+            case NodeKind::unary_expr: {
+                static const unordered_map<string, Opcode> unary = {
+                    {"-", Opcode::UNARY_NEGATIVE}, {"+", Opcode::UNARY_POSITIVE},
+                    {"~", Opcode::UNARY_INVERT}, {"not", Opcode::UNARY_NOT}};
+                const ParseTreeNode* op = child(*node, 0);
+                auto code = op ? unary.find(op->value) : unary.end();
+                if (code == unary.end()) break;
+                expression(child(*node, 1));
+                emit(code->second);
+                return;
+            }
+            case NodeKind::func_call: call(*node); return;
+            case NodeKind::list_literal: list(*node); return;
+            case NodeKind::dict_literal: dict(*node); return;
+            case NodeKind::IDENTIFIER: name(*node, Access::LOAD); return;
+            case NodeKind::NUMBER: number(*node, node->value); return;
+            case NodeKind::KEYWORD:
+                if (node->value == "True") emit(Opcode::LOAD_TRUE);
+                else if (node->value == "False") emit(Opcode::LOAD_FALSE);
+                else if (node->value == "None") emit(Opcode::LOAD_NONE);
+                else break;
+                return;
+            default:
+                break;
+        }
+        error(node, "unsupported expression");
+        emit(Opcode::LOAD_NONE);
+    }
+
+    void number(const ParseTreeNode& node, const string& text) {
+        NumericLiteral literal;
+        if (!decodeNumber(text, literal)) {
+            error(&node, "invalid number " + text);
+        } else if (literal.kind == NumericLiteral::COMPLEX) {
+            error(&node, "complex numbers are not supported: " + text);
+        } else if (literal.overflowed) {
+            error(&node, "integer does not fit in 64 bits: " + text);
+        } else if (literal.kind == NumericLiteral::INT) {
+            if (literal.intValue >= INT16_MIN && literal.intValue <= INT16_MAX) {
+                emit(Opcode::LOAD_SMALL_INT, (uint16_t)literal.intValue);
+            } else {
+                ConstantValue value;
+                value.kind = ConstantValue::INT;
+                value.intValue = literal.intValue;
+                emit(Opcode::LOAD_CONST, constant(value));
+            }
+            return;
+        } else {
+            ConstantValue value;
+            value.kind = ConstantValue::FLOAT;
+            value.floatValue = literal.floatValue;
+            emit(Opcode::LOAD_CONST, constant(value));
+            return;
+        }
+        emit(Opcode::LOAD_NONE);
+    }
+
+    void stringConstant(const string& text) {
+        ConstantValue value;
+        value.kind = ConstantValue::STR;
+        value.text = text;
+        emit(Opcode::LOAD_CONST, constant(value));
+    }
+
+    // Left operands nest, a + b - c being (a + b) - c, so the left spine is
+    // walked in a loop and long chains do not recurse. and/or leave the
+    // deciding operand on the stack.
+    void binary(const ParseTreeNode& node) {
+        if (child(node, 1) && is_comparison(child(node, 1)->value)) {
+            comparison(node);
+            return;
+        }
+        vector<const ParseTreeNode*> spine;
+        const ParseTreeNode* left = &node;
+        while (left && left->kind == NodeKind::binary_expr && left->children.size() == 3 &&
+               !is_comparison(left->children[1]->value)) {
+            spine.push_back(left);
+            left = child(*left, 0);
+        }
+        // -5 ** 2 is -(5 ** 2), though the lexer reads -5 as one number
+        const ParseTreeNode* number = left && left->kind == NodeKind::factor && left->children.size() == 1
+                                          ? child(*left, 0) : nullptr;
+        bool negatedPower = !spine.empty() && spine.back()->children[1]->value == "**" && number &&
+                            number->kind == NodeKind::NUMBER && number->value.size() > 1 && number->value[0] == '-';
+        if (negatedPower) {
+            this->number(*number, number->value.substr(1));
+        } else {
+            expression(left);
+        }
+        for (size_t i = spine.size(); i-- > 0;) {
+            const ParseTreeNode& current = *spine[i];
+            const string& op = current.children[1]->value;
+            if (op == "and" || op == "or") {
+                uint32_t end = newLabel();
+                emit(op == "and" ? Opcode::JUMP_IF_FALSE_OR_POP : Opcode::JUMP_IF_TRUE_OR_POP, end);
+                expression(child(current, 2));
+                bind(end);
+                continue;
+            }
+            Opcode code;
+            if (!binary_opcode(op, code)) {
+                error(&current, "unsupported operator " + op);
+                code = Opcode::BINARY_ADD;
+            }
+            expression(child(current, 2));
+            emit(code);
+            if (negatedPower && i + 1 == spine.size()) emit(Opcode::UNARY_NEGATIVE);
+        }
+    }
+
+    // a < b < c is a < b and b < c with b evaluated once: each middle
+    // operand is duplicated under the comparison, and a false result skips
+    // the rest and drops the copy.
+    void comparison(const ParseTreeNode& node) {
+        vector<const ParseTreeNode*> operands;
+        vector<Opcode> ops;
+        const ParseTreeNode* left = &node;
+        while (left && left->kind == NodeKind::binary_expr && left->children.size() == 3 &&
+               is_comparison(left->children[1]->value)) {
+            Opcode code = Opcode::COMPARE_EQ;
+            binary_opcode(left->children[1]->value, code);
+            ops.push_back(code);
+            operands.push_back(child(*left, 2));
+            left = child(*left, 0);
+        }
+        operands.push_back(left);
+        reverse(operands.begin(), operands.end());
+        reverse(ops.begin(), ops.end());
+
+        expression(operands[0]);
+        if (ops.size() == 1) {
+            expression(operands[1]);
+            emit(ops[0]);
+            return;
+        }
+        uint32_t cleanup = newLabel(), end = newLabel();
+        for (size_t i = 0; i < ops.size(); i++) {
+            expression(operands[i + 1]);
+            if (i + 1 == ops.size()) {
+                emit(ops[i]);
+                break;
+            }
+            emit(Opcode::DUP_TOP);
+            emit(Opcode::ROT_THREE);
+            emit(ops[i]);
+            emit(Opcode::JUMP_IF_FALSE_OR_POP, cleanup);
+        }
+        emit(Opcode::JUMP, end);
+        bind(cleanup);
+        emit(Opcode::ROT_TWO);
+        emit(Opcode::POP_TOP);
+        bind(end);
+    }
+
+    void call(const ParseTreeNode& node) {
+        const ParseTreeNode* callee = child(node, 0);
+        if (!callee || callee->kind != NodeKind::IDENTIFIER) {
+            error(&node, "invalid call");
+            emit(Opcode::LOAD_NONE);
+            return;
+        }
+        name(*callee, Access::LOAD);
+        uint32_t count = 0;
+        // argument_list_prime chains are followed in a loop; a string first
+        // argument is its quotes and text directly in argument_list
+        for (const ParseTreeNode* list = find_child(node, NodeKind::argument_list); list;) {
+            const ParseTreeNode* next = nullptr;
+            for (size_t i = 0; i < list->children.size(); i++) {
+                const ParseTreeNode& c = *list->children[i];
+                if (c.kind == NodeKind::expression) {
+                    expression(&c);
+                    count++;
+                } else if (c.kind == NodeKind::STRING_QUOTE) {
+                    stringConstant(string_text(*list, i, &i));
+                    count++;
+                } else if (c.kind == NodeKind::argument_list_prime) {
+                    next = &c;
+                }
+            }
+            list = next;
+        }
+        emit(Opcode::CALL, count);
+    }
+
+    void list(const ParseTreeNode& node) {
+        uint32_t count = 0;
+        bool built = false;
+        for (const ParseTreeNode* items = &node; items;) {
+            const ParseTreeNode* next = nullptr;
+            for (const auto& c : items->children) {
+                if (c->kind == NodeKind::list_items_prime) {
+                    next = c.get();
+                } else if (c->kind == NodeKind::expression) {
+                    if (!built && count == MAX_BUILD_ITEMS) {
+                        emit(Opcode::BUILD_LIST, count);
+                        built = true;
+                    }
+                    expression(c.get());
+                    if (built) {
+                        emit(Opcode::LIST_APPEND);
+                    } else {
+                        count++;
+                    }
+                }
+            }
+            items = next;
+        }
+        if (!built) emit(Opcode::BUILD_LIST, count);
+    }
+
+    void dict(const ParseTreeNode& node) {
+        vector<const ParseTreeNode*> pairs;
+        for (const auto& c : node.children) {
+            if (c->kind == NodeKind::dict_pair) pairs.push_back(c.get());
+            if (c->kind == NodeKind::dict_items_prime) {
+                for (const auto& pair : c->children) {
+                    if (pair->kind == NodeKind::dict_pair) pairs.push_back(pair.get());
+                }
+            }
+        }
+        uint32_t count = 0;
+        bool built = false;
+        for (const ParseTreeNode* pair : pairs) {
+            if (!built && count == MAX_BUILD_ITEMS) {
+                emit(Opcode::BUILD_MAP, count);
+                built = true;
+            }
+            const ParseTreeNode* key = child(*pair, 0);
+            if (key && key->kind == NodeKind::string_key) {
+                stringConstant(string_text(*key, 0));
+            } else {
+                expression(key);
+            }
+            expression(find_child(*pair, NodeKind::expression));
+            if (built) {
+                emit(Opcode::MAP_ADD);
+            } else {
+                count++;
+            }
+        }
+        if (!built) emit(Opcode::BUILD_MAP, count);
+    }
+};
+
+bool BytecodeCompiler::compile(const shared_ptr<ParseTreeNode>& root, const ScopeTree& scopes,
+                               const vector<Token>& tokens) {
+    result = BytecodeModule();
+    errorList.clear();
+    instructions = 0;
+    if (!root || scopes.scopes().empty()) return false;
+
+    result.code.resize(scopes.scopes().size());
+    for (size_t s = 0; s < scopes.scopes().size(); s++) {
+        result.code[s].kind = scopes.scopes()[s].kind;
+        result.code[s].name = scopes.scopes()[s].name;
+    }
+    Emitter emitter(*this, scopes, tokens);
+    emitter.compileScope(0);
+    return errorList.empty();
+}
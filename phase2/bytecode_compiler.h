@@ -0,0 +1,56 @@
+#ifndef BYTECODE_COMPILER_H
+#define BYTECODE_COMPILER_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+#include "scope_tree.h"
+#include "bytecode.h"
+#include <string>
+#include <vector>
+
+struct CompileError {
+    int line;
+    std::string message;
+};
+
+// Lowers the parse tree to bytecode (bytecode.h), one code object per scope
+// of the scope tree. Each body is emitted as instructions with symbolic jump
+// labels, then assembled: jump operands are sized to their targets, the
+// deepest stack is found by following every path, and the line table and
+// exception table are encoded.
+//
+// Conditions jump directly on and/or/not instead of materialising a bool,
+// while loops test at the bottom, and a comparison chain evaluates each
+// middle operand once, as in Python. break, continue and return leaving a
+// try with a finally run a copy of the finally body first; exceptions use
+// the exception table, so entering a try costs nothing at run time.
+//
+// The scope tree must describe root, with lazy bodies expanded; after
+// constant folding, rebuild it first. tokens map source offsets to lines.
+// Constructs the runtime cannot represent (complex numbers, ints beyond 64
+// bits, "import *" inside a function) are reported as errors.
+class BytecodeCompiler {
+public:
+    BytecodeCompiler() = default;
+    BytecodeCompiler(const shared_ptr<ParseTreeNode>& root, const ScopeTree& scopes,
+                     const std::vector<Token>& tokens) {
+        compile(root, scopes, tokens);
+    }
+
+    // False if there were errors; the module is then incomplete.
+    bool compile(const shared_ptr<ParseTreeNode>& root, const ScopeTree& scopes, const std::vector<Token>& tokens);
+
+    const BytecodeModule& module() const { return result; }
+    const std::vector<CompileError>& errors() const { return errorList; }
+
+    size_t instructionCount() const { return instructions; }
+
+private:
+    BytecodeModule result;
+    std::vector<CompileError> errorList;
+    size_t instructions = 0;
+
+    struct Emitter;
+};
+
+#endif // BYTECODE_COMPILER_H
@@ -0,0 +1,820 @@
+#include "constant_folding.h"
+#include "node_visitor.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_set>
+
+using namespace std;
+
+// Doubles hold every integer up to this exactly; mixed int/float arithmetic
+// on larger ints would round differently from Python.
+const int64_t MAX_EXACT_DOUBLE_INT = (int64_t)1 << 53;
+
+static bool exact_as_double(int64_t value) {
+    return value >= -MAX_EXACT_DOUBLE_INT && value <= MAX_EXACT_DOUBLE_INT;
+}
+
+// Conditions are looked into this many and/or/not levels deep.
+const int MAX_CONDITION_DEPTH = 64;
+
+string float_repr(double value) {
+    if (std::isnan(value)) return "nan";
+    if (std::isinf(value)) return value < 0 ? "-inf" : "inf";
+    char buffer[40];
+    int precision = 1;
+    for (; precision < 17; precision++) {
+        snprintf(buffer, sizeof buffer, "%.*e", precision - 1, value);
+        if (strtod(buffer, nullptr) == value) break;
+    }
+    snprintf(buffer, sizeof buffer, "%.*e", precision - 1, value);
+    string text = buffer;
+    string sign = text[0] == '-' ? "-" : "";
+    if (!sign.empty()) text.erase(0, 1);
+    size_t e = text.find('e');
+    int exponent = atoi(text.c_str() + e + 1);
+    string digits = text.substr(0, 1) + (e > 1 ? text.substr(2, e - 2) : "");
+    while (digits.size() > 1 && digits.back() == '0') digits.pop_back();
+
+    if (exponent < -4 || exponent >= 16) {
+        string mantissa = digits.substr(0, 1) + (digits.size() > 1 ? "." + digits.substr(1) : "");
+        snprintf(buffer, sizeof buffer, "e%c%02d", exponent < 0 ? '-' : '+', abs(exponent));
+        return sign + mantissa + buffer;
+    }
+    if (exponent < 0) return sign + "0." + string(-exponent - 1, '0') + digits;
+    if ((int)digits.size() <= exponent + 1) return sign + digits + string(exponent + 1 - digits.size(), '0') + ".0";
+    return sign + digits.substr(0, exponent + 1) + "." + digits.substr(exponent + 1);
+}
+
+string constant_repr(const ConstantValue& value) {
+    switch (value.kind) {
+        case ConstantValue::INT: return to_string(value.intValue);
+        case ConstantValue::FLOAT: return float_repr(value.floatValue);
+        case ConstantValue::BOOL: return value.intValue ? "True" : "False";
+        case ConstantValue::NONE: return "None";
+        case ConstantValue::STR: {
+            // Single quotes unless only double quotes avoid escaping
+            bool single = value.text.find('\'') == string::npos || value.text.find('"') != string::npos;
+            char quote = single ? '\'' : '"';
+            string repr(1, quote);
+            for (char c : value.text) {
+                switch (c) {
+                    case '\\': repr += "\\\\"; continue;
+                    case '\n': repr += "\\n"; continue;
+                    case '\r': repr += "\\r"; continue;
+                    case '\t': repr += "\\t"; continue;
+                }
+                if ((unsigned char)c < 0x20 || c == 0x7f) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof escaped, "\\x%02x", (unsigned char)c);
+                    repr += escaped;
+                    continue;
+                }
+                if (c == quote) repr += '\\';
+                repr += c;
+            }
+            return repr + quote;
+        }
+    }
+    return "?";
+}
+
+bool constant_truth(const ConstantValue& value) {
+    switch (value.kind) {
+        case ConstantValue::INT:
+        case ConstantValue::BOOL: return value.intValue != 0;
+        case ConstantValue::FLOAT: return value.floatValue != 0;
+        case ConstantValue::STR: return !value.text.empty();
+        case ConstantValue::NONE: return false;
+    }
+    return false;
+}
+
+static bool is_comparison(const string& op) {
+    return op == "==" || op == "!=" || op == "<" || op == ">" || op == "<=" || op == ">=";
+}
+
+template <typename T>
+static bool compare(T a, const string& op, T b) {
+    if (op == "==") return a == b;
+    if (op == "!=") return a != b;
+    if (op == "<") return a < b;
+    if (op == ">") return a > b;
+    if (op == "<=") return a <= b;
+    return a >= b;
+}
+
+static void set_bool(ConstantValue& result, bool value) {
+    result = ConstantValue();
+    result.kind = ConstantValue::BOOL;
+    result.intValue = value;
+}
+
+static void set_int(ConstantValue& result, int64_t value) {
+    result = ConstantValue();
+    result.kind = ConstantValue::INT;
+    result.intValue = value;
+}
+
+static bool set_float(ConstantValue& result, double value) {
+    if (!isfinite(value)) return false;
+    result = ConstantValue();
+    result.kind = ConstantValue::FLOAT;
+    result.floatValue = value;
+    return true;
+}
+
+// A quote that text can sit between without escapes, preferring the one it
+// came with; empty if it holds both kinds.
+static string quote_for(const string& text, const string& preferred) {
+    char first = preferred.empty() ? '\'' : preferred[0];
+    if (text.find(first) == string::npos) return string(1, first);
+    char other = first == '\'' ? '"' : '\'';
+    if (text.find(other) == string::npos) return string(1, other);
+    return "";
+}
+
+static bool set_string(ConstantValue& result, string text, const string& preferredQuote) {
+    if (text.size() > MAX_FOLDED_STRING) return false;
+    string quote = quote_for(text, preferredQuote);
+    if (quote.empty()) return false;
+    result = ConstantValue();
+    result.kind = ConstantValue::STR;
+    result.text = move(text);
+    result.quote = quote;
+    return true;
+}
+
+static bool fold_int(int64_t a, const string& op, int64_t b, bool bothBool, ConstantValue& result) {
+    int64_t value;
+    if (op == "+") {
+        if (__builtin_add_overflow(a, b, &value)) return false;
+    } else if (op == "-") {
+        if (__builtin_sub_overflow(a, b, &value)) return false;
+    } else if (op == "*") {
+        if (__builtin_mul_overflow(a, b, &value)) return false;
+    } else if (op == "/") {
+        if (b == 0 || !exact_as_double(a) || !exact_as_double(b)) return false;
+        return set_float(result, (double)a / (double)b);
+    } else if (op == "//" || op == "%") {
+        if (b == 0 || (a == INT64_MIN && b == -1)) return false;
+        // C++ truncates toward zero; Python floors
+        int64_t quotient = a / b, remainder = a % b;
+        if (remainder != 0 && ((remainder < 0) != (b < 0))) {
+            quotient--;
+            remainder += b;
+        }
+        value = op == "//" ? quotient : remainder;
+    } else if (op == "**") {
+        if (b < 0) {
+            if (a == 0) return false;
+            return set_float(result, pow((double)a, (double)b));
+        }
+        value = 1;
+        for (int64_t base = a, exponent = b; exponent > 0;) {
+            if ((exponent & 1) && __builtin_mul_overflow(value, base, &value)) return false;
+            exponent >>= 1;
+            if (exponent > 0 && __builtin_mul_overflow(base, base, &base)) return false;
+        }
+    } else if (op == "<<") {
+        if (b < 0) return false;
+        if (a == 0) {
+            value = 0;
+        } else {
+            if (b >= 63) return false;
+            value = (int64_t)((uint64_t)a << b);
+            if ((value >> b) != a) return false;
+        }
+    } else if (op == ">>") {
+        if (b < 0) return false;
+        value = b >= 63 ? (a < 0 ? -1 : 0) : a >> b;
+    } else if (op == "&" || op == "|" || op == "^") {
+        value = op == "&" ? a & b : op == "|" ? a | b : a ^ b;
+        if (bothBool) {
+            set_bool(result, value != 0);
+            return true;
+        }
+    } else if (is_comparison(op)) {
+        set_bool(result, compare(a, op, b));
+        return true;
+    } else {
+        return false;
+    }
+    set_int(result, value);
+    return true;
+}
+
+static bool fold_float(double a, const string& op, double b, ConstantValue& result) {
+    if (op == "+") return set_float(result, a + b);
+    if (op == "-") return set_float(result, a - b);
+    if (op == "*") return set_float(result, a * b);
+    if (op == "/") return b != 0 && set_float(result, a / b);
+    if (op == "//" || op == "%") {
+        if (b == 0) return false;
+        // Same steps as CPython's float divmod
+        double mod = fmod(a, b);
+        double div = (a - mod) / b;
+        if (mod != 0) {
+            if ((b < 0) != (mod < 0)) {
+                mod += b;
+                div -= 1.0;
+            }
+        } else {
+            mod = copysign(0.0, b);
+        }
+        double floorDiv;
+        if (div != 0) {
+            floorDiv = floor(div);
+            if (div - floorDiv > 0.5) floorDiv += 1.0;
+        } else {
+            floorDiv = copysign(0.0, a / b);
+        }
+        return set_float(result, op == "//" ? floorDiv : mod);
+    }
+    if (op == "**") {
+        if (a == 0 && b < 0) return false;             // ZeroDivisionError
+        if (a < 0 && b != floor(b)) return false;      // a complex result
+        return set_float(result, pow(a, b));
+    }
+    if (is_comparison(op)) {
+        set_bool(result, compare(a, op, b));
+        return true;
+    }
+    return false;
+}
+
+static bool fold_string(const ConstantValue& left, const string& op, const ConstantValue& right,
+                        ConstantValue& result) {
+    bool leftStr = left.kind == ConstantValue::STR, rightStr = right.kind == ConstantValue::STR;
+    if (leftStr && rightStr) {
+        if (op == "+") return set_string(result, left.text + right.text, left.quote);
+        if (is_comparison(op)) {
+            set_bool(result, compare(left.text.compare(right.text), op, 0));
+            return true;
+        }
+        if (op == "in" || op == "not in") {
+            set_bool(result, (right.text.find(left.text) != string::npos) == (op == "in"));
+            return true;
+        }
+        return false;
+    }
+    // "ab" == 1 is simply false; "ab" < 1 raises
+    if (op == "==" || op == "!=") {
+        set_bool(result, op == "!=");
+        return true;
+    }
+    const ConstantValue& text = leftStr ? left : right;
+    const ConstantValue& count = leftStr ? right : left;
+    if (op != "*" || (count.kind != ConstantValue::INT && count.kind != ConstantValue::BOOL)) return false;
+    if (count.intValue <= 0 || text.text.empty()) return set_string(result, "", text.quote);
+    if (text.text.size() * (uint64_t)count.intValue > MAX_FOLDED_STRING) return false;
+    string repeated;
+    repeated.reserve(text.text.size() * count.intValue);
+    for (int64_t i = 0; i < count.intValue; i++) repeated += text.text;
+    return set_string(result, move(repeated), text.quote);
+}
+
+bool fold_binary(const ConstantValue& left, const string& op, const ConstantValue& right, ConstantValue& result) {
+    if (op == "and") {
+        result = constant_truth(left) ? right : left;
+        return true;
+    }
+    if (op == "or") {
+        result = constant_truth(left) ? left : right;
+        return true;
+    }
+    if (left.kind == ConstantValue::STR || right.kind == ConstantValue::STR) {
+        return fold_string(left, op, right, result);
+    }
+    bool leftSingleton = left.kind == ConstantValue::NONE || left.kind == ConstantValue::BOOL;
+    bool rightSingleton = right.kind == ConstantValue::NONE || right.kind == ConstantValue::BOOL;
+    if (op == "is" || op == "is not") {
+        // Only None, True and False have a known identity
+        if (!leftSingleton || !rightSingleton) return false;
+        bool same = left.kind == right.kind && left.intValue == right.intValue;
+        set_bool(result, same == (op == "is"));
+        return true;
+    }
+    if (left.kind == ConstantValue::NONE || right.kind == ConstantValue::NONE) {
+        if (op != "==" && op != "!=") return false;
+        set_bool(result, (left.kind == right.kind) == (op == "=="));
+        return true;
+    }
+    if (left.kind == ConstantValue::FLOAT || right.kind == ConstantValue::FLOAT) {
+        const ConstantValue& other = left.kind == ConstantValue::FLOAT ? right : left;
+        if (other.kind != ConstantValue::FLOAT && !exact_as_double(other.intValue)) return false;
+        double a = left.kind == ConstantValue::FLOAT ? left.floatValue : (double)left.intValue;
+        double b = right.kind == ConstantValue::FLOAT ? right.floatValue : (double)right.intValue;
+        return fold_float(a, op, b, result);
+    }
+    bool bothBool = left.kind == ConstantValue::BOOL && right.kind == ConstantValue::BOOL;
+    return fold_int(left.intValue, op, right.intValue, bothBool, result);
+}
+
+bool fold_unary(const string& op, const ConstantValue& operand, ConstantValue& result) {
+    if (op == "not") {
+        set_bool(result, !constant_truth(operand));
+        return true;
+    }
+    if (operand.kind == ConstantValue::FLOAT) {
+        if (op == "-") return set_float(result, -operand.floatValue);
+        if (op == "+") return set_float(result, operand.floatValue);
+        return false;
+    }
+    if (operand.kind != ConstantValue::INT && operand.kind != ConstantValue::BOOL) return false;
+    if (op == "-") {
+        if (operand.intValue == INT64_MIN) return false;
+        set_int(result, -operand.intValue);
+    } else if (op == "+") {
+        set_int(result, operand.intValue);
+    } else if (op == "~") {
+        set_int(result, ~operand.intValue);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static const ParseTreeNode* child(const ParseTreeNode& node, size_t i) {
+    return i < node.children.size() ? node.children[i].get() : nullptr;
+}
+
+static const ParseTreeNode* find_child(const ParseTreeNode& node, NodeKind kind) {
+    for (const auto& c : node.children) {
+        if (c && c->kind == kind) return c.get();
+    }
+    return nullptr;
+}
+
+// Folding works bottom up, so a literal operand is at most a parenthesized
+// negative number deep: factor ( expression factor NUMBER ).
+const int LITERAL_DEPTH = 4;
+
+// The single node an expression reduces to, looking through parentheses,
+// at most maxSteps levels down.
+static const ParseTreeNode* innermost(const ParseTreeNode* node, int maxSteps = INT32_MAX) {
+    for (int step = 0; node && step < maxSteps; step++) {
+        if ((node->kind == NodeKind::expression || node->kind == NodeKind::factor) && node->children.size() == 1) {
+            node = child(*node, 0);
+        } else if (node->kind == NodeKind::factor && node->children.size() == 3 &&
+                   node->children[0]->kind == NodeKind::DELIMITER) {
+            node = child(*node, 1);
+        } else {
+            return node;
+        }
+    }
+    return node;    // a wrapper when maxSteps ran out: not a literal
+}
+
+// A factor holding one string on one line, without escapes.
+static bool string_literal(const ParseTreeNode& factor, ConstantValue& value) {
+    size_t n = factor.children.size();
+    if (n != 2 && n != 3) return false;
+    const ParseTreeNode* open = child(factor, 0);
+    const ParseTreeNode* close = child(factor, n - 1);
+    if (!open || !close || open->kind != NodeKind::STRING_QUOTE || close->kind != NodeKind::STRING_QUOTE ||
+        open->value != close->value) {
+        return false;
+    }
+    string text;
+    if (n == 3) {
+        const ParseTreeNode* literal = child(factor, 1);
+        if (!literal || literal->kind != NodeKind::STRING_LITERAL) return false;
+        if (literal->value.find_first_of("\\\r\n") != string::npos) return false;
+        text = literal->value;
+    }
+    value = ConstantValue();
+    value.kind = ConstantValue::STR;
+    value.text = move(text);
+    value.quote = open->value;
+    return true;
+}
+
+// The constant an expression is written as, if it is a literal.
+static bool literal_value(const ParseTreeNode* node, ConstantValue& value) {
+    node = innermost(node, LITERAL_DEPTH);
+    if (!node) return false;
+    switch (node->kind) {
+        case NodeKind::NUMBER: {
+            NumericLiteral literal;
+            if (!decodeNumber(node->value, literal) || literal.overflowed) return false;
+            if (literal.kind == NumericLiteral::INT) {
+                set_int(value, literal.intValue);
+                return true;
+            }
+            return literal.kind == NumericLiteral::FLOAT && set_float(value, literal.floatValue);
+        }
+        case NodeKind::KEYWORD:
+            if (node->value == "True" || node->value == "False") {
+                set_bool(value, node->value == "True");
+                return true;
+            }
+            if (node->value == "None") {
+                value = ConstantValue();
+                return true;
+            }
+            return false;
+        case NodeKind::factor: return string_literal(*node, value);
+        default: return false;
+    }
+}
+
+// The lexer reads "-5" as one NUMBER, but in "-5 ** 2" the minus applies
+// to the power, as it binds less tightly.
+static bool is_negated_literal(const ParseTreeNode* factor) {
+    const ParseTreeNode* number = factor && factor->kind == NodeKind::factor && factor->children.size() == 1
+                                      ? factor->children[0].get() : nullptr;
+    return number && number->kind == NodeKind::NUMBER && !number->value.empty() && number->value[0] == '-';
+}
+
+static void place(ParseTreeNode& node, const ParseTreeNode& replaced) {
+    node.sourceStart = replaced.sourceStart;
+    node.sourceEnd = replaced.sourceEnd;
+    for (auto& c : node.children) place(*c, replaced);
+}
+
+// A factor spelling value, placed where replaced was. Negative numbers are
+// parenthesized, so they read the same as the left operand of **.
+static shared_ptr<ParseTreeNode> make_literal(const ConstantValue& value, const ParseTreeNode& replaced) {
+    auto factor = make_node("factor");
+    switch (value.kind) {
+        case ConstantValue::INT:
+        case ConstantValue::FLOAT: {
+            string text = constant_repr(value);
+            if (text[0] == '-') {
+                auto number = make_node("factor");
+                number->addChild(make_node("NUMBER", text));
+                auto expression = make_node("expression");
+                expression->addChild(number);
+                factor->addChild(make_node("DELIMITER", "("));
+                factor->addChild(expression);
+                factor->addChild(make_node("DELIMITER", ")"));
+            } else {
+                factor->addChild(make_node("NUMBER", text));
+            }
+            break;
+        }
+        case ConstantValue::BOOL:
+        case ConstantValue::NONE:
+            factor->addChild(make_node("KEYWORD", constant_repr(value)));
+            break;
+        case ConstantValue::STR:
+            factor->addChild(make_node("STRING_QUOTE", value.quote));
+            if (!value.text.empty()) factor->addChild(make_node("STRING_LITERAL", value.text));
+            factor->addChild(make_node("STRING_QUOTE", value.quote));
+            break;
+    }
+    place(*factor, replaced);
+    return factor;
+}
+
+struct ConstantFolder::Rewriter : TreeRewriter<ConstantFolder::Rewriter> {
+    struct Frame {
+        uint32_t scope;
+        int blockDepth;     // if, loop and try statements around the current node
+        bool known;         // false inside a def the scope tree did not see
+    };
+
+    ConstantFolder& result;
+    const ScopeTree& tree;
+    PackedKeyMap<uint32_t> scopeOfNode;                 // func_def / class_def address -> scope
+    vector<Frame> frames;
+    int headerDepth = 0;                                // inside a parameter list or base class list
+    unordered_set<const ParseTreeNode*> chainStarts;    // a < b in a < b < c
+    unordered_set<const ParseTreeNode*> negatedPowers;  // -5 ** n, read as -(5 ** n)
+    bool removedStatement = false;                      // the last rewrite removed a whole statement
+
+    Rewriter(ConstantFolder& result, const ScopeTree& tree) : result(result), tree(tree) {
+        for (uint32_t s = 1; s < tree.scopes().size(); s++) {
+            scopeOfNode.insert((uint64_t)(uintptr_t)tree.scopes()[s].node, s);
+        }
+        frames.push_back({0, 0, !tree.scopes().empty()});
+    }
+
+    // Defaults and base classes are evaluated in the enclosing scope.
+    const Frame& evalFrame() const {
+        return headerDepth > 0 && frames.size() > 1 ? frames[frames.size() - 2] : frames.back();
+    }
+
+    bool enterScope(ParseTreeNode& node) {
+        const uint32_t* scope = scopeOfNode.find((uint64_t)(uintptr_t)&node);
+        frames.push_back({scope ? *scope : frames.back().scope, 0, scope && frames.back().known});
+        return true;
+    }
+
+    bool enter_func_def(ParseTreeNode& node) { return enterScope(node); }
+    bool enter_class_def(ParseTreeNode& node) { return enterScope(node); }
+    void rewrite_func_def(shared_ptr<ParseTreeNode>&) { frames.pop_back(); }
+    void rewrite_class_def(shared_ptr<ParseTreeNode>&) { frames.pop_back(); }
+
+    bool enter_param_list(ParseTreeNode&) { headerDepth++; return true; }
+    bool enter_class_inheritance_opt(ParseTreeNode&) { headerDepth++; return true; }
+    void rewrite_param_list(shared_ptr<ParseTreeNode>&) { headerDepth--; }
+    void rewrite_class_inheritance_opt(shared_ptr<ParseTreeNode>&) { headerDepth--; }
+
+    bool enterBlock() {
+        frames.back().blockDepth++;
+        return true;
+    }
+    bool enter_if_stmt(ParseTreeNode&) { return enterBlock(); }
+    bool enter_while_stmt(ParseTreeNode&) { return enterBlock(); }
+    bool enter_for_stmt(ParseTreeNode&) { return enterBlock(); }
+    bool enter_try_stmt(ParseTreeNode&) { return enterBlock(); }
+    void rewrite_while_stmt(shared_ptr<ParseTreeNode>&) { frames.back().blockDepth--; }
+    void rewrite_for_stmt(shared_ptr<ParseTreeNode>&) { frames.back().blockDepth--; }
+    void rewrite_try_stmt(shared_ptr<ParseTreeNode>&) { frames.back().blockDepth--; }
+
+    void rewrite_if_stmt(shared_ptr<ParseTreeNode>& slot) {
+        frames.back().blockDepth--;
+        pruneBranches(slot);
+    }
+
+    // A statement left empty by a removed if goes too.
+    bool enter_statement(ParseTreeNode&) { removedStatement = false; return true; }
+    bool enter_loop_statement(ParseTreeNode&) { removedStatement = false; return true; }
+    void rewrite_statement(shared_ptr<ParseTreeNode>& slot) { removeIfEmptied(slot); }
+    void rewrite_loop_statement(shared_ptr<ParseTreeNode>& slot) { removeIfEmptied(slot); }
+
+    void removeIfEmptied(shared_ptr<ParseTreeNode>& slot) {
+        if (removedStatement && slot->children.empty()) slot.reset();
+        else removedStatement = false;
+    }
+
+    // a < b < c means a < b and b < c, so a < b must not fold on its own.
+    bool enter_binary_expr(ParseTreeNode& node) {
+        const ParseTreeNode* left = child(node, 0);
+        const ParseTreeNode* op = child(node, 1);
+        const ParseTreeNode* leftOp = left && left->kind == NodeKind::binary_expr ? child(*left, 1) : nullptr;
+        if (op && leftOp && is_chained_comparison(op->value) && is_chained_comparison(leftOp->value)) {
+            chainStarts.insert(left);
+        }
+        if (op && op->value == "**" && is_negated_literal(left)) negatedPowers.insert(&node);
+        return true;
+    }
+
+    static bool is_chained_comparison(const string& op) {
+        return is_comparison(op) || op == "in" || op == "not in" || op == "is" || op == "is not";
+    }
+
+    void rewrite_binary_expr(shared_ptr<ParseTreeNode>& slot) {
+        const ParseTreeNode& node = *slot;
+        if (node.children.size() != 3 || chainStarts.count(&node)) return;
+        const string& op = node.children[1]->value;
+        ConstantValue left, right, value;
+        if (!literal_value(node.children[0].get(), left)) return;
+        if (op == "and" || op == "or") {
+            // The result is one of the operands, so the other need not be constant
+            bool pickLeft = constant_truth(left) == (op == "or");
+            shared_ptr<ParseTreeNode> picked = node.children[pickLeft ? 0 : 2];
+            slot = picked;
+            result.folded++;
+            return;
+        }
+        if (!literal_value(node.children[2].get(), right)) return;
+        if (negatedPowers.count(&node)) {
+            ConstantValue base, power;
+            if (!fold_unary("-", left, base) || !fold_binary(base, op, right, power) ||
+                !fold_unary("-", power, value)) {
+                return;
+            }
+        } else if (!fold_binary(left, op, right, value)) {
+            return;
+        }
+        slot = make_literal(value, node);
+        result.folded++;
+    }
+
+    void rewrite_unary_expr(shared_ptr<ParseTreeNode>& slot) {
+        const ParseTreeNode& node = *slot;
+        const ParseTreeNode* op = child(node, 0);
+        ConstantValue operand, value;
+        if (!op || !literal_value(child(node, 1), operand) || !fold_unary(op->value, operand, value)) return;
+        slot = make_literal(value, node);
+        result.folded++;
+    }
+
+    // x if True else y -> x
+    void rewrite_expression(shared_ptr<ParseTreeNode>& slot) {
+        ParseTreeNode& node = *slot;
+        const ParseTreeNode* inlineIf = child(node, 1);
+        ConstantValue condition;
+        if (!inlineIf || inlineIf->kind != NodeKind::inline_if_else || !literal_value(child(*inlineIf, 1), condition)) {
+            return;
+        }
+        if (constant_truth(condition)) {
+            node.children.resize(1);
+        } else {
+            if (inlineIf->children.size() < 4 || !inlineIf->children[3]) return;
+            shared_ptr<ParseTreeNode> other = inlineIf->children[3];
+            vector<shared_ptr<ParseTreeNode>> replacement = other->children;
+            node.children = move(replacement);
+        }
+        result.folded++;
+    }
+
+    void rewrite_factor(shared_ptr<ParseTreeNode>& slot) {
+        const ParseTreeNode& node = *slot;
+        const ParseTreeNode* first = child(node, 0);
+        if (!first) return;
+        if (node.children.size() == 1 && first->kind == NodeKind::IDENTIFIER) {
+            if (result.constants.empty()) return;
+            const Frame& frame = evalFrame();
+            if (!frame.known) return;
+            int32_t symbol;
+            tree.resolve(frame.scope, first->value, symbol);
+            if (symbol < 0) return;
+            if (const ConstantValue* value = result.symbolValue(symbol)) {
+                slot = make_literal(*value, node);
+                result.propagated++;
+            }
+            return;
+        }
+        // (literal) -> literal
+        const ParseTreeNode* inner = child(node, 1);
+        ConstantValue value;
+        if (node.children.size() == 3 && first->kind == NodeKind::DELIMITER && inner &&
+            inner->kind == NodeKind::expression && inner->children.size() == 1 &&
+            inner->children[0]->kind == NodeKind::factor && !is_negated_literal(inner->children[0].get()) &&
+            literal_value(inner, value)) {
+            shared_ptr<ParseTreeNode> literal = inner->children[0];
+            literal->sourceStart = node.sourceStart;
+            literal->sourceEnd = node.sourceEnd;
+            slot = literal;
+        }
+    }
+
+    // NAME = constant, bound nowhere else and run unconditionally
+    void rewrite_assignment(shared_ptr<ParseTreeNode>& slot) {
+        const ParseTreeNode& node = *slot;
+        const Frame& frame = frames.back();
+        if (!frame.known || frame.blockDepth > 0) return;
+        const ParseTreeNode* target = child(node, 0);
+        const ParseTreeNode* primary = target ? child(*target, 0) : nullptr;
+        const ParseTreeNode* tail = target ? child(*target, 1) : nullptr;
+        if (!primary || primary->children.size() != 1 || (tail && !tail->children.empty())) return;
+        const ParseTreeNode* name = child(*primary, 0);
+        ConstantValue value;
+        if (!name || name->kind != NodeKind::IDENTIFIER || !literal_value(child(node, 2), value)) return;
+        int32_t symbol = tree.lookup(frame.scope, name->value);
+        if (symbol < 0) return;
+        const ScopeSymbol& info = tree.symbols()[symbol];
+        if (info.flags != SYMBOL_ASSIGNED || info.bindingCount != 1) return;
+        result.constantOf[symbol] = result.constants.size();
+        result.constants.push_back(value);
+    }
+
+    // --- dead branches ---
+
+    // A name that resolves, a literal, or not/and/or of those: evaluating it
+    // has no effect, so a condition can skip it.
+    bool isPure(const ParseTreeNode* node, int depth = 0) const {
+        node = innermost(node);
+        ConstantValue value;
+        if (!node || depth > MAX_CONDITION_DEPTH) return false;
+        if (literal_value(node, value)) return true;
+        if (node->kind == NodeKind::IDENTIFIER) {
+            int32_t symbol;
+            return tree.resolve(frames.back().scope, node->value, symbol) != NameResolution::UNRESOLVED;
+        }
+        const ParseTreeNode* op = child(*node, node->kind == NodeKind::unary_expr ? 0 : 1);
+        if (!op) return false;
+        if (node->kind == NodeKind::unary_expr && op->value == "not") return isPure(child(*node, 1), depth + 1);
+        if (node->kind == NodeKind::binary_expr && (op->value == "and" || op->value == "or")) {
+            return isPure(child(*node, 0), depth + 1) && isPure(child(*node, 2), depth + 1);
+        }
+        return false;
+    }
+
+    // 1 or 0 if the condition is always true or always false, -1 if it depends.
+    int conditionTruth(const ParseTreeNode* node, int depth = 0) const {
+        node = innermost(node);
+        ConstantValue value;
+        if (!node || depth > MAX_CONDITION_DEPTH) return -1;
+        if (literal_value(node, value)) return constant_truth(value);
+        const ParseTreeNode* op = child(*node, node->kind == NodeKind::unary_expr ? 0 : 1);
+        if (!op) return -1;
+        if (node->kind == NodeKind::unary_expr && op->value == "not") {
+            int truth = conditionTruth(child(*node, 1), depth + 1);
+            return truth < 0 ? -1 : !truth;
+        }
+        if (node->kind != NodeKind::binary_expr || (op->value != "and" && op->value != "or")) return -1;
+        // and stops at the first false operand, or at the first true one
+        int decisive = op->value == "and" ? 0 : 1;
+        int left = conditionTruth(child(*node, 0), depth + 1);
+        int right = conditionTruth(child(*node, 2), depth + 1);
+        if (left == decisive) return decisive;
+        if (right == decisive && isPure(child(*node, 0), depth + 1)) return decisive;
+        if (left >= 0 && right >= 0) return right;
+        return -1;
+    }
+
+    struct Clause {
+        shared_ptr<ParseTreeNode> node;     // if_stmt, elif_stmt or else_part
+        bool conditional;
+    };
+
+    // The parts of a clause after its keyword; the if_stmt's own elif and
+    // else are not part of it.
+    static void clause_rest(const Clause& clause, bool dropCondition, ParseTreeNode& into) {
+        const auto& children = clause.node->children;
+        for (size_t i = dropCondition ? 2 : 1; i < children.size(); i++) {
+            const auto& c = children[i];
+            if (c && (c->kind == NodeKind::elif_stmt || c->kind == NodeKind::else_part)) continue;
+            into.addChild(c);
+        }
+    }
+
+    static shared_ptr<ParseTreeNode> make_clause(const Clause& clause, const string& kind, const string& keyword) {
+        auto node = make_node(kind);
+        node->sourceStart = clause.node->sourceStart;
+        node->sourceEnd = clause.node->sourceEnd;
+        auto word = make_node("KEYWORD", keyword);
+        if (const ParseTreeNode* original = child(*clause.node, 0)) {
+            word->sourceStart = original->sourceStart;
+            word->sourceEnd = original->sourceEnd;
+        }
+        node->addChild(word);
+        clause_rest(clause, clause.node->kind != NodeKind::else_part && keyword == "else", *node);
+        return node;
+    }
+
+    // Drops clauses whose condition is always false. The first clause whose
+    // condition is always true becomes the else, and the ones after it go.
+    void pruneBranches(shared_ptr<ParseTreeNode>& slot) {
+        vector<Clause> clauses = {{slot, true}};
+        for (const auto& c : slot->children) {
+            if (!c || c->children.empty()) continue;
+            if (c->kind == NodeKind::elif_stmt) clauses.push_back({c, true});
+            else if (c->kind == NodeKind::else_part) clauses.push_back({c, false});
+        }
+        vector<Clause> kept;
+        bool changed = false;
+        bool lastIsElse = false;
+        for (size_t i = 0; i < clauses.size(); i++) {
+            int truth = clauses[i].conditional ? conditionTruth(child(*clauses[i].node, 1)) : 1;
+            if (truth == 0) {
+                result.removedBranches++;
+                changed = true;
+                continue;
+            }
+            kept.push_back(clauses[i]);
+            if (truth == 1) {
+                changed |= clauses[i].conditional || i + 1 < clauses.size();
+                result.removedBranches += clauses.size() - i - 1;
+                lastIsElse = true;
+                break;
+            }
+        }
+        if (!changed) return;
+
+        if (kept.empty()) {
+            slot.reset();
+            removedStatement = true;
+            return;
+        }
+        if (kept.size() == 1 && lastIsElse) {
+            // The statement is its body
+            const ParseTreeNode* body = find_child(*kept[0].node, NodeKind::statement_list);
+            for (const auto& c : kept[0].node->children) {
+                if (c.get() == body) {
+                    shared_ptr<ParseTreeNode> statements = c;
+                    slot = statements;
+                    return;
+                }
+            }
+            slot.reset();
+            removedStatement = true;
+            return;
+        }
+        auto rebuilt = make_clause(kept[0], "if_stmt", "if");
+        rebuilt->sourceStart = slot->sourceStart;
+        rebuilt->sourceEnd = slot->sourceEnd;
+        for (size_t i = 1; i < kept.size(); i++) {
+            bool isElse = i + 1 == kept.size() && lastIsElse;
+            rebuilt->addChild(isElse ? make_clause(kept[i], "else_part", "else")
+                                     : make_clause(kept[i], "elif_stmt", "elif"));
+        }
+        slot = rebuilt;
+    }
+};
+
+void ConstantFolder::fold(shared_ptr<ParseTreeNode>& root, const ScopeTree& scopes) {
+    constantOf.assign(scopes.symbols().size(), -1);
+    constants.clear();
+    folded = propagated = removedBranches = 0;
+    if (!root) return;
+    Rewriter rewriter(*this, scopes);
+    rewriter.rewrite(root);
+}
+
+void recordFoldedValues(SymbolTable& table, const ScopeTree& scopes, const ConstantFolder& folder) {
+    for (const SymbolTable::Symbol& symbol : table) {
+        SymbolEntry* entry = table.find(symbol.name, symbol.scope);
+        for (const SymbolReference& ref : entry->references) {
+            int32_t found = ref.offset < 0 ? -1 : scopes.symbolAt(ref.offset);
+            if (found < 0) continue;
+            if (const ConstantValue* value = folder.symbolValue(found)) entry->value = constant_repr(*value);
+            break;
+        }
+    }
+}
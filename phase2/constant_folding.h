@@ -0,0 +1,89 @@
+#ifndef CONSTANT_FOLDING_H
+#define CONSTANT_FOLDING_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+#include "scope_tree.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A value known before the program runs: a literal, a folded result or an
+// entry of a bytecode constant pool. Complex numbers and ints that do not
+// fit in 64 bits are never constants; the folder also leaves strings with
+// escapes alone.
+struct ConstantValue {
+    enum Kind : uint8_t { INT, FLOAT, BOOL, STR, NONE } kind = NONE;
+    int64_t intValue = 0;       // INT; BOOL as 0 or 1
+    double floatValue = 0;      // FLOAT
+    std::string text;           // STR: the value, escapes decoded
+    std::string quote;          // STR: the quote it is written with
+};
+
+// Python's repr of the value: 86400, 0.5, 'ab', True, None.
+std::string constant_repr(const ConstantValue& value);
+
+bool constant_truth(const ConstantValue& value);
+
+// repr() of a float: the shortest digits that read back as the same double,
+// in positional notation for exponents -4..15 and scientific otherwise.
+std::string float_repr(double value);
+
+// Evaluates op as Python would. False when the result is not a constant:
+// the operation raises (1 / 0, "a" < 1), overflows 64 bits, gives inf or
+// nan, builds a string longer than MAX_FOLDED_STRING, or depends on object
+// identity.
+bool fold_binary(const ConstantValue& left, const std::string& op, const ConstantValue& right,
+                 ConstantValue& result);
+bool fold_unary(const std::string& op, const ConstantValue& operand, ConstantValue& result);
+
+const size_t MAX_FOLDED_STRING = 4096;
+
+// Constant folding and propagation over the parse tree, in one rewrite.
+// Operators whose operands are literals are replaced by their result, and
+// "and"/"or" with a literal left operand by the operand they pick. An
+// if/elif/else clause whose condition is a constant false is removed, and
+// one whose condition is a constant true becomes the else of the statement,
+// dropping the clauses after it; in a condition, "x and False" is false
+// and "x or True" is true when x is a name or a literal.
+//
+// A name is propagated when its scope binds it exactly once, by an
+// assignment of a constant that is not inside an if, loop or try. Such an
+// assignment has run before anything after it in the source, including the
+// bodies of functions defined later, so every reference the rewrite meets
+// after it is replaced by the value.
+//
+// The scope tree must describe root as it is before folding; lazy bodies
+// are skipped, so expand them first. Folding replaces nodes and may remove
+// whole functions, so rebuild the scope tree afterwards.
+class ConstantFolder {
+public:
+    ConstantFolder() = default;
+    ConstantFolder(shared_ptr<ParseTreeNode>& root, const ScopeTree& scopes) { fold(root, scopes); }
+
+    void fold(shared_ptr<ParseTreeNode>& root, const ScopeTree& scopes);
+
+    // Value a scope-tree symbol always has, or null.
+    const ConstantValue* symbolValue(uint32_t symbol) const {
+        return symbol < constantOf.size() && constantOf[symbol] >= 0 ? &constants[constantOf[symbol]] : nullptr;
+    }
+
+    size_t foldedCount() const { return folded; }               // operators and inline ifs replaced
+    size_t propagatedCount() const { return propagated; }       // names replaced by their value
+    size_t removedBranchCount() const { return removedBranches; }
+
+private:
+    std::vector<int32_t> constantOf;        // by symbol, into constants; -1 if not constant
+    std::vector<ConstantValue> constants;
+    size_t folded = 0;
+    size_t propagated = 0;
+    size_t removedBranches = 0;
+
+    struct Rewriter;
+};
+
+// Fills the value column of table with the constant each entry's
+// scope-tree symbol was found to have.
+void recordFoldedValues(SymbolTable& table, const ScopeTree& scopes, const ConstantFolder& folder);
+
+#endif // CONSTANT_FOLDING_H
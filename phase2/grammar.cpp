@@ -0,0 +1,225 @@
+#include "grammar.h"
+#include <fstream>
+#include <sstream>
+#include <cctype>
+
+using namespace std;
+
+static const string ARROW = "→";
+static const string EPSILON = "ε";
+
+static bool isQuoted(const string& symbol) {
+    return symbol.size() >= 2 && symbol.front() == '\'' && symbol.back() == '\'';
+}
+
+// Removes (* ... *) comments, which may span several lines.
+static string stripComments(const string& text) {
+    string result;
+    size_t i = 0;
+    while (i < text.size()) {
+        if (text.compare(i, 2, "(*") == 0) {
+            size_t end = text.find("*)", i + 2);
+            if (end == string::npos) break;
+            // Keep the newlines so continuation lines stay separate
+            for (size_t j = i; j < end; j++) {
+                if (text[j] == '\n') result += '\n';
+            }
+            i = end + 2;
+        } else {
+            result += text[i++];
+        }
+    }
+    return result;
+}
+
+// Splits one alternative into symbols; quoted terminals may contain '|'.
+static vector<string> splitSymbols(const string& text) {
+    vector<string> symbols;
+    size_t i = 0;
+    while (i < text.size()) {
+        if (isspace(static_cast<unsigned char>(text[i]))) {
+            i++;
+        } else if (text[i] == '\'') {
+            size_t end = text.find('\'', i + 1);
+            if (end == string::npos) end = text.size() - 1;
+            symbols.push_back(text.substr(i, end - i + 1));
+            i = end + 1;
+        } else {
+            size_t start = i;
+            while (i < text.size() && !isspace(static_cast<unsigned char>(text[i])) && text[i] != '\'') i++;
+            symbols.push_back(text.substr(start, i - start));
+        }
+    }
+    return symbols;
+}
+
+// Splits a right-hand side on '|' outside quotes.
+static vector<string> splitAlternatives(const string& rhs) {
+    vector<string> alternatives;
+    string current;
+    bool inQuote = false;
+    for (char c : rhs) {
+        if (c == '\'') inQuote = !inQuote;
+        if (c == '|' && !inQuote) {
+            alternatives.push_back(current);
+            current.clear();
+        } else {
+            current += c;
+        }
+    }
+    alternatives.push_back(current);
+    return alternatives;
+}
+
+bool parseGrammar(const string& text, Grammar& grammar, string& error) {
+    istringstream input(stripComments(text));
+    string line;
+    string currentRule;
+    int lineNumber = 0;
+
+    while (getline(input, line)) {
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos) continue;
+
+        string rhs;
+        size_t arrow = line.find(ARROW);
+        if (arrow != string::npos) {
+            istringstream lhs(line.substr(0, arrow));
+            lhs >> currentRule;
+            if (currentRule.empty()) {
+                error = "line " + to_string(lineNumber) + ": missing rule name";
+                return false;
+            }
+            if (!grammar.isNonterminal(currentRule)) {
+                grammar.nonterminals.push_back(currentRule);
+                grammar.productions[currentRule];
+            }
+            if (grammar.startSymbol.empty()) grammar.startSymbol = currentRule;
+            rhs = line.substr(arrow + ARROW.size());
+        } else if (line[first] == '|' && !currentRule.empty()) {
+            rhs = line.substr(first + 1);
+        } else {
+            error = "line " + to_string(lineNumber) + ": expected a rule or a '|' continuation";
+            return false;
+        }
+
+        for (const string& alternative : splitAlternatives(rhs)) {
+            vector<string> symbols;
+            for (const string& symbol : splitSymbols(alternative)) {
+                if (symbol != EPSILON) symbols.push_back(symbol);
+            }
+            grammar.productions[currentRule].push_back(symbols);
+        }
+    }
+
+    if (grammar.startSymbol.empty()) {
+        error = "grammar has no rules";
+        return false;
+    }
+    return true;
+}
+
+bool loadGrammar(const string& path, Grammar& grammar, string& error) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        error = "cannot open " + path;
+        return false;
+    }
+    stringstream buffer;
+    buffer << file.rdbuf();
+    if (!parseGrammar(buffer.str(), grammar, error)) return false;
+    computeFirstFollow(grammar);
+    return true;
+}
+
+set<string> firstOfSequence(const Grammar& grammar, const vector<string>& symbols, size_t from, bool& nullable) {
+    set<string> result;
+    for (size_t i = from; i < symbols.size(); i++) {
+        const string& symbol = symbols[i];
+        if (!grammar.isNonterminal(symbol)) {
+            result.insert(symbol);
+            nullable = false;
+            return result;
+        }
+        auto it = grammar.first.find(symbol);
+        if (it != grammar.first.end()) result.insert(it->second.begin(), it->second.end());
+        if (!grammar.nullable.count(symbol)) {
+            nullable = false;
+            return result;
+        }
+    }
+    nullable = true;
+    return result;
+}
+
+// Standard fixed-point iteration; the grammar is small so the naive loop is fine.
+void computeFirstFollow(Grammar& grammar) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const string& rule : grammar.nonterminals) {
+            for (const vector<string>& alternative : grammar.productions[rule]) {
+                bool nullable = false;
+                set<string> first = firstOfSequence(grammar, alternative, 0, nullable);
+                set<string>& target = grammar.first[rule];
+                for (const string& terminal : first) {
+                    if (target.insert(terminal).second) changed = true;
+                }
+                if (nullable && grammar.nullable.insert(rule).second) changed = true;
+            }
+        }
+    }
+
+    grammar.follow[grammar.startSymbol].insert("$");
+    changed = true;
+    while (changed) {
+        changed = false;
+        for (const string& rule : grammar.nonterminals) {
+            for (const vector<string>& alternative : grammar.productions[rule]) {
+                for (size_t i = 0; i < alternative.size(); i++) {
+                    const string& symbol = alternative[i];
+                    if (!grammar.isNonterminal(symbol)) continue;
+
+                    bool restNullable = false;
+                    set<string> rest = firstOfSequence(grammar, alternative, i + 1, restNullable);
+                    if (restNullable) {
+                        const set<string>& ruleFollow = grammar.follow[rule];
+                        rest.insert(ruleFollow.begin(), ruleFollow.end());
+                    }
+                    set<string>& target = grammar.follow[symbol];
+                    for (const string& terminal : rest) {
+                        if (target.insert(terminal).second) changed = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool terminalMatches(const string& terminal, const Token& token) {
+    if (isQuoted(terminal)) {
+        return token.type != "STRING_LITERAL" && token.value == terminal.substr(1, terminal.size() - 2);
+    }
+    if (terminal == "STRING") return token.type == "STRING_QUOTE";
+    if (terminal == "$") return token.type == "END_OF_FILE";
+    return token.type == terminal;
+}
+
+void TerminalSet::add(const string& terminal) {
+    if (isQuoted(terminal)) {
+        values.insert(terminal.substr(1, terminal.size() - 2));
+    } else if (terminal == "STRING") {
+        types.insert("STRING_QUOTE");
+    } else if (terminal == "$") {
+        endOfInput = true;
+    } else {
+        types.insert(terminal);
+    }
+}
+
+bool TerminalSet::contains(const Token& token) const {
+    if (token.type == "END_OF_FILE") return endOfInput;
+    if (types.count(token.type)) return true;
+    return token.type != "STRING_LITERAL" && values.count(token.value) > 0;
+}
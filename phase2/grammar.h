@@ -0,0 +1,49 @@
+#ifndef GRAMMAR_H
+#define GRAMMAR_H
+
+#include "lexical_analyzer.h"
+#include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+// Grammar read from GrammarRules.txt.
+// Terminals are either quoted literals ('if', ':') matched against the token
+// value, or token classes (IDENTIFIER, NUMBER, STRING, NEWLINE, INDENT, DEDENT)
+// matched against the token type. "$" marks end of input in FOLLOW sets.
+struct Grammar {
+    std::string startSymbol;
+    std::vector<std::string> nonterminals;  // in declaration order
+    std::unordered_map<std::string, std::vector<std::vector<std::string>>> productions;  // ε is an empty alternative
+
+    std::unordered_set<std::string> nullable;
+    std::unordered_map<std::string, std::set<std::string>> first;
+    std::unordered_map<std::string, std::set<std::string>> follow;
+
+    bool isNonterminal(const std::string& symbol) const {
+        return productions.find(symbol) != productions.end();
+    }
+};
+
+// Set of terminals that can be tested against a token in O(1).
+struct TerminalSet {
+    std::unordered_set<std::string> values;  // quoted literals, without quotes
+    std::unordered_set<std::string> types;   // token classes
+    bool endOfInput = false;
+
+    void add(const std::string& terminal);
+    bool contains(const Token& token) const;
+};
+
+bool parseGrammar(const std::string& text, Grammar& grammar, std::string& error);
+bool loadGrammar(const std::string& path, Grammar& grammar, std::string& error);
+void computeFirstFollow(Grammar& grammar);
+
+// FIRST of symbols[from..]; nullable is set when the whole suffix can derive ε.
+std::set<std::string> firstOfSequence(const Grammar& grammar, const std::vector<std::string>& symbols,
+                                      size_t from, bool& nullable);
+
+bool terminalMatches(const std::string& terminal, const Token& token);
+
+#endif // GRAMMAR_H
@@ -0,0 +1,420 @@
+// Grammar compiler: reads GrammarRules.txt, computes nullable/FIRST/FOLLOW,
+// reports LL(1) conflicts and writes the table used by the predictive parser
+// backend (ll1_parser.cpp).
+//
+//   g++ -std=c++17 -o grammar_compiler grammar_compiler.cpp grammar.cpp lexical_analyzer.cpp
+//   ./grammar_compiler GrammarRules.txt -o ll1_table.h [--sets]
+
+#include "grammar.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+using namespace std;
+
+struct Production {
+    string lhs;
+    vector<string> rhs;
+};
+
+string joinSet(const set<string>& symbols) {
+    string result = "{";
+    bool first = true;
+    for (const string& symbol : symbols) {
+        if (!first) result += ", ";
+        result += symbol;
+        first = false;
+    }
+    return result + "}";
+}
+
+string productionText(const Production& p) {
+    string text = p.lhs + " →";
+    if (p.rhs.empty()) return text + " ε";
+    for (const string& symbol : p.rhs) text += " " + symbol;
+    return text;
+}
+
+void printSets(const Grammar& grammar) {
+    cout << "NULLABLE / FIRST / FOLLOW\n";
+    cout << "=========================\n";
+    for (const string& rule : grammar.nonterminals) {
+        auto first = grammar.first.find(rule);
+        auto follow = grammar.follow.find(rule);
+        cout << rule << (grammar.nullable.count(rule) ? " (nullable)" : "") << "\n";
+        cout << "  FIRST  " << joinSet(first == grammar.first.end() ? set<string>() : first->second) << "\n";
+        cout << "  FOLLOW " << joinSet(follow == grammar.follow.end() ? set<string>() : follow->second) << "\n";
+    }
+    cout << endl;
+}
+
+// Lookahead set of one production: FIRST(rhs), plus FOLLOW(lhs) when rhs is nullable.
+set<string> predictSet(const Grammar& grammar, const Production& p) {
+    bool nullable = false;
+    set<string> predict = firstOfSequence(grammar, p.rhs, 0, nullable);
+    if (nullable) {
+        auto follow = grammar.follow.find(p.lhs);
+        if (follow != grammar.follow.end()) predict.insert(follow->second.begin(), follow->second.end());
+    }
+    return predict;
+}
+
+// Strings of at most two terminals that a symbol sequence can start with.
+typedef vector<string> Prefix;
+
+set<Prefix> concat2(const set<Prefix>& left, const set<Prefix>& right) {
+    set<Prefix> result;
+    for (const Prefix& a : left) {
+        if (a.size() >= 2) {
+            result.insert(a);
+            continue;
+        }
+        for (const Prefix& b : right) {
+            Prefix joined = a;
+            for (size_t i = 0; i < b.size() && joined.size() < 2; i++) joined.push_back(b[i]);
+            result.insert(joined);
+        }
+    }
+    return result;
+}
+
+set<Prefix> first2OfSequence(const Grammar& grammar, const map<string, set<Prefix>>& first2,
+                             const vector<string>& symbols) {
+    set<Prefix> result = {Prefix()};
+    for (const string& symbol : symbols) {
+        if (grammar.isNonterminal(symbol)) {
+            auto it = first2.find(symbol);
+            result = concat2(result, it == first2.end() ? set<Prefix>() : it->second);
+        } else {
+            result = concat2(result, {Prefix{symbol}});
+        }
+    }
+    return result;
+}
+
+map<string, set<Prefix>> computeFirst2(const Grammar& grammar) {
+    map<string, set<Prefix>> first2;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const string& rule : grammar.nonterminals) {
+            for (const vector<string>& alternative : grammar.productions.at(rule)) {
+                for (const Prefix& prefix : first2OfSequence(grammar, first2, alternative)) {
+                    if (first2[rule].insert(prefix).second) changed = true;
+                }
+            }
+        }
+    }
+    return first2;
+}
+
+// Tokens that may follow `terminal` when p is chosen on it. "*" means the
+// second token comes from beyond the rule and cannot be told apart.
+set<string> secondTokens(const Grammar& grammar, const map<string, set<Prefix>>& first2,
+                         const Production& p, const string& terminal) {
+    set<string> result;
+    for (const Prefix& prefix : first2OfSequence(grammar, first2, p.rhs)) {
+        if (prefix.empty()) {
+            result.insert("*");
+        } else if (prefix[0] != terminal) {
+            continue;
+        } else if (prefix.size() == 2) {
+            result.insert(prefix[1]);
+        } else {
+            auto follow = grammar.follow.find(p.lhs);
+            if (follow != grammar.follow.end()) result.insert(follow->second.begin(), follow->second.end());
+        }
+    }
+    return result;
+}
+
+// A conflicting table cell resolved by the token after the lookahead. At most
+// one candidate may be the default, taken when no other one matches.
+struct SecondTokenChoice {
+    map<string, int> bySecondToken;
+    int defaultProduction = -1;
+};
+
+bool resolveWithSecondToken(const Grammar& grammar, const map<string, set<Prefix>>& first2,
+                            const vector<Production>& productions, const vector<int>& candidates,
+                            const string& terminal, SecondTokenChoice& choice) {
+    vector<set<string>> seconds;
+    for (int p : candidates) seconds.push_back(secondTokens(grammar, first2, productions[p], terminal));
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (!seconds[i].count("*")) continue;
+        if (choice.defaultProduction >= 0) return false;
+        choice.defaultProduction = candidates[i];
+    }
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (candidates[i] == choice.defaultProduction) continue;
+        for (const string& t : seconds[i]) {
+            auto existing = choice.bySecondToken.find(t);
+            if (existing != choice.bySecondToken.end() && existing->second != candidates[i]) return false;
+            choice.bySecondToken[t] = candidates[i];
+        }
+    }
+    return true;
+}
+
+// A nullable symbol before a rule's own recursive use lets the predictive
+// parser expand the rule forever without consuming input (e.g. A → B A with
+// B ⇒ ε and A ⇒ ε), so such cycles are reported as errors.
+bool hasNullableCycle(const Grammar& grammar, const string& start, string& path) {
+    vector<pair<string, string>> stack = {{start, start}};
+    set<string> seen;
+    while (!stack.empty()) {
+        auto [rule, trail] = stack.back();
+        stack.pop_back();
+        auto it = grammar.productions.find(rule);
+        for (const vector<string>& alternative : it->second) {
+            for (size_t i = 0; i < alternative.size(); i++) {
+                const string& symbol = alternative[i];
+                if (!grammar.isNonterminal(symbol)) break;
+                // Only symbols reachable without consuming input count
+                bool prefixNullable = true;
+                for (size_t j = 0; j < i; j++) {
+                    if (!grammar.nullable.count(alternative[j])) prefixNullable = false;
+                }
+                bool restNullable = true;
+                for (size_t j = i + 1; j < alternative.size(); j++) {
+                    if (!grammar.isNonterminal(alternative[j]) || !grammar.nullable.count(alternative[j])) restNullable = false;
+                }
+                if (prefixNullable && restNullable) {
+                    if (symbol == start) {
+                        path = trail + " ⇒ " + symbol;
+                        return true;
+                    }
+                    if (seen.insert(symbol).second) stack.push_back({symbol, trail + " ⇒ " + symbol});
+                }
+                if (!grammar.nullable.count(symbol)) break;
+            }
+        }
+    }
+    return false;
+}
+
+string cString(const string& text) {
+    string result = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') result += '\\';
+        result += c;
+    }
+    return result + "\"";
+}
+
+// Writes the tables as a header of constant arrays for ll1_parser.cpp.
+// Symbols are numbered terminals first ("$" is 0), then nonterminals in
+// declaration order.
+bool writeTable(const string& path, const string& grammarPath, const Grammar& grammar,
+                const vector<Production>& productions,
+                const map<string, map<string, vector<int>>>& table,
+                const map<string, map<string, SecondTokenChoice>>& secondTokenCells) {
+    set<string> terminalSet;
+    for (const Production& p : productions) {
+        for (const string& symbol : p.rhs) {
+            if (!grammar.isNonterminal(symbol)) terminalSet.insert(symbol);
+        }
+    }
+    terminalSet.erase("$");
+    vector<string> symbols = {"$"};
+    symbols.insert(symbols.end(), terminalSet.begin(), terminalSet.end());
+    int terminalCount = symbols.size();
+    symbols.insert(symbols.end(), grammar.nonterminals.begin(), grammar.nonterminals.end());
+
+    map<string, int> id;
+    for (int i = 0; i < (int)symbols.size(); i++) id[symbols[i]] = i;
+
+    ofstream out(path);
+    if (!out.is_open()) return false;
+
+    out << "// Generated by grammar_compiler from " << grammarPath << ". Do not edit.\n";
+    out << "// Regenerate with: ./grammar_compiler " << grammarPath << " -o " << path << "\n\n";
+    out << "#ifndef LL1_TABLE_H\n#define LL1_TABLE_H\n\n";
+    out << "namespace ll1 {\n\n";
+    out << "struct SecondTokenEntry {\n    int terminal;\n    int production;\n};\n\n";
+    out << "const int TERMINAL_COUNT = " << terminalCount << ";\n";
+    out << "const int NONTERMINAL_COUNT = " << grammar.nonterminals.size() << ";\n";
+    out << "const int START_SYMBOL = " << id[grammar.startSymbol] << ";  // " << grammar.startSymbol << "\n";
+    out << "const int END_OF_INPUT = 0;  // $\n\n";
+
+    out << "// Terminals, then nonterminals. Quoted terminals match the token value,\n";
+    out << "// the others the token type.\n";
+    out << "const char* const SYMBOL_NAMES[] = {\n";
+    for (const string& symbol : symbols) out << "    " << cString(symbol) << ",\n";
+    out << "};\n\n";
+
+    out << "const int PRODUCTION_COUNT = " << productions.size() << ";\n";
+    out << "const int PRODUCTION_LHS[] = {";
+    for (size_t i = 0; i < productions.size(); i++) {
+        out << (i % 16 == 0 ? "\n    " : " ") << id[productions[i].lhs] << ",";
+    }
+    out << "\n};\n\n";
+    out << "// Right-hand side of production i is PRODUCTION_SYMBOLS[PRODUCTION_START[i] .. PRODUCTION_START[i + 1])\n";
+    out << "const int PRODUCTION_START[] = {";
+    int offset = 0;
+    for (size_t i = 0; i <= productions.size(); i++) {
+        out << (i % 16 == 0 ? "\n    " : " ") << offset << ",";
+        if (i < productions.size()) offset += productions[i].rhs.size();
+    }
+    out << "\n};\n\n";
+    out << "const int PRODUCTION_SYMBOLS[] = {";
+    int column = 0;
+    for (const Production& p : productions) {
+        for (const string& symbol : p.rhs) {
+            out << (column++ % 16 == 0 ? "\n    " : " ") << id[symbol] << ",";
+        }
+    }
+    if (column == 0) out << " 0";
+    out << "\n};\n\n";
+
+    // Cells needing the next token are numbered in table order
+    vector<const SecondTokenChoice*> cells;
+    out << "// PARSE_TABLE[nonterminal][terminal]: production to expand, NO_PRODUCTION,\n";
+    out << "// or SECOND_TOKEN_BASE - k to choose with the next token via cell k.\n";
+    out << "const int NO_PRODUCTION = -1;\n";
+    out << "const int SECOND_TOKEN_BASE = -2;\n";
+    out << "const int PARSE_TABLE[NONTERMINAL_COUNT][TERMINAL_COUNT] = {\n";
+    for (const string& rule : grammar.nonterminals) {
+        auto row = table.find(rule);
+        auto secondRow = secondTokenCells.find(rule);
+        out << "    {";
+        for (int t = 0; t < terminalCount; t++) {
+            int cell = -1;
+            if (row != table.end()) {
+                auto entry = row->second.find(symbols[t]);
+                if (entry != row->second.end()) cell = entry->second[0];
+            }
+            if (secondRow != secondTokenCells.end()) {
+                auto choice = secondRow->second.find(symbols[t]);
+                if (choice != secondRow->second.end()) {
+                    cell = -2 - (int)cells.size();
+                    cells.push_back(&choice->second);
+                }
+            }
+            out << (t ? ", " : "") << cell;
+        }
+        out << "},  // " << rule << "\n";
+    }
+    out << "};\n\n";
+
+    out << "// Second-token cell k: entries SECOND_TOKEN_START[k] .. SECOND_TOKEN_START[k + 1],\n";
+    out << "// SECOND_TOKEN_DEFAULT[k] when none matches.\n";
+    out << "const int SECOND_TOKEN_DEFAULT[] = {";
+    for (const SecondTokenChoice* cell : cells) out << " " << cell->defaultProduction << ",";
+    if (cells.empty()) out << " -1";
+    out << " };\n";
+    out << "const int SECOND_TOKEN_START[] = {";
+    int entries = 0;
+    out << " 0,";
+    for (const SecondTokenChoice* cell : cells) {
+        entries += cell->bySecondToken.size();
+        out << " " << entries << ",";
+    }
+    out << " };\n";
+    out << "const SecondTokenEntry SECOND_TOKEN_ENTRIES[] = {\n";
+    for (const SecondTokenChoice* cell : cells) {
+        for (const auto& [terminal, production] : cell->bySecondToken) {
+            out << "    {" << id[terminal] << ", " << production << "},  // " << terminal << "\n";
+        }
+    }
+    if (entries == 0) out << "    {-1, -1}\n";
+    out << "};\n\n";
+    out << "} // namespace ll1\n\n#endif // LL1_TABLE_H\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    string grammarPath;
+    string outputPath;
+    bool showSets = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--sets") {
+            showSets = true;
+        } else if (grammarPath.empty() && arg[0] != '-') {
+            grammarPath = arg;
+        } else {
+            cerr << "Usage: " << argv[0] << " GRAMMAR [-o OUTPUT.h] [--sets]" << endl;
+            return 1;
+        }
+    }
+    if (grammarPath.empty()) {
+        cerr << "Usage: " << argv[0] << " GRAMMAR [-o OUTPUT.h] [--sets]" << endl;
+        return 1;
+    }
+
+    Grammar grammar;
+    string error;
+    if (!loadGrammar(grammarPath, grammar, error)) {
+        cerr << grammarPath << ": " << error << endl;
+        return 1;
+    }
+
+    vector<Production> productions;
+    for (const string& rule : grammar.nonterminals) {
+        for (const vector<string>& alternative : grammar.productions.at(rule)) {
+            productions.push_back({rule, alternative});
+        }
+    }
+    cout << grammarPath << ": " << grammar.nonterminals.size() << " rules, "
+         << productions.size() << " productions" << endl;
+
+    if (showSets) printSets(grammar);
+
+    int errors = 0;
+    for (const string& rule : grammar.nonterminals) {
+        string path;
+        if (hasNullableCycle(grammar, rule, path)) {
+            cout << "error: " << rule << " derives itself without consuming input: " << path << endl;
+            errors++;
+        }
+    }
+
+    // table[rule][terminal] = productions predicted by that lookahead
+    map<string, map<string, vector<int>>> table;
+    for (int i = 0; i < (int)productions.size(); i++) {
+        for (const string& terminal : predictSet(grammar, productions[i])) {
+            table[productions[i].lhs][terminal].push_back(i);
+        }
+    }
+
+    map<string, map<string, SecondTokenChoice>> secondTokenCells;
+    map<string, set<Prefix>> first2 = computeFirst2(grammar);
+    int conflicts = 0;
+    int unresolved = 0;
+    for (const string& rule : grammar.nonterminals) {
+        for (auto& [terminal, candidates] : table[rule]) {
+            if (candidates.size() < 2) continue;
+            conflicts++;
+            SecondTokenChoice choice;
+            bool resolved = resolveWithSecondToken(grammar, first2, productions, candidates, terminal, choice);
+            cout << (resolved ? "conflict (resolved by the next token): " : "conflict: ")
+                 << rule << " on " << terminal << "\n";
+            for (int p : candidates) cout << "    " << productionText(productions[p]) << "\n";
+            if (resolved) {
+                secondTokenCells[rule][terminal] = choice;
+            } else {
+                cout << "    using " << productionText(productions[candidates[0]]) << "\n";
+                unresolved++;
+                candidates.resize(1);
+            }
+        }
+    }
+    cout << conflicts << " LL(1) conflict(s), " << unresolved << " not resolved by two-token lookahead" << endl;
+
+    if (errors > 0) return 1;
+    if (!outputPath.empty()) {
+        if (!writeTable(outputPath, grammarPath, grammar, productions, table, secondTokenCells)) {
+            cerr << "cannot write " << outputPath << endl;
+            return 1;
+        }
+        cout << "wrote " << outputPath << endl;
+    }
+    return unresolved > 0 ? 1 : 0;
+}
@@ -0,0 +1,229 @@
+#ifndef IDENTIFIER_TABLE_H
+#define IDENTIFIER_TABLE_H
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// Hashing and lookup for identifier-keyed tables. Identifiers are hashed
+// once with a wyhash-style function (read the bytes as 64-bit words, fold
+// each pair with a 64x64->128 multiply) and interned to dense 32-bit IDs.
+// Each ID keeps its hash, so a table that grows never hashes a string
+// again. A key made of two identifiers is packed into one 64-bit integer
+// and stored in an open-addressing table with linear probing.
+
+const uint64_t HASH_SECRET[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+};
+
+// Full 64x64->128-bit product as its low and high words. MSVC has no
+// 128-bit integer type, so it uses the x64 intrinsic or, on other targets,
+// four 32x32-bit products.
+inline void hash_multiply(uint64_t a, uint64_t b, uint64_t& low, uint64_t& high) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t)a * b;
+    low = (uint64_t)product;
+    high = (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    low = _umul128(a, b, &high);
+#else
+    uint64_t lowLow = (a & 0xffffffff) * (b & 0xffffffff);
+    uint64_t lowHigh = (a & 0xffffffff) * (b >> 32);
+    uint64_t highLow = (a >> 32) * (b & 0xffffffff);
+    uint64_t highHigh = (a >> 32) * (b >> 32);
+    uint64_t middle = (lowLow >> 32) + (lowHigh & 0xffffffff) + (highLow & 0xffffffff);
+    low = (middle << 32) | (lowLow & 0xffffffff);
+    high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+}
+
+// Folds a 128-bit product into 64 bits; every input bit affects every output bit.
+inline uint64_t hash_mix(uint64_t a, uint64_t b) {
+    uint64_t low, high;
+    hash_multiply(a, b, low, high);
+    return low ^ high;
+}
+
+inline uint64_t hash_read64(const char* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t hash_read32(const char* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+inline uint64_t hash_identifier(std::string_view s, uint64_t seed = 0) {
+    const char* p = s.data();
+    size_t length = s.size();
+    seed ^= hash_mix(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+    uint64_t a, b;
+    if (length <= 16) {
+        if (length >= 4) {
+            // Two overlapping pairs of 32-bit reads cover 4..16 bytes
+            size_t step = (length >> 3) << 2;
+            a = (hash_read32(p) << 32) | hash_read32(p + step);
+            b = (hash_read32(p + length - 4) << 32) | hash_read32(p + length - 4 - step);
+        } else if (length > 0) {
+            a = ((uint64_t)(uint8_t)p[0] << 16) | ((uint64_t)(uint8_t)p[length >> 1] << 8) | (uint8_t)p[length - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t left = length;
+        while (left > 16) {
+            seed = hash_mix(hash_read64(p) ^ HASH_SECRET[1], hash_read64(p + 8) ^ seed);
+            p += 16;
+            left -= 16;
+        }
+        a = hash_read64(p + left - 16);
+        b = hash_read64(p + left - 8);
+    }
+    uint64_t low, high;
+    hash_multiply(a ^ HASH_SECRET[1], b ^ seed, low, high);
+    return hash_mix(low ^ HASH_SECRET[0] ^ length, high ^ HASH_SECRET[1]);
+}
+
+// Packed keys are small integers side by side; spread them over the table.
+inline uint64_t hash_packed_key(uint64_t key) {
+    return hash_mix(key ^ HASH_SECRET[0], HASH_SECRET[1]);
+}
+
+inline uint64_t pack_key(uint32_t high, uint32_t low) {
+    return ((uint64_t)high << 32) | low;
+}
+
+// Tables are kept at most 3/8 full; with linear probing a successful
+// lookup then examines about 1.2 slots on average.
+inline bool over_max_load(size_t count, size_t capacity) {
+    return count * 8 > capacity * 3;
+}
+
+// Strings to dense IDs in first-seen order.
+class IdentifierInterner {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    uint32_t intern(std::string_view s) {
+        if (over_max_load(strings.size() + 1, table.size())) grow();
+        uint64_t h = hash_identifier(s);
+        size_t i = h & (table.size() - 1);
+        for (; table[i] != NONE; i = (i + 1) & (table.size() - 1)) {
+            if (hashes[table[i]] == h && strings[table[i]] == s) return table[i];
+        }
+        uint32_t id = strings.size();
+        strings.emplace_back(s);
+        hashes.push_back(h);
+        table[i] = id;
+        return id;
+    }
+
+    // ID of s, or NONE if it was never interned.
+    uint32_t find(std::string_view s) const {
+        if (table.empty()) return NONE;
+        uint64_t h = hash_identifier(s);
+        for (size_t i = h & (table.size() - 1); table[i] != NONE; i = (i + 1) & (table.size() - 1)) {
+            if (hashes[table[i]] == h && strings[table[i]] == s) return table[i];
+        }
+        return NONE;
+    }
+
+    const std::string& text(uint32_t id) const { return strings[id]; }
+    uint64_t hash(uint32_t id) const { return hashes[id]; }
+    size_t size() const { return strings.size(); }
+
+private:
+    std::deque<std::string> strings;    // stable, so text() references stay valid
+    std::vector<uint64_t> hashes;
+    std::vector<uint32_t> table;        // IDs; size is a power of two
+
+    void grow() {
+        std::vector<uint32_t> bigger(table.empty() ? 64 : table.size() * 2, NONE);
+        for (uint32_t id = 0; id < strings.size(); id++) {
+            size_t i = hashes[id] & (bigger.size() - 1);
+            while (bigger[i] != NONE) i = (i + 1) & (bigger.size() - 1);
+            bigger[i] = id;
+        }
+        table.swap(bigger);
+    }
+};
+
+// Open-addressing map from packed 64-bit keys. EMPTY is reserved.
+template <typename Value>
+class PackedKeyMap {
+public:
+    static constexpr uint64_t EMPTY = UINT64_MAX;
+
+    Value* find(uint64_t key) {
+        return const_cast<Value*>(static_cast<const PackedKeyMap*>(this)->find(key));
+    }
+
+    const Value* find(uint64_t key) const {
+        if (entries.empty()) return nullptr;
+        for (size_t i = hash_packed_key(key) & (entries.size() - 1);; i = (i + 1) & (entries.size() - 1)) {
+            if (entries[i].key == key) return &entries[i].value;
+            if (entries[i].key == EMPTY) return nullptr;
+        }
+    }
+
+    // Like unordered_map::emplace: the entry for key, and whether it was added.
+    std::pair<Value*, bool> insert(uint64_t key, const Value& value) {
+        if (over_max_load(count + 1, entries.size())) grow();
+        size_t i = hash_packed_key(key) & (entries.size() - 1);
+        for (;; i = (i + 1) & (entries.size() - 1)) {
+            if (entries[i].key == key) return {&entries[i].value, false};
+            if (entries[i].key == EMPTY) break;
+        }
+        entries[i] = {key, value};
+        count++;
+        return {&entries[i].value, true};
+    }
+
+    void clear() {
+        entries.clear();
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+
+    // Slots find(key) examines, for benchmarks; lookups themselves count nothing.
+    size_t probeCount(uint64_t key) const {
+        if (entries.empty()) return 0;
+        size_t probes = 1;
+        size_t i = hash_packed_key(key) & (entries.size() - 1);
+        for (; entries[i].key != key && entries[i].key != EMPTY; i = (i + 1) & (entries.size() - 1)) probes++;
+        return probes;
+    }
+
+private:
+    struct Entry {
+        uint64_t key;
+        Value value;
+    };
+    std::vector<Entry> entries;         // size is a power of two
+    size_t count = 0;
+
+    void grow() {
+        std::vector<Entry> bigger(entries.empty() ? 64 : entries.size() * 2, Entry{EMPTY, Value()});
+        for (const Entry& entry : entries) {
+            if (entry.key == EMPTY) continue;
+            size_t i = hash_packed_key(entry.key) & (bigger.size() - 1);
+            while (bigger[i].key != EMPTY) i = (i + 1) & (bigger.size() - 1);
+            bigger[i] = entry;
+        }
+        entries.swap(bigger);
+    }
+};
+
+#endif // IDENTIFIER_TABLE_H
@@ -8,79 +8,119 @@
 #include <cctype>
 #include <iomanip>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
 using namespace std;
 
-SymbolEntry* getEntryByScope(const unordered_map<pair<string, string>, SymbolEntry, PairHash>& symbolTable, const string& tokenValue, const string& scope) {
-    for (const auto& entry : symbolTable) {
-        const auto& key = entry.first;
-        const auto& symbol = entry.second;
-
-        if (key.first == tokenValue && key.second == scope) { 
-            return const_cast<SymbolEntry*>(&symbol); 
-        }
-    }
+const vector<size_t>* SymbolTable::slotsNamed(const string& name) const {
+    uint32_t id = identifiers.find(name);
+    return id < slotsByName.size() && !slotsByName[id].empty() ? &slotsByName[id] : nullptr;
+}
 
-    return nullptr; 
+bool SymbolTable::contains(const string& name) const {
+    return slotsNamed(name) != nullptr;
 }
 
-SymbolEntry* getFirstEntryForValue(const unordered_map<pair<string, string>, SymbolEntry, PairHash>& symbolTable, 
-    const vector<string>& scopeStack, 
-    const string& tokenValue) {
-    // Iterate through the scopeStack from the last (current scope) to the first (global scope)
-    for (auto it = scopeStack.rbegin(); it != scopeStack.rend(); ++it) {
-        string currentScope = *it; // Get the current scope
-        pair<string, string> key = {tokenValue, currentScope}; // Create the composite key
-
-        // Check if the key exists in the symbol table
-        auto entry = symbolTable.find(key);
-        if (entry != symbolTable.end()) {
-            return const_cast<SymbolEntry*>(&entry->second); // Return the matching entry
-        }
-    }
+SymbolEntry* SymbolTable::find(const string& name, const string& scope) {
+    return const_cast<SymbolEntry*>(static_cast<const SymbolTable*>(this)->find(name, scope));
+}
 
-    return nullptr; // Return nullptr if no matching entry is found
+const SymbolEntry* SymbolTable::find(const string& name, const string& scope) const {
+    uint32_t nameId = identifiers.find(name);
+    uint32_t scopeId = identifiers.find(scope);
+    if (nameId == IdentifierInterner::NONE || scopeId == IdentifierInterner::NONE) return nullptr;
+    const size_t* slot = slotOf.find(pack_key(nameId, scopeId));
+    return slot ? &slots[*slot].entry : nullptr;
 }
 
-string getHighestScope(const unordered_map<pair<string, string>, SymbolEntry, PairHash>& symbolTable, const string& tokenValue) {
-    string highestScope = "global"; // Default to global if no higher scope is found
+size_t SymbolTable::keyProbes(const string& name, const string& scope) const {
+    uint32_t nameId = identifiers.find(name);
+    uint32_t scopeId = identifiers.find(scope);
+    if (nameId == IdentifierInterner::NONE || scopeId == IdentifierInterner::NONE) return 0;
+    return slotOf.probeCount(pack_key(nameId, scopeId));
+}
 
-    for (const auto& entry : symbolTable) {
-        const auto& key = entry.first;
-        const auto& scope = key.second;
+vector<const SymbolTable::Symbol*> SymbolTable::lookup(const string& name) const {
+    vector<const Symbol*> found;
+    if (const vector<size_t>* named = slotsNamed(name)) {
+        for (size_t slot : *named) found.push_back(&slots[slot]);
+    }
+    return found;
+}
 
+vector<const SymbolTable::Symbol*> SymbolTable::symbolsOnLine(int line) const {
+    vector<const Symbol*> found;
+    auto it = slotsByLine.find(line);
+    if (it != slotsByLine.end()) {
+        for (size_t slot : it->second) found.push_back(&slots[slot]);
+    }
+    return found;
+}
 
-        if (key.first == tokenValue) {
-            if (scope != "global") {
-                highestScope = scope;
-            }
-        }
+size_t SymbolTable::slotFor(const string& name, const string& scope) {
+    uint32_t nameId = identifiers.intern(name);
+    uint32_t scopeId = identifiers.intern(scope);
+    auto inserted = slotOf.insert(pack_key(nameId, scopeId), slots.size());
+    if (inserted.second) {
+        slots.push_back({name, scope, SymbolEntry()});
+        if (nameId >= slotsByName.size()) slotsByName.resize(nameId + 1);
+        slotsByName[nameId].push_back(*inserted.first);
     }
+    return *inserted.first;
+}
 
-    return highestScope;
+SymbolEntry& SymbolTable::at(const string& name, const string& scope) {
+    return slots[slotFor(name, scope)].entry;
 }
 
+void SymbolTable::add(const string& name, const string& scope, const SymbolEntry& entry) {
+    size_t slot = slotFor(name, scope);
+    slots[slot].entry = entry;
+    if (slot >= declared.size()) declared.resize(slot + 1);
+    if (!declared[slot]) {
+        declared[slot] = true;
+        listed.push_back(slot);
+    }
+}
 
-string getLastScope(const unordered_map<pair<string, string>, SymbolEntry, PairHash>& symbolTable, 
-    const vector<pair<string, string>>& symbolOrder, 
-    const string& tokenValue) {
-    // Iterate through the symbolOrder in reverse to find the last occurrence of the token
-    for (auto it = symbolOrder.rbegin(); it != symbolOrder.rend(); ++it) {
-        const auto& key = *it;
-        if (key.first == tokenValue) {
-            return key.second; // Return the scope of the last occurrence
-        }
+void SymbolTable::finish() {
+    slotsByLine.clear();
+    for (size_t slot = 0; slot < slots.size(); slot++) {
+        // lines holds no repeats, so each slot is listed once per line
+        for (int line : slots[slot].entry.lines) slotsByLine[line].push_back(slot);
     }
-    return "global"; // Default to global if the token is not found
 }
 
-bool isIdentifierInSymbolTable(const unordered_map<pair<string, string>, SymbolEntry, PairHash>& symbolTable, const string& identifier) {
-    for (const auto& entry : symbolTable) {
-        if (entry.first.first == identifier) {
-            return true;
+const string& SymbolTable::latestScope(const string& name) const {
+    static const string global = "global";
+    if (const vector<size_t>* named = slotsNamed(name)) {
+        for (auto slot = named->rbegin(); slot != named->rend(); ++slot) {
+            if (slots[*slot].scope != global) return slots[*slot].scope;
         }
     }
-    return false;
+    return global;
+}
+
+SymbolEntry* SymbolTable::resolve(const string& name, const vector<string>& scopeStack) {
+    if (!contains(name)) return nullptr;
+    for (auto scope = scopeStack.rbegin(); scope != scopeStack.rend(); ++scope) {
+        if (SymbolEntry* entry = find(name, *scope)) return entry;
+    }
+    return nullptr;
+}
+
+// Tokens are visited in order, so a repeated line can only be the last one.
+static void addReference(SymbolEntry& entry, const Token& token) {
+    if (entry.lines.empty() || entry.lines.back() != token.line) {
+        entry.lines.push_back(token.line);
+    }
+    entry.references.push_back({token.line, token.offset});
+}
+
+// Entry for the first occurrence of a symbol.
+static SymbolEntry declaration(int id, const Token& token, const string& type, const string& scope) {
+    return {id, {token.line}, type, "undefined", scope, {{token.line, token.offset}}};
 }
 
 // Python keywords
@@ -96,7 +136,8 @@ const unordered_set<string> KEYWORDS = {
 const unordered_set<string> OPERATORS = {
     "+", "-", "", "/", "%", "", "//", "=", "+=", "-=", "=", "/=",
     "%=", "=", "//=", "==", "!=", "<", ">", "<=", ">=", "&", "|",
-    "^", "~", "<<", ">>", "and", "or", "not", "is", ":=","*","**","*="
+    "^", "~", "<<", ">>", "and", "or", "not", "is", ":=","*","**","*=",
+    "**=", "&=", "|=", "^=", "<<=", ">>="
 };
 
 // Python delimiters
@@ -250,6 +291,93 @@ bool isNumber(const std::string& str) {
     return hasDigit && (!hasExponent || hasDigitAfterExponent);
 }
 
+bool decodeNumber(const string& str, NumericLiteral& literal) {
+    if (!isNumber(str)) return false;
+    literal = NumericLiteral();
+    bool negative = str[0] == '-';
+    size_t start = (str[0] == '-' || str[0] == '+') ? 1 : 0;
+
+    if (tolower(str.back()) == 'j') {
+        literal.kind = NumericLiteral::COMPLEX;
+        literal.floatValue = strtod(str.substr(0, str.length() - 1).c_str(), nullptr);
+        return true;
+    }
+
+    int base = 10;
+    if (str.length() > 2 + start && str[start] == '0') {
+        char prefix = tolower(str[start + 1]);
+        if (prefix == 'x') base = 16;
+        else if (prefix == 'b') base = 2;
+        else if (prefix == 'o') base = 8;
+    }
+    if (base == 10 && str.find_first_of(".eE", start) != string::npos) {
+        literal.kind = NumericLiteral::FLOAT;
+        literal.floatValue = strtod(str.c_str(), nullptr);
+        return true;
+    }
+
+    // Accumulate the magnitude negated, so INT64_MIN fits
+    int64_t value = 0;
+    for (size_t i = base == 10 ? start : start + 2; i < str.length(); i++) {
+        char c = tolower(str[i]);
+        int digit = isdigit(c) ? c - '0' : c - 'a' + 10;
+        if (__builtin_mul_overflow(value, (int64_t)base, &value) ||
+            __builtin_sub_overflow(value, (int64_t)digit, &value)) {
+            literal.overflowed = true;
+            return true;
+        }
+    }
+    if (!negative && value == INT64_MIN) {
+        literal.overflowed = true;
+        return true;
+    }
+    literal.intValue = negative ? value : -value;
+    return true;
+}
+
+// Fills Token::offset/length by finding each token's text in the source,
+// scanning forward from the previous token and starting no earlier than the
+// token's own line, so comments cannot be matched. An INDENT is zero width
+// at the next token and a DEDENT at the end of the previous one, so both lie
+// inside the block they delimit. Text the lexer rewrote (e.g. ';' emitted as
+// a NEWLINE) gets zero width where the scan stands.
+static void locateTokens(const string& source, vector<Token>& tokens) {
+    vector<size_t> lineStarts = {0, 0};     // 1-based
+    for (size_t i = 0; i < source.size(); i++) {
+        if (source[i] == '\n') lineStarts.push_back(i + 1);
+    }
+    lineStarts.push_back(source.size() + 1);
+    size_t pos = 0;
+    for (Token& token : tokens) {
+        if (token.type == "DEDENT") {
+            token.offset = pos;
+            continue;
+        }
+        if (token.type == "INDENT") continue;
+        int line = min<int>(max(token.line, 1), lineStarts.size() - 2);
+        size_t from = max(pos, lineStarts[line]);
+        size_t found = token.type == "NEWLINE" ? source.find('\n', from) : source.find(token.value, from);
+        if (token.type != "NEWLINE" && token.value.empty()) found = string::npos;
+        if (found != string::npos && found < lineStarts[line + 1]) {
+            token.offset = found;
+            token.length = token.type == "NEWLINE" ? 1 : token.value.size();
+            pos = found + token.length;
+        } else {
+            token.offset = pos;
+            token.length = 0;
+        }
+    }
+    int next = source.size();
+    for (size_t i = tokens.size(); i > 0; i--) {
+        Token& token = tokens[i - 1];
+        if (token.type == "INDENT") {
+            token.offset = next;
+        } else if (token.type != "DEDENT") {
+            next = token.offset;
+        }
+    }
+}
+
 vector<Token> tokenize(const string& source) { 
     vector<Token> tokens;
     string currentToken;
@@ -843,9 +971,181 @@ vector<Token> tokenize(const string& source) {
     }
 
     // Check for unterminated multiline string
+    locateTokens(source, tokens);
     return tokens;
 }
 
+// Side table for constant-time lookahead: each '(' '[' '{' and each INDENT maps
+// to the index of its matching close or DEDENT, and the close maps back to the
+// opener. Unmatched tokens and everything else map to -1. Brackets and
+// indentation use separate stacks because the lexer still emits NEWLINE/INDENT
+// tokens inside multi-line brackets.
+vector<int> buildMatchTable(const vector<Token>& tokens) {
+    vector<int> matchTable(tokens.size(), -1);
+    vector<int> bracketStack;
+    vector<int> indentStack;
+
+    for (int i = 0; i < (int)tokens.size(); i++) {
+        const Token& token = tokens[i];
+        if (token.type == "INDENT") {
+            indentStack.push_back(i);
+        }
+        else if (token.type == "DEDENT") {
+            if (!indentStack.empty()) {
+                matchTable[indentStack.back()] = i;
+                matchTable[i] = indentStack.back();
+                indentStack.pop_back();
+            }
+        }
+        else if (token.type == "DELIMITER" && token.value.size() == 1) {
+            char c = token.value[0];
+            if (c == '(' || c == '[' || c == '{') {
+                bracketStack.push_back(i);
+            }
+            else if (c == ')' || c == ']' || c == '}') {
+                char open = (c == ')') ? '(' : (c == ']') ? '[' : '{';
+                if (!bracketStack.empty() && tokens[bracketStack.back()].value[0] == open) {
+                    matchTable[bracketStack.back()] = i;
+                    matchTable[i] = bracketStack.back();
+                    bracketStack.pop_back();
+                }
+            }
+        }
+    }
+    return matchTable;
+}
+
+static bool isBracket(const Token& token) {
+    return token.type == "DELIMITER" && token.value.size() == 1 && strchr("()[]{}", token.value[0]);
+}
+
+// True if both lines have the same brackets at the same token positions.
+static bool sameBrackets(const vector<Token>& a, const vector<Token>& b) {
+    for (size_t i = 0; i < max(a.size(), b.size()); i++) {
+        bool inA = i < a.size() && isBracket(a[i]);
+        bool inB = i < b.size() && isBracket(b[i]);
+        if (inA != inB || (inA && a[i].value != b[i].value)) return false;
+    }
+    return true;
+}
+
+// Tokens of a line that lexes the same on its own as in the file when it
+// starts outside a string. An indented probe line after it must lex as a
+// line of its own with its INDENT, which shows the line leaves the lexer as
+// it found it; continuations and triple quotes are turned away first, and so
+// is a string before any token but delimiters, as its tokens take the line
+// number of the token before them. A line with no token before its NEWLINE (blank or
+// only a comment) takes no part in indentation, so it is turned away too.
+static bool tokenizeLine(const string& line, vector<Token>& lineTokens) {
+    if (line.find('\\') != string::npos || line.find("'''") != string::npos ||
+        line.find("\"\"\"") != string::npos) {
+        return false;
+    }
+    lineTokens = tokenize(line + " _\n");
+    size_t n = lineTokens.size();
+    if (n < 6 || lineTokens[n - 5].type != "NEWLINE" || lineTokens[n - 4].type != "INDENT" ||
+        lineTokens[n - 3].line != 2 || lineTokens[n - 3].value != "_" || lineTokens[n - 2].type != "NEWLINE" ||
+        lineTokens[n - 1].type != "DEDENT") {
+        return false;
+    }
+    lineTokens.resize(n - 4);
+    for (const Token& token : lineTokens) {
+        if (token.type == "STRING_QUOTE") return false;
+        if (token.type != "DELIMITER") break;
+    }
+    return true;
+}
+
+bool relexEdit(const string& source, vector<Token>& tokens, size_t offset, const string& replacedText,
+               size_t insertedLength, TokenEdit& edit) {
+    if (offset > source.size() || insertedLength > source.size() - offset) return false;
+    if (replacedText.find('\n') != string::npos || memchr(source.data() + offset, '\n', insertedLength)) {
+        return false;
+    }
+    // The edit must leave the line's indentation alone and end before its
+    // newline; at the first character of the line, both old and new text
+    // must start there.
+    size_t newline = offset == 0 ? string::npos : source.rfind('\n', offset - 1);
+    size_t lineStart = newline == string::npos ? 0 : newline + 1;
+    size_t textStart = source.find_first_not_of(" \t\r\f\v", lineStart);
+    size_t lineEnd = source.find('\n', offset + insertedLength);
+    if (textStart > offset || lineEnd == string::npos || source[textStart] == '\n') return false;
+    if (textStart == offset) {
+        char oldFirst = replacedText.empty() ? source[offset + insertedLength] : replacedText[0];
+        if (isspace((unsigned char)oldFirst)) return false;
+    }
+
+    string newLine = source.substr(textStart, lineEnd + 1 - textStart);
+    string oldLine = source.substr(textStart, offset - textStart) + replacedText +
+                     source.substr(offset + insertedLength, lineEnd + 1 - offset - insertedLength);
+    vector<Token> oldTokens, newTokens;
+    if (!tokenizeLine(oldLine, oldTokens) || !tokenizeLine(newLine, newTokens)) return false;
+
+    // The old line's tokens start at its first character, after any INDENT or
+    // DEDENT; matching them also shows the line did not start inside a string
+    auto at = lower_bound(tokens.begin(), tokens.end(), textStart,
+                          [](const Token& token, size_t pos) { return (size_t)token.offset < pos; });
+    size_t first = at - tokens.begin();
+    while (first < tokens.size() && (tokens[first].type == "INDENT" || tokens[first].type == "DEDENT")) first++;
+    if (first + oldTokens.size() > tokens.size()) return false;
+    for (size_t i = 0; i < oldTokens.size(); i++) {
+        const Token& expected = oldTokens[i];
+        const Token& token = tokens[first + i];
+        if (token.type != expected.type || token.value != expected.value ||
+            token.offset != (int)textStart + expected.offset || token.length != expected.length) {
+            return false;
+        }
+    }
+
+    edit.brackets = !sameBrackets(oldTokens, newTokens);
+    int line = tokens[first].line;
+    for (Token& token : newTokens) {
+        token.line = line;
+        token.offset += textStart;
+    }
+    // Overwrite in place and move the tail only when the token count changes
+    size_t removed = oldTokens.size(), inserted = newTokens.size();
+    size_t common = min(removed, inserted);
+    move(newTokens.begin(), newTokens.begin() + common, tokens.begin() + first);
+    if (removed > inserted) {
+        tokens.erase(tokens.begin() + first + common, tokens.begin() + first + removed);
+    } else {
+        tokens.insert(tokens.begin() + first + common, newTokens.begin() + common, newTokens.end());
+    }
+    int delta = (int)insertedLength - (int)replacedText.size();
+    if (delta != 0) {
+        for (size_t i = first + inserted; i < tokens.size(); i++) tokens[i].offset += delta;
+    }
+
+    // The edit covers the line's INDENT or DEDENTs too: an INDENT sits at the
+    // line's first token, which may have moved
+    size_t lead = first;
+    while (lead > 0 && (tokens[lead - 1].type == "INDENT" || tokens[lead - 1].type == "DEDENT")) {
+        lead--;
+        if (tokens[lead].type == "INDENT") tokens[lead].offset = tokens[first].offset;
+    }
+    edit.first = lead;
+    edit.removed = first - lead + removed;
+    edit.inserted = first - lead + inserted;
+    return true;
+}
+
+bool updateMatchTable(vector<int>& matchTable, const TokenEdit& edit) {
+    if (edit.brackets) return false;
+    int delta = edit.inserted - edit.removed;
+    if (delta == 0) return true;
+    // The brackets sit at the same places in the old and new line, so their
+    // entries keep their position from edit.first
+    int after = edit.first + edit.removed;
+    vector<int> line(matchTable.begin() + edit.first, matchTable.begin() + after);
+    line.resize(edit.inserted, -1);
+    matchTable.erase(matchTable.begin() + edit.first, matchTable.begin() + after);
+    matchTable.insert(matchTable.begin() + edit.first, line.begin(), line.end());
+    for (int& match : matchTable) {
+        if (match >= after) match += delta;
+    }
+    return true;
+}
 
 void printHorizontalLine(int tokenColWidth, int valueColWidth, int lineColWidth) {
     cout << "+-" << string(tokenColWidth, '-') << "-+-" << string(valueColWidth, '-')
@@ -878,9 +1178,8 @@ void printTokenTable(const vector<Token>& tokens) {
     cout << "Total tokens: " << tokens.size() << endl << endl;
 }
 
-void generateSymbolTable(const vector<Token>& tokens) {
-    unordered_map<pair<string, string>, SymbolEntry, PairHash> symbolTable;
-    vector<pair<string, string>> symbolOrder; // To maintain the order of occurrence
+SymbolTable generateSymbolTable(const vector<Token>& tokens) {
+    SymbolTable symbolTable;  // declared entries keep the order of occurrence
     int currentId = 1;
 
     vector<string> scopeStack = {"global"};  // Stack to track current scope
@@ -919,20 +1218,16 @@ void generateSymbolTable(const vector<Token>& tokens) {
 
         // Process identifiers
         if (token.type == "IDENTIFIER") {
-            string currentScope = scopeStack.back();  // Get the current scope
-            pair<string, string> key = {token.value, currentScope};  // Composite key
+            const string& currentScope = scopeStack.back();  // Get the current scope
 
-            if (!isIdentifierInSymbolTable(symbolTable , token.value) && token.value != currentScope) {
+            if (!symbolTable.contains(token.value) && token.value != currentScope) {
                 // Add new identifier to the symbol table
-                symbolTable[key] = {currentId++, {token.line}, "unknown", "undefined", currentScope};
-                symbolOrder.push_back(key); // Record the order of occurrence
+                symbolTable.add(token.value, currentScope, declaration(currentId++, token, "unknown", currentScope));
             }
             else if(currentScope == "if" || currentScope == "for" || currentScope == "while" || currentScope == "elif" || currentScope == "else"){
-                SymbolEntry* entry = getEntryByScope(symbolTable , token.value , getHighestScope(symbolTable , token.value));
+                SymbolEntry* entry = symbolTable.find(token.value, symbolTable.latestScope(token.value));
                 if(entry != nullptr) {
-                    if(find(entry->lines.begin(), entry->lines.end(), token.line) == entry->lines.end()) {
-                        entry->lines.push_back(token.line);
-                    }
+                    addReference(*entry, token);
                 }
             }
             else if(token.value == currentScope && tokens[i - 1].value == "def") {
@@ -943,8 +1238,7 @@ void generateSymbolTable(const vector<Token>& tokens) {
                     previous_scope = scopeStack[scopeStack.size() - 2]; // Get the previous scope
                 }
 
-                symbolTable[key] = {currentId++, {token.line}, "function", "undefined", previous_scope};
-                symbolOrder.push_back(key); // Record the order of occurrence
+                symbolTable.add(token.value, currentScope, declaration(currentId++, token, "function", previous_scope));
             }
             else if(token.value == currentScope && tokens[i - 1].value == "class") {
                 // Class definition - add scope
@@ -954,8 +1248,7 @@ void generateSymbolTable(const vector<Token>& tokens) {
                     previous_scope = scopeStack[scopeStack.size() - 2]; // Get the previous scope
                 }
 
-                symbolTable[key] = {currentId++, {token.line}, "class", "undefined", previous_scope};
-                symbolOrder.push_back(key); // Record the order of occurrence
+                symbolTable.add(token.value, currentScope, declaration(currentId++, token, "class", previous_scope));
 
             }
             else{
@@ -964,17 +1257,13 @@ void generateSymbolTable(const vector<Token>& tokens) {
                 // if (find(entry.lines.begin(), entry.lines.end(), token.line) == entry.lines.end()) {
                     //     entry.lines.push_back(token.line);
                     // }
-                SymbolEntry* entry = getEntryByScope(symbolTable , token.value , currentScope);
-                string highest_scope = getHighestScope(symbolTable , token.value);
+                SymbolEntry* entry = symbolTable.find(token.value, currentScope);
                 if(entry != nullptr) {
-                    if(find(entry->lines.begin(), entry->lines.end(), token.line) == entry->lines.end()) {
-                        entry->lines.push_back(token.line);
-                    }
+                    addReference(*entry, token);
                 }
                 else {
                     // If the identifier is not found in the current scope, add it
-                    symbolTable[key] = {currentId++, {token.line}, "unknown", "undefined", currentScope};
-                    symbolOrder.push_back(key); // Record the order of occurrence
+                    symbolTable.add(token.value, currentScope, declaration(currentId++, token, "unknown", currentScope));
                 }
 
             }
@@ -982,95 +1271,122 @@ void generateSymbolTable(const vector<Token>& tokens) {
 
         // Handle assignments to infer types and values
         if (token.type == "IDENTIFIER" && i + 1 < tokens.size() && tokens[i + 1].value == "=") {
-            string identifier = token.value;
-            string currentScope = scopeStack.back();
-            pair<string, string> key = {identifier, currentScope};
+            SymbolEntry& entry = symbolTable.at(token.value, scopeStack.back());
 
             const Token& valueToken = tokens[i + 2];
             if (valueToken.type == "NUMBER") {
-                symbolTable[key].type = "numeric";
-                symbolTable[key].value = valueToken.value;
+                entry.type = "numeric";
+                entry.value = valueToken.value;
             } else if (valueToken.type == "STRING_LITERAL") {
-                symbolTable[key].type = "string";
-                symbolTable[key].value = valueToken.value;
+                entry.type = "string";
+                entry.value = valueToken.value;
             } else if (valueToken.value == "True" || valueToken.value == "False") {
-                symbolTable[key].type = "boolean";
-                symbolTable[key].value = valueToken.value;
+                entry.type = "boolean";
+                entry.value = valueToken.value;
             }
         }
 
         // Handle built-in functions
         if (token.type == "IDENTIFIER" && (token.value == "print" || token.value == "format")) {
-            string currentScope = scopeStack.back();
-            pair<string, string> key = {token.value, currentScope};
+            const string& currentScope = scopeStack.back();
 
-            if (symbolTable.find(key) == symbolTable.end()) {
-                symbolTable[key] = {currentId++, {token.line}, "builtin_function", "undefined", currentScope};
-                symbolOrder.push_back(key); // Record the order of occurrence
+            if (symbolTable.find(token.value, currentScope) == nullptr) {
+                symbolTable.add(token.value, currentScope, declaration(currentId++, token, "builtin_function", currentScope));
             }
         }
     }
 
-    // Print the symbol table
-    cout << "\nSYMBOL TABLE (With Scope)\n";
-    cout << "---------------------------------------------\n";
+    symbolTable.finish();
+    return symbolTable;
+}
+
+// Pads s to width with spaces, on the right or (for right alignment) the left.
+static void appendPadded(string& out, const string& s, size_t width, bool alignRight = false) {
+    size_t pad = s.size() < width ? width - s.size() : 0;
+    if (alignRight) out.append(pad, ' ');
+    out += s;
+    if (!alignRight) out.append(pad, ' ');
+}
 
-    if (symbolTable.empty()) {
-        cout << "No identifiers found in the code.\n";
+// Formats the declared symbols as a table. The whole table is built in
+// memory and written with a single call.
+void printSymbolTable(const SymbolTable& table, ostream& stream) {
+    string out = "\nSYMBOL TABLE (With Scope)\n";
+    out += "---------------------------------------------\n";
+
+    if (table.empty()) {
+        out += "No identifiers found in the code.\n";
+        stream.write(out.data(), out.size());
         return;
     }
 
     // Calculate column widths
-    int idColWidth = 5;
-    int nameColWidth = 20;
-    int typeColWidth = 15;
-    int valueColWidth = 20;
-    int scopeColWidth = 15;
-    int linesColWidth = 30;
-
-    for (const auto& key : symbolOrder) {
-        const auto& entry = symbolTable[key];
-        if (key.first.length() > nameColWidth) nameColWidth = key.first.length();
-        if (entry.type.length() > typeColWidth) typeColWidth = entry.type.length();
-        if (entry.value.length() > valueColWidth) valueColWidth = entry.value.length();
-        if (entry.scope.length() > scopeColWidth) scopeColWidth = entry.scope.length();
+    size_t idColWidth = 5;
+    size_t nameColWidth = 20;
+    size_t typeColWidth = 15;
+    size_t valueColWidth = 20;
+    size_t scopeColWidth = 15;
+    size_t linesColWidth = 30;
+
+    for (const SymbolTable::Symbol& symbol : table) {
+        nameColWidth = max(nameColWidth, symbol.name.length());
+        typeColWidth = max(typeColWidth, symbol.entry.type.length());
+        valueColWidth = max(valueColWidth, symbol.entry.value.length());
+        scopeColWidth = max(scopeColWidth, symbol.entry.scope.length());
     }
 
+    string rule = "+-" + string(idColWidth, '-') + "-+-" + string(nameColWidth, '-') +
+                  "-+-" + string(typeColWidth, '-') + "-+-" + string(valueColWidth, '-') +
+                  "-+-" + string(scopeColWidth, '-') + "-+-" + string(linesColWidth, '-') + "-+\n";
+    size_t rowWidth = rule.size();
+    out.reserve(out.size() + rowWidth * (table.declaredCount() + 5));
+
     // Print table header
-    cout << "+-" << string(idColWidth, '-') << "-+-" << string(nameColWidth, '-')
-         << "-+-" << string(typeColWidth, '-') << "-+-" << string(valueColWidth, '-')
-         << "-+-" << string(scopeColWidth, '-') << "-+-" << string(linesColWidth, '-') << "-+" << endl;
-    cout << "| " << left << setw(idColWidth) << "ID" << " | "
-         << setw(nameColWidth) << "IDENTIFIER" << " | "
-         << setw(typeColWidth) << "TYPE" << " | "
-         << setw(valueColWidth) << "VALUE" << " | "
-         << setw(scopeColWidth) << "SCOPE" << " | "
-         << setw(linesColWidth) << "LINES" << " |" << endl;
-    cout << "+-" << string(idColWidth, '-') << "-+-" << string(nameColWidth, '-')
-         << "-+-" << string(typeColWidth, '-') << "-+-" << string(valueColWidth, '-')
-         << "-+-" << string(scopeColWidth, '-') << "-+-" << string(linesColWidth, '-') << "-+" << endl;
+    out += rule;
+    out += "| ";
+    appendPadded(out, "ID", idColWidth);
+    out += " | ";
+    appendPadded(out, "IDENTIFIER", nameColWidth);
+    out += " | ";
+    appendPadded(out, "TYPE", typeColWidth);
+    out += " | ";
+    appendPadded(out, "VALUE", valueColWidth);
+    out += " | ";
+    appendPadded(out, "SCOPE", scopeColWidth);
+    out += " | ";
+    appendPadded(out, "LINES", linesColWidth);
+    out += " |\n";
+    out += rule;
 
     // Print table rows in order of occurrence
-    for (const auto& key : symbolOrder) {
-        const auto& entry = symbolTable[key];
-        string linesStr;
-        for (size_t i = 0; i < entry.lines.size(); i++) {
-            if (i > 0) linesStr += ", ";
-            linesStr += to_string(entry.lines[i]);
+    string linesStr;
+    for (const SymbolTable::Symbol& symbol : table) {
+        const SymbolEntry& entry = symbol.entry;
+        linesStr.clear();
+        for (size_t j = 0; j < entry.lines.size(); j++) {
+            if (j > 0) linesStr += ", ";
+            linesStr += to_string(entry.lines[j]);
         }
 
-        cout << "| " << right << setw(idColWidth) << entry.id << " | "
-             << left << setw(nameColWidth) << key.first << " | "
-             << setw(typeColWidth) << entry.type << " | "
-             << setw(valueColWidth) << entry.value << " | "
-             << setw(scopeColWidth) << entry.scope << " | "
-             << setw(linesColWidth) << linesStr << " |" << endl;
+        out += "| ";
+        appendPadded(out, to_string(entry.id), idColWidth, true);
+        out += " | ";
+        appendPadded(out, symbol.name, nameColWidth);
+        out += " | ";
+        appendPadded(out, entry.type, typeColWidth);
+        out += " | ";
+        appendPadded(out, entry.value, valueColWidth);
+        out += " | ";
+        appendPadded(out, entry.scope, scopeColWidth);
+        out += " | ";
+        appendPadded(out, linesStr, linesColWidth);
+        out += " |\n";
     }
 
-    cout << "+-" << string(idColWidth, '-') << "-+-" << string(nameColWidth, '-')
-         << "-+-" << string(typeColWidth, '-') << "-+-" << string(valueColWidth, '-')
-         << "-+-" << string(scopeColWidth, '-') << "-+-" << string(linesColWidth, '-') << "-+" << endl;
-    cout << "Total identifiers: " << symbolTable.size() << endl << endl;
+    out += rule;
+    out += "Total identifiers: " + to_string(table.declaredCount()) + "\n\n";
+    stream.write(out.data(), out.size());
+    stream.flush();
 }
 
 // int main() {
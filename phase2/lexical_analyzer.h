@@ -1,11 +1,15 @@
 #ifndef LEXICAL_ANALYZER_H
 #define LEXICAL_ANALYZER_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
+#include <deque>
+#include <ostream>
+#include "identifier_table.h"
 
 
 // Token structure
@@ -13,6 +17,14 @@ struct Token {
     std::string type;  // Type of the token (e.g., KEYWORD, IDENTIFIER, etc.)
     std::string value; // Value of the token
     int line;          // Line number where the token appears
+    int offset = -1;   // Byte offset of the token in the source, -1 if unknown
+    int length = 0;    // Bytes it spans; 0 for INDENT/DEDENT
+};
+
+// One occurrence of a symbol's name in the source.
+struct SymbolReference {
+    int line;
+    int offset;     // byte offset of the token, -1 if unknown
 };
 
 // Symbol table entry structure
@@ -22,22 +34,111 @@ struct SymbolEntry {
     std::string type = "unknown";  // Data type
     std::string value = "undefined";  // Assigned value
     std::string scope = "global";    // Scope of the identifier
+    std::vector<SymbolReference> references;  // Every occurrence, in source order
 };
 
-// Custom hash function for std::pair
-struct PairHash {
-    template <typename T1, typename T2>
-    size_t operator()(const std::pair<T1, T2>& p) const {
-        auto hash1 = std::hash<T1>{}(p.first);
-        auto hash2 = std::hash<T2>{}(p.second);
-        return hash1 ^ (hash2 << 1); // Combine the two hashes
-    }
+// Symbols keyed by (name, scope), as built by generateSymbolTable(). Names
+// and scopes are interned, and the pair of IDs is packed into one 64-bit key,
+// so a lookup hashes each string once and probes a flat table. Each name also
+// lists the scopes it was entered in and each line the symbols used on it.
+// Entries never move once created.
+class SymbolTable {
+public:
+    struct Symbol {
+        std::string name;
+        std::string scope;      // scope the symbol is keyed under
+        SymbolEntry entry;
+    };
+
+    // Iterates the declared symbols in order of first occurrence.
+    class const_iterator {
+    public:
+        const_iterator(const SymbolTable* table, size_t i) : table(table), i(i) {}
+        const Symbol& operator*() const { return table->slots[table->listed[i]]; }
+        const Symbol* operator->() const { return &**this; }
+        const_iterator& operator++() { ++i; return *this; }
+        bool operator!=(const const_iterator& other) const { return i != other.i; }
+        bool operator==(const const_iterator& other) const { return i == other.i; }
+    private:
+        const SymbolTable* table;
+        size_t i;
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, listed.size()); }
+    size_t declaredCount() const { return listed.size(); }
+
+    // Every entry, including ones only assigned to and never declared.
+    size_t size() const { return slots.size(); }
+    bool empty() const { return slots.empty(); }
+
+    // Entry for (name, scope), or null.
+    SymbolEntry* find(const std::string& name, const std::string& scope);
+    const SymbolEntry* find(const std::string& name, const std::string& scope) const;
+
+    // Entries for name in every scope, in creation order.
+    std::vector<const Symbol*> lookup(const std::string& name) const;
+
+    // Entries used on line, in creation order. Valid once finish() has run.
+    std::vector<const Symbol*> symbolsOnLine(int line) const;
+
+    bool contains(const std::string& name) const;
+
+    // Last non-global scope name was entered in, or "global".
+    const std::string& latestScope(const std::string& name) const;
+
+    // First entry for name walking scopeStack from innermost to outermost;
+    // O(scope depth).
+    SymbolEntry* resolve(const std::string& name, const std::vector<std::string>& scopeStack);
+
+    // Building. add() stores entry under (name, scope) and declares it,
+    // replacing the entry but keeping the place of an earlier declaration;
+    // at() returns the entry, created empty and undeclared if missing.
+    void add(const std::string& name, const std::string& scope, const SymbolEntry& entry);
+    SymbolEntry& at(const std::string& name, const std::string& scope);
+
+    // Indexes lines; called once the table is complete.
+    void finish();
+
+    // Table slots find(name, scope) examines, for benchmarks.
+    size_t keyProbes(const std::string& name, const std::string& scope) const;
+
+private:
+    std::deque<Symbol> slots;
+    IdentifierInterner identifiers;                 // names and scopes
+    PackedKeyMap<size_t> slotOf;                    // pack_key(name, scope) -> slot
+    std::vector<std::vector<size_t>> slotsByName;   // by name ID, in creation order
+    std::unordered_map<int, std::vector<size_t>> slotsByLine;
+    std::vector<size_t> listed;                     // declared slots, each once
+    std::vector<bool> declared;                     // by slot: in listed
+
+    size_t slotFor(const std::string& name, const std::string& scope);
+    const std::vector<size_t>* slotsNamed(const std::string& name) const;
 };
 
 // Function declarations
 std::vector<Token> tokenize(const std::string& source);
-void generateSymbolTable(const std::vector<Token>& tokens);
+std::vector<int> buildMatchTable(const std::vector<Token>& tokens);
+
+// Incremental relexing. relexEdit() updates tokens after replacedText at
+// offset was replaced by the insertedLength bytes now there in source,
+// lexing only the edited line. It returns false and leaves tokens alone if
+// the edit could change other lines (newlines, indentation, continuations,
+// triple-quoted or unclosed strings); relex the whole source then.
+struct TokenEdit {
+    int first = 0;          // index of the first replaced token
+    int removed = 0;        // tokens replaced
+    int inserted = 0;       // tokens now in their place
+    bool brackets = false;  // brackets were added, removed or moved
+};
+bool relexEdit(const std::string& source, std::vector<Token>& tokens, size_t offset,
+               const std::string& replacedText, size_t insertedLength, TokenEdit& edit);
+// Applies a relexEdit() to the match table; false if it must be rebuilt.
+bool updateMatchTable(std::vector<int>& matchTable, const TokenEdit& edit);
+
+SymbolTable generateSymbolTable(const std::vector<Token>& tokens);
 void printTokenTable(const std::vector<Token>& tokens);
+void printSymbolTable(const SymbolTable& table, std::ostream& out);
 
 bool isKeyword(const std::string& str);
 bool isOperator(const std::string& str);
@@ -45,4 +146,16 @@ bool isDelimiter(const std::string& str);
 bool isIdentifier(const std::string& str);
 bool isNumber(const std::string& str);
 
+// Value of a NUMBER token. An int that does not fit in 64 bits keeps its
+// kind but is marked overflowed and has no value.
+struct NumericLiteral {
+    enum Kind : uint8_t { INT, FLOAT, COMPLEX } kind = INT;
+    int64_t intValue = 0;
+    double floatValue = 0;      // FLOAT value, or the imaginary part of a COMPLEX
+    bool overflowed = false;
+};
+
+// False if str is not a number the lexer accepts.
+bool decodeNumber(const std::string& str, NumericLiteral& literal);
+
 #endif // LEXICAL_ANALYZER_H
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "ll1_parser.h"
+#include "ll1_table.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+
+// One input symbol. A token can match a quoted terminal by value and a token
+// class by type (an IDENTIFIER named "int" is both 'int' and IDENTIFIER).
+struct InputSymbol {
+    int valueTerminal;
+    int typeTerminal;
+    int token;           // index into tokens, -1 for end of input
+    string value;        // leaf text; whole literal for strings
+};
+
+struct TerminalIds {
+    unordered_map<string, int> byValue;
+    unordered_map<string, int> byType;
+
+    TerminalIds() {
+        for (int i = 1; i < ll1::TERMINAL_COUNT; i++) {
+            string name = ll1::SYMBOL_NAMES[i];
+            if (name.size() >= 2 && name.front() == '\'') {
+                byValue[name.substr(1, name.size() - 2)] = i;
+            } else {
+                byType[name] = i;
+            }
+        }
+    }
+
+    int value(const string& v) const {
+        auto it = byValue.find(v);
+        return it == byValue.end() ? -1 : it->second;
+    }
+    int type(const string& t) const {
+        auto it = byType.find(t);
+        return it == byType.end() ? -1 : it->second;
+    }
+};
+
+// The grammar sees a string literal as one STRING terminal, while the lexer
+// emits quote, text and quote tokens.
+vector<InputSymbol> classify(const vector<Token>& tokens, const TerminalIds& ids) {
+    vector<InputSymbol> input;
+    input.reserve(tokens.size() + 1);
+    int stringTerminal = ids.type("STRING");
+    for (int i = 0; i < (int)tokens.size(); i++) {
+        const Token& tok = tokens[i];
+        if (tok.type == "STRING_QUOTE") {
+            string text;
+            int start = i++;
+            while (i < (int)tokens.size() && tokens[i].type != "STRING_QUOTE") {
+                if (tokens[i].type == "STRING_LITERAL") text += tokens[i].value;
+                i++;
+            }
+            input.push_back({-1, stringTerminal, start, text});
+            continue;
+        }
+        input.push_back({ids.value(tok.value), ids.type(tok.type), i, tok.value});
+    }
+    input.push_back({-1, ll1::END_OF_INPUT, -1, ""});
+    return input;
+}
+
+int predict(int nonterminal, const InputSymbol& lookahead, const InputSymbol& next) {
+    const int* row = ll1::PARSE_TABLE[nonterminal - ll1::TERMINAL_COUNT];
+    int cell = ll1::NO_PRODUCTION;
+    if (lookahead.valueTerminal >= 0) cell = row[lookahead.valueTerminal];
+    if (cell == ll1::NO_PRODUCTION && lookahead.typeTerminal >= 0) cell = row[lookahead.typeTerminal];
+    if (cell > ll1::SECOND_TOKEN_BASE) return cell;
+
+    int k = ll1::SECOND_TOKEN_BASE - cell;
+    for (int e = ll1::SECOND_TOKEN_START[k]; e < ll1::SECOND_TOKEN_START[k + 1]; e++) {
+        int terminal = ll1::SECOND_TOKEN_ENTRIES[e].terminal;
+        if (terminal == next.valueTerminal || terminal == next.typeTerminal) {
+            return ll1::SECOND_TOKEN_ENTRIES[e].production;
+        }
+    }
+    return ll1::SECOND_TOKEN_DEFAULT[k];
+}
+
+string describe(const vector<Token>& tokens, const InputSymbol& symbol) {
+    if (symbol.token < 0) return "end of input";
+    const Token& tok = tokens[symbol.token];
+    return "Line " + to_string(tok.line) + ": " + tok.type + " '" + symbol.value + "'";
+}
+
+} // namespace
+
+shared_ptr<ParseTreeNode> ll1_parse(const vector<Token>& tokens, string& error) {
+    static const TerminalIds ids;
+    vector<InputSymbol> input = classify(tokens, ids);
+
+    struct Frame {
+        int symbol;
+        ParseTreeNode* parent;
+    };
+    auto root = make_shared<ParseTreeNode>("parse");
+    vector<Frame> stack = {{ll1::START_SYMBOL, root.get()}};
+    size_t pos = 0;
+
+    while (!stack.empty()) {
+        Frame frame = stack.back();
+        stack.pop_back();
+        const InputSymbol& lookahead = input[pos];
+
+        if (frame.symbol < ll1::TERMINAL_COUNT) {
+            if (frame.symbol != lookahead.valueTerminal && frame.symbol != lookahead.typeTerminal) {
+                error = describe(tokens, lookahead) + ": expected " + ll1::SYMBOL_NAMES[frame.symbol];
+                return nullptr;
+            }
+            if (lookahead.token >= 0) {
+                const Token& tok = tokens[lookahead.token];
+                string type = tok.type == "STRING_QUOTE" ? "STRING" : tok.type;
+                frame.parent->addChild(make_shared<ParseTreeNode>(type, lookahead.value));
+            }
+            pos++;
+            continue;
+        }
+
+        const InputSymbol& next = input[pos + 1 < input.size() ? pos + 1 : pos];
+        int production = predict(frame.symbol, lookahead, next);
+        if (production < 0) {
+            error = describe(tokens, lookahead) + ": unexpected while parsing " + ll1::SYMBOL_NAMES[frame.symbol];
+            return nullptr;
+        }
+        int first = ll1::PRODUCTION_START[production];
+        int last = ll1::PRODUCTION_START[production + 1];
+        if (first == last) {
+            continue;  // ε: no node, as the hand-written parser omits empty tails
+        }
+        auto node = make_shared<ParseTreeNode>(ll1::SYMBOL_NAMES[frame.symbol]);
+        frame.parent->addChild(node);
+        for (int i = last - 1; i >= first; i--) {
+            stack.push_back({ll1::PRODUCTION_SYMBOLS[i], node.get()});
+        }
+    }
+
+    if (input[pos].typeTerminal != ll1::END_OF_INPUT) {
+        error = describe(tokens, input[pos]) + ": expected end of input";
+        return nullptr;
+    }
+    return root->children.empty() ? nullptr : root->children[0];
+}
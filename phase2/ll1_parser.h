@@ -0,0 +1,14 @@
+#ifndef LL1_PARSER_H
+#define LL1_PARSER_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+
+// Table-driven predictive parser over the tables grammar_compiler generates
+// into ll1_table.h. Interior nodes are named after grammar rules, leaves after
+// token types. Stops at the first syntax error: returns nullptr and sets error.
+// It accepts only the language of GrammarRules.txt: imports, classes, del
+// and subscripted assignment targets are left to the hand-written parser.
+shared_ptr<ParseTreeNode> ll1_parse(const vector<Token>& tokens, string& error);
+
+#endif // LL1_PARSER_H
@@ -0,0 +1,345 @@
+// Generated by grammar_compiler from GrammarRules.txt. Do not edit.
+// Regenerate with: ./grammar_compiler GrammarRules.txt -o ll1_table.h
+
+#ifndef LL1_TABLE_H
+#define LL1_TABLE_H
+
+namespace ll1 {
+
+struct SecondTokenEntry {
+    int terminal;
+    int production;
+};
+
+const int TERMINAL_COUNT = 75;
+const int NONTERMINAL_COUNT = 65;
+const int START_SYMBOL = 75;  // program
+const int END_OF_INPUT = 0;  // $
+
+// Terminals, then nonterminals. Quoted terminals match the token value,
+// the others the token type.
+const char* const SYMBOL_NAMES[] = {
+    "$",
+    "'!='",
+    "'%'",
+    "'%='",
+    "'&'",
+    "'&='",
+    "'('",
+    "')'",
+    "'*'",
+    "'**'",
+    "'**='",
+    "'*='",
+    "'+'",
+    "'+='",
+    "','",
+    "'-'",
+    "'-='",
+    "'->'",
+    "'/'",
+    "'//'",
+    "'//='",
+    "'/='",
+    "':'",
+    "'<'",
+    "'<<'",
+    "'<<='",
+    "'<='",
+    "'='",
+    "'=='",
+    "'>'",
+    "'>='",
+    "'>>'",
+    "'>>='",
+    "'False'",
+    "'None'",
+    "'True'",
+    "'['",
+    "']'",
+    "'^'",
+    "'^='",
+    "'and'",
+    "'as'",
+    "'bool'",
+    "'break'",
+    "'continue'",
+    "'def'",
+    "'elif'",
+    "'else'",
+    "'except'",
+    "'finally'",
+    "'float'",
+    "'for'",
+    "'if'",
+    "'in'",
+    "'int'",
+    "'is'",
+    "'not'",
+    "'or'",
+    "'pass'",
+    "'return'",
+    "'str'",
+    "'try'",
+    "'while'",
+    "'yield'",
+    "'{'",
+    "'|'",
+    "'|='",
+    "'}'",
+    "'~'",
+    "DEDENT",
+    "IDENTIFIER",
+    "INDENT",
+    "NEWLINE",
+    "NUMBER",
+    "STRING",
+    "program",
+    "statement",
+    "assignment",
+    "augmented_assignment",
+    "aug_assign_op",
+    "return_stmt",
+    "yield_stmt",
+    "yield_value_opt",
+    "if_stmt",
+    "elif_parts",
+    "else_part",
+    "while_stmt",
+    "for_stmt",
+    "else_part_opt",
+    "call_stmt",
+    "func_call",
+    "argument_list",
+    "argument_list_prime",
+    "func_def",
+    "return_type_opt",
+    "param_list",
+    "param_list_prime",
+    "param",
+    "type",
+    "statement_list",
+    "expression",
+    "inline_if_else_opt",
+    "or_expr",
+    "or_expr_prime",
+    "and_expr",
+    "and_expr_prime",
+    "not_expr",
+    "comparison",
+    "comparison_prime",
+    "comp_op",
+    "is_not_opt",
+    "bitor_expr",
+    "bitor_expr_prime",
+    "bitxor_expr",
+    "bitxor_expr_prime",
+    "bitand_expr",
+    "bitand_expr_prime",
+    "shift_expr",
+    "shift_expr_prime",
+    "arith_expr",
+    "arith_expr_prime",
+    "term",
+    "term_prime",
+    "unary_expr",
+    "power",
+    "power_tail",
+    "factor",
+    "list_literal",
+    "list_items",
+    "list_items_prime",
+    "dict_literal",
+    "dict_items",
+    "dict_items_prime",
+    "dict_pair",
+    "try_stmt",
+    "except_clauses",
+    "except_clause",
+    "exception_type_opt",
+    "exception_var_opt",
+    "finally_clause",
+};
+
+const int PRODUCTION_COUNT = 152;
+const int PRODUCTION_LHS[] = {
+    75, 75, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76, 76,
+    77, 78, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 79, 80, 81,
+    82, 82, 83, 84, 84, 85, 85, 86, 87, 88, 88, 89, 90, 91, 91, 92,
+    92, 93, 94, 94, 95, 95, 96, 96, 97, 97, 98, 98, 98, 98, 98, 99,
+    99, 100, 101, 101, 102, 103, 103, 104, 105, 105, 106, 106, 107, 108, 108, 109,
+    109, 109, 109, 109, 109, 109, 109, 109, 110, 110, 111, 112, 112, 113, 114, 114,
+    115, 116, 116, 117, 118, 118, 118, 119, 120, 120, 120, 121, 122, 122, 122, 122,
+    122, 123, 123, 123, 123, 124, 125, 125, 126, 126, 126, 126, 126, 126, 126, 126,
+    126, 126, 126, 127, 128, 128, 129, 129, 130, 131, 131, 132, 132, 133, 134, 135,
+    135, 136, 137, 137, 138, 138, 139, 139,
+};
+
+// Right-hand side of production i is PRODUCTION_SYMBOLS[PRODUCTION_START[i] .. PRODUCTION_START[i + 1])
+const int PRODUCTION_START[] = {
+    0, 2, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 14, 16, 18,
+    19, 23, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 42,
+    45, 46, 46, 55, 63, 63, 69, 69, 76, 86, 92, 92, 94, 98, 100, 100,
+    103, 103, 114, 116, 116, 118, 118, 121, 121, 122, 125, 126, 127, 128, 129, 130,
+    132, 132, 134, 138, 138, 140, 143, 143, 145, 148, 148, 150, 151, 153, 156, 156,
+    157, 158, 159, 160, 161, 162, 163, 165, 167, 168, 168, 170, 173, 173, 175, 178,
+    178, 180, 183, 183, 185, 188, 191, 191, 193, 196, 199, 199, 201, 204, 207, 210,
+    213, 213, 215, 217, 219, 220, 222, 224, 224, 227, 228, 232, 233, 234, 235, 236,
+    237, 238, 239, 240, 243, 245, 245, 248, 248, 251, 253, 253, 256, 256, 259, 267,
+    269, 269, 277, 278, 278, 280, 280, 286, 286,
+};
+
+const int PRODUCTION_SYMBOLS[] = {
+    76, 75, 77, 78, 80, 81, 83, 86, 87, 89, 93, 134, 58, 72, 43, 72,
+    44, 72, 72, 70, 27, 100, 72, 70, 79, 100, 72, 13, 16, 11, 21, 3,
+    20, 10, 5, 66, 39, 25, 32, 59, 100, 72, 63, 82, 72, 100, 52, 100,
+    22, 72, 71, 99, 69, 84, 85, 46, 100, 22, 72, 71, 99, 69, 84, 47,
+    22, 72, 71, 99, 69, 62, 100, 22, 72, 71, 99, 69, 51, 70, 53, 100,
+    22, 72, 71, 99, 69, 88, 47, 22, 72, 71, 99, 69, 90, 72, 70, 6,
+    91, 7, 100, 92, 14, 100, 92, 45, 70, 6, 95, 7, 94, 22, 72, 71,
+    99, 69, 17, 98, 97, 96, 14, 97, 96, 70, 70, 27, 100, 54, 50, 60,
+    42, 34, 76, 99, 102, 101, 52, 100, 47, 100, 104, 103, 57, 104, 103, 106,
+    105, 40, 106, 105, 56, 106, 107, 111, 108, 109, 111, 108, 28, 1, 23, 26,
+    29, 30, 53, 56, 53, 55, 110, 56, 113, 112, 65, 113, 112, 115, 114, 38,
+    115, 114, 117, 116, 4, 117, 116, 119, 118, 24, 119, 118, 31, 119, 118, 121,
+    120, 12, 121, 120, 15, 121, 120, 123, 122, 8, 123, 122, 18, 123, 122, 19,
+    123, 122, 2, 123, 122, 15, 123, 12, 123, 68, 123, 124, 126, 125, 9, 123,
+    6, 100, 7, 70, 70, 36, 100, 37, 73, 35, 33, 34, 74, 127, 130, 90,
+    36, 128, 37, 100, 129, 14, 100, 129, 64, 131, 67, 133, 132, 14, 133, 132,
+    74, 22, 100, 61, 22, 72, 71, 99, 69, 135, 139, 136, 135, 48, 137, 138,
+    22, 72, 71, 99, 69, 100, 41, 70, 49, 22, 72, 71, 99, 69,
+};
+
+// PARSE_TABLE[nonterminal][terminal]: production to expand, NO_PRODUCTION,
+// or SECOND_TOKEN_BASE - k to choose with the next token via cell k.
+const int NO_PRODUCTION = -1;
+const int SECOND_TOKEN_BASE = -2;
+const int PARSE_TABLE[NONTERMINAL_COUNT][TERMINAL_COUNT] = {
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, -1, -1, -1, -1, -1, 0, 0, -1, -1, -1, -1, -1, 0, 0, -1, 0, 0, 0, -1, -1, -1, -1, -1, -1, 0, -1, 0, -1, -1},  // program
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 13, 14, 10, -1, -1, -1, -1, -1, 8, 6, -1, -1, -1, -1, -1, 12, 4, -1, 11, 7, 5, -1, -1, -1, -1, -1, -1, -2, -1, 15, -1, -1},  // statement
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 16, -1, -1, -1, -1},  // assignment
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 17, -1, -1, -1, -1},  // augmented_assignment
+    {-1, -1, -1, 22, -1, 25, -1, -1, -1, -1, 24, 20, -1, 18, -1, -1, 19, -1, -1, -1, 23, 21, -1, -1, -1, 28, -1, -1, -1, -1, -1, -1, 29, -1, -1, -1, -1, -1, -1, 27, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 26, -1, -1, -1, -1, -1, -1, -1, -1},  // aug_assign_op
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 30, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // return_stmt
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 31, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // yield_stmt
+    {-1, -1, -1, -1, -1, -1, 32, -1, -1, -1, -1, -1, 32, -1, -1, 32, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 32, 32, 32, 32, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 32, -1, -1, -1, -1, -1, -1, -1, 32, -1, -1, -1, 32, -1, 32, -1, 33, 32, 32},  // yield_value_opt
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 34, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // if_stmt
+    {36, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 36, 36, 36, 35, 36, -1, -1, -1, 36, 36, -1, -1, -1, -1, -1, 36, 36, -1, 36, 36, 36, -1, -1, -1, -1, -1, 36, 36, -1, 36, -1, -1},  // elif_parts
+    {38, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 38, 38, 38, -1, 37, -1, -1, -1, 38, 38, -1, -1, -1, -1, -1, 38, 38, -1, 38, 38, 38, -1, -1, -1, -1, -1, 38, 38, -1, 38, -1, -1},  // else_part
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 39, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // while_stmt
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 40, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // for_stmt
+    {42, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 42, 42, 42, -1, 41, -1, -1, -1, 42, 42, -1, -1, -1, -1, -1, 42, 42, -1, 42, 42, 42, -1, -1, -1, -1, -1, 42, 42, -1, 42, -1, -1},  // else_part_opt
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 43, -1, -1, -1, -1},  // call_stmt
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 44, -1, -1, -1, -1},  // func_call
+    {-1, -1, -1, -1, -1, -1, 45, 46, -1, -1, -1, -1, 45, -1, -1, 45, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 45, 45, 45, 45, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 45, -1, -1, -1, -1, -1, -1, -1, 45, -1, -1, -1, 45, -1, 45, -1, -1, 45, 45},  // argument_list
+    {-1, -1, -1, -1, -1, -1, -1, 48, -1, -1, -1, -1, -1, -1, 47, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // argument_list_prime
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 49, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // func_def
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 50, -1, -1, -1, -1, 51, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // return_type_opt
+    {-1, -1, -1, -1, -1, -1, -1, 53, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 52, -1, -1, -1, -1},  // param_list
+    {-1, -1, -1, -1, -1, -1, -1, 55, -1, -1, -1, -1, -1, -1, 54, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // param_list_prime
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -3, -1, -1, -1, -1},  // param
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, -1, -1, -1, -1, 61, -1, -1, -1, -1, -1, -1, -1, 59, -1, -1, -1, 58, -1, -1, -1, -1, -1, 60, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // type
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 63, 63, 63, -1, -1, -1, -1, -1, 63, 63, -1, -1, -1, -1, -1, 63, 63, -1, 63, 63, 63, -1, -1, -1, -1, -1, 64, 63, -1, 63, -1, -1},  // statement_list
+    {-1, -1, -1, -1, -1, -1, 65, -1, -1, -1, -1, -1, 65, -1, -1, 65, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 65, 65, 65, 65, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 65, -1, -1, -1, -1, -1, -1, -1, 65, -1, -1, -1, 65, -1, 65, -1, -1, 65, 65},  // expression
+    {-1, -1, -1, -1, -1, -1, -1, 67, -1, -1, -1, -1, -1, -1, 67, -1, -1, -1, -1, -1, -1, -1, 67, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 67, -1, -1, -1, 67, -1, -1, -1, -1, -1, 67, -1, -1, -1, -1, 66, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 67, -1, -1, -1, -1, 67, -1, -1},  // inline_if_else_opt
+    {-1, -1, -1, -1, -1, -1, 68, -1, -1, -1, -1, -1, 68, -1, -1, 68, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 68, 68, 68, 68, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 68, -1, -1, -1, -1, -1, -1, -1, 68, -1, -1, -1, 68, -1, 68, -1, -1, 68, 68},  // or_expr
+    {-1, -1, -1, -1, -1, -1, -1, 70, -1, -1, -1, -1, -1, -1, 70, -1, -1, -1, -1, -1, -1, -1, 70, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 70, -1, -1, -1, 70, -1, -1, -1, -1, -1, 70, -1, -1, -1, -1, 70, -1, -1, -1, -1, 69, -1, -1, -1, -1, -1, -1, -1, -1, -1, 70, -1, -1, -1, -1, 70, -1, -1},  // or_expr_prime
+    {-1, -1, -1, -1, -1, -1, 71, -1, -1, -1, -1, -1, 71, -1, -1, 71, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 71, 71, 71, 71, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 71, -1, -1, -1, -1, -1, -1, -1, 71, -1, -1, -1, 71, -1, 71, -1, -1, 71, 71},  // and_expr
+    {-1, -1, -1, -1, -1, -1, -1, 73, -1, -1, -1, -1, -1, -1, 73, -1, -1, -1, -1, -1, -1, -1, 73, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 73, -1, -1, 72, 73, -1, -1, -1, -1, -1, 73, -1, -1, -1, -1, 73, -1, -1, -1, -1, 73, -1, -1, -1, -1, -1, -1, -1, -1, -1, 73, -1, -1, -1, -1, 73, -1, -1},  // and_expr_prime
+    {-1, -1, -1, -1, -1, -1, 75, -1, -1, -1, -1, -1, 75, -1, -1, 75, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 75, 75, 75, 75, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 74, -1, -1, -1, -1, -1, -1, -1, 75, -1, -1, -1, 75, -1, 75, -1, -1, 75, 75},  // not_expr
+    {-1, -1, -1, -1, -1, -1, 76, -1, -1, -1, -1, -1, 76, -1, -1, 76, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 76, 76, 76, 76, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 76, -1, -1, -1, 76, -1, 76, -1, -1, 76, 76},  // comparison
+    {-1, 77, -1, -1, -1, -1, -1, 78, -1, -1, -1, -1, -1, -1, 78, -1, -1, -1, -1, -1, -1, -1, 78, 77, -1, -1, 77, -1, 77, 77, 77, -1, -1, -1, -1, -1, -1, 78, -1, -1, 78, 78, -1, -1, -1, -1, -1, 78, -1, -1, -1, -1, 78, 77, -1, 77, 77, 78, -1, -1, -1, -1, -1, -1, -1, -1, -1, 78, -1, -1, -1, -1, 78, -1, -1},  // comparison_prime
+    {-1, 80, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 81, -1, -1, 82, -1, 79, 83, 84, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 85, -1, 87, 86, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // comp_op
+    {-1, -1, -1, -1, -1, -1, 89, -1, -1, -1, -1, -1, 89, -1, -1, 89, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 89, 89, 89, 89, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 88, -1, -1, -1, -1, -1, -1, -1, 89, -1, -1, -1, 89, -1, 89, -1, -1, 89, 89},  // is_not_opt
+    {-1, -1, -1, -1, -1, -1, 90, -1, -1, -1, -1, -1, 90, -1, -1, 90, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 90, 90, 90, 90, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 90, -1, -1, -1, 90, -1, 90, -1, -1, 90, 90},  // bitor_expr
+    {-1, 92, -1, -1, -1, -1, -1, 92, -1, -1, -1, -1, -1, -1, 92, -1, -1, -1, -1, -1, -1, -1, 92, 92, -1, -1, 92, -1, 92, 92, 92, -1, -1, -1, -1, -1, -1, 92, -1, -1, 92, 92, -1, -1, -1, -1, -1, 92, -1, -1, -1, -1, 92, 92, -1, 92, 92, 92, -1, -1, -1, -1, -1, -1, -1, 91, -1, 92, -1, -1, -1, -1, 92, -1, -1},  // bitor_expr_prime
+    {-1, -1, -1, -1, -1, -1, 93, -1, -1, -1, -1, -1, 93, -1, -1, 93, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 93, 93, 93, 93, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 93, -1, -1, -1, 93, -1, 93, -1, -1, 93, 93},  // bitxor_expr
+    {-1, 95, -1, -1, -1, -1, -1, 95, -1, -1, -1, -1, -1, -1, 95, -1, -1, -1, -1, -1, -1, -1, 95, 95, -1, -1, 95, -1, 95, 95, 95, -1, -1, -1, -1, -1, -1, 95, 94, -1, 95, 95, -1, -1, -1, -1, -1, 95, -1, -1, -1, -1, 95, 95, -1, 95, 95, 95, -1, -1, -1, -1, -1, -1, -1, 95, -1, 95, -1, -1, -1, -1, 95, -1, -1},  // bitxor_expr_prime
+    {-1, -1, -1, -1, -1, -1, 96, -1, -1, -1, -1, -1, 96, -1, -1, 96, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 96, 96, 96, 96, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 96, -1, -1, -1, 96, -1, 96, -1, -1, 96, 96},  // bitand_expr
+    {-1, 98, -1, -1, 97, -1, -1, 98, -1, -1, -1, -1, -1, -1, 98, -1, -1, -1, -1, -1, -1, -1, 98, 98, -1, -1, 98, -1, 98, 98, 98, -1, -1, -1, -1, -1, -1, 98, 98, -1, 98, 98, -1, -1, -1, -1, -1, 98, -1, -1, -1, -1, 98, 98, -1, 98, 98, 98, -1, -1, -1, -1, -1, -1, -1, 98, -1, 98, -1, -1, -1, -1, 98, -1, -1},  // bitand_expr_prime
+    {-1, -1, -1, -1, -1, -1, 99, -1, -1, -1, -1, -1, 99, -1, -1, 99, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 99, 99, 99, 99, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 99, -1, -1, -1, 99, -1, 99, -1, -1, 99, 99},  // shift_expr
+    {-1, 102, -1, -1, 102, -1, -1, 102, -1, -1, -1, -1, -1, -1, 102, -1, -1, -1, -1, -1, -1, -1, 102, 102, 100, -1, 102, -1, 102, 102, 102, 101, -1, -1, -1, -1, -1, 102, 102, -1, 102, 102, -1, -1, -1, -1, -1, 102, -1, -1, -1, -1, 102, 102, -1, 102, 102, 102, -1, -1, -1, -1, -1, -1, -1, 102, -1, 102, -1, -1, -1, -1, 102, -1, -1},  // shift_expr_prime
+    {-1, -1, -1, -1, -1, -1, 103, -1, -1, -1, -1, -1, 103, -1, -1, 103, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 103, 103, 103, 103, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 103, -1, -1, -1, 103, -1, 103, -1, -1, 103, 103},  // arith_expr
+    {-1, 106, -1, -1, 106, -1, -1, 106, -1, -1, -1, -1, 104, -1, 106, 105, -1, -1, -1, -1, -1, -1, 106, 106, 106, -1, 106, -1, 106, 106, 106, 106, -1, -1, -1, -1, -1, 106, 106, -1, 106, 106, -1, -1, -1, -1, -1, 106, -1, -1, -1, -1, 106, 106, -1, 106, 106, 106, -1, -1, -1, -1, -1, -1, -1, 106, -1, 106, -1, -1, -1, -1, 106, -1, -1},  // arith_expr_prime
+    {-1, -1, -1, -1, -1, -1, 107, -1, -1, -1, -1, -1, 107, -1, -1, 107, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 107, 107, 107, 107, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 107, -1, -1, -1, 107, -1, 107, -1, -1, 107, 107},  // term
+    {-1, 112, 111, -1, 112, -1, -1, 112, 108, -1, -1, -1, 112, -1, 112, 112, -1, -1, 109, 110, -1, -1, 112, 112, 112, -1, 112, -1, 112, 112, 112, 112, -1, -1, -1, -1, -1, 112, 112, -1, 112, 112, -1, -1, -1, -1, -1, 112, -1, -1, -1, -1, 112, 112, -1, 112, 112, 112, -1, -1, -1, -1, -1, -1, -1, 112, -1, 112, -1, -1, -1, -1, 112, -1, -1},  // term_prime
+    {-1, -1, -1, -1, -1, -1, 116, -1, -1, -1, -1, -1, 114, -1, -1, 113, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 116, 116, 116, 116, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 116, -1, -1, -1, 115, -1, 116, -1, -1, 116, 116},  // unary_expr
+    {-1, -1, -1, -1, -1, -1, 117, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 117, 117, 117, 117, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 117, -1, -1, -1, -1, -1, 117, -1, -1, 117, 117},  // power
+    {-1, 119, 119, -1, 119, -1, -1, 119, 119, 118, -1, -1, 119, -1, 119, 119, -1, -1, 119, 119, -1, -1, 119, 119, 119, -1, 119, -1, 119, 119, 119, 119, -1, -1, -1, -1, -1, 119, 119, -1, 119, 119, -1, -1, -1, -1, -1, 119, -1, -1, -1, -1, 119, 119, -1, 119, 119, 119, -1, -1, -1, -1, -1, -1, -1, 119, -1, 119, -1, -1, -1, -1, 119, -1, -1},  // power_tail
+    {-1, -1, -1, -1, -1, -1, 120, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 125, 126, 124, 128, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 129, -1, -1, -1, -1, -1, -4, -1, -1, 123, 127},  // factor
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 131, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // list_literal
+    {-1, -1, -1, -1, -1, -1, 132, -1, -1, -1, -1, -1, 132, -1, -1, 132, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 132, 132, 132, 132, 133, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 132, -1, -1, -1, -1, -1, -1, -1, 132, -1, -1, -1, 132, -1, 132, -1, -1, 132, 132},  // list_items
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 134, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 135, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // list_items_prime
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 136, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // dict_literal
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 138, -1, -1, -1, -1, -1, -1, 137},  // dict_items
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 139, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 140, -1, -1, -1, -1, -1, -1, -1},  // dict_items_prime
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 141},  // dict_pair
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 142, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // try_stmt
+    {144, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 144, 144, 144, -1, -1, 143, 144, -1, 144, 144, -1, -1, -1, -1, -1, 144, 144, -1, 144, 144, 144, -1, -1, -1, -1, -1, 144, 144, -1, 144, -1, -1},  // except_clauses
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 145, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // except_clause
+    {-1, -1, -1, -1, -1, -1, 146, -1, -1, -1, -1, -1, 146, -1, -1, 146, -1, -1, -1, -1, -1, -1, 147, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 146, 146, 146, 146, -1, -1, -1, -1, 147, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 146, -1, -1, -1, -1, -1, -1, -1, 146, -1, -1, -1, 146, -1, 146, -1, -1, 146, 146},  // exception_type_opt
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 149, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 148, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},  // exception_var_opt
+    {151, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 151, 151, 151, -1, -1, -1, 150, -1, 151, 151, -1, -1, -1, -1, -1, 151, 151, -1, 151, 151, 151, -1, -1, -1, -1, -1, 151, 151, -1, 151, -1, -1},  // finally_clause
+};
+
+// Second-token cell k: entries SECOND_TOKEN_START[k] .. SECOND_TOKEN_START[k + 1],
+// SECOND_TOKEN_DEFAULT[k] when none matches.
+const int SECOND_TOKEN_DEFAULT[] = { -1, -1, -1, };
+const int SECOND_TOKEN_START[] = { 0, 14, 17, 51, };
+const SecondTokenEntry SECOND_TOKEN_ENTRIES[] = {
+    {3, 3},  // '%='
+    {5, 3},  // '&='
+    {6, 9},  // '('
+    {10, 3},  // '**='
+    {11, 3},  // '*='
+    {13, 3},  // '+='
+    {16, 3},  // '-='
+    {20, 3},  // '//='
+    {21, 3},  // '/='
+    {25, 3},  // '<<='
+    {27, 2},  // '='
+    {32, 3},  // '>>='
+    {39, 3},  // '^='
+    {66, 3},  // '|='
+    {7, 56},  // ')'
+    {14, 56},  // ','
+    {27, 57},  // '='
+    {1, 121},  // '!='
+    {2, 121},  // '%'
+    {4, 121},  // '&'
+    {6, 130},  // '('
+    {7, 121},  // ')'
+    {8, 121},  // '*'
+    {9, 121},  // '**'
+    {12, 121},  // '+'
+    {14, 121},  // ','
+    {15, 121},  // '-'
+    {18, 121},  // '/'
+    {19, 121},  // '//'
+    {22, 121},  // ':'
+    {23, 121},  // '<'
+    {24, 121},  // '<<'
+    {26, 121},  // '<='
+    {28, 121},  // '=='
+    {29, 121},  // '>'
+    {30, 121},  // '>='
+    {31, 121},  // '>>'
+    {36, 122},  // '['
+    {37, 121},  // ']'
+    {38, 121},  // '^'
+    {40, 121},  // 'and'
+    {41, 121},  // 'as'
+    {47, 121},  // 'else'
+    {52, 121},  // 'if'
+    {53, 121},  // 'in'
+    {55, 121},  // 'is'
+    {56, 121},  // 'not'
+    {57, 121},  // 'or'
+    {65, 121},  // '|'
+    {67, 121},  // '}'
+    {72, 121},  // NEWLINE
+};
+
+} // namespace ll1
+
+#endif // LL1_TABLE_H
@@ -0,0 +1,95 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only mappings of whole files, for the on-disk AST and symbol index
+// readers: mmap on POSIX systems, MapViewOfFile on Windows.
+
+enum class MapStatus { OK, CANNOT_OPEN, CANNOT_MAP };
+
+// Maps the file at path. An empty file maps to data == nullptr, length 0.
+inline MapStatus map_file(const std::string& path, const char*& data, size_t& length) {
+    data = nullptr;
+    length = 0;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return MapStatus::CANNOT_OPEN;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return MapStatus::CANNOT_OPEN;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        return MapStatus::OK;
+    }
+    // The view keeps the mapping, and the mapping the file, open
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) return MapStatus::CANNOT_MAP;
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) return MapStatus::CANNOT_MAP;
+    data = static_cast<const char*>(view);
+    length = (size_t)size.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return MapStatus::CANNOT_OPEN;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return MapStatus::CANNOT_OPEN;
+    }
+    if (info.st_size == 0) {
+        ::close(fd);
+        return MapStatus::OK;
+    }
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return MapStatus::CANNOT_MAP;
+    data = static_cast<const char*>(mapped);
+    length = info.st_size;
+#endif
+    return MapStatus::OK;
+}
+
+inline void unmap_file(const char* data, size_t length) {
+    if (!data) return;
+#ifdef _WIN32
+    (void)length;
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<char*>(data), length);
+#endif
+}
+
+// Moves the finished temporary file over path. rename() replaces an existing
+// file atomically on POSIX but fails on Windows, where the old file is
+// removed first; a reader then briefly finds no file, never a partial one.
+inline bool replace_file(const std::string& temporary, const std::string& path) {
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,54 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator for parse tree nodes. Memory is released all at once when
+// the arena is destroyed, i.e. after the last node allocated from it.
+class NodeArena {
+public:
+    explicit NodeArena(size_t blockSize = 64 * 1024) : blockSize(blockSize) {}
+
+    void* allocate(size_t size, size_t align) {
+        size_t offset = (used + align - 1) & ~(align - 1);
+        if (blocks.empty() || offset + size > capacity) {
+            // new[] memory is aligned for any fundamental type
+            capacity = size > blockSize ? size : blockSize;
+            blocks.emplace_back(new char[capacity]);
+            offset = 0;
+        }
+        used = offset + size;
+        return blocks.back().get() + offset;
+    }
+
+private:
+    size_t blockSize;
+    size_t capacity = 0;
+    size_t used = 0;
+    std::vector<std::unique_ptr<char[]>> blocks;
+};
+
+// Allocator for allocate_shared; keeps its arena alive while nodes exist.
+template <typename T>
+struct ArenaAllocator {
+    typedef T value_type;
+    std::shared_ptr<NodeArena> arena;
+
+    explicit ArenaAllocator(std::shared_ptr<NodeArena> arena) : arena(std::move(arena)) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) {}
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena == b.arena; }
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena != b.arena; }
+
+#endif // NODE_ARENA_H
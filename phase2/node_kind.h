@@ -0,0 +1,64 @@
+#ifndef NODE_KIND_H
+#define NODE_KIND_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Every node name the parsers produce. Grammar rules are lower case, token
+// leaves use the token type. Each entry becomes NodeKind::<name> and the
+// enter_<name> / leave_<name> / rewrite_<name> hooks in node_visitor.h.
+#define NODE_KINDS(X) \
+    X(program) X(statement) X(statement_list) X(loop_statement) X(loop_statement_list) \
+    X(assignment) X(assign_target) X(assign_target_tail) X(primary_target) \
+    X(augmented_assignment) X(return_stmt) X(yield_stmt) X(break_stmt) X(continue_stmt) \
+    X(del_stmt) X(del_target) X(if_stmt) X(elif_stmt) X(else_part) X(while_stmt) X(for_stmt) \
+    X(func_def) X(param_list) X(param) X(type) X(lazy_body) X(class_def) X(class_inheritance_opt) \
+    X(try_stmt) X(except_clauses) X(except_clause) X(finally_clause) \
+    X(import_stmt) X(import_tail) X(import_item) X(import_alias_opt) \
+    X(expression) X(binary_expr) X(unary_expr) X(factor) X(inline_if_else) \
+    X(func_call) X(argument_list) X(argument_list_prime) \
+    X(list_literal) X(list_items_prime) X(dict_literal) X(dict_items_prime) X(dict_pair) X(string_key) \
+    X(IDENTIFIER) X(KEYWORD) X(OPERATOR) X(DELIMITER) X(NUMBER) \
+    X(STRING_QUOTE) X(STRING_LITERAL) X(NEWLINE) X(INDENT) X(DEDENT) \
+    X(other)
+
+enum class NodeKind : uint8_t {
+#define X(kind) kind,
+    NODE_KINDS(X)
+#undef X
+};
+
+const size_t NODE_KIND_COUNT = 0
+#define X(kind) + 1
+    NODE_KINDS(X)
+#undef X
+    ;
+
+inline const char* node_kind_name(NodeKind kind) {
+    static const char* const names[] = {
+#define X(kind) #kind,
+        NODE_KINDS(X)
+#undef X
+    };
+    return names[static_cast<size_t>(kind)];
+}
+
+// Leaves that stand for a single token.
+inline bool is_token_kind(NodeKind kind) {
+    return kind >= NodeKind::IDENTIFIER && kind <= NodeKind::DEDENT;
+}
+
+// Looked up once when a node is created; names outside the list (LL(1)
+// nonterminals with no hand-parser counterpart) map to NodeKind::other.
+inline NodeKind node_kind_of(const std::string& name) {
+    static const std::unordered_map<std::string, NodeKind> kinds = {
+#define X(kind) {#kind, NodeKind::kind},
+        NODE_KINDS(X)
+#undef X
+    };
+    auto it = kinds.find(name);
+    return it == kinds.end() ? NodeKind::other : it->second;
+}
+
+#endif // NODE_KIND_H
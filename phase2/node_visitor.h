@@ -0,0 +1,161 @@
+#ifndef NODE_VISITOR_H
+#define NODE_VISITOR_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Statically dispatched tree passes. A pass derives from TreeVisitor<Pass>
+// or TreeRewriter<Pass> and defines hooks only for the kinds it cares about:
+//
+//     struct CountCalls : TreeVisitor<CountCalls> {
+//         int calls = 0;
+//         bool enter_func_call(ParseTreeNode&) { calls++; return true; }
+//     };
+//
+// Dispatch is a switch on node.kind that calls the derived hook directly, so
+// hooks inline and kinds the pass does not handle fold away. There are no
+// virtual calls and no name compares. Traversal uses an explicit stack, so
+// deeply nested trees do not overflow the call stack.
+
+template <typename Derived>
+class TreeVisitor {
+public:
+    // Depth first, children in order. enter_<kind> runs before the children
+    // and returns false to skip them; leave_<kind> runs after the children
+    // (also when they were skipped). Unhandled kinds fall back to
+    // enter_node / leave_node.
+    void walk(ParseTreeNode* root) {
+        if (!root) return;
+        stack.clear();
+        push(root);
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            if (frame.next != frame.end) {
+                ParseTreeNode* child = (frame.next++)->get();
+                if (child) push(child);
+                continue;
+            }
+            ParseTreeNode* node = frame.node;
+            stack.pop_back();
+            leave(*node);
+        }
+    }
+
+    void walk(const shared_ptr<ParseTreeNode>& root) { walk(root.get()); }
+
+    bool enter_node(ParseTreeNode&) { return true; }
+    void leave_node(ParseTreeNode&) {}
+
+#define X(kind) \
+    bool enter_##kind(ParseTreeNode& node) { return self().enter_node(node); } \
+    void leave_##kind(ParseTreeNode& node) { self().leave_node(node); }
+    NODE_KINDS(X)
+#undef X
+
+private:
+    typedef std::vector<shared_ptr<ParseTreeNode>>::const_iterator ChildIterator;
+    struct Frame {
+        ParseTreeNode* node;
+        ChildIterator next;
+        ChildIterator end;
+    };
+    std::vector<Frame> stack;   // kept between walks to reuse its storage
+
+    Derived& self() { return static_cast<Derived&>(*this); }
+
+    void push(ParseTreeNode* node) {
+        auto end = node->children.cend();
+        stack.push_back({node, enter(*node) ? node->children.cbegin() : end, end});
+    }
+
+    bool enter(ParseTreeNode& node) {
+        switch (node.kind) {
+#define X(kind) case NodeKind::kind: return self().enter_##kind(node);
+            NODE_KINDS(X)
+#undef X
+        }
+        return true;
+    }
+
+    void leave(ParseTreeNode& node) {
+        switch (node.kind) {
+#define X(kind) case NodeKind::kind: self().leave_##kind(node); return;
+            NODE_KINDS(X)
+#undef X
+        }
+    }
+};
+
+template <typename Derived>
+class TreeRewriter {
+public:
+    // Post order: a node's children are rewritten before the node itself.
+    // rewrite_<kind> receives the owning pointer and may replace it with a
+    // different subtree, or reset it to remove the node from its parent. It
+    // may change the node's own children but not its parent's.
+    // enter_<kind> runs on the way down and returns false to leave the
+    // children untouched; the node itself is still rewritten.
+    void rewrite(shared_ptr<ParseTreeNode>& root) {
+        if (!root) return;
+        stack.clear();
+        push(root);
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            auto& children = (*frame.slot)->children;
+            if (frame.next < children.size()) {
+                shared_ptr<ParseTreeNode>& child = children[frame.next++];
+                if (child) push(child);
+                continue;
+            }
+            if (frame.removedChild) {
+                children.erase(remove(children.begin(), children.end(), nullptr), children.end());
+            }
+            shared_ptr<ParseTreeNode>* slot = frame.slot;
+            stack.pop_back();
+            rewrite_dispatch(*slot);
+            if (!*slot && !stack.empty()) stack.back().removedChild = true;
+        }
+    }
+
+    bool enter_node(ParseTreeNode&) { return true; }
+    void rewrite_node(shared_ptr<ParseTreeNode>&) {}
+
+#define X(kind) \
+    bool enter_##kind(ParseTreeNode& node) { return self().enter_node(node); } \
+    void rewrite_##kind(shared_ptr<ParseTreeNode>& node) { self().rewrite_node(node); }
+    NODE_KINDS(X)
+#undef X
+
+private:
+    struct Frame {
+        shared_ptr<ParseTreeNode>* slot;   // parent's child pointer, stable until the parent is rewritten
+        size_t next;
+        bool removedChild;
+    };
+    std::vector<Frame> stack;
+
+    Derived& self() { return static_cast<Derived&>(*this); }
+
+    void push(shared_ptr<ParseTreeNode>& slot) {
+        bool descend = true;
+        switch (slot->kind) {
+#define X(kind) case NodeKind::kind: descend = self().enter_##kind(*slot); break;
+            NODE_KINDS(X)
+#undef X
+        }
+        stack.push_back({&slot, descend ? 0 : slot->children.size(), false});
+    }
+
+    void rewrite_dispatch(shared_ptr<ParseTreeNode>& slot) {
+        switch (slot->kind) {
+#define X(kind) case NodeKind::kind: self().rewrite_##kind(slot); return;
+            NODE_KINDS(X)
+#undef X
+        }
+    }
+};
+
+#endif // NODE_VISITOR_H
@@ -0,0 +1,735 @@
+#include "parser_core.h"
+#include "node_visitor.h"
+#include <cstring>
+
+using namespace std;
+
+vector<Token> tokens;
+vector<int> matchTable;
+
+// Parser position. Thread-local so top-level segments can be parsed in
+// parallel; tokenEnd is where the segment being parsed stops.
+thread_local Token currentToken;
+thread_local int tokenIndex = 0;
+thread_local size_t tokenEnd = SIZE_MAX;
+thread_local shared_ptr<NodeArena> nodeArena;
+
+// Diagnostics are stored compactly and only formatted when printed. After an
+// error the parser is in panic mode: further errors are dropped until it
+// consumes a token on its own, so one mistake yields one message.
+thread_local vector<Diagnostic> diagnostics;
+thread_local bool panic_mode = false;
+thread_local bool error_limit_reached = false;
+int max_errors = 100;       // 0 = unlimited
+bool fast_fail = false;     // stop at the first error
+
+// FOLLOW sets computed from GrammarRules.txt, keyed by rule name.
+unordered_map<string, TerminalSet> followSets;
+
+// Grammar rule being parsed; synchronize() recovers to its FOLLOW set.
+thread_local const char* currentRule = "program";
+
+// Nesting limits: blocks, brackets and calls each add one level. Beyond
+// max_nesting_depth the offending group is skipped with a diagnostic instead
+// of overflowing the C++ stack.
+int max_nesting_depth = 5000;
+thread_local int nestingDepth = 0;
+bool iterative_expressions = true;  // explicit-stack expression engine (default)
+
+void report_error(DiagCode code, const char* arg) {
+    if (panic_mode || error_limit_reached) {
+        return;
+    }
+    int line = tokenIndex < tokens.size() ? tokens[tokenIndex].line : (tokens.empty() ? 0 : tokens.back().line);
+    diagnostics.push_back({code, line, tokenIndex, arg});
+    panic_mode = true;
+    if (fast_fail || (max_errors > 0 && (int)diagnostics.size() >= max_errors)) {
+        // Jump to the end of input: every parser loop stops at END_OF_FILE
+        error_limit_reached = true;
+        seek(min(tokenEnd, tokens.size()));
+    }
+}
+
+// Panic-mode recovery: skip tokens until one that can follow the current rule,
+// without crossing a NEWLINE, INDENT or DEDENT so block structure stays intact.
+// The stopping token is left for the caller.
+void synchronize() {
+    auto it = followSets.find(currentRule);
+    const TerminalSet* follow = it == followSets.end() ? nullptr : &it->second;
+    while (tokenIndex < tokenEnd && tokenIndex < tokens.size()) {
+        const Token& tok = peek();
+        if (tok.type == "NEWLINE" || tok.type == "INDENT" || tok.type == "DEDENT") {
+            break;
+        }
+        if (follow && follow->contains(tok)) {
+            break;
+        }
+        advance();
+    }
+    panic_mode = true;
+}
+
+// Statement-level recovery: drop the rest of the offending line.
+void skip_statement() {
+    advance();
+    while (peek().type != "END_OF_FILE" && peek().type != "NEWLINE" &&
+           peek().type != "INDENT" && peek().type != "DEDENT") {
+        advance();
+    }
+    panic_mode = true;
+}
+
+void load_follow_sets(const string& path) {
+    Grammar grammar;
+    string error;
+    if (!loadGrammar(path, grammar, error)) {
+        cerr << "Warning: " << error << "; error recovery will stop at line boundaries only" << endl;
+        return;
+    }
+    for (const auto& entry : grammar.follow) {
+        TerminalSet& set = followSets[entry.first];
+        for (const string& terminal : entry.second) {
+            set.add(terminal);
+        }
+    }
+}
+
+string found_token(int index) {
+    if (index >= tokens.size()) {
+        return "END_OF_FILE";
+    }
+    return tokens[index].type + " with value '" + tokens[index].value + "'";
+}
+
+string format_diagnostic(const Diagnostic& d) {
+    const Token& tok = d.tokenIndex < tokens.size() ? tokens[d.tokenIndex] : peek();
+    string message;
+    switch (d.code) {
+        case DiagCode::NESTING_LIMIT:
+            message = "nesting exceeds the limit of " + to_string(max_nesting_depth) + " levels"; break;
+        case DiagCode::EXPECTED_TOKEN:
+            message = "expected type '" + string(d.arg) + "' but found " + found_token(d.tokenIndex); break;
+        case DiagCode::UNEXPECTED_TOKEN:
+            message = "unexpected token " + found_token(d.tokenIndex); break;
+        case DiagCode::RETURN_OUTSIDE_FUNCTION:
+            message = "'return' outside function"; break;
+        case DiagCode::YIELD_OUTSIDE_FUNCTION:
+            message = "'yield' outside function"; break;
+        case DiagCode::BREAK_OUTSIDE_LOOP:
+            message = "'break' outside loop"; break;
+        case DiagCode::CONTINUE_OUTSIDE_LOOP:
+            message = "'continue' outside loop"; break;
+        case DiagCode::UNTERMINATED_STRING:
+            message = "unterminated string literal"; break;
+        case DiagCode::UNEXPECTED_IN_STRING:
+            message = "unexpected token inside string literal: " + tok.type; break;
+        case DiagCode::EXPECTED_FACTOR:
+            message = "expected factor but found " + found_token(d.tokenIndex); break;
+        case DiagCode::EXPECTED_AUG_ASSIGN_OP:
+            message = "expected augmented assignment operator but found '" + tok.value + "'"; break;
+        case DiagCode::EXPECTED_SYMBOL:
+            message = "expected " + string(d.arg) + " but found '" + tok.value + "'"; break;
+        case DiagCode::EXPECTED_LOOP_VARIABLE:
+            message = "expected loop variable, but found '" + tok.value + "' of type '" + tok.type + "'"; break;
+        case DiagCode::INVALID_LOOP_VARIABLE:
+            message = "invalid loop variable '" + tok.value + "'"; break;
+        case DiagCode::EXPECTED_ITERABLE:
+            message = "expected iterable expression after 'in' but found '" + tok.value + "'"; break;
+        case DiagCode::EXPECTED_TYPE_NAME:
+            message = "expected type but found " + found_token(d.tokenIndex); break;
+        case DiagCode::EXPECTED_IMPORT:
+            message = "expected 'import' or 'from'"; break;
+        case DiagCode::EXPECTED_MODULE_NAME:
+            message = "expected module name in import"; break;
+        case DiagCode::EXPECTED_ALIAS:
+            message = "expected alias after 'as'"; break;
+        case DiagCode::UNSUPPORTED_DICT_KEY:
+            message = "unsupported dictionary key type"; break;
+        case DiagCode::EXPECTED_DICT_COLON:
+            message = "expected ':' in dictionary pair"; break;
+        case DiagCode::EXPECTED_STRING_KEY:
+            message = "expected string literal inside quotes"; break;
+        case DiagCode::EXPECTED_CLOSING_QUOTE:
+            message = "expected closing quote"; break;
+        case DiagCode::EXPECTED_OPENING_QUOTE:
+            message = "expected opening quote for string key"; break;
+    }
+    return "Line " + to_string(d.line) + ": Syntax error: " + message;
+}
+
+void print_diagnostics() {
+    cout << "\nERRORS FOUND DURING PARSING\n";
+    cout << "===========================\n";
+    for (const auto& d : diagnostics) {
+        cout << format_diagnostic(d) << "\n";
+    }
+    if (error_limit_reached) {
+        cout << "Parsing stopped after " << diagnostics.size() << " error(s)" << endl;
+    }
+}
+
+const Token& peek(){
+    static const Token endOfFile = {"END_OF_FILE", "", 0};
+    if (tokenIndex >= tokenEnd || tokenIndex >= tokens.size()) {
+        return endOfFile;
+    }
+    return tokens[tokenIndex];
+}
+
+const unordered_map<string, pair<int, int>> INFIX_BINDING_POWER = {
+    {"or", {1, 2}},
+    {"and", {3, 4}},
+    {"in", {7, 8}}, {"not in", {7, 8}}, {"is", {7, 8}}, {"is not", {7, 8}},
+    {"<", {7, 8}}, {">", {7, 8}}, {"==", {7, 8}}, {"!=", {7, 8}}, {"<=", {7, 8}}, {">=", {7, 8}},
+    {"|", {9, 10}},
+    {"^", {11, 12}},
+    {"&", {13, 14}},
+    {"<<", {15, 16}}, {">>", {15, 16}},
+    {"+", {17, 18}}, {"-", {17, 18}},
+    {"*", {19, 20}}, {"/", {19, 20}}, {"//", {19, 20}}, {"%", {19, 20}},
+    {"**", {23, 22}}
+};
+
+// Returns the binary operator at tokenIndex, or "" if the expression ends here.
+// 'not in' and 'is not' span two tokens; width reports how many to consume.
+string peek_infix_operator(int& width) {
+    const Token& tok = peek();
+    width = 1;
+    if (tok.type == "KEYWORD") {
+        if (tok.value == "not") {
+            if (tokenIndex + 1 < tokens.size() && tokens[tokenIndex + 1].value == "in") {
+                width = 2;
+                return "not in";
+            }
+            return "";
+        }
+        if (tok.value == "is" && tokenIndex + 1 < tokens.size() && tokens[tokenIndex + 1].value == "not") {
+            width = 2;
+            return "is not";
+        }
+    } else if (tok.type != "OPERATOR") {
+        return "";
+    }
+    if (INFIX_BINDING_POWER.find(tok.value) == INFIX_BINDING_POWER.end()) {
+        return "";
+    }
+    return tok.value;
+}
+
+// Returns the binding power of a prefix operator, or -1 if tok is not one.
+int prefix_binding_power(const Token& tok) {
+    if (tok.value == "not" && (tok.type == "KEYWORD" || tok.type == "OPERATOR")) {
+        return NOT_BINDING_POWER;
+    }
+    if (tok.type == "OPERATOR" && (tok.value == "-" || tok.value == "+" || tok.value == "~")) {
+        return UNARY_BINDING_POWER;
+    }
+    return -1;
+}
+
+bool is_augmented_assign_op(const string& op) {
+    return op == "+=" || op == "-=" || op == "*=" || op == "/=" || op == "%=" ||
+           op == "//=" || op == "**=" || op == "&=" || op == "|=" || op == "^=" ||
+           op == "<<=" || op == ">>=";
+}
+
+// Index just past the group opened at idx, or -1 if the group is unbalanced.
+int skip_balanced(int idx) {
+    if (idx < 0 || idx >= (int)matchTable.size() || matchTable[idx] < idx) return -1;
+    return matchTable[idx] + 1;
+}
+
+void seek(int idx) {
+    tokenIndex = idx;
+    currentToken = peek();
+}
+
+void report_nesting_limit() {
+    report_error(DiagCode::NESTING_LIMIT);
+}
+
+// Skips the bracket group at tokenIndex in O(1) once the nesting limit is hit.
+void skip_too_deep_group() {
+    report_nesting_limit();
+    int next = skip_balanced(tokenIndex);
+    if (next < 0) {
+        synchronize();
+        return;
+    }
+    seek(next);
+}
+
+// Prefix operators and right-associative ** chains have no closing bracket
+// to jump to, so past the limit the rest of the operand is dropped like any
+// other malformed expression.
+void skip_too_deep_operand() {
+    report_nesting_limit();
+    synchronize();
+}
+
+// Skips the statement at tokenIndex, its indented body and any trailing
+// elif/else/except/finally clauses once the nesting limit is hit.
+void skip_too_deep_statement() {
+    report_nesting_limit();
+    do {
+        while (peek().type != "END_OF_FILE" && peek().type != "NEWLINE") {
+            advance();
+        }
+        if (peek().type == "NEWLINE") advance();
+        if (peek().type == "INDENT") {
+            int next = skip_balanced(tokenIndex);
+            if (next < 0) return;
+            seek(next);
+        }
+    } while (starts_statement(peek(), CONTINUATION_CLAUSE_FIRST));
+}
+
+bool is_assignment_target(int idx, string& op) {
+    // Accepts IDENTIFIER (DOT IDENTIFIER | [expr])*
+    if (tokens[idx].type != "IDENTIFIER") return false;
+    idx++;
+    while (idx < tokens.size()) {
+        if (tokens[idx].type == "DELIMITER" && tokens[idx].value == ".") {
+            idx++;
+            if (idx >= tokens.size() || tokens[idx].type != "IDENTIFIER") return false;
+            idx++;
+        } else if (tokens[idx].type == "DELIMITER" && tokens[idx].value == "[") {
+            // jump over [ ... ] using the lexer's match table
+            idx = skip_balanced(idx);
+            if (idx < 0) return false;
+        } else {
+            break;
+        }
+    }
+    if (idx < tokens.size() && tokens[idx].type == "OPERATOR") {
+        string val = tokens[idx].value;
+        if (val == "=" || is_augmented_assign_op(val)) {
+            op = val;
+            return true;
+        }
+    }
+    return false;
+}
+
+thread_local vector<ParseContext> contextStack = {{ContextKind::MODULE, ""}};
+
+void push_context(ContextKind kind, const string& name) {
+    contextStack.push_back({kind, name});
+}
+
+void pop_context() {
+    if (contextStack.size() > 1) {
+        contextStack.pop_back();
+    }
+}
+
+bool is_inside_loop() {
+    return contextStack.back().loopDepth > 0;
+}
+
+bool is_inside_function() {
+    return contextStack.back().kind == ContextKind::FUNCTION;
+}
+
+void advance(){
+    if(tokenIndex < tokenEnd && tokenIndex < tokens.size()){
+        tokenIndex++;
+        currentToken = peek();
+        panic_mode = false;
+    }
+}
+
+bool match(const char* expectedType){
+    cout << "\nDEBUG: Matching - Expected: " << expectedType 
+         << ", Current token - Type: " << currentToken.type 
+         << ", Value: '" << currentToken.value << "'" << endl;
+    
+    if(currentToken.type == expectedType){
+        advance();
+        cout << "DEBUG: Match successful" << endl;
+        return true;
+    }
+    else{
+        cout << "DEBUG: Match failed" << endl;
+        report_error(DiagCode::EXPECTED_TOKEN, expectedType);
+        synchronize();
+        return false;
+
+    }
+}
+
+bool lazy_bodies = false;
+vector<int> unmatchedPrefix;    // unmatched brackets and INDENT/DEDENTs in tokens[0, i)
+
+void build_unmatched_prefix() {
+    unmatchedPrefix.assign(tokens.size() + 1, 0);
+    for (size_t i = 0; i < tokens.size(); i++) {
+        const Token& tok = tokens[i];
+        bool opensOrCloses = tok.type == "INDENT" || tok.type == "DEDENT" ||
+            (tok.type == "DELIMITER" && tok.value.size() == 1 && strchr("()[]{}", tok.value[0]));
+        unmatchedPrefix[i + 1] = unmatchedPrefix[i] + (opensOrCloses && matchTable[i] < 0);
+    }
+}
+
+void reset_parser_state() {
+    if (lazy_bodies) build_unmatched_prefix();
+    tokenEnd = tokens.size();
+    seek(0);
+    diagnostics.clear();
+    panic_mode = false;
+    error_limit_reached = false;
+    nestingDepth = 0;
+    contextStack = {{ContextKind::MODULE, ""}};
+}
+
+int parallel_threads = 0;            // 0 = sequential
+
+// End (exclusive) of the statement starting at tokens[i]: its line, its
+// indented body and any elif/else/except/finally clauses. Returns -1 if
+// brackets or indentation inside it do not balance.
+int statement_end(int i) {
+    int n = tokens.size();
+    do {
+        while (i < n && tokens[i].type != "NEWLINE") {
+            const Token& tok = tokens[i];
+            if (matchTable[i] > i) {
+                i = matchTable[i] + 1;
+            } else if (tok.type == "INDENT" || tok.type == "DEDENT" ||
+                       (tok.type == "DELIMITER" && tok.value.size() == 1 && strchr("()[]{}", tok.value[0]))) {
+                return -1;
+            } else if (tok.type == "STRING_QUOTE") {
+                // multi-line strings contain NEWLINE tokens
+                i++;
+                while (i < n && tokens[i].type != "STRING_QUOTE") i++;
+                i++;
+            } else {
+                i++;
+            }
+        }
+        if (i < n) i++;
+        if (i < n && tokens[i].type == "INDENT") {
+            if (matchTable[i] < i) return -1;
+            i = matchTable[i] + 1;
+        }
+    } while (i < n && tokens[i].type == "KEYWORD" && starts_statement(tokens[i], CONTINUATION_CLAUSE_FIRST));
+    return min(i, n);
+}
+
+ThreadPool& parser_thread_pool() {
+    static ThreadPool pool(parallel_threads);
+    return pool;
+}
+
+// Start index of every top-level statement. Returns nothing if brackets or
+// indentation do not balance; the sequential parser reports those.
+vector<int> find_top_level_statements() {
+    vector<int> starts;
+    int i = 0;
+    while (i < (int)tokens.size()) {
+        starts.push_back(i);
+        i = statement_end(i);
+        if (i < 0) return {};
+    }
+    return starts;
+}
+
+thread_local SubtreeCache* subtreeCache = nullptr;  // set only for incremental parses
+thread_local int cacheBypassIndex = -1;             // statement being parsed to fill the cache
+vector<uint64_t> tokenHashes;                       // hash_token() of each token
+vector<uint64_t> tokenHashPrefix;                   // hash of tokens[0, i)
+vector<uint64_t> tokenHashPower;
+const uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+// Hashes tokens[i] with its length and its distance from the token before,
+// so reused subtrees also match in spacing, which their source ranges show.
+static uint64_t hash_token(size_t i) {
+    const Token& tok = tokens[i];
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : tok.type) h = (h ^ (unsigned char)c) * FNV_PRIME;
+    h = (h ^ 0xff) * FNV_PRIME;
+    for (char c : tok.value) h = (h ^ (unsigned char)c) * FNV_PRIME;
+    int gap = i == 0 ? tok.offset : tok.offset - tokens[i - 1].offset;
+    h = (h ^ (uint32_t)gap) * FNV_PRIME;
+    return (h ^ (uint32_t)tok.length) * FNV_PRIME;
+}
+
+// Prefix hashes make the hash of any token range O(1).
+static void build_hash_prefix(size_t from) {
+    size_t oldSize = tokenHashPower.size();
+    tokenHashPrefix.resize(tokens.size() + 1, 0);
+    tokenHashPower.resize(tokens.size() + 1, 1);
+    for (size_t i = max<size_t>(oldSize, 1); i < tokenHashPower.size(); i++) {
+        tokenHashPower[i] = tokenHashPower[i - 1] * FNV_PRIME;
+    }
+    for (size_t i = from; i < tokens.size(); i++) {
+        tokenHashPrefix[i + 1] = tokenHashPrefix[i] * FNV_PRIME + tokenHashes[i];
+    }
+}
+
+void build_token_hashes() {
+    tokenHashes.resize(tokens.size());
+    for (size_t i = 0; i < tokens.size(); i++) tokenHashes[i] = hash_token(i);
+    build_hash_prefix(0);
+}
+
+// Hashes only the edited tokens and the one after them, whose distance from
+// the token before may change; the prefix sums after them still change.
+void update_token_hashes(const TokenEdit& edit) {
+    if (edit.removed > edit.inserted) {
+        auto from = tokenHashes.begin() + edit.first + edit.inserted;
+        tokenHashes.erase(from, from + (edit.removed - edit.inserted));
+    } else {
+        tokenHashes.insert(tokenHashes.begin() + edit.first + edit.removed, edit.inserted - edit.removed, 0);
+    }
+    int end = min<int>(edit.first + edit.inserted + 1, tokens.size());
+    for (int i = edit.first; i < end; i++) tokenHashes[i] = hash_token(i);
+    build_hash_prefix(edit.first);
+}
+
+uint64_t token_range_hash(int start, int end) {
+    return tokenHashPrefix[end] - tokenHashPrefix[start] * tokenHashPower[end - start];
+}
+
+// Key for tokens[start, end) parsed in the current context, which decides
+// errors such as 'return' outside function or the nesting limit.
+uint64_t subtree_key(int start, int end) {
+    uint64_t h = token_range_hash(start, end);
+    const ParseContext& context = contextStack.back();
+    uint64_t state = (uint64_t)context.kind | (context.loopDepth > 0 ? 4 : 0) | (lazy_bodies ? 8 : 0) |
+                     ((uint64_t)nestingDepth << 4);
+    return (h ^ (state * 0x9e3779b97f4a7c15ULL)) * FNV_PRIME + (end - start);
+}
+
+bool is_compound_statement_start(const Token& tok) {
+    return tok.type == "KEYWORD" && starts_statement(tok, COMPOUND_STATEMENT_FIRST);
+}
+
+// Switches on length first, so each token costs at most a few compares.
+StatementToken statement_token(const Token& tok) {
+    const string& type = tok.type;
+    if (type == "IDENTIFIER") return StatementToken::IDENTIFIER;
+    if (type == "NEWLINE") return StatementToken::NEWLINE;
+    if (type == "INDENT") return StatementToken::INDENT;
+    const string& v = tok.value;
+    switch (v.size()) {
+        case 2:
+            if (v == "if") return StatementToken::IF;
+            break;
+        case 3:
+            if (v == "for") return StatementToken::FOR;
+            if (v == "def") return StatementToken::DEF;
+            if (v == "try") return StatementToken::TRY;
+            if (v == "del") return StatementToken::DEL;
+            break;
+        case 4:
+            if (v == "from") return StatementToken::FROM;
+            if (v == "elif") return StatementToken::ELIF;
+            if (v == "else") return StatementToken::ELSE;
+            break;
+        case 5:
+            if (v == "class") return StatementToken::CLASS;
+            if (v == "while") return StatementToken::WHILE;
+            if (v == "yield") return StatementToken::YIELD;
+            if (v == "break") return StatementToken::BREAK;
+            break;
+        case 6:
+            if (v == "import") return StatementToken::IMPORT;
+            if (v == "return") return StatementToken::RETURN;
+            if (v == "except") return StatementToken::EXCEPT;
+            break;
+        case 7:
+            if (v == "finally") return StatementToken::FINALLY;
+            break;
+        case 8:
+            if (v == "continue") return StatementToken::CONTINUE;
+            break;
+    }
+    return StatementToken::OTHER;
+}
+
+LazyBodyNode::LazyBodyNode(int begin, int end, bool balanced, const string& function, int nestingDepth)
+    : ParseTreeNode("lazy_body", "lines " + to_string(tokens[begin].line) + "-" + to_string(tokens[end - 1].line)),
+      begin(begin), end(end), balanced(balanced), function(function), nestingDepth(nestingDepth) {
+    sourceStart = tokens[begin].offset;
+    sourceEnd = tokens[end - 1].offset + tokens[end - 1].length;
+}
+
+template <typename... Args>
+static shared_ptr<ParseTreeNode> allocate_lazy_body(Args&&... args) {
+    if (nodeArena) {
+        return allocate_shared<LazyBodyNode>(ArenaAllocator<LazyBodyNode>(nodeArena), forward<Args>(args)...);
+    }
+    return make_shared<LazyBodyNode>(forward<Args>(args)...);
+}
+
+shared_ptr<ParseTreeNode> make_lazy_body(int begin, int end) {
+    bool balanced = (int)unmatchedPrefix.size() > end && unmatchedPrefix[end] == unmatchedPrefix[begin];
+    return allocate_lazy_body(begin, end, balanced, contextStack.back().name, nestingDepth);
+}
+
+bool expand_lazy_body(shared_ptr<ParseTreeNode>& slot) {
+    if (!slot || slot->kind != NodeKind::lazy_body) return false;
+    const LazyBodyNode& body = static_cast<const LazyBodyNode&>(*slot);
+
+    // Parse as if inside the function, then put the caller's state back
+    int savedIndex = tokenIndex;
+    size_t savedEnd = tokenEnd;
+    bool savedPanic = panic_mode;
+    int savedDepth = nestingDepth;
+    vector<ParseContext> savedContext;
+    savedContext.swap(contextStack);
+    contextStack = {{ContextKind::MODULE, ""}, {ContextKind::FUNCTION, body.function}};
+    nestingDepth = body.nestingDepth;
+    tokenEnd = body.end;
+    seek(body.begin);
+    panic_mode = false;
+
+    slot = TreeParser::parse_statement_list();
+    compute_source_ranges(slot);
+
+    contextStack.swap(savedContext);
+    nestingDepth = savedDepth;
+    panic_mode = savedPanic;
+    tokenEnd = savedEnd;
+    seek(savedIndex);
+    return true;
+}
+
+namespace {
+
+struct LazyBodyExpander : TreeRewriter<LazyBodyExpander> {
+    void rewrite_lazy_body(shared_ptr<ParseTreeNode>& node) { expand_lazy_body(node); }
+};
+
+} // namespace
+
+void expand_lazy_bodies(shared_ptr<ParseTreeNode>& root) {
+    // Nested bodies are parsed eagerly while expanding
+    bool savedLazy = lazy_bodies;
+    lazy_bodies = false;
+    LazyBodyExpander expander;
+    expander.rewrite(root);
+    lazy_bodies = savedLazy;
+}
+
+shared_ptr<ParseTreeNode> function_body(const shared_ptr<ParseTreeNode>& funcDef) {
+    if (!funcDef || funcDef->kind != NodeKind::func_def) return nullptr;
+    for (auto& child : funcDef->children) {
+        if (!child) continue;
+        if (child->kind == NodeKind::lazy_body) expand_lazy_body(child);
+        if (child->kind == NodeKind::statement_list) return child;
+    }
+    return nullptr;
+}
+
+uint32_t current_source_offset() {
+    if (tokenIndex < (int)tokens.size()) return tokens[tokenIndex].offset;
+    return tokens.empty() ? 0 : tokens.back().offset + tokens.back().length;
+}
+
+// Places an empty node and its (equally empty) descendants at offset.
+static void move_empty_subtree(ParseTreeNode& root, uint32_t offset) {
+    vector<ParseTreeNode*> pending = {&root};
+    while (!pending.empty()) {
+        ParseTreeNode* node = pending.back();
+        pending.pop_back();
+        node->sourceStart = node->sourceEnd = offset;
+        for (const auto& child : node->children) {
+            if (child && child->sourceStart != NO_SOURCE_OFFSET) pending.push_back(child.get());
+        }
+    }
+}
+
+void compute_source_ranges(const shared_ptr<ParseTreeNode>& root) {
+    if (!root || root->sourceEnd != NO_SOURCE_OFFSET) return;
+    // Children first; each frame resumes at its next child
+    vector<pair<ParseTreeNode*, size_t>> stack = {{root.get(), 0}};
+    while (!stack.empty()) {
+        auto& [node, next] = stack.back();
+        if (next < node->children.size()) {
+            ParseTreeNode* child = node->children[next++].get();
+            if (child && child->sourceEnd == NO_SOURCE_OFFSET) stack.push_back({child, 0});
+            continue;
+        }
+        // Empty children (missing tokens, empty rules, DEDENT) sit wherever
+        // the parser stood, possibly past the node's last token. They do not
+        // widen the node and are moved inside it, so a node's range depends
+        // only on its own tokens and a reused subtree shifts as a whole.
+        uint32_t start = node->sourceStart, end = 0;
+        bool hasText = false;
+        for (const auto& child : node->children) {
+            if (!child || child->sourceStart == NO_SOURCE_OFFSET || child->sourceEnd == child->sourceStart) continue;
+            start = min(start, child->sourceStart);
+            end = max(end, child->sourceEnd);
+            hasText = true;
+        }
+        if (start != NO_SOURCE_OFFSET) {
+            node->sourceStart = start;
+            node->sourceEnd = hasText ? end : start;
+            for (const auto& child : node->children) {
+                if (!child || child->sourceStart == NO_SOURCE_OFFSET || child->sourceEnd != child->sourceStart) continue;
+                uint32_t at = min(max(child->sourceStart, node->sourceStart), node->sourceEnd);
+                if (at != child->sourceStart) move_empty_subtree(*child, at);
+            }
+        }
+        stack.pop_back();
+    }
+}
+
+static shared_ptr<ParseTreeNode> shifted_copy(const ParseTreeNode& node, int delta, int64_t offsetDelta) {
+    shared_ptr<ParseTreeNode> copy;
+    if (node.kind == NodeKind::lazy_body) {
+        const LazyBodyNode& body = static_cast<const LazyBodyNode&>(node);
+        copy = allocate_lazy_body(body.begin + delta, body.end + delta, body.balanced, body.function, body.nestingDepth);
+        return copy;
+    }
+    copy = make_node(node.name, node.value);
+    if (node.sourceStart != NO_SOURCE_OFFSET) copy->sourceStart = node.sourceStart + offsetDelta;
+    if (node.sourceEnd != NO_SOURCE_OFFSET) copy->sourceEnd = node.sourceEnd + offsetDelta;
+    copy->children.reserve(node.children.size());
+    return copy;
+}
+
+shared_ptr<ParseTreeNode> shift_subtree(const shared_ptr<ParseTreeNode>& root, int delta, int64_t offsetDelta) {
+    if (!root) return nullptr;
+    auto copy = shifted_copy(*root, delta, offsetDelta);
+    vector<pair<const ParseTreeNode*, ParseTreeNode*>> pending = {{root.get(), copy.get()}};
+    while (!pending.empty()) {
+        auto [from, to] = pending.back();
+        pending.pop_back();
+        for (const auto& child : from->children) {
+            if (!child) continue;
+            to->addChild(shifted_copy(*child, delta, offsetDelta));
+            pending.push_back({child.get(), to->children.back().get()});
+        }
+    }
+    return copy;
+}
+
+void shift_cached_subtree(shared_ptr<ParseTreeNode>& root, int delta, int64_t offsetDelta) {
+    if (!root) return;
+    if (root.use_count() > 1) {
+        root = shift_subtree(root, delta, offsetDelta);
+        return;
+    }
+    vector<ParseTreeNode*> pending = {root.get()};
+    while (!pending.empty()) {
+        ParseTreeNode* node = pending.back();
+        pending.pop_back();
+        if (node->sourceStart != NO_SOURCE_OFFSET) node->sourceStart += offsetDelta;
+        if (node->sourceEnd != NO_SOURCE_OFFSET) node->sourceEnd += offsetDelta;
+        if (node->kind == NodeKind::lazy_body) {
+            LazyBodyNode& body = static_cast<LazyBodyNode&>(*node);
+            body.begin += delta;
+            body.end += delta;
+        }
+        for (auto& child : node->children) {
+            if (!child) continue;
+            if (child.use_count() > 1) {
+                child = shift_subtree(child, delta, offsetDelta);
+            } else {
+                pending.push_back(child.get());
+            }
+        }
+    }
+}
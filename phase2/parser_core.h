@@ -0,0 +1,286 @@
+#ifndef PARSER_CORE_H
+#define PARSER_CORE_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+#include "grammar.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Recursive-descent parser shared by the tree-building front end
+// (parserWtree.cpp) and the validate-only checker (parser.cpp). The grammar
+// is written once, in Parser<Builder> below; the Builder policy decides what
+// a parse produces. TreeBuilder builds ParseTreeNode trees, NullBuilder
+// builds nothing, so validation allocates nothing.
+
+extern vector<Token> tokens;
+extern vector<int> matchTable;     // matching bracket / INDENT-DEDENT index, see buildMatchTable()
+
+// Parser position. Thread-local so top-level segments can be parsed in
+// parallel; tokenEnd is where the segment being parsed stops.
+extern thread_local Token currentToken;
+extern thread_local int tokenIndex;
+extern thread_local size_t tokenEnd;
+
+// Diagnostics are stored compactly and only formatted when printed. After an
+// error the parser is in panic mode: further errors are dropped until it
+// consumes a token on its own, so one mistake yields one message.
+extern thread_local vector<Diagnostic> diagnostics;
+extern thread_local bool panic_mode;
+extern thread_local bool error_limit_reached;
+extern int max_errors;              // 0 = unlimited
+extern bool fast_fail;              // stop at the first error
+
+// Grammar rule being parsed; synchronize() recovers to its FOLLOW set.
+extern thread_local const char* currentRule;
+
+struct RuleGuard {
+    const char* saved;
+    explicit RuleGuard(const char* rule) : saved(currentRule) { currentRule = rule; }
+    ~RuleGuard() { currentRule = saved; }
+};
+
+// Nesting limits: blocks, brackets and calls each add one level. Beyond
+// max_nesting_depth the offending group is skipped with a diagnostic instead
+// of overflowing the C++ stack.
+extern int max_nesting_depth;
+extern thread_local int nestingDepth;
+extern bool iterative_expressions;  // explicit-stack expression engine (default)
+
+// Counts one nesting level for as long as the enclosing parser function runs.
+struct NestingGuard {
+    NestingGuard() { nestingDepth++; }
+    ~NestingGuard() { nestingDepth--; }
+};
+
+// Enclosing constructs of the statement being parsed. Statement parsers push
+// and pop frames, so break/continue/return/yield checks are constant time.
+enum class ContextKind { MODULE, FUNCTION, CLASS };
+
+struct ParseContext {
+    ContextKind kind;
+    string name;        // function or class name, empty for the module
+    int loopDepth = 0;  // loops open inside this function/class/module body
+    int tryDepth = 0;   // try blocks open inside this body
+};
+
+extern thread_local vector<ParseContext> contextStack;
+
+void push_context(ContextKind kind, const string& name);
+void pop_context();
+bool is_inside_loop();
+bool is_inside_function();
+
+// Binding powers for the precedence-climbing expression parser, lowest first.
+// Each entry is {left, right}: right > left makes the operator left-associative,
+// right < left (as for '**') makes it right-associative.
+extern const unordered_map<string, pair<int, int>> INFIX_BINDING_POWER;
+const int NOT_BINDING_POWER = 5;      // 'not x' binds looser than comparisons
+const int UNARY_BINDING_POWER = 21;   // '-x', '+x', '~x' bind looser than '**'
+
+const Token& peek();
+void advance();
+void seek(int idx);
+bool match(const char* expectedType);
+void report_error(DiagCode code, const char* arg = nullptr);
+void synchronize();
+string format_diagnostic(const Diagnostic& d);
+void print_diagnostics();
+
+string peek_infix_operator(int& width);
+int prefix_binding_power(const Token& tok);
+bool is_augmented_assign_op(const string& op);
+int skip_balanced(int idx);
+bool is_assignment_target(int idx, string& op);
+
+void skip_statement();
+void skip_too_deep_group();
+void skip_too_deep_operand();
+void skip_too_deep_statement();
+void load_follow_sets(const string& path);
+
+// Clears position, diagnostics and context before a parse of the whole input.
+void reset_parser_state();
+
+// Parallel mode: top-level statements are independent once tokens exist, so
+// runs of them are parsed concurrently and stitched back in source order.
+extern int parallel_threads;         // 0 = sequential
+const size_t MIN_SEGMENT_TOKENS = 2048;
+
+// Discards output; stands in for cout while worker threads parse.
+struct NullBuffer : streambuf {
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+int statement_end(int i);
+vector<int> find_top_level_statements();
+
+// Workers for parallel mode, created on first use with parallel_threads threads.
+ThreadPool& parser_thread_pool();
+
+// Incremental reparsing: error-free compound statements and runs of simple
+// statements are cached under a hash of their tokens, so after an edit only
+// the blocks around it are parsed again. Line numbers are not hashed, so a block that only moved is reused.
+struct CachedSubtree {
+    shared_ptr<ParseTreeNode> node;
+    int start;      // token index it was parsed at
+    int length;
+};
+
+struct CachedRange {
+    uint64_t key;   // of its CachedSubtree
+    int length;
+};
+
+struct SubtreeCache {
+    // One entry per occurrence, so repeated code keeps a subtree for each copy
+    unordered_multimap<uint64_t, CachedSubtree> previous;  // from the last parse
+    unordered_multimap<uint64_t, CachedSubtree> current;   // filled by this parse
+    // Cached ranges by start token, so a parse after a known edit finds the
+    // unchanged ones without rescanning their statements.
+    unordered_map<int, CachedRange> previousRanges;
+    unordered_map<int, CachedRange> currentRanges;
+    TokenEdit edit;         // every token change since the last parse,
+    bool edited = false;    // if set; cleared by each parse
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+extern thread_local SubtreeCache* subtreeCache;      // set only for incremental parses
+extern thread_local int cacheBypassIndex;            // statement being parsed to fill the cache
+
+// Dense IDs for the tokens that decide which statement rule applies, so
+// parse_statement() dispatches through a table instead of a chain of string
+// compares. Keywords are classified by value, as the rules compare them.
+enum class StatementToken : uint8_t {
+    OTHER, IDENTIFIER, NEWLINE, INDENT,
+    IMPORT, FROM, DEF, CLASS, TRY, RETURN, IF, WHILE, FOR, YIELD, BREAK, CONTINUE, DEL,
+    ELIF, ELSE, EXCEPT, FINALLY,
+    COUNT
+};
+
+StatementToken statement_token(const Token& tok);
+
+constexpr uint32_t token_bit(StatementToken t) { return 1u << (unsigned)t; }
+
+// Statements with an indented body; the unit of incremental reparsing.
+constexpr uint32_t COMPOUND_STATEMENT_FIRST =
+    token_bit(StatementToken::IF) | token_bit(StatementToken::WHILE) |
+    token_bit(StatementToken::FOR) | token_bit(StatementToken::DEF) |
+    token_bit(StatementToken::CLASS) | token_bit(StatementToken::TRY);
+
+// Clauses that continue the compound statement before them.
+constexpr uint32_t CONTINUATION_CLAUSE_FIRST =
+    token_bit(StatementToken::ELIF) | token_bit(StatementToken::ELSE) |
+    token_bit(StatementToken::EXCEPT) | token_bit(StatementToken::FINALLY);
+
+inline bool starts_statement(const Token& tok, uint32_t firstSet) {
+    return (token_bit(statement_token(tok)) & firstSet) != 0;
+}
+
+void build_token_hashes();
+void update_token_hashes(const TokenEdit& edit);   // after relexEdit()
+uint64_t token_range_hash(int start, int end);
+uint64_t subtree_key(int start, int end);
+bool is_compound_statement_start(const Token& tok);
+
+// Lazy bodies: with lazy_bodies set, TreeParser skips each function body
+// that has a matching DEDENT in O(1) and leaves a lazy_body node holding its
+// token range. Class bodies are still parsed, so method signatures are in the
+// tree. The body is parsed when first asked for through function_body() or
+// expand_lazy_body(), against the tokens of the same parse; its syntax errors
+// are reported then.
+extern bool lazy_bodies;
+
+struct LazyBodyNode : ParseTreeNode {
+    int begin;              // first body token, after the INDENT
+    int end;                // the matching DEDENT
+    bool balanced;          // every bracket and INDENT inside is matched
+    string function;        // enclosing function, for context checks
+    int nestingDepth;       // nesting level the body starts at
+
+    LazyBodyNode(int begin, int end, bool balanced, const string& function, int nestingDepth);
+};
+
+shared_ptr<ParseTreeNode> make_lazy_body(int begin, int end);
+
+// Replaces a lazy_body node in place with the parsed statement_list. Returns
+// false if slot is not a lazy body.
+bool expand_lazy_body(shared_ptr<ParseTreeNode>& slot);
+
+// Expands every lazy body under root, including nested ones.
+void expand_lazy_bodies(shared_ptr<ParseTreeNode>& root);
+
+// statement_list of a func_def node, parsed now if it was skipped; null for
+// a one-line function.
+shared_ptr<ParseTreeNode> function_body(const shared_ptr<ParseTreeNode>& funcDef);
+
+// Source ranges: token leaves take the range of the token they are made for;
+// rule nodes record where they start and get their end from their children
+// in compute_source_ranges(), which only descends into nodes not yet done.
+
+// Offset of the token at tokenIndex, or the end of the input.
+uint32_t current_source_offset();
+
+void compute_source_ranges(const shared_ptr<ParseTreeNode>& root);
+
+// Deep copy of a cached subtree reused delta tokens and offsetDelta bytes
+// away from where it was parsed.
+shared_ptr<ParseTreeNode> shift_subtree(const shared_ptr<ParseTreeNode>& root, int delta, int64_t offsetDelta);
+// The same for a subtree the cache takes over from the previous parse: nodes
+// only the cache still holds are moved in place, shared ones are copied, so
+// a tree still held elsewhere never changes.
+void shift_cached_subtree(shared_ptr<ParseTreeNode>& root, int delta, int64_t offsetDelta);
+
+// Builder policies. make() creates a node, add() appends a child and ignores
+// empty ones, finish() runs once on the finished tree. Node must be
+// default-constructible as "no node" and testable in a boolean context.
+struct TreeBuilder {
+    typedef shared_ptr<ParseTreeNode> Node;
+    static const bool buildsTree = true;
+
+    static Node make(const string& name, const string& value = "") {
+        Node node = make_node(name, value);
+        const Token& tok = peek();
+        node->sourceStart = current_source_offset();
+        if (is_token_kind(node->kind)) {
+            // A leaf made for a token the input lacks is empty
+            node->sourceEnd = node->sourceStart + (tok.type == name ? tok.length : 0);
+        }
+        return node;
+    }
+    static void add(const Node& parent, const Node& child) {
+        if (child) parent->addChild(child);
+    }
+    static void finish(const Node& root) { compute_source_ranges(root); }
+};
+
+struct NullBuilder {
+    struct Node {
+        explicit operator bool() const { return false; }
+    };
+    static const bool buildsTree = false;
+
+    template <typename... Args>
+    static Node make(const Args&...) { return Node(); }
+    static void add(Node, Node) {}
+    static void finish(Node) {}
+};
+
+#include "parser_rules.h"
+
+typedef Parser<TreeBuilder> TreeParser;
+typedef Parser<NullBuilder> Validator;
+
+#endif // PARSER_CORE_H
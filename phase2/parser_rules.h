@@ -0,0 +1,1738 @@
+#ifndef PARSER_RULES_H
+#define PARSER_RULES_H
+
+// Grammar rules of the recursive-descent parser, included from parser_core.h.
+// Each rule creates its node with Builder::make() and attaches children with
+// Builder::add(); everything else (token handling, diagnostics, recovery,
+// nesting limits) is shared by every Builder.
+
+template <typename Builder>
+struct Parser {
+    typedef typename Builder::Node Node;
+
+    struct SegmentResult {
+        vector<Node> statements;
+        vector<Diagnostic> diagnostics;
+    };
+
+    // Parses tokens [start, end) on the calling thread into a fresh arena.
+    static void parse_segment(int start, int end, SegmentResult& result) {
+        if (Builder::buildsTree) nodeArena = make_shared<NodeArena>();
+        tokenEnd = end;
+        seek(start);
+        diagnostics.clear();
+        panic_mode = false;
+        error_limit_reached = false;
+        nestingDepth = 0;
+        contextStack = {{ContextKind::MODULE, ""}};
+        while (peek().type != "END_OF_FILE") {
+            auto child = parse_statement();
+            if (child) result.statements.push_back(child);
+        }
+        result.diagnostics.swap(diagnostics);
+        nodeArena.reset();
+    }
+
+    // Returns false, having parsed nothing, if the input does not split into
+    // at least two segments.
+    static bool parse_program_parallel(Node& node) {
+        vector<int> starts = find_top_level_statements();
+        if (starts.size() < 2) return false;
+
+        // Group statements into segments of similar size, a few per thread
+        size_t target = max(MIN_SEGMENT_TOKENS, tokens.size() / (parallel_threads * 4));
+        vector<pair<int, int>> segments;
+        int segmentStart = 0;
+        for (size_t s = 1; s <= starts.size(); s++) {
+            int end = s < starts.size() ? starts[s] : tokens.size();
+            if (end - segmentStart >= (int)target || s == starts.size()) {
+                segments.push_back({segmentStart, end});
+                segmentStart = end;
+            }
+        }
+        if (segments.size() < 2) return false;
+
+        ThreadPool& pool = parser_thread_pool();
+        vector<SegmentResult> results(segments.size());
+        NullBuffer discard;
+        streambuf* console = cout.rdbuf(&discard);
+        for (size_t s = 0; s < segments.size(); s++) {
+            pool.submit([&, s] { parse_segment(segments[s].first, segments[s].second, results[s]); });
+        }
+        pool.wait();
+        cout.rdbuf(console);
+
+        node = Builder::make("program");
+        diagnostics.clear();
+        for (SegmentResult& result : results) {
+            for (auto& statement : result.statements) Builder::add(node, statement);
+            for (const Diagnostic& d : result.diagnostics) {
+                if (error_limit_reached) break;
+                diagnostics.push_back(d);
+                error_limit_reached = fast_fail || (max_errors > 0 && (int)diagnostics.size() >= max_errors);
+            }
+        }
+        seek(tokens.size());
+        return true;
+    }
+
+    // Only instantiated for TreeBuilder: the cache holds built subtrees.
+    static Node parse_statement_cached() {
+        int start = tokenIndex;
+        int end = unchanged_range_end(start, 0);
+        if (end < 0) end = statement_end(start);
+        int savedBypass = cacheBypassIndex;
+        cacheBypassIndex = start;
+        if (end < 0 || end > tokenEnd) {
+            auto node = parse_statement();
+            cacheBypassIndex = savedBypass;
+            return node;
+        }
+
+        uint64_t key = subtree_key(start, end);
+        Node node;
+        if (reuse_cached(key, start, end, node)) {
+            cacheBypassIndex = savedBypass;
+            return node;
+        }
+
+        subtreeCache->misses++;
+        size_t errorsBefore = diagnostics.size();
+        bool cleanStart = !panic_mode;
+        node = parse_statement();
+        cacheBypassIndex = savedBypass;
+        if (cleanStart && diagnostics.size() == errorsBefore && tokenIndex == end && node) {
+            subtreeCache->current.insert({key, {node, start, end - start}});
+            subtreeCache->currentRanges[start] = {key, end - start};
+        }
+        return node;
+    }
+
+    // End of the range cached at start by the previous parse, if the edit
+    // since then left its tokens and the token after them (which decides
+    // where a statement ends) alone and it is keyed the same here; else -1.
+    static int unchanged_range_end(int start, uint64_t salt) {
+        if (!subtreeCache->edited) return -1;
+        const TokenEdit& edit = subtreeCache->edit;
+        int old = previous_start(start);
+        if (old < 0) return -1;
+        auto range = subtreeCache->previousRanges.find(old);
+        if (range == subtreeCache->previousRanges.end()) return -1;
+        int length = range->second.length;
+        if (old < edit.first + edit.removed && old + length >= edit.first) return -1;
+        int end = start + length;
+        if (end > (int)min(tokenEnd, tokens.size()) || (subtree_key(start, end) ^ salt) != range->second.key) {
+            return -1;
+        }
+        return end;
+    }
+
+    // Token index that start had in the previous parse, or -1 if the edit
+    // since then replaced it.
+    static int previous_start(int start) {
+        if (!subtreeCache->edited) return start;
+        const TokenEdit& edit = subtreeCache->edit;
+        if (start >= edit.first + edit.inserted) return start - edit.inserted + edit.removed;
+        return start < edit.first ? start : -1;
+    }
+
+    // Takes the subtree cached under key for tokens[start, end) into this
+    // parse's cache and skips its tokens. A hit from the previous parse is
+    // moved, not copied, so unchanged subtrees cost no allocation. Of equal
+    // subtrees the one parsed at this position needs no shifting; only the
+    // first few are searched for it, so many copies stay linear.
+    static bool reuse_cached(uint64_t key, int start, int end, Node& node) {
+        auto [first, last] = subtreeCache->previous.equal_range(key);
+        auto it = first;
+        int old = previous_start(start);
+        for (int tries = 0; it != last && it->second.start != old && tries < 8; tries++) ++it;
+        if (it == last || it->second.start != old) it = first;
+        bool fromPrevious = it != last;
+        CachedSubtree* cached = nullptr;
+        if (fromPrevious) {
+            auto entry = subtreeCache->previous.extract(it);
+            cached = &subtreeCache->current.insert(std::move(entry))->second;
+        } else {
+            auto current = subtreeCache->current.find(key);
+            if (current != subtreeCache->current.end()) cached = &current->second;
+        }
+        if (!cached || cached->length != end - start) return false;
+
+        subtreeCache->hits++;
+        int64_t offsetDelta = (int64_t)tokens[start].offset - cached->node->sourceStart;
+        if (fromPrevious && (cached->start != start || offsetDelta != 0)) {
+            // Moved by the edit
+            shift_cached_subtree(cached->node, start - cached->start, offsetDelta);
+            cached->start = start;
+            node = cached->node;
+        } else if (cached->start != start || offsetDelta != 0) {
+            // The same tokens elsewhere in the file: copy with moved ranges,
+            // kept as its own occurrence for the next parse
+            node = shift_subtree(cached->node, start - cached->start, offsetDelta);
+            subtreeCache->current.insert({key, {node, start, end - start}});
+        } else {
+            node = cached->node;
+        }
+        subtreeCache->currentRanges[start] = {key, end - start};
+        seek(end);
+        panic_mode = false;
+        return true;
+    }
+
+    // Longest statements a cached run may hold, and the hash test that ends
+    // a run early. Boundaries depend only on each statement's own tokens, so
+    // an edit moves at most the boundaries next to it.
+    static const int MAX_RUN_STATEMENTS = 64;
+    static bool ends_run(int start, int end) { return token_range_hash(start, end) % 16 == 0; }
+
+    // Only instantiated for TreeBuilder. Adds the run of simple statements at
+    // tokenIndex to parent, reusing the whole run when the same tokens were
+    // parsed before in the same context, as parse_statement_list() (or, with
+    // loopStatements, parse_loop_statement_list()) would add them one by one.
+    // Returns false if no run starts here.
+    template <bool loopStatements>
+    static bool add_statement_run_cached(const Node& parent) {
+        // Runs start at simple statements and cached compound statements do
+        // not, so their keys never meet; loop and plain runs build different nodes
+        const uint64_t salt = loopStatements ? 0x5bd1e995ULL : 0;
+        int start = tokenIndex;
+        if (start >= (int)min(tokenEnd, tokens.size()) || is_compound_statement_start(tokens[start])) return false;
+        int end = unchanged_range_end(start, salt);
+        if (end < 0) end = run_end(start);
+        if (end == start) return false;
+
+        uint64_t key = subtree_key(start, end) ^ salt;
+        Node run;
+        if (!reuse_cached(key, start, end, run)) {
+            subtreeCache->misses++;
+            size_t errorsBefore = diagnostics.size();
+            bool cleanStart = !panic_mode;
+            run = Builder::make("statement_list");
+            while (tokenIndex < end && peek().type != "DEDENT" && peek().type != "END_OF_FILE") {
+                Builder::add(run, loopStatements ? parse_loop_statement() : parse_statement());
+            }
+            if (cleanStart && diagnostics.size() == errorsBefore && tokenIndex == end) {
+                subtreeCache->current.insert({key, {run, start, end - start}});
+                subtreeCache->currentRanges[start] = {key, end - start};
+            }
+        }
+        for (const auto& statement : run->children) Builder::add(parent, statement);
+        return true;
+    }
+
+    static int run_end(int start) {
+        int end = start;
+        int limit = min(tokenEnd, tokens.size());
+        for (int count = 0; count < MAX_RUN_STATEMENTS && end < limit; count++) {
+            const Token& tok = tokens[end];
+            if (tok.type == "DEDENT" || is_compound_statement_start(tok)) break;
+            int next = statement_end(end);
+            if (next < 0 || next > limit) break;
+            bool last = ends_run(end, next);
+            end = next;
+            if (last) break;
+        }
+        return end;
+    }
+
+    static Node parse_program() {
+        RuleGuard rule("program");
+        if (parallel_threads > 0) {
+            Node node;
+            if (parse_program_parallel(node)) {
+                Builder::finish(node);
+                return node;
+            }
+        }
+        auto node = Builder::make("program");
+        cout << "\nDEBUG: Starting program parsing..." << endl;
+        while (peek().type != "END_OF_FILE") {
+            if constexpr (Builder::buildsTree) {
+                if (subtreeCache && add_statement_run_cached<false>(node)) continue;
+            }
+            auto child = parse_statement();
+            Builder::add(node, child);
+        }
+        cout << "DEBUG: Program parsing completed" << endl;
+        Builder::finish(node);
+        return node;
+    }
+
+    static Node parse_statement() {
+        RuleGuard rule("statement");
+        if (nestingDepth >= max_nesting_depth) {
+            skip_too_deep_statement();
+            return Node();
+        }
+        if constexpr (Builder::buildsTree) {
+            if (subtreeCache && tokenIndex != cacheBypassIndex && is_compound_statement_start(peek())) {
+                return parse_statement_cached();
+            }
+        }
+        NestingGuard guard;
+        auto node = Builder::make("statement");
+        cout << "\nDEBUG: Parsing statement" << endl;
+        cout << "DEBUG: Current token - Type: " << peek().type 
+             << ", Value: '" << peek().value << "'" << endl;
+
+        // Indexed by StatementToken. debug, when set, is printed before the rule runs.
+        static constexpr StatementRule rules[] = {
+            {nullptr, parse_unexpected_statement},                              // OTHER
+            {nullptr, parse_identifier_statement},                              // IDENTIFIER
+            {"DEBUG: Found newline", parse_empty_statement},                    // NEWLINE
+            {"DEBUG: Unexpected indented block", parse_unexpected_block},       // INDENT
+            {"DEBUG: Found import statement", parse_import_stmt},               // IMPORT
+            {"DEBUG: Found import statement", parse_import_stmt},               // FROM
+            {"DEBUG: Found function definition", parse_func_def},               // DEF
+            {"DEBUG: Found class definition", parse_class_def},                 // CLASS
+            {"DEBUG: Found try statement", parse_try_stmt},                     // TRY
+            {"DEBUG: Found return statement", parse_return_stmt},               // RETURN
+            {"DEBUG: Found if statement", parse_if_stmt},                       // IF
+            {"DEBUG: Found while statement", parse_while_stmt},                 // WHILE
+            {nullptr, parse_for_stmt},                                          // FOR
+            {"DEBUG: Found yield statement", parse_yield_stmt},                 // YIELD
+            {"DEBUG: Found break statement", parse_break_stmt},                 // BREAK
+            {"DEBUG: Found continue statement", parse_continue_stmt},           // CONTINUE
+            {"DEBUG: Found delete statement", parse_del_stmt},                  // DEL
+            {nullptr, parse_unexpected_statement},                              // ELIF
+            {nullptr, parse_unexpected_statement},                              // ELSE
+            {nullptr, parse_unexpected_statement},                              // EXCEPT
+            {nullptr, parse_unexpected_statement},                              // FINALLY
+        };
+        static_assert(sizeof(rules) / sizeof(rules[0]) == (size_t)StatementToken::COUNT,
+                      "one statement rule per StatementToken");
+
+        const StatementRule& entry = rules[(size_t)statement_token(peek())];
+        if (entry.debug) cout << entry.debug << endl;
+        Builder::add(node, entry.parse());
+        return node;
+    }
+
+    struct StatementRule {
+        const char* debug;
+        Node (*parse)();
+    };
+
+    // Assignment, augmented assignment or call; anything else is an error.
+    static Node parse_identifier_statement() {
+        string op;
+        if (is_assignment_target(tokenIndex, op)) {
+            if (op == "=") {
+                cout << "DEBUG: Found assignment statement" << endl;
+                return parse_assignment();
+            }
+            if (is_augmented_assign_op(op)) {
+                cout << "DEBUG: Found augmented assignment statement" << endl;
+                return parse_augmented_assignment();
+            }
+            return Node();
+        }
+        if (tokenIndex + 1 < tokens.size() && tokens[tokenIndex + 1].value == "(") {
+            cout << "DEBUG: Found function call" << endl;
+            return parse_func_call();
+        }
+        return parse_unexpected_statement();
+    }
+
+    static Node parse_empty_statement() {
+        auto node = Builder::make("NEWLINE");
+        advance();
+        return node;
+    }
+
+    // Unexpected indent: report it, then parse the block in place so its
+    // matching DEDENT does not produce a second error
+    static Node parse_unexpected_block() {
+        report_error(DiagCode::UNEXPECTED_TOKEN);
+        advance();
+        auto block = parse_statement_list();
+        if (peek().type == "DEDENT") advance();
+        return block;
+    }
+
+    static Node parse_unexpected_statement() {
+        cout << "DEBUG: Unexpected token in statement" << endl;
+        report_error(DiagCode::UNEXPECTED_TOKEN);
+        skip_statement();
+        return Node();
+    }
+
+    static Node parse_assignment(){
+        RuleGuard rule("assignment");
+        auto node = Builder::make("assignment");
+        cout << "\nDEBUG: Starting assignment parsing" << endl;
+        auto child1 = parse_assign_target();
+        Builder::add(node, child1);
+
+        auto opNode = Builder::make("OPERATOR", currentToken.value);
+        Builder::add(node, opNode);
+        match("OPERATOR");
+
+        auto child2 = parse_expression();
+        Builder::add(node, child2);
+
+        if (peek().type == "NEWLINE") {
+            Builder::add(node, Builder::make("NEWLINE"));
+            match("NEWLINE");
+        }
+
+        cout << "DEBUG: Assignment parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_assign_target(){
+        auto node = Builder::make("assign_target");
+        cout<< "\nDEBUG: Starting assignment target parsing" << endl;
+        auto child1 = parse_primary_target();
+        Builder::add(node, child1);
+        auto child2 = parse_assign_target_tail();
+        Builder::add(node, child2);
+        cout << "DEBUG: Assignment target parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_primary_target(){
+        auto node = Builder::make("primary_target");
+        cout<< "\nDEBUG: Starting primary target parsing" << endl;
+        if(peek().type == "IDENTIFIER"){
+            cout << "DEBUG: Found identifier in primary target" << endl;
+            Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+            match("IDENTIFIER");
+            if(peek().type == "DELIMITER" && peek().value == "[") {
+                cout << "DEBUG: Found list literal in primary target" << endl;
+                Builder::add(node, Builder::make("DELIMITER", "["));
+                match("DELIMITER");
+                auto child = parse_expression();
+                Builder::add(node, child);
+                Builder::add(node, Builder::make("DELIMITER", "]"));
+                match("DELIMITER");
+            }
+        }
+        cout<< "DEBUG: Primary target parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_assign_target_tail(){
+        auto node = Builder::make("assign_target_tail");
+        if(peek().type == "DELIMITER" && peek().value == "."){
+            cout << "DEBUG: Found dot operator in assignment target" << endl;
+            Builder::add(node, Builder::make("DELIMITER", "."));
+            match("DELIMITER");
+            Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+            match("IDENTIFIER");
+            auto child = parse_assign_target_tail();
+            Builder::add(node, child);
+        }
+        return node;
+    }
+
+    static Node parse_return_stmt(){
+        RuleGuard rule("return_stmt");
+        auto node = Builder::make("return_stmt");
+        cout << "\nDEBUG: Starting return statement parsing" << endl;
+        Builder::add(node, Builder::make("KEYWORD", "return"));
+        match("KEYWORD");
+        if (!is_inside_function()) {
+            report_error(DiagCode::RETURN_OUTSIDE_FUNCTION);
+        }
+        auto child = parse_expression();
+        Builder::add(node, child);
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        cout << "DEBUG: Return statement parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_yield_stmt(){
+        RuleGuard rule("yield_stmt");
+        auto node = Builder::make("yield_stmt");
+        cout << "\nDEBUG: Starting yield statement parsing" << endl;
+        Builder::add(node, Builder::make("KEYWORD", "yield"));
+        match("KEYWORD");
+        if (!is_inside_function()) {
+            report_error(DiagCode::YIELD_OUTSIDE_FUNCTION);
+        }
+        if (peek().type != "NEWLINE") {
+            auto child = parse_expression();
+            Builder::add(node, child);
+        }
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        cout << "DEBUG: Yield statement parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_if_stmt() {
+        RuleGuard rule("if_stmt");
+        auto node = Builder::make("if_stmt");
+        cout << "\nDEBUG: Starting if statement parsing" << endl;
+
+        // 'if' keyword
+        Builder::add(node, Builder::make("KEYWORD", "if"));
+        match("KEYWORD");
+
+        // Expression
+        auto expr = parse_expression();
+        Builder::add(node, expr);
+
+        // Colon operator
+        Builder::add(node, Builder::make("OPERATOR", ":"));
+        match("OPERATOR");
+
+        // Newline
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+
+        // Indent
+        Builder::add(node, Builder::make("INDENT"));
+        match("INDENT");
+
+        // Statement list
+        auto stmtList = parse_statement_list();
+        Builder::add(node, stmtList);
+
+        // Dedent
+        Builder::add(node, Builder::make("DEDENT"));
+        match("DEDENT");
+
+        // Optional elif and else parts (they'll handle their own existence checks)
+        if (peek().value == "elif") {
+            auto elif = parse_elif_stmt();
+            Builder::add(node, elif);
+        }
+
+        if (peek().value == "else") {
+            auto elsePart = parse_else_part();
+            Builder::add(node, elsePart);
+        }
+
+        cout << "DEBUG: If statement parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_elif_stmt(){
+        RuleGuard rule("elif_parts");
+        auto node = Builder::make("elif_stmt");
+        cout << "\nDEBUG: Starting elif statement parsing" << endl;
+        if(peek().value != "elif"){
+            cout << "DEBUG: No elif clause found" << endl;
+            return node;
+        }
+        Builder::add(node, Builder::make("KEYWORD", "elif"));
+        match("KEYWORD");
+        auto expr = parse_expression();
+        Builder::add(node, expr);
+        Builder::add(node, Builder::make("OPERATOR", ":"));
+        match("OPERATOR");
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        Builder::add(node, Builder::make("INDENT"));
+        match("INDENT");
+        auto stmtList = parse_statement_list();
+        Builder::add(node, stmtList);
+        Builder::add(node, Builder::make("DEDENT"));
+        match("DEDENT");
+        cout << "DEBUG: Elif statement parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_else_part(){
+        RuleGuard rule("else_part");
+        auto node = Builder::make("else_part");
+        cout << "\nDEBUG: Starting else part parsing" << endl;
+        if(peek().value == "else"){
+            cout << "DEBUG: Found else clause" << endl;
+            Builder::add(node, Builder::make("KEYWORD", "else"));
+            match("KEYWORD");
+            Builder::add(node, Builder::make("OPERATOR", ":"));
+            match("OPERATOR");
+            Builder::add(node, Builder::make("NEWLINE"));
+            match("NEWLINE");
+            Builder::add(node, Builder::make("INDENT"));
+            match("INDENT");
+            auto stmtList = parse_statement_list();
+            Builder::add(node, stmtList);
+            Builder::add(node, Builder::make("DEDENT"));
+            match("DEDENT");
+        } else {
+            cout << "DEBUG: No else clause found" << endl;
+        }
+        cout << "DEBUG: Else part parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_while_stmt(){
+        RuleGuard rule("while_stmt");
+        auto node = Builder::make("while_stmt");
+        cout << "\nDEBUG: Starting while statement parsing" << endl;
+        Builder::add(node, Builder::make("KEYWORD", "while"));
+        match("KEYWORD");
+        auto expr = parse_expression();
+        Builder::add(node, expr);
+        Builder::add(node, Builder::make("OPERATOR", ":"));
+        match("OPERATOR");
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        Builder::add(node, Builder::make("INDENT"));
+        match("INDENT");
+        contextStack.back().loopDepth++;
+        auto loopList = parse_loop_statement_list();
+        contextStack.back().loopDepth--;
+        Builder::add(node, loopList);
+        Builder::add(node, Builder::make("DEDENT"));
+        match("DEDENT");
+        cout << "DEBUG: While statement parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_func_call(){
+        RuleGuard rule("func_call");
+        auto node = Builder::make("func_call");
+        cout << "\nDEBUG: Starting function call parsing" << endl;
+        Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+        match("IDENTIFIER");
+        if (nestingDepth >= max_nesting_depth) {
+            // Arguments are expressions a level down, so f(f(...)) nests like brackets
+            skip_too_deep_group();
+        } else {
+            Builder::add(node, Builder::make("DELIMITER", "("));
+            match("DELIMITER");  // Opening parenthesis
+            auto argList = parse_argument_list();
+            Builder::add(node, argList);
+            Builder::add(node, Builder::make("DELIMITER", ")"));
+            match("DELIMITER");  // Closing parenthesis
+        }
+        if (peek().type == "NEWLINE") {
+            Builder::add(node, Builder::make("NEWLINE"));
+            match("NEWLINE");
+        }
+        cout << "DEBUG: Function call parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_argument_list() {
+        RuleGuard rule("argument_list");
+        auto node = Builder::make("argument_list");
+        cout << "\nDEBUG: Starting argument list parsing" << endl;
+        if (peek().type != "DELIMITER" || peek().value != ")") {
+            cout << "DEBUG: Found first argument" << endl;
+            if (peek().type == "STRING_QUOTE") {
+                Builder::add(node, Builder::make("STRING_QUOTE", currentToken.value));
+                match("STRING_QUOTE");  // Match opening quote
+                if (peek().type == "STRING_LITERAL") {
+                    Builder::add(node, Builder::make("STRING_LITERAL", currentToken.value));
+                    match("STRING_LITERAL");  // Match string content
+                }
+                Builder::add(node, Builder::make("STRING_QUOTE", currentToken.value));
+                match("STRING_QUOTE");  // Match closing quote
+            } else {
+                auto expr = parse_expression();
+                Builder::add(node, expr);  // Handle other types of arguments
+            }
+            auto prime = parse_argument_list_prime();
+            Builder::add(node, prime);  // Check for additional ones
+        } else {
+            cout << "DEBUG: Empty argument list" << endl;
+        }
+        cout << "DEBUG: Argument list parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_argument_list_prime(){
+        RuleGuard rule("argument_list_prime");
+        auto node = Builder::make("argument_list_prime");
+        cout << "\nDEBUG: Starting argument list prime parsing" << endl;
+        if(peek().type == "DELIMITER" && peek().value == ","){
+            cout << "DEBUG: Found additional argument" << endl;
+            Builder::add(node, Builder::make("DELIMITER", ","));
+            match("DELIMITER");  // Comma
+            auto expr = parse_expression();
+            Builder::add(node, expr);
+            auto prime = parse_argument_list_prime();
+            Builder::add(node, prime);
+        } else {
+            cout << "DEBUG: No more arguments" << endl;
+        }
+        cout << "DEBUG: Argument list prime parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_statement_list(){
+        RuleGuard rule("statement_list");
+        auto node = Builder::make("statement_list");
+        cout << "\nDEBUG: Starting statement list parsing" << endl;
+        // Loop rather than recurse per statement, so long blocks use constant stack.
+        // A block always ends at its DEDENT; stray tokens before it are reported
+        // by parse_statement instead of ending the block early.
+        while (peek().type != "DEDENT" && peek().type != "END_OF_FILE") {
+            cout << "DEBUG: Found valid statement" << endl;
+            if constexpr (Builder::buildsTree) {
+                if (subtreeCache && add_statement_run_cached<false>(node)) continue;
+            }
+            auto stmt = parse_statement();
+            Builder::add(node, stmt);
+        }
+        cout << "DEBUG: End of statement list" << endl;
+        cout << "DEBUG: Statement list parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_expression(){
+        RuleGuard rule("expression");
+        NestingGuard guard;
+        auto node = Builder::make("expression");
+        cout << "\nDEBUG: Starting expression parsing" << endl;
+        cout << "DEBUG: Current token in expression - Type: " << peek().type 
+             << ", Value: '" << peek().value << "'" << endl;
+        auto expr = iterative_expressions ? parse_binary_expr_iterative(0) : parse_binary_expr(0);
+        Builder::add(node, expr);
+
+        if (peek().type == "KEYWORD" && peek().value == "if") {
+            auto inlineIf = parse_inline_if_else();
+            Builder::add(node, inlineIf);
+        }
+        cout << "DEBUG: Expression parsing completed" << endl;
+        return node;
+    }
+
+    // Precedence climbing: parse one operand, then fold in every binary operator
+    // that binds at least as tightly as minBindingPower. Each operator costs a
+    // single recursive call for its right-hand side.
+    static Node parse_binary_expr(int minBindingPower){
+        auto left = parse_unary_expr();
+        while (true) {
+            int width = 0;
+            string op = peek_infix_operator(width);
+            if (op.empty()) break;
+            const pair<int, int>& bindingPower = INFIX_BINDING_POWER.at(op);
+            if (bindingPower.first < minBindingPower) break;
+
+            auto node = Builder::make("binary_expr");
+            Builder::add(node, left);
+            Builder::add(node, Builder::make("OPERATOR", op));
+            for (int i = 0; i < width; i++) advance();
+            if (nestingDepth >= max_nesting_depth) {
+                skip_too_deep_operand();
+                Builder::add(node, Builder::make("factor"));
+            } else {
+                NestingGuard guard;
+                auto right = parse_binary_expr(bindingPower.second);
+                Builder::add(node, right);
+            }
+            left = node;
+        }
+        return left;
+    }
+
+    static Node parse_unary_expr(){
+        RuleGuard rule("unary_expr");
+        int bindingPower = prefix_binding_power(peek());
+        if (bindingPower < 0) {
+            return parse_factor();
+        }
+        if (nestingDepth >= max_nesting_depth) {
+            skip_too_deep_operand();
+            return Builder::make("factor");
+        }
+        NestingGuard guard;
+        auto node = Builder::make("unary_expr");
+        Builder::add(node, Builder::make("OPERATOR", peek().value));
+        advance();
+        auto operand = parse_binary_expr(bindingPower);
+        Builder::add(node, operand);
+        return node;
+    }
+
+    // Explicit-stack version of parse_binary_expr(). It builds the same tree, but
+    // operator, parenthesis and list-literal nesting is kept in a heap-allocated
+    // frame stack, so deeply nested input is bounded by max_nesting_depth rather
+    // than by the C++ call stack. The stack is shared by all calls on a thread:
+    // a nested call (an argument, subscript or dict value) stacks its frames on
+    // top and pops them before returning, so once the stack has grown, parsing
+    // allocates nothing for it. Prefix operators and right operands count as
+    // a level each while open, so long "- - x" or "a ** a ** b" chains hit the
+    // limit too. Atoms (names, calls, dicts, strings) still go through
+    // parse_factor().
+    enum class ExprFrameKind { BINARY, PREFIX, EXPRESSION, PAREN, LIST };
+
+    struct ExprFrame {
+        ExprFrameKind kind;
+        int minBindingPower;                  // BINARY: weakest operator it may fold in
+        Node node;       // receives the next finished operand
+        Node factor;     // PAREN/LIST: factor node being built
+        Node list;       // LIST: list_literal node being built
+
+        ExprFrame(ExprFrameKind kind, int minBindingPower, Node node = Node(), Node factor = Node(),
+                  Node list = Node())
+            : kind(kind), minBindingPower(minBindingPower), node(node), factor(factor), list(list) {}
+    };
+
+    static vector<ExprFrame>& expr_frames() {
+        static thread_local vector<ExprFrame> frames;
+        return frames;
+    }
+
+    static Node parse_binary_expr_iterative(int minBindingPower){
+        vector<ExprFrame>& stack = expr_frames();
+        const size_t base = stack.size();   // frames below belong to enclosing calls
+        stack.push_back({ExprFrameKind::BINARY, minBindingPower});
+        Node result;
+        bool needOperand = true;
+
+        while (true) {
+            if (needOperand) {
+                int bindingPower = prefix_binding_power(peek());
+                if (bindingPower >= 0) {
+                    if (nestingDepth >= max_nesting_depth) {
+                        skip_too_deep_operand();
+                        result = Builder::make("factor");
+                        needOperand = false;
+                        continue;
+                    }
+                    nestingDepth++;
+                    auto node = Builder::make("unary_expr");
+                    Builder::add(node, Builder::make("OPERATOR", peek().value));
+                    advance();
+                    stack.push_back({ExprFrameKind::PREFIX, 0, node});
+                    stack.push_back({ExprFrameKind::BINARY, bindingPower});
+                    continue;
+                }
+                bool paren = peek().type == "DELIMITER" && peek().value == "(";
+                bool list = peek().type == "DELIMITER" && peek().value == "[";
+                if (!paren && !list) {
+                    result = parse_factor();
+                    needOperand = false;
+                    continue;
+                }
+                auto factor = Builder::make("factor");
+                if (nestingDepth >= max_nesting_depth) {
+                    skip_too_deep_group();
+                    result = factor;
+                    needOperand = false;
+                    continue;
+                }
+                nestingDepth++;
+                if (paren) {
+                    Builder::add(factor, Builder::make("DELIMITER", "("));
+                    match("DELIMITER");
+                    stack.push_back({ExprFrameKind::PAREN, 0, factor, factor});
+                } else {
+                    auto listNode = Builder::make("list_literal");
+                    Builder::add(factor, listNode);
+                    Builder::add(listNode, Builder::make("DELIMITER", "["));
+                    match("DELIMITER");
+                    if (peek().value == "]") {
+                        Builder::add(listNode, Builder::make("DELIMITER", "]"));
+                        match("DELIMITER");
+                        nestingDepth--;
+                        result = factor;
+                        needOperand = false;
+                        continue;
+                    }
+                    stack.push_back({ExprFrameKind::LIST, 0, listNode, factor, listNode});
+                }
+                stack.push_back({ExprFrameKind::EXPRESSION, 0, Builder::make("expression")});
+                stack.push_back({ExprFrameKind::BINARY, 0});
+                continue;
+            }
+
+            // An operand is finished: hand it to the frame on top of the stack.
+            ExprFrame& frame = stack.back();
+            switch (frame.kind) {
+                case ExprFrameKind::BINARY: {
+                    if (frame.node) {
+                        Builder::add(frame.node, result);
+                        result = frame.node;
+                        frame.node = Node();
+                    }
+                    int width = 0;
+                    string op = peek_infix_operator(width);
+                    if (!op.empty()) {
+                        const pair<int, int>& bindingPower = INFIX_BINDING_POWER.at(op);
+                        if (bindingPower.first >= frame.minBindingPower) {
+                            auto node = Builder::make("binary_expr");
+                            Builder::add(node, result);
+                            Builder::add(node, Builder::make("OPERATOR", op));
+                            for (int i = 0; i < width; i++) advance();
+                            frame.node = node;
+                            if (nestingDepth >= max_nesting_depth) {
+                                skip_too_deep_operand();
+                                result = Builder::make("factor");
+                                continue;
+                            }
+                            nestingDepth++;
+                            stack.push_back({ExprFrameKind::BINARY, bindingPower.second});
+                            needOperand = true;
+                            continue;
+                        }
+                    }
+                    stack.pop_back();
+                    if (stack.size() == base) return result;
+                    // Only a right operand sits directly on another BINARY frame
+                    if (stack.back().kind == ExprFrameKind::BINARY) nestingDepth--;
+                    break;
+                }
+                case ExprFrameKind::PREFIX:
+                    Builder::add(frame.node, result);
+                    result = frame.node;
+                    nestingDepth--;
+                    stack.pop_back();
+                    break;
+                case ExprFrameKind::EXPRESSION:
+                    Builder::add(frame.node, result);
+                    if (peek().type == "KEYWORD" && peek().value == "if") {
+                        auto inlineIf = parse_inline_if_else();
+                        // The nested parse may have moved the frames
+                        Builder::add(stack.back().node, inlineIf);
+                    }
+                    result = stack.back().node;
+                    stack.pop_back();
+                    break;
+                case ExprFrameKind::PAREN:
+                    Builder::add(frame.node, result);
+                    Builder::add(frame.node, Builder::make("DELIMITER", ")"));
+                    match("DELIMITER");
+                    nestingDepth--;
+                    result = frame.factor;
+                    stack.pop_back();
+                    break;
+                case ExprFrameKind::LIST: {
+                    Builder::add(frame.node, result);
+                    auto prime = Builder::make("list_items_prime");
+                    Builder::add(frame.node, prime);
+                    if (peek().type == "DELIMITER" && peek().value == ",") {
+                        Builder::add(prime, Builder::make("DELIMITER", ","));
+                        match("DELIMITER");
+                        frame.node = prime;
+                        stack.push_back({ExprFrameKind::EXPRESSION, 0, Builder::make("expression")});
+                        stack.push_back({ExprFrameKind::BINARY, 0});
+                        needOperand = true;
+                        continue;
+                    }
+                    Builder::add(frame.list, Builder::make("DELIMITER", "]"));
+                    match("DELIMITER");
+                    nestingDepth--;
+                    result = frame.factor;
+                    stack.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+
+    static Node parse_factor(){
+        RuleGuard rule("factor");
+        auto node = Builder::make("factor");
+        cout << "DEBUG: Starting factor parsing" << endl;
+        cout << "DEBUG: Current token in factor - Type: " << peek().type 
+             << ", Value: '" << peek().value << "'" << endl;
+
+        if ((peek().value == "(" || peek().value == "[" || peek().value == "{") &&
+            nestingDepth >= max_nesting_depth) {
+            skip_too_deep_group();
+            return node;
+        }
+        if(peek().value == "("){
+            cout << "DEBUG: Found opening parenthesis" << endl;
+            Builder::add(node, Builder::make("DELIMITER", "("));
+            match("DELIMITER");
+            auto expr = parse_expression();
+            Builder::add(node, expr);
+            Builder::add(node, Builder::make("DELIMITER", ")"));
+            match("DELIMITER");
+        }
+        else if(peek().type == "IDENTIFIER"){
+            cout << "DEBUG: Found identifier" << endl;
+
+            if (tokenIndex + 1 < tokens.size() && tokens[tokenIndex + 1].value == "(") {
+                auto funcCall = parse_func_call();
+                Builder::add(node, funcCall);
+            }   else   {
+                Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+                match("IDENTIFIER");
+            }
+        }
+        else if (peek().value == "{") {
+            cout << "DEBUG: Found dictionary literal" << endl;
+            auto dictLit = parse_dict_literal();
+            Builder::add(node, dictLit);
+        }
+        else if(peek().type == "NUMBER"){
+            cout << "DEBUG: Found number" << endl;
+            Builder::add(node, Builder::make("NUMBER", currentToken.value));
+            match("NUMBER");
+        }
+        else if (peek().type == "KEYWORD" &&
+                 (peek().value == "True" || peek().value == "False" || peek().value == "None")) {
+            cout << "DEBUG: Found constant" << endl;
+            Builder::add(node, Builder::make("KEYWORD", currentToken.value));
+            match("KEYWORD");
+        }
+        else if (peek().type == "STRING_QUOTE") {
+            cout << "DEBUG: Found string literal" << endl;
+            Builder::add(node, Builder::make("STRING_QUOTE", currentToken.value));
+            match("STRING_QUOTE");  // Match opening quote
+            bool closed = true;
+            while (peek().type != "STRING_QUOTE") {
+                if (peek().type == "STRING_LITERAL") {
+                    Builder::add(node, Builder::make("STRING_LITERAL", currentToken.value));
+                    match("STRING_LITERAL");
+                } else if (peek().type == "NEWLINE") {
+                    Builder::add(node, Builder::make("NEWLINE"));
+                    match("NEWLINE");
+                } else {
+                    // synchronize() may stop right here, so leave the loop
+                    report_error(peek().type == "END_OF_FILE" ? DiagCode::UNTERMINATED_STRING
+                                                              : DiagCode::UNEXPECTED_IN_STRING);
+                    synchronize();
+                    closed = false;
+                    break;
+                }
+            }
+            if (closed) {
+                Builder::add(node, Builder::make("STRING_QUOTE", currentToken.value));
+                match("STRING_QUOTE");  // Match closing quote
+            }
+        }
+        else if (peek().value == "[") {
+            cout << "DEBUG: Found list literal" << endl;
+            auto listLit = parse_list_literal();
+            Builder::add(node, listLit);
+        }
+        else{
+            cout << "DEBUG: Unexpected token in factor" << endl;
+            report_error(DiagCode::EXPECTED_FACTOR);
+            synchronize();
+        }
+        cout << "DEBUG: Factor parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_augmented_assignment() {
+        RuleGuard rule("augmented_assignment");
+        auto node = Builder::make("augmented_assignment");
+        cout << "\nDEBUG: Starting augmented assignment parsing" << endl;
+
+        Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+        match("IDENTIFIER");
+
+        if (peek().type == "OPERATOR" && is_augmented_assign_op(peek().value)) 
+        {
+            Builder::add(node, Builder::make("OPERATOR", currentToken.value));
+            match("OPERATOR");
+        } else {
+            report_error(DiagCode::EXPECTED_AUG_ASSIGN_OP);
+            synchronize();
+        }
+
+        auto expr = parse_expression();
+        Builder::add(node, expr);
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+
+        cout << "DEBUG: Augmented assignment parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_for_stmt() {
+        RuleGuard rule("for_stmt");
+        auto node = Builder::make("for_stmt");
+        cout << "\nDEBUG: Starting for-loop parsing" << endl;
+        if (peek().value != "for") {
+            report_error(DiagCode::EXPECTED_SYMBOL, "'for' keyword");
+            synchronize();
+        }
+
+        Builder::add(node, Builder::make("KEYWORD", "for"));
+        match("KEYWORD");         // 'for'
+
+        if (peek().type != "IDENTIFIER")    {
+            report_error(DiagCode::EXPECTED_LOOP_VARIABLE);
+            synchronize();
+
+            string loopVar = peek().value;
+            if (loopVar == "for" || loopVar == "in" || loopVar == "if" || loopVar == "while" || peek().type == "NUMBER") {
+                report_error(DiagCode::INVALID_LOOP_VARIABLE);
+                synchronize();
+            }
+        }
+
+        Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+        match("IDENTIFIER");      // loop variable
+
+        if (peek().value != "in") {
+            report_error(DiagCode::EXPECTED_SYMBOL, "'in' keyword");
+            synchronize();
+        }
+
+        Builder::add(node, Builder::make("KEYWORD", "in"));
+        match("KEYWORD");         // 'in'
+
+        int exprStartIndex = tokenIndex;
+
+        if (peek().type == "OPERATOR" && peek().value == ":") {
+            report_error(DiagCode::EXPECTED_ITERABLE);
+            synchronize();
+        }
+        auto expr = parse_expression();
+        Builder::add(node, expr);
+
+        if (tokenIndex == exprStartIndex) {
+            report_error(DiagCode::EXPECTED_ITERABLE);
+            synchronize();
+        }
+
+        if (peek().value != ":") {
+            report_error(DiagCode::EXPECTED_SYMBOL, "':' after iterable");
+            synchronize();
+        }
+
+        Builder::add(node, Builder::make("OPERATOR", ":"));
+        match("OPERATOR");       // ':'
+
+        if (peek().type != "NEWLINE") {
+            report_error(DiagCode::EXPECTED_SYMBOL, "NEWLINE after ':'");
+            synchronize();
+        }
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+
+        if (peek().type != "INDENT") {
+            report_error(DiagCode::EXPECTED_SYMBOL, "INDENT after NEWLINE");
+            synchronize();
+        }
+
+        Builder::add(node, Builder::make("INDENT"));
+        match("INDENT");
+        contextStack.back().loopDepth++;
+        auto loopList = parse_loop_statement_list();
+        contextStack.back().loopDepth--;
+        Builder::add(node, loopList);
+
+        if (peek().type != "DEDENT") {
+            report_error(DiagCode::EXPECTED_SYMBOL, "DEDENT after loop body");
+            synchronize();
+        }
+        Builder::add(node, Builder::make("DEDENT"));
+        match("DEDENT");
+        cout << "DEBUG: For-loop parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_list_literal() {
+        RuleGuard rule("list_literal");
+        auto node = Builder::make("list_literal");
+        cout << "\nDEBUG: Starting list literal parsing" << endl;
+
+        Builder::add(node, Builder::make("DELIMITER", "["));
+        match("DELIMITER");  // '['
+
+        if (peek().value != "]") {
+            cout << "DEBUG: Parsing first list item" << endl;
+            auto expr = parse_expression();
+            Builder::add(node, expr);
+            auto prime = parse_list_items_prime();
+            Builder::add(node, prime);
+        } else {
+            cout << "DEBUG: Empty list" << endl;
+        }
+
+        Builder::add(node, Builder::make("DELIMITER", "]"));
+        match("DELIMITER");  // ']'
+
+        cout << "DEBUG: List literal parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_list_items_prime() {
+        RuleGuard rule("list_items_prime");
+        auto node = Builder::make("list_items_prime");
+        cout << "DEBUG: Parsing list items prime" << endl;
+
+        if (peek().type == "DELIMITER" && peek().value == ",") {
+            Builder::add(node, Builder::make("DELIMITER", ","));
+            match("DELIMITER");  // ','
+            auto expr = parse_expression();
+            Builder::add(node, expr);
+            auto prime = parse_list_items_prime();
+            Builder::add(node, prime);
+        } else {
+            cout << "DEBUG: No more list items" << endl;
+        }
+        return node;
+    }
+
+    static Node parse_func_def() {
+        RuleGuard rule("func_def");
+        auto node = Builder::make("func_def");
+        cout << "\nDEBUG: Starting function definition parsing" << endl;
+
+        Builder::add(node, Builder::make("KEYWORD", "def"));
+        match("KEYWORD");         // 'def'
+        string funcName = currentToken.value;
+        Builder::add(node, Builder::make("IDENTIFIER", funcName));
+        match("IDENTIFIER");      // function name
+        Builder::add(node, Builder::make("DELIMITER", "("));
+        match("DELIMITER");       // '('
+        auto paramList = parse_param_list();
+        Builder::add(node, paramList);
+        Builder::add(node, Builder::make("DELIMITER", ")"));
+        match("DELIMITER");       // ')'
+
+        // Optional return type
+        if (peek().type == "OPERATOR" && peek().value == "->") {
+            Builder::add(node, Builder::make("OPERATOR", "->"));
+            match("OPERATOR");
+            auto typeNode = parse_type();
+            Builder::add(node, typeNode);
+        }
+
+        Builder::add(node, Builder::make("OPERATOR", ":"));
+        match("OPERATOR");        // ':'
+        // Detect if it's a single-line body
+
+        push_context(ContextKind::FUNCTION, funcName);
+        if (peek().type != "NEWLINE") {
+            cout << "DEBUG: Detected single-line function definition" << endl;
+            auto stmt = parse_statement();  // just one statement (like return, assignment, etc.)
+            Builder::add(node, stmt);
+        } else {
+            // Multiline function
+            Builder::add(node, Builder::make("NEWLINE"));
+            match("NEWLINE");
+            Builder::add(node, Builder::make("INDENT"));
+            int indent = tokenIndex;
+            match("INDENT");
+            auto stmtList = parse_function_body(indent);
+            Builder::add(node, stmtList);
+            Builder::add(node, Builder::make("DEDENT"));
+            match("DEDENT");
+        }
+        pop_context();
+
+        cout << "DEBUG: Function definition parsing completed" << endl;
+        return node;
+    }
+
+    // Statements of a function body whose INDENT is at indent.
+    static Node parse_function_body(int indent) {
+        if constexpr (Builder::buildsTree) {
+            if (lazy_bodies && tokenIndex == indent + 1 && tokens[indent].type == "INDENT" &&
+                matchTable[indent] > indent && matchTable[indent] < (int)tokenEnd) {
+                int end = matchTable[indent];
+                auto body = make_lazy_body(tokenIndex, end);
+                seek(end);
+                cout << "DEBUG: Skipped function body" << endl;
+                return body;
+            }
+        }
+        return parse_statement_list();
+    }
+
+    static Node parse_param_list() {
+        RuleGuard rule("param_list");
+        auto node = Builder::make("param_list");
+        cout << "DEBUG: Starting parameter list parsing" << endl;
+
+        if (peek().type == "IDENTIFIER") {
+            auto param = parse_param();
+            Builder::add(node, param);
+
+            while (peek().type == "DELIMITER" && peek().value == ",") {
+                Builder::add(node, Builder::make("DELIMITER", ","));
+                match("DELIMITER");
+                auto param2 = parse_param();
+                Builder::add(node, param2);
+            }
+        }
+
+        cout << "DEBUG: Parameter list parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_param() {
+        RuleGuard rule("param");
+        auto node = Builder::make("param");
+        Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+        match("IDENTIFIER");
+
+        if (peek().type == "OPERATOR" && peek().value == "=") {
+            Builder::add(node, Builder::make("OPERATOR", "="));
+            match("OPERATOR");
+            auto expr = parse_expression();
+            Builder::add(node, expr);
+        }
+        return node;
+    }
+
+    static Node parse_type() {
+        RuleGuard rule("type");
+        auto node = Builder::make("type");
+        if (peek().type == "KEYWORD" && 
+            (peek().value == "int" || peek().value == "float" || 
+             peek().value == "str" || peek().value == "bool" || 
+             peek().value == "None")) 
+        {
+            Builder::add(node, Builder::make("KEYWORD", currentToken.value));
+            match("KEYWORD");
+        } else {
+            report_error(DiagCode::EXPECTED_TYPE_NAME);
+            synchronize();
+        }
+        return node;
+    }
+
+    static Node parse_import_stmt() {
+        auto node = Builder::make("import_stmt");
+        cout << "\nDEBUG: Starting import statement parsing" << endl;
+
+        if (peek().value == "import") {
+            Builder::add(node, Builder::make("KEYWORD", "import"));
+            match("KEYWORD");  // 'import'
+            auto importItem = parse_import_item();
+            Builder::add(node, importItem);
+            auto importTail = parse_import_tail();
+            Builder::add(node, importTail);
+        } 
+        else if (peek().value == "from") {
+            Builder::add(node, Builder::make("KEYWORD", "from"));
+            match("KEYWORD");        // 'from'
+            Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+            match("IDENTIFIER");     // module name
+            Builder::add(node, Builder::make("KEYWORD", "import"));
+            match("KEYWORD");        // 'import'
+            auto importItem = parse_import_item();
+            Builder::add(node, importItem);
+            auto importTail = parse_import_tail();
+            Builder::add(node, importTail);
+        } 
+        else {
+            report_error(DiagCode::EXPECTED_IMPORT);
+            synchronize();
+        }
+
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        cout << "DEBUG: Import statement parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_import_item() {
+        auto node = Builder::make("import_item");
+        if (peek().type == "IDENTIFIER") {
+            Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+            match("IDENTIFIER");
+            auto aliasOpt = parse_import_alias_opt();
+            Builder::add(node, aliasOpt);
+        } 
+        else if (peek().type == "OPERATOR" && peek().value == "*") {
+            Builder::add(node, Builder::make("OPERATOR", "*"));
+            match("OPERATOR");  // '*'
+            auto aliasOpt = parse_import_alias_opt();
+            Builder::add(node, aliasOpt);
+        }
+        else {
+            report_error(DiagCode::EXPECTED_MODULE_NAME);
+            synchronize();
+        }
+        return node;
+    }
+
+    static Node parse_import_tail() {
+        auto node = Builder::make("import_tail");
+        while (peek().type == "DELIMITER" && peek().value == ",") {
+            Builder::add(node, Builder::make("DELIMITER", ","));
+            match("DELIMITER");      // ','
+            auto importItem = parse_import_item();
+            Builder::add(node, importItem);
+        }
+        return node;
+    }
+
+    static Node parse_import_alias_opt() {
+        auto node = Builder::make("import_alias_opt");
+        if (peek().value == "as") {
+            Builder::add(node, Builder::make("KEYWORD", "as"));
+            match("KEYWORD");        // 'as'
+            if (peek().type == "IDENTIFIER") {
+                Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+                match("IDENTIFIER");  // alias
+            } else {
+                report_error(DiagCode::EXPECTED_ALIAS);
+                synchronize();
+            }
+        } else {
+            cout << "DEBUG: No alias in import" << endl;
+        }
+        return node;
+    }
+
+    static Node parse_dict_literal() {
+        RuleGuard rule("dict_literal");
+        auto node = Builder::make("dict_literal");
+        cout << "\nDEBUG: Starting dictionary literal parsing" << endl;
+
+        Builder::add(node, Builder::make("DELIMITER", "{"));
+        match("DELIMITER");  // '{'
+
+        if (peek().value != "}") {
+            auto dictPair = parse_dict_pair();
+            Builder::add(node, dictPair);
+            auto dictItemsPrime = parse_dict_items_prime();
+            Builder::add(node, dictItemsPrime);
+        } else {
+            cout << "DEBUG: Empty dictionary" << endl;
+        }
+
+        Builder::add(node, Builder::make("DELIMITER", "}"));
+        match("DELIMITER");  // '}'
+
+        cout << "DEBUG: Dictionary literal parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_dict_items_prime() {
+        RuleGuard rule("dict_items_prime");
+        auto node = Builder::make("dict_items_prime");
+        while (peek().type == "DELIMITER" && peek().value == ",") {
+            Builder::add(node, Builder::make("DELIMITER", ","));
+            match("DELIMITER");
+            auto dictPair = parse_dict_pair();
+            Builder::add(node, dictPair);
+        }
+        return node;
+    }
+
+    static Node parse_dict_pair() {
+        RuleGuard rule("dict_pair");
+        auto node = Builder::make("dict_pair");
+        cout << "DEBUG: Parsing dictionary key" << endl;
+
+        if (peek().type == "STRING_QUOTE") {
+            auto strKey = parse_string_key();
+            Builder::add(node, strKey);
+        }
+        else if (peek().type == "IDENTIFIER") {
+            if (tokenIndex + 1 < tokens.size() && tokens[tokenIndex + 1].value == "(") {
+                auto funcCall = parse_func_call();
+                Builder::add(node, funcCall);
+            } else {
+                Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+                match("IDENTIFIER");
+            }
+        }
+        else if (peek().type == "NUMBER") {
+            Builder::add(node, Builder::make("NUMBER", currentToken.value));
+            match("NUMBER");
+        }
+        else if (peek().type == "KEYWORD" && 
+                 (peek().value == "True" || peek().value == "False" || peek().value == "None")) {
+            Builder::add(node, Builder::make("KEYWORD", currentToken.value));
+            match("KEYWORD");
+        }
+        else {
+            report_error(DiagCode::UNSUPPORTED_DICT_KEY);
+            synchronize();
+        }
+
+        if (peek().type == "OPERATOR" && peek().value == ":") {
+            Builder::add(node, Builder::make("OPERATOR", ":"));
+            match("OPERATOR");  // ':'
+            auto expr = parse_expression();
+            Builder::add(node, expr); // value expression
+        } else {
+            report_error(DiagCode::EXPECTED_DICT_COLON);
+            synchronize();
+        }
+        return node;
+    }
+
+    static Node parse_loop_statement_list() {
+        auto node = Builder::make("loop_statement_list");
+        cout << "DEBUG: Starting loop statement list" << endl;
+        while (peek().type != "DEDENT" && peek().type != "END_OF_FILE") {
+            if constexpr (Builder::buildsTree) {
+                if (subtreeCache && add_statement_run_cached<true>(node)) continue;
+            }
+            auto stmt = parse_loop_statement();
+            Builder::add(node, stmt);
+        }
+        cout << "DEBUG: Completed loop statement list" << endl;
+        return node;
+    }
+
+    static Node parse_loop_statement() {
+        auto node = Builder::make("loop_statement");
+        switch (statement_token(peek())) {
+            case StatementToken::BREAK: Builder::add(node, parse_break_stmt()); break;
+            case StatementToken::CONTINUE: Builder::add(node, parse_continue_stmt()); break;
+            default: Builder::add(node, parse_statement()); break;
+        }
+        return node;
+    }
+
+    static Node parse_del_stmt() {
+        auto node = Builder::make("del_stmt");
+        cout << "\nDEBUG: Starting delete statement parsing" << endl;
+
+        Builder::add(node, Builder::make("KEYWORD", "del"));
+        match("KEYWORD");  // 'del'
+        auto delTarget = parse_del_target();
+        Builder::add(node, delTarget);
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+
+        cout << "DEBUG: Delete statement parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_del_target() {
+        auto node = Builder::make("del_target");
+        cout << "DEBUG: Starting delete target parsing" << endl;
+        Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+        match("IDENTIFIER");  
+        if(peek().type == "DELIMITER" && peek().value == "["){
+            Builder::add(node, Builder::make("DELIMITER", "["));
+            match("DELIMITER");  // '['
+            auto expr = parse_expression();
+            Builder::add(node, expr);
+            Builder::add(node, Builder::make("DELIMITER", "]"));
+            match("DELIMITER");  // ']'
+        }
+        else if(peek().type == "DELIMITER" && peek().value == "."){
+            Builder::add(node, Builder::make("DELIMITER", "."));
+            match("DELIMITER");  // '.'
+            Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+            match("IDENTIFIER");  // attribute to delete
+        }
+        else{
+            cout << "DEBUG: No additional delete target found" << endl;
+        }
+
+        cout << "DEBUG: Delete target parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_inline_if_else() {
+        auto node = Builder::make("inline_if_else");
+        cout << "\nDEBUG: Starting inline if/else expression parsing" << endl;
+
+        Builder::add(node, Builder::make("KEYWORD", "if"));
+        match("KEYWORD");  // match 'if'
+        auto expr1 = parse_expression();
+        Builder::add(node, expr1);
+
+        Builder::add(node, Builder::make("KEYWORD", "else"));
+        match("KEYWORD");  // match 'else'
+        auto expr2 = parse_expression();
+        Builder::add(node, expr2);  // parse expression after else
+
+        cout << "DEBUG: Inline if/else expression parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_string_key() {
+        auto node = Builder::make("string_key");
+        if (peek().type == "STRING_QUOTE") {
+            Builder::add(node, Builder::make("STRING_QUOTE", currentToken.value));
+            match("STRING_QUOTE");         // opening quote
+            if (peek().type == "STRING_LITERAL") {
+                Builder::add(node, Builder::make("STRING_LITERAL", currentToken.value));
+                match("STRING_LITERAL");   // string content
+            } else {
+                report_error(DiagCode::EXPECTED_STRING_KEY);
+                synchronize();
+            }
+            if (peek().type == "STRING_QUOTE") {
+                Builder::add(node, Builder::make("STRING_QUOTE", currentToken.value));
+                match("STRING_QUOTE");     // closing quote
+            } else {
+                report_error(DiagCode::EXPECTED_CLOSING_QUOTE);
+                synchronize();
+            }
+        } else {
+            report_error(DiagCode::EXPECTED_OPENING_QUOTE);
+            synchronize();
+        }
+        return node;
+    }
+
+    static Node parse_class_def() {
+        auto node = Builder::make("class_def");
+        cout << "\nDEBUG: Starting class definition parsing" << endl;
+
+        Builder::add(node, Builder::make("KEYWORD", "class"));
+        match("KEYWORD");        // 'class'
+        string className = currentToken.value;
+        Builder::add(node, Builder::make("IDENTIFIER", className));
+        match("IDENTIFIER");     // class name
+        auto inhOpt = parse_class_inheritance_opt();
+        Builder::add(node, inhOpt);
+        Builder::add(node, Builder::make("OPERATOR", ":"));
+        match("OPERATOR");       // ':'
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        Builder::add(node, Builder::make("INDENT"));
+        match("INDENT");
+        push_context(ContextKind::CLASS, className);
+        auto stmtList = parse_statement_list();
+        pop_context();
+        Builder::add(node, stmtList);
+        Builder::add(node, Builder::make("DEDENT"));
+        match("DEDENT");
+
+        cout << "DEBUG: Class definition parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_class_inheritance_opt() {
+        auto node = Builder::make("class_inheritance_opt");
+        if (peek().value == "(") {
+            Builder::add(node, Builder::make("DELIMITER", "("));
+            match("DELIMITER");      // '('
+            Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+            match("IDENTIFIER");     // base class
+            Builder::add(node, Builder::make("DELIMITER", ")"));
+            match("DELIMITER");      // ')'
+        } else {
+            cout << "DEBUG: No base class (inheritance) specified" << endl;
+        }
+        return node;
+    }
+
+    static Node parse_try_stmt() {
+        RuleGuard rule("try_stmt");
+        auto node = Builder::make("try_stmt");
+        cout << "\nDEBUG: Starting try statement parsing" << endl;
+        Builder::add(node, Builder::make("KEYWORD", "try"));
+        match("KEYWORD");  // 'try'
+        Builder::add(node, Builder::make("OPERATOR", ":"));
+        match("OPERATOR"); // ':'
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        Builder::add(node, Builder::make("INDENT"));
+        match("INDENT");
+        contextStack.back().tryDepth++;
+        auto stmtList = parse_statement_list();
+        contextStack.back().tryDepth--;
+        Builder::add(node, stmtList);
+        Builder::add(node, Builder::make("DEDENT"));
+        match("DEDENT");
+        auto excepts = parse_except_clauses();
+        Builder::add(node, excepts);
+        auto finally = parse_finally_clause();
+        Builder::add(node, finally);
+        cout << "DEBUG: Try statement parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_except_clauses() {
+        RuleGuard rule("except_clauses");
+        auto node = Builder::make("except_clauses");
+        cout << "\nDEBUG: Starting except clauses parsing" << endl;
+        while (peek().value == "except") {
+            auto except = parse_except_clause();
+            Builder::add(node, except);
+        }
+        cout << "DEBUG: Except clauses parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_except_clause() {
+        RuleGuard rule("except_clause");
+        auto node = Builder::make("except_clause");
+        cout << "\nDEBUG: Starting except clause parsing" << endl;
+        Builder::add(node, Builder::make("KEYWORD", "except"));
+        match("KEYWORD");  // 'except'
+
+        // Optional exception type
+        if (peek().type != "OPERATOR" || peek().value != ":") {
+            auto expr = parse_expression();
+            Builder::add(node, expr);
+        }
+
+        // Optional 'as' identifier
+        if (peek().value == "as") {
+            Builder::add(node, Builder::make("KEYWORD", "as"));
+            match("KEYWORD");  // 'as'
+            Builder::add(node, Builder::make("IDENTIFIER", currentToken.value));
+            match("IDENTIFIER");
+        }
+
+        Builder::add(node, Builder::make("OPERATOR", ":"));
+        match("OPERATOR"); // ':'
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        Builder::add(node, Builder::make("INDENT"));
+        match("INDENT");
+        auto stmtList = parse_statement_list();
+        Builder::add(node, stmtList);
+        Builder::add(node, Builder::make("DEDENT"));
+        match("DEDENT");
+        cout << "DEBUG: Except clause parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_finally_clause() {
+        RuleGuard rule("finally_clause");
+        auto node = Builder::make("finally_clause");
+        cout << "\nDEBUG: Checking for finally clause" << endl;
+        if (peek().value == "finally") {
+            cout << "DEBUG: Found finally clause" << endl;
+            Builder::add(node, Builder::make("KEYWORD", "finally"));
+            match("KEYWORD");  // 'finally'
+            Builder::add(node, Builder::make("OPERATOR", ":"));
+            match("OPERATOR"); // ':'
+            Builder::add(node, Builder::make("NEWLINE"));
+            match("NEWLINE");
+            Builder::add(node, Builder::make("INDENT"));
+            match("INDENT");
+            auto stmtList = parse_statement_list();
+            Builder::add(node, stmtList);
+            Builder::add(node, Builder::make("DEDENT"));
+            match("DEDENT");
+        } else {
+            cout << "DEBUG: No finally clause found" << endl;
+        }
+        cout << "DEBUG: Finally clause parsing completed" << endl;
+        return node;
+    }
+
+    static Node parse_break_stmt() {
+        auto node = Builder::make("break_stmt");
+        cout << "\nDEBUG: Parsing break statement" << endl;
+        Builder::add(node, Builder::make("KEYWORD", "break"));
+        match("KEYWORD");  // 'break'
+
+        // Check if we're inside a loop
+        if (!is_inside_loop()) {
+            report_error(DiagCode::BREAK_OUTSIDE_LOOP);
+            synchronize();
+        }
+
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        cout << "DEBUG: Break statement parsed successfully" << endl;
+        return node;
+    }
+
+    static Node parse_continue_stmt() {
+        auto node = Builder::make("continue_stmt");
+        cout << "\nDEBUG: Parsing continue statement" << endl;
+        Builder::add(node, Builder::make("KEYWORD", "continue"));
+        match("KEYWORD");  // 'continue'
+
+        // Check if we're inside a loop
+        if (!is_inside_loop()) {
+            report_error(DiagCode::CONTINUE_OUTSIDE_LOOP);
+            synchronize();
+        }
+
+        Builder::add(node, Builder::make("NEWLINE"));
+        match("NEWLINE");
+        cout << "DEBUG: Continue statement parsed successfully" << endl;
+        return node;
+    }
+};
+
+#endif // PARSER_RULES_H
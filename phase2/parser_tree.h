@@ -5,6 +5,9 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <cstdint>
+#include "node_arena.h"
+#include "node_kind.h"
 
 using namespace std;
 
@@ -13,86 +16,85 @@ enum class TokenType {     IDENTIFIER, KEYWORD, OPERATOR, DELIMITER,
     ASSIGN, IF, ELSE, WHILE, FOR, RETURN, 
     NEWLINE, INDENT, DEDENT, END_OF_FILE};
 
+// Marks a node whose source range is not known (or not computed yet).
+const uint32_t NO_SOURCE_OFFSET = UINT32_MAX;
+
 struct ParseTreeNode {
     std::string name;
     std::string value;
+    NodeKind kind;          // name resolved once, for switch-based passes
+    uint32_t sourceStart = NO_SOURCE_OFFSET;   // byte range [sourceStart, sourceEnd)
+    uint32_t sourceEnd = NO_SOURCE_OFFSET;
     std::vector<std::shared_ptr<ParseTreeNode>> children;
     
     ParseTreeNode(const std::string& n, const std::string& v = "") 
-        : name(n), value(v) {}
+        : name(n), value(v), kind(node_kind_of(n)) {}
+
+    // Frees the subtree from a work list instead of recursing through child
+    // destructors, so tearing down a very deep tree cannot overflow the stack.
+    // Subtrees still shared with another owner (e.g. a cache) are left alone.
+    ~ParseTreeNode() {
+        std::vector<std::shared_ptr<ParseTreeNode>> pending;
+        pending.swap(children);
+        while (!pending.empty()) {
+            std::shared_ptr<ParseTreeNode> node = std::move(pending.back());
+            pending.pop_back();
+            if (node.use_count() == 1) {
+                for (auto& child : node->children) pending.push_back(std::move(child));
+                node->children.clear();
+            }
+        }
+    }
     
     void addChild(std::shared_ptr<ParseTreeNode> child) {
-        children.push_back(child);
+        children.push_back(std::move(child));
     }
 };
 
-void report_error(const string& message);
-void synchronize();
-std::string escapeDotString(const std::string& input);
-shared_ptr<ParseTreeNode> parse_program();
-shared_ptr<ParseTreeNode> parse_statement();
-shared_ptr<ParseTreeNode> parse_assignment();
-shared_ptr<ParseTreeNode> parse_return_stmt();
-shared_ptr<ParseTreeNode> parse_if_stmt();
-shared_ptr<ParseTreeNode> parse_elif_stmt();
-shared_ptr<ParseTreeNode> parse_else_part();
-shared_ptr<ParseTreeNode> parse_while_stmt();
-shared_ptr<ParseTreeNode> parse_func_call();
-shared_ptr<ParseTreeNode> parse_argument_list();
-shared_ptr<ParseTreeNode> parse_argument_list_prime();
-shared_ptr<ParseTreeNode> parse_statement_list();
-shared_ptr<ParseTreeNode> parse_expression();
-shared_ptr<ParseTreeNode> parse_bool_expr_prime();
-shared_ptr<ParseTreeNode> parse_bool_term();
-shared_ptr<ParseTreeNode> parse_bool_term_prime();
-shared_ptr<ParseTreeNode> parse_bool_factor();
-shared_ptr<ParseTreeNode> parse_rel_expr();
-shared_ptr<ParseTreeNode> parse_rel_op();
-shared_ptr<ParseTreeNode> parse_arith_expr();
-shared_ptr<ParseTreeNode> parse_arith_expr_prime();
-shared_ptr<ParseTreeNode> parse_term();
-shared_ptr<ParseTreeNode> parse_term_prime();
-shared_ptr<ParseTreeNode> parse_factor();
-shared_ptr<ParseTreeNode> parse_augmented_assignment();
-shared_ptr<ParseTreeNode> parse_for_stmt();
-shared_ptr<ParseTreeNode> parse_list_items_prime();
-shared_ptr<ParseTreeNode> parse_list_literal();
-shared_ptr<ParseTreeNode> parse_func_def();
-shared_ptr<ParseTreeNode> parse_param_list();
-shared_ptr<ParseTreeNode> parse_param();
-shared_ptr<ParseTreeNode> parse_type();
-shared_ptr<ParseTreeNode> parse_import_stmt();
-shared_ptr<ParseTreeNode> parse_import_tail();
-shared_ptr<ParseTreeNode> parse_import_item();
-shared_ptr<ParseTreeNode> parse_import_alias_opt();
-shared_ptr<ParseTreeNode> parse_dict_literal();
-shared_ptr<ParseTreeNode> parse_dict_items_prime();
-shared_ptr<ParseTreeNode> parse_dict_pair();
-shared_ptr<ParseTreeNode> parse_loop_statement_list();
-shared_ptr<ParseTreeNode> parse_loop_statement();
-shared_ptr<ParseTreeNode> parse_or_test();
-shared_ptr<ParseTreeNode> parse_inline_if_else();
-shared_ptr<ParseTreeNode> parse_string_key();
-shared_ptr<ParseTreeNode> parse_class_def();
-shared_ptr<ParseTreeNode> parse_class_inheritance_opt();
-shared_ptr<ParseTreeNode> parse_try_stmt();
-shared_ptr<ParseTreeNode> parse_except_clauses();
-shared_ptr<ParseTreeNode> parse_except_clause();
-shared_ptr<ParseTreeNode> parse_finally_clause();
-shared_ptr<ParseTreeNode> parse_del_stmt();
-shared_ptr<ParseTreeNode> parse_del_target();
-shared_ptr<ParseTreeNode> parse_assign_target();
-shared_ptr<ParseTreeNode> parse_primary_target();
-shared_ptr<ParseTreeNode> parse_assign_target_tail();
-shared_ptr<ParseTreeNode> parse_continue_stmt();
-shared_ptr<ParseTreeNode> parse_break_stmt();
-
+// Arena new nodes are allocated from on this thread; the global heap when null.
+extern thread_local shared_ptr<NodeArena> nodeArena;
 
-void next_token();
-bool match(string expectedType);
+inline shared_ptr<ParseTreeNode> make_node(const string& name, const string& value = "") {
+    if (nodeArena) {
+        return allocate_shared<ParseTreeNode>(ArenaAllocator<ParseTreeNode>(nodeArena), name, value);
+    }
+    return make_shared<ParseTreeNode>(name, value);
+}
 
-Token peek();
-void advance();
+// Syntax errors found while parsing. Messages are built from the code, the
+// offending token and arg only when diagnostics are printed.
+enum class DiagCode {
+    NESTING_LIMIT,
+    EXPECTED_TOKEN,          // arg: expected token type
+    UNEXPECTED_TOKEN,
+    RETURN_OUTSIDE_FUNCTION,
+    YIELD_OUTSIDE_FUNCTION,
+    BREAK_OUTSIDE_LOOP,
+    CONTINUE_OUTSIDE_LOOP,
+    UNTERMINATED_STRING,
+    UNEXPECTED_IN_STRING,
+    EXPECTED_FACTOR,
+    EXPECTED_AUG_ASSIGN_OP,
+    EXPECTED_SYMBOL,         // arg: what was expected, e.g. "':' after iterable"
+    EXPECTED_LOOP_VARIABLE,
+    INVALID_LOOP_VARIABLE,
+    EXPECTED_ITERABLE,
+    EXPECTED_TYPE_NAME,
+    EXPECTED_IMPORT,
+    EXPECTED_MODULE_NAME,
+    EXPECTED_ALIAS,
+    UNSUPPORTED_DICT_KEY,
+    EXPECTED_DICT_COLON,
+    EXPECTED_STRING_KEY,
+    EXPECTED_CLOSING_QUOTE,
+    EXPECTED_OPENING_QUOTE
+};
 
+struct Diagnostic {
+    DiagCode code;
+    int line;
+    int tokenIndex;       // offending token
+    const char* arg;      // static string or nullptr
+};
 
 #endif
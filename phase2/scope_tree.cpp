@@ -0,0 +1,280 @@
+#include "scope_tree.h"
+#include "node_visitor.h"
+#include <algorithm>
+#include <unordered_set>
+
+using namespace std;
+
+// Records scopes, bindings and references in tree order. Which identifiers
+// bind is decided by the node that owns them, so each leaf is looked at once.
+// Symbols are numbered in binding order here and regrouped by build().
+struct ScopeTree::Builder : TreeVisitor<ScopeTree::Builder> {
+    ScopeTree& tree;
+    vector<uint32_t> scopeStack;
+    vector<pair<const ParseTreeNode*, uint32_t>> pending;   // reference, scope
+    vector<uint64_t> symbolKeys;                            // by symbol, in binding order
+    vector<pair<uint32_t, uint32_t>> bindingSites;          // offset, symbol in binding order
+    int headerDepth = 0;    // inside a parameter list or base class list
+
+    explicit Builder(ScopeTree& tree) : tree(tree) {}
+
+    uint32_t current() const { return scopeStack.back(); }
+
+    // Defaults and base classes are evaluated in the enclosing scope.
+    uint32_t referenceScope() const {
+        return headerDepth > 0 ? (uint32_t)tree.scopeList[current()].parent : current();
+    }
+
+    void push_scope(ScopeKind kind, const ParseTreeNode& node, const string& name) {
+        int32_t parent = scopeStack.empty() ? -1 : (int32_t)current();
+        scopeStack.push_back(tree.scopeList.size());
+        tree.scopeList.push_back({kind, parent, &node, name, 0, 0, 0, 0});
+    }
+
+    void bind(uint32_t scope, const ParseTreeNode* leaf, uint8_t flags) {
+        if (!leaf || leaf->kind != NodeKind::IDENTIFIER) return;
+        uint64_t key = pack_key(scope, tree.names.intern(leaf->value));
+        auto inserted = tree.symbolOf.insert(key, tree.symbolList.size());
+        if (inserted.second) {
+            tree.symbolList.push_back({leaf->value, scope, flags, leaf, 1});
+            symbolKeys.push_back(key);
+        } else {
+            tree.symbolList[*inserted.first].flags |= flags;
+            tree.symbolList[*inserted.first].bindingCount++;
+        }
+        if (leaf->sourceStart != NO_SOURCE_OFFSET) bindingSites.push_back({leaf->sourceStart, *inserted.first});
+    }
+
+    void reference(const ParseTreeNode* leaf) {
+        if (leaf && leaf->kind == NodeKind::IDENTIFIER) pending.push_back({leaf, referenceScope()});
+    }
+
+    static const ParseTreeNode* child(const ParseTreeNode& node, size_t i) {
+        return i < node.children.size() ? node.children[i].get() : nullptr;
+    }
+
+    // Any other identifier directly under a node is a use of that name.
+    bool enter_node(ParseTreeNode& node) {
+        for (const auto& c : node.children) reference(c.get());
+        return true;
+    }
+
+    // 'from module import ...': the module name is not a variable
+    bool enter_import_stmt(ParseTreeNode&) { return true; }
+    bool enter_import_alias_opt(ParseTreeNode&) { return true; }
+
+    bool enter_import_item(ParseTreeNode& node) {
+        const ParseTreeNode* alias = child(node, 1);
+        const ParseTreeNode* aliasName = alias ? child(*alias, 1) : nullptr;
+        bind(current(), aliasName ? aliasName : child(node, 0), SYMBOL_IMPORTED);
+        return true;
+    }
+
+    // A bare name is bound; 'a.b = ...' and 'a[i] = ...' only use a.
+    bool enter_assign_target(ParseTreeNode& node) {
+        const ParseTreeNode* primary = child(node, 0);
+        const ParseTreeNode* tail = child(node, 1);
+        if (!primary) return true;
+        if (primary->children.size() == 1 && (!tail || tail->children.empty())) {
+            bind(current(), child(*primary, 0), SYMBOL_ASSIGNED);
+        } else {
+            reference(child(*primary, 0));
+        }
+        return true;
+    }
+    bool enter_primary_target(ParseTreeNode&) { return true; }
+    bool enter_assign_target_tail(ParseTreeNode&) { return true; }     // attribute names
+
+    bool enter_augmented_assignment(ParseTreeNode& node) {
+        reference(child(node, 0));
+        bind(current(), child(node, 0), SYMBOL_ASSIGNED);
+        return true;
+    }
+
+    bool enter_for_stmt(ParseTreeNode& node) {
+        bind(current(), child(node, 1), SYMBOL_ASSIGNED);
+        return true;
+    }
+
+    bool enter_except_clause(ParseTreeNode& node) {
+        for (size_t i = 1; i < node.children.size(); i++) {
+            const ParseTreeNode* c = node.children[i].get();
+            if (c && c->kind == NodeKind::IDENTIFIER && node.children[i - 1]->value == "as") {
+                bind(current(), c, SYMBOL_ASSIGNED);
+            }
+        }
+        return true;
+    }
+
+    // 'del x' unbinds x, which makes it local; 'del x.y' and 'del x[i]' use x
+    bool enter_del_target(ParseTreeNode& node) {
+        if (node.children.size() == 1) {
+            bind(current(), child(node, 0), SYMBOL_DELETED);
+        } else {
+            reference(child(node, 0));
+        }
+        return true;
+    }
+
+    bool enter_func_def(ParseTreeNode& node) {
+        const ParseTreeNode* name = child(node, 1);
+        bind(current(), name, SYMBOL_FUNCTION);
+        push_scope(ScopeKind::FUNCTION, node, name ? name->value : "");
+        return true;
+    }
+    void leave_func_def(ParseTreeNode&) { scopeStack.pop_back(); }
+
+    bool enter_param_list(ParseTreeNode& node) {
+        headerDepth++;
+        return enter_node(node);
+    }
+    void leave_param_list(ParseTreeNode&) { headerDepth--; }
+
+    bool enter_param(ParseTreeNode& node) {
+        bind(current(), child(node, 0), SYMBOL_PARAMETER);
+        return true;
+    }
+
+    bool enter_lazy_body(ParseTreeNode&) {
+        tree.lazyBodies++;
+        return false;
+    }
+
+    bool enter_class_def(ParseTreeNode& node) {
+        const ParseTreeNode* name = child(node, 1);
+        bind(current(), name, SYMBOL_CLASS);
+        push_scope(ScopeKind::CLASS, node, name ? name->value : "");
+        return true;
+    }
+    void leave_class_def(ParseTreeNode&) { scopeStack.pop_back(); }
+
+    bool enter_class_inheritance_opt(ParseTreeNode& node) {
+        headerDepth++;
+        return enter_node(node);
+    }
+    void leave_class_inheritance_opt(ParseTreeNode&) { headerDepth--; }
+};
+
+void ScopeTree::build(const shared_ptr<ParseTreeNode>& root) {
+    scopeList.clear();
+    symbolList.clear();
+    referenceList.clear();
+    names = IdentifierInterner();
+    symbolOf.clear();
+    symbolSites.clear();
+    lazyBodies = 0;
+    if (!root) return;
+
+    Builder builder(*this);
+    builder.push_scope(ScopeKind::MODULE, *root, "");
+    builder.walk(root);
+
+    // Group symbols by scope with a counting sort, keeping binding order
+    vector<uint32_t> symbolStart(scopeList.size() + 1, 0);
+    for (const ScopeSymbol& symbol : symbolList) symbolStart[symbol.scope + 1]++;
+    for (size_t s = 0; s < scopeList.size(); s++) {
+        symbolStart[s + 1] += symbolStart[s];
+        scopeList[s].symbolBegin = symbolStart[s];
+        scopeList[s].symbolEnd = symbolStart[s + 1];
+    }
+    vector<uint32_t> newIndex(symbolList.size());
+    vector<ScopeSymbol> grouped(symbolList.size());
+    for (size_t i = 0; i < symbolList.size(); i++) {
+        newIndex[i] = symbolStart[symbolList[i].scope]++;
+        grouped[newIndex[i]] = move(symbolList[i]);
+    }
+    symbolList = move(grouped);
+    for (size_t i = 0; i < newIndex.size(); i++) *symbolOf.find(builder.symbolKeys[i]) = newIndex[i];
+
+    // Every binding is known now, so references resolve in one pass
+    vector<uint32_t> referenceStart(scopeList.size() + 1, 0);
+    for (const auto& ref : builder.pending) referenceStart[ref.second + 1]++;
+    for (size_t s = 0; s < scopeList.size(); s++) {
+        referenceStart[s + 1] += referenceStart[s];
+        scopeList[s].referenceBegin = referenceStart[s];
+        scopeList[s].referenceEnd = referenceStart[s + 1];
+    }
+    referenceList.resize(builder.pending.size());
+    for (const auto& ref : builder.pending) {
+        NameReference& out = referenceList[referenceStart[ref.second]++];
+        out.node = ref.first;
+        out.scope = ref.second;
+        out.resolution = resolve(ref.second, ref.first->value, out.symbol);
+    }
+
+    symbolSites.reserve(builder.bindingSites.size() + referenceList.size());
+    for (const auto& site : builder.bindingSites) symbolSites.push_back({site.first, newIndex[site.second]});
+    for (const NameReference& ref : referenceList) {
+        if (ref.symbol >= 0 && ref.node->sourceStart != NO_SOURCE_OFFSET) {
+            symbolSites.push_back({ref.node->sourceStart, (uint32_t)ref.symbol});
+        }
+    }
+    sort(symbolSites.begin(), symbolSites.end());
+}
+
+int32_t ScopeTree::symbolAt(uint32_t offset) const {
+    auto it = lower_bound(symbolSites.begin(), symbolSites.end(), make_pair(offset, (uint32_t)0));
+    return it != symbolSites.end() && it->first == offset ? (int32_t)it->second : -1;
+}
+
+int32_t ScopeTree::lookup(uint32_t scope, const string& name) const {
+    uint32_t id = names.find(name);
+    if (id == IdentifierInterner::NONE) return -1;
+    const uint32_t* symbol = symbolOf.find(pack_key(scope, id));
+    return symbol ? (int32_t)*symbol : -1;
+}
+
+NameResolution ScopeTree::resolve(uint32_t scope, const string& name, int32_t& symbol) const {
+    symbol = lookup(scope, name);
+    if (symbol >= 0) {
+        return scopeList[scope].kind == ScopeKind::MODULE ? NameResolution::GLOBAL : NameResolution::LOCAL;
+    }
+    for (int32_t s = scopeList[scope].parent; s >= 0; s = scopeList[s].parent) {
+        // Names bound in a class body are not visible to the scopes inside it
+        if (scopeList[s].kind == ScopeKind::CLASS) continue;
+        symbol = lookup(s, name);
+        if (symbol >= 0) {
+            return scopeList[s].kind == ScopeKind::MODULE ? NameResolution::GLOBAL : NameResolution::ENCLOSING;
+        }
+    }
+    return is_builtin_name(name) ? NameResolution::BUILTIN : NameResolution::UNRESOLVED;
+}
+
+bool is_builtin_name(const string& name) {
+    static const unordered_set<string> builtins = {
+        "abs", "all", "any", "ascii", "bin", "bool", "breakpoint", "bytearray", "bytes", "callable",
+        "chr", "classmethod", "compile", "complex", "delattr", "dict", "dir", "divmod", "enumerate",
+        "eval", "exec", "filter", "float", "format", "frozenset", "getattr", "globals", "hasattr",
+        "hash", "help", "hex", "id", "input", "int", "isinstance", "issubclass", "iter", "len",
+        "list", "locals", "map", "max", "memoryview", "min", "next", "object", "oct", "open", "ord",
+        "pow", "print", "property", "range", "repr", "reversed", "round", "set", "setattr", "slice",
+        "sorted", "staticmethod", "str", "sum", "super", "tuple", "type", "vars", "zip",
+        "__name__", "__file__", "__doc__",
+        "Exception", "BaseException", "ArithmeticError", "AssertionError", "AttributeError",
+        "EOFError", "ImportError", "IndexError", "KeyError", "KeyboardInterrupt", "LookupError",
+        "MemoryError", "NameError", "NotImplementedError", "OSError", "OverflowError",
+        "RecursionError", "RuntimeError", "StopIteration", "SyntaxError", "SystemExit",
+        "TypeError", "ValueError", "ZeroDivisionError", "NotImplemented", "Ellipsis",
+    };
+    return builtins.count(name) != 0;
+}
+
+const char* scope_kind_name(ScopeKind kind) {
+    switch (kind) {
+        case ScopeKind::MODULE: return "module";
+        case ScopeKind::CLASS: return "class";
+        case ScopeKind::FUNCTION: return "function";
+    }
+    return "?";
+}
+
+const char* name_resolution_name(NameResolution resolution) {
+    switch (resolution) {
+        case NameResolution::LOCAL: return "local";
+        case NameResolution::ENCLOSING: return "enclosing";
+        case NameResolution::GLOBAL: return "global";
+        case NameResolution::BUILTIN: return "builtin";
+        case NameResolution::UNRESOLVED: return "unresolved";
+    }
+    return "?";
+}
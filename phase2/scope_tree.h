@@ -0,0 +1,106 @@
+#ifndef SCOPE_TREE_H
+#define SCOPE_TREE_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+#include "identifier_table.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Python scopes read off the parse tree: the module, each class body and
+// each function. Names are bound where Python binds them (assignment
+// targets, for targets, parameters, def/class names, imports, except ... as,
+// del) and every other identifier is a reference, resolved in LEGB order.
+// Class bodies are skipped when resolving from a nested scope, as in Python.
+// The grammar has no comprehensions, lambdas or global/nonlocal statements,
+// so they do not appear here.
+//
+// Built in one walk of the tree; symbols and references are then stored in
+// flat arrays grouped by scope, and each Scope holds its ranges in them.
+// Lazy function bodies are not looked into: expand them first. Like
+// SourceIndex, the tree holds raw node pointers.
+
+enum class ScopeKind : uint8_t { MODULE, CLASS, FUNCTION };
+
+// Where a reference resolved to. Module-level names are GLOBAL.
+enum class NameResolution : uint8_t { LOCAL, ENCLOSING, GLOBAL, BUILTIN, UNRESOLVED };
+
+// How a symbol is bound in its scope; a symbol may have several.
+enum SymbolFlag : uint8_t {
+    SYMBOL_ASSIGNED = 1,
+    SYMBOL_PARAMETER = 2,
+    SYMBOL_IMPORTED = 4,
+    SYMBOL_FUNCTION = 8,
+    SYMBOL_CLASS = 16,
+    SYMBOL_DELETED = 32,
+};
+
+struct ScopeSymbol {
+    std::string name;
+    uint32_t scope;
+    uint8_t flags;
+    const ParseTreeNode* definition;    // IDENTIFIER of the first binding
+    uint32_t bindingCount;              // places that bind it, the first included
+};
+
+struct NameReference {
+    const ParseTreeNode* node;          // the IDENTIFIER leaf
+    uint32_t scope;                     // scope it is evaluated in
+    int32_t symbol;                     // -1 for builtins and unresolved names
+    NameResolution resolution;
+};
+
+struct Scope {
+    ScopeKind kind;
+    int32_t parent;                     // -1 for the module
+    const ParseTreeNode* node;          // program, class_def or func_def
+    std::string name;                   // empty for the module
+    uint32_t symbolBegin, symbolEnd;            // range in symbols()
+    uint32_t referenceBegin, referenceEnd;      // range in references()
+};
+
+class ScopeTree {
+public:
+    ScopeTree() = default;
+    explicit ScopeTree(const shared_ptr<ParseTreeNode>& root) { build(root); }
+
+    void build(const shared_ptr<ParseTreeNode>& root);
+
+    // Preorder, so a parent comes before its children; the module is first.
+    const std::vector<Scope>& scopes() const { return scopeList; }
+    // Grouped by scope, in order of first binding.
+    const std::vector<ScopeSymbol>& symbols() const { return symbolList; }
+    // Grouped by scope, in source order.
+    const std::vector<NameReference>& references() const { return referenceList; }
+
+    // Symbol bound under name in scope itself, or -1.
+    int32_t lookup(uint32_t scope, const std::string& name) const;
+
+    // Resolves name as seen from scope, O(scope depth). symbol is set to the
+    // binding found, or -1.
+    NameResolution resolve(uint32_t scope, const std::string& name, int32_t& symbol) const;
+
+    // Symbol the identifier token at a source offset binds or resolves to,
+    // or -1. O(log n); lets token-based tables find their scope-tree symbol.
+    int32_t symbolAt(uint32_t offset) const;
+
+    size_t lazyBodyCount() const { return lazyBodies; }
+
+private:
+    std::vector<Scope> scopeList;
+    std::vector<ScopeSymbol> symbolList;
+    std::vector<NameReference> referenceList;
+    IdentifierInterner names;
+    PackedKeyMap<uint32_t> symbolOf;    // pack_key(scope, name ID) -> symbol
+    std::vector<std::pair<uint32_t, uint32_t>> symbolSites;     // (offset, symbol), sorted
+    size_t lazyBodies = 0;
+
+    struct Builder;
+};
+
+bool is_builtin_name(const std::string& name);
+const char* scope_kind_name(ScopeKind kind);
+const char* name_resolution_name(NameResolution resolution);
+
+#endif // SCOPE_TREE_H
@@ -0,0 +1,69 @@
+#include "source_index.h"
+#include <algorithm>
+
+using namespace std;
+
+void SourceIndex::addSegment(uint32_t start, int32_t node) {
+    // An empty range, or one that overlaps after error recovery, relabels
+    // the last segment so the starts stay ascending
+    if (!segmentStart.empty() && start <= segmentStart.back()) {
+        segmentNode.back() = node;
+        return;
+    }
+    if (!segmentNode.empty() && segmentNode.back() == node) return;
+    segmentStart.push_back(start);
+    segmentNode.push_back(node);
+}
+
+void SourceIndex::build(const shared_ptr<ParseTreeNode>& root) {
+    nodes.clear();
+    segmentStart.clear();
+    segmentNode.clear();
+    if (!root || root->sourceStart == NO_SOURCE_OFFSET) return;
+
+    // Entering a node starts a segment labelled with it; finishing a child
+    // returns the rest of the parent's range to the parent.
+    struct Frame {
+        int32_t index;
+        size_t next;
+    };
+    vector<Frame> stack;
+    nodes.push_back({root.get(), -1});
+    addSegment(root->sourceStart, 0);
+    stack.push_back({0, 0});
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        ParseTreeNode* node = nodes[frame.index].node;
+        if (frame.next < node->children.size()) {
+            ParseTreeNode* child = node->children[frame.next++].get();
+            if (!child || child->sourceStart == NO_SOURCE_OFFSET) continue;
+            int32_t index = nodes.size();
+            nodes.push_back({child, frame.index});
+            addSegment(child->sourceStart, index);
+            stack.push_back({index, 0});
+            continue;
+        }
+        int32_t parent = nodes[frame.index].parent;
+        stack.pop_back();
+        addSegment(node->sourceEnd, parent);
+    }
+}
+
+int32_t SourceIndex::find(uint32_t offset) const {
+    auto it = upper_bound(segmentStart.begin(), segmentStart.end(), offset);
+    if (it == segmentStart.begin()) return -1;
+    return segmentNode[it - segmentStart.begin() - 1];
+}
+
+ParseTreeNode* SourceIndex::nodeAt(uint32_t offset) const {
+    int32_t index = find(offset);
+    return index < 0 ? nullptr : nodes[index].node;
+}
+
+vector<ParseTreeNode*> SourceIndex::pathAt(uint32_t offset) const {
+    vector<ParseTreeNode*> path;
+    for (int32_t index = find(offset); index >= 0; index = nodes[index].parent) {
+        path.push_back(nodes[index].node);
+    }
+    return path;
+}
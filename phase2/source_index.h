@@ -0,0 +1,43 @@
+#ifndef SOURCE_INDEX_H
+#define SOURCE_INDEX_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+#include <cstdint>
+#include <vector>
+
+// Answers "which node is at byte offset X" for hover, error underlining and
+// go-to-definition. Node ranges nest, so the file splits into segments that
+// each have one innermost node; the segments are kept as a sorted array and a
+// lookup is one binary search. Nodes without a source range are left out.
+// The index holds raw pointers: keep the tree alive and rebuild after edits.
+class SourceIndex {
+public:
+    SourceIndex() = default;
+    explicit SourceIndex(const shared_ptr<ParseTreeNode>& root) { build(root); }
+
+    void build(const shared_ptr<ParseTreeNode>& root);
+
+    // Innermost node whose range contains offset, or null.
+    ParseTreeNode* nodeAt(uint32_t offset) const;
+
+    // nodeAt(offset) followed by its ancestors up to the root.
+    std::vector<ParseTreeNode*> pathAt(uint32_t offset) const;
+
+    size_t nodeCount() const { return nodes.size(); }
+    size_t segmentCount() const { return segmentStart.size(); }
+
+private:
+    struct Entry {
+        ParseTreeNode* node;
+        int32_t parent;             // index in nodes, -1 for the root
+    };
+    std::vector<Entry> nodes;                 // preorder
+    std::vector<uint32_t> segmentStart;       // ascending; a segment ends where the next starts
+    std::vector<int32_t> segmentNode;         // index in nodes, -1 outside the root
+
+    int32_t find(uint32_t offset) const;
+    void addSegment(uint32_t start, int32_t node);
+};
+
+#endif // SOURCE_INDEX_H
@@ -0,0 +1,369 @@
+#include "symbol_index.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+#include <unordered_set>
+#include <sys/stat.h>
+
+using namespace std;
+
+namespace {
+
+// Deduplicating string pool; scopes, types and paths repeat constantly.
+struct StringPool {
+    string bytes;
+    unordered_map<string, uint32_t> offsets;
+
+    uint32_t add(const string& s) {
+        auto it = offsets.find(s);
+        if (it != offsets.end()) return it->second;
+        uint32_t offset = bytes.size();
+        bytes += s;
+        offsets.emplace(s, offset);
+        return offset;
+    }
+};
+
+uint32_t indexOffset(int offset) {
+    return offset < 0 ? SYMBOL_NO_OFFSET : (uint32_t)offset;
+}
+
+template <typename Record>
+bool sourceOrder(const Record& a, const Record& b) {
+    return tie(a.file, a.line, a.offset) < tie(b.file, b.line, b.offset);
+}
+
+} // namespace
+
+bool statFile(const string& path, FileStamp& stamp) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) return false;
+    stamp.size = info.st_size;
+#ifdef _WIN32
+    stamp.mtime = (int64_t)info.st_mtime * 1000000000;   // whole seconds only
+#else
+    stamp.mtime = (int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+uint32_t SymbolIndexBuilder::addFileRecord(const string& path, const FileStamp& stamp) {
+    files.push_back({path, stamp});
+    return files.size() - 1;
+}
+
+void SymbolIndexBuilder::addFile(const string& path, const FileStamp& stamp, const SymbolTable& table) {
+    uint32_t file = addFileRecord(path, stamp);
+    // A symbol may be declared again under the same key; index it once
+    unordered_set<const SymbolEntry*> seen;
+    for (const SymbolTable::Symbol& symbol : table) {
+        const SymbolEntry& entry = symbol.entry;
+        if (entry.references.empty() || !seen.insert(&entry).second) continue;
+        Postings& p = postings[symbol.name];
+        const SymbolReference& first = entry.references.front();
+        p.definitions.push_back({file, (uint32_t)first.line, indexOffset(first.offset), entry.scope, entry.type});
+        for (const SymbolReference& ref : entry.references) {
+            p.references.push_back({file, (uint32_t)ref.line, indexOffset(ref.offset)});
+        }
+    }
+}
+
+void SymbolIndexBuilder::copyFiles(const SymbolIndexView& old, const vector<bool>& keep) {
+    const uint32_t DROPPED = UINT32_MAX;
+    vector<uint32_t> renumbered(old.fileCount(), DROPPED);
+    for (uint32_t f = 0; f < old.fileCount(); f++) {
+        if (f < keep.size() && keep[f]) {
+            const IndexedFile& record = old.file(f);
+            renumbered[f] = addFileRecord(string(old.path(f)), {record.size, record.mtime});
+        }
+    }
+    for (uint32_t n = 0; n < old.nameCount(); n++) {
+        const IndexedName& name = old.name(n);
+        Postings* p = nullptr;
+        const IndexedDefinition* defs = old.definitions(name);
+        for (uint32_t i = 0; i < name.definitionCount; i++) {
+            uint32_t file = renumbered[defs[i].file];
+            if (file == DROPPED) continue;
+            if (!p) p = &postings[string(old.nameText(name))];
+            p->definitions.push_back({file, defs[i].line, defs[i].offset,
+                                      string(old.scope(defs[i])), string(old.type(defs[i]))});
+        }
+        const IndexedReference* refs = old.references(name);
+        for (uint32_t i = 0; i < name.referenceCount; i++) {
+            uint32_t file = renumbered[refs[i].file];
+            if (file == DROPPED) continue;
+            if (!p) p = &postings[string(old.nameText(name))];
+            p->references.push_back({file, refs[i].line, refs[i].offset});
+        }
+    }
+}
+
+bool SymbolIndexBuilder::write(const string& path, string& error) const {
+    StringPool pool;
+    vector<IndexedFile> fileRecords;
+    fileRecords.reserve(files.size());
+    for (const File& file : files) {
+        fileRecords.push_back({pool.add(file.path), (uint32_t)file.path.size(), file.stamp.size, file.stamp.mtime});
+    }
+
+    vector<const pair<const string, Postings>*> sorted;
+    sorted.reserve(postings.size());
+    for (const auto& entry : postings) sorted.push_back(&entry);
+    sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    vector<IndexedName> nameRecords;
+    vector<IndexedDefinition> defRecords;
+    vector<IndexedReference> refRecords;
+    nameRecords.reserve(sorted.size());
+    for (const auto* entry : sorted) {
+        const Postings& p = entry->second;
+        IndexedName name;
+        name.nameOffset = pool.add(entry->first);
+        name.nameLength = entry->first.size();
+        name.firstDefinition = defRecords.size();
+        name.definitionCount = p.definitions.size();
+        name.firstReference = refRecords.size();
+        name.referenceCount = p.references.size();
+        nameRecords.push_back(name);
+
+        // Copied and new files arrive in any order; sort each run by position
+        size_t firstDef = defRecords.size();
+        for (const Definition& d : p.definitions) {
+            defRecords.push_back({d.file, d.line, d.offset, pool.add(d.scope), (uint32_t)d.scope.size(),
+                                  pool.add(d.type), (uint32_t)d.type.size()});
+        }
+        sort(defRecords.begin() + firstDef, defRecords.end(), sourceOrder<IndexedDefinition>);
+        size_t firstRef = refRecords.size();
+        refRecords.insert(refRecords.end(), p.references.begin(), p.references.end());
+        sort(refRecords.begin() + firstRef, refRecords.end(), sourceOrder<IndexedReference>);
+    }
+    if (defRecords.size() > UINT32_MAX || refRecords.size() > UINT32_MAX || pool.bytes.size() > UINT32_MAX) {
+        error = "too many symbols for the index format";
+        return false;
+    }
+
+    SymbolIndexHeader header;
+    memcpy(header.magic, SYMBOL_INDEX_MAGIC, sizeof(header.magic));
+    header.version = SYMBOL_INDEX_VERSION;
+    header.byteOrder = SYMBOL_INDEX_BYTE_ORDER_MARK;
+    header.fileCount = fileRecords.size();
+    header.nameCount = nameRecords.size();
+    header.definitionCount = defRecords.size();
+    header.referenceCount = refRecords.size();
+    header.filesOffset = sizeof(SymbolIndexHeader);
+    header.namesOffset = header.filesOffset + fileRecords.size() * sizeof(IndexedFile);
+    header.definitionsOffset = header.namesOffset + nameRecords.size() * sizeof(IndexedName);
+    header.referencesOffset = header.definitionsOffset + defRecords.size() * sizeof(IndexedDefinition);
+    header.stringsOffset = header.referencesOffset + refRecords.size() * sizeof(IndexedReference);
+    header.stringsSize = pool.bytes.size();
+    header.fileSize = header.stringsOffset + header.stringsSize;
+
+    vector<char> buffer(header.fileSize);
+    memcpy(buffer.data(), &header, sizeof(header));
+    auto place = [&](uint64_t offset, const void* records, size_t bytes) {
+        if (bytes > 0) memcpy(buffer.data() + offset, records, bytes);
+    };
+    place(header.filesOffset, fileRecords.data(), fileRecords.size() * sizeof(IndexedFile));
+    place(header.namesOffset, nameRecords.data(), nameRecords.size() * sizeof(IndexedName));
+    place(header.definitionsOffset, defRecords.data(), defRecords.size() * sizeof(IndexedDefinition));
+    place(header.referencesOffset, refRecords.data(), refRecords.size() * sizeof(IndexedReference));
+    place(header.stringsOffset, pool.bytes.data(), pool.bytes.size());
+
+    string temporary = path + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (!file) {
+        error = "cannot open " + temporary + " for writing";
+        return false;
+    }
+    setvbuf(file, nullptr, _IONBF, 0);
+    bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    written = fclose(file) == 0 && written;
+    if (!written || !replace_file(temporary, path)) {
+        remove(temporary.c_str());
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+SymbolIndexView::~SymbolIndexView() {
+    close();
+}
+
+void SymbolIndexView::close() {
+    unmap_file(data, length);
+    data = nullptr;
+    length = 0;
+    header = nullptr;
+    files = nullptr;
+    names = nullptr;
+    defs = nullptr;
+    refs = nullptr;
+    strings = nullptr;
+}
+
+bool SymbolIndexView::open(const string& path, string& error) {
+    close();
+    MapStatus status = map_file(path, data, length);
+    if (status != MapStatus::OK) {
+        error = (status == MapStatus::CANNOT_OPEN ? "cannot open " : "cannot map ") + path;
+        return false;
+    }
+    if (length < sizeof(SymbolIndexHeader)) {
+        close();
+        error = path + " is not a symbol index";
+        return false;
+    }
+    header = reinterpret_cast<const SymbolIndexHeader*>(data);
+
+    if (memcmp(header->magic, SYMBOL_INDEX_MAGIC, sizeof(SYMBOL_INDEX_MAGIC)) != 0) {
+        error = path + " is not a symbol index";
+    } else if (header->byteOrder != SYMBOL_INDEX_BYTE_ORDER_MARK) {
+        error = path + " was written on a machine with a different byte order";
+    } else if (header->version != SYMBOL_INDEX_VERSION) {
+        error = path + " has format version " + to_string(header->version)
+              + ", expected " + to_string(SYMBOL_INDEX_VERSION);
+    } else if (header->fileSize != length
+            || header->filesOffset % alignof(IndexedFile) != 0
+            || header->namesOffset % alignof(IndexedName) != 0
+            || header->definitionsOffset % alignof(IndexedDefinition) != 0
+            || header->referencesOffset % alignof(IndexedReference) != 0
+            || header->filesOffset + (uint64_t)header->fileCount * sizeof(IndexedFile) > header->namesOffset
+            || header->namesOffset + (uint64_t)header->nameCount * sizeof(IndexedName) > header->definitionsOffset
+            || header->definitionsOffset + (uint64_t)header->definitionCount * sizeof(IndexedDefinition) > header->referencesOffset
+            || header->referencesOffset + (uint64_t)header->referenceCount * sizeof(IndexedReference) > header->stringsOffset
+            || header->stringsOffset + header->stringsSize > length) {
+        error = path + " is truncated or corrupt";
+    } else {
+        files = reinterpret_cast<const IndexedFile*>(data + header->filesOffset);
+        names = reinterpret_cast<const IndexedName*>(data + header->namesOffset);
+        defs = reinterpret_cast<const IndexedDefinition*>(data + header->definitionsOffset);
+        refs = reinterpret_cast<const IndexedReference*>(data + header->referencesOffset);
+        strings = data + header->stringsOffset;
+        return true;
+    }
+    close();
+    return false;
+}
+
+bool SymbolIndexView::validate(string& error) const {
+    if (!header) {
+        error = "no symbol index is open";
+        return false;
+    }
+    auto inPool = [&](uint32_t offset, uint32_t size) { return (uint64_t)offset + size <= header->stringsSize; };
+    for (uint32_t f = 0; f < header->fileCount; f++) {
+        if (!inPool(files[f].pathOffset, files[f].pathLength)) {
+            error = "file " + to_string(f) + " has a path outside the pool";
+            return false;
+        }
+    }
+    // Runs are consecutive and names strictly ascending, which find() relies on
+    uint64_t nextDef = 0, nextRef = 0;
+    for (uint32_t n = 0; n < header->nameCount; n++) {
+        const IndexedName& name = names[n];
+        if (!inPool(name.nameOffset, name.nameLength)) {
+            error = "name " + to_string(n) + " is outside the pool";
+            return false;
+        }
+        if (n > 0 && nameText(names[n - 1]) >= nameText(name)) {
+            error = "names are not sorted at " + to_string(n);
+            return false;
+        }
+        if (name.firstDefinition != nextDef || name.firstReference != nextRef) {
+            error = "name " + to_string(n) + " has an invalid record range";
+            return false;
+        }
+        nextDef += name.definitionCount;
+        nextRef += name.referenceCount;
+    }
+    if (nextDef != header->definitionCount || nextRef != header->referenceCount) {
+        error = "record ranges do not cover the tables";
+        return false;
+    }
+    for (uint32_t i = 0; i < header->definitionCount; i++) {
+        if (defs[i].file >= header->fileCount || !inPool(defs[i].scopeOffset, defs[i].scopeLength)
+                || !inPool(defs[i].typeOffset, defs[i].typeLength)) {
+            error = "definition " + to_string(i) + " is invalid";
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header->referenceCount; i++) {
+        if (refs[i].file >= header->fileCount) {
+            error = "reference " + to_string(i) + " names an unknown file";
+            return false;
+        }
+    }
+    return true;
+}
+
+const IndexedName* SymbolIndexView::find(string_view name) const {
+    if (!header) return nullptr;
+    uint32_t low = 0, high = header->nameCount;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        int order = nameText(names[mid]).compare(name);
+        if (order == 0) return &names[mid];
+        if (order < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return nullptr;
+}
+
+bool updateSymbolIndex(const string& indexPath, const vector<string>& paths,
+                       SymbolIndexUpdate& update, string& error) {
+    update = SymbolIndexUpdate();
+    SymbolIndexView old;
+    string ignored;
+    if (old.open(indexPath, ignored) && !old.validate(ignored)) old.close();
+
+    unordered_map<string_view, uint32_t> oldFiles;
+    for (uint32_t f = 0; f < old.fileCount(); f++) oldFiles.emplace(old.path(f), f);
+
+    // Listed files that did not change since the old index was written
+    vector<bool> keep(old.fileCount(), false);
+    vector<bool> listed(old.fileCount(), false);
+    vector<pair<const string*, FileStamp>> changed;
+    for (const string& path : paths) {
+        auto it = oldFiles.find(path);
+        if (it != oldFiles.end()) {
+            if (listed[it->second]) continue;   // listed twice
+            listed[it->second] = true;
+        }
+        FileStamp stamp;
+        if (!statFile(path, stamp)) {
+            update.unreadable++;
+            continue;
+        }
+        if (it != oldFiles.end() && old.file(it->second).size == stamp.size
+                && old.file(it->second).mtime == stamp.mtime) {
+            keep[it->second] = true;
+            update.reused++;
+        } else {
+            changed.push_back({&path, stamp});
+        }
+    }
+    update.removed = count(listed.begin(), listed.end(), false);
+
+    SymbolIndexBuilder builder;
+    builder.copyFiles(old, keep);
+    old.close();
+    for (const auto& [path, stamp] : changed) {
+        ifstream file(*path, ios::binary);
+        if (!file.is_open()) {
+            update.unreadable++;
+            continue;
+        }
+        string source((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+        builder.addFile(*path, stamp, generateSymbolTable(tokenize(source)));
+        update.indexed++;
+    }
+    return builder.write(indexPath, error);
+}
@@ -0,0 +1,192 @@
+#ifndef SYMBOL_INDEX_H
+#define SYMBOL_INDEX_H
+
+#include "lexical_analyzer.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Project-wide symbol index built from the per-file symbol tables, for
+// "find definition" and "find references" across many files without
+// tokenizing them again. Loaded by mapping the file read-only, like the
+// binary AST format:
+//
+//   header | files | names | definitions | references | string pool
+//
+// Names are interned once and sorted bytewise, so a lookup is a binary
+// search. Each name owns a run of definition records and a run of reference
+// records (its postings), both ordered by file and then position. Every
+// position is an offset from the start of the file and integers are in the
+// writer's byte order.
+const char SYMBOL_INDEX_MAGIC[8] = {'P', 'Y', 'S', 'Y', 'M', 'I', 'D', 'X'};
+const uint32_t SYMBOL_INDEX_VERSION = 1;
+const uint32_t SYMBOL_INDEX_BYTE_ORDER_MARK = 0x01020304;
+const uint32_t SYMBOL_NO_OFFSET = UINT32_MAX;   // token offset not recorded
+
+struct SymbolIndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t fileCount;
+    uint32_t nameCount;
+    uint32_t definitionCount;
+    uint32_t referenceCount;
+    uint64_t filesOffset;
+    uint64_t namesOffset;
+    uint64_t definitionsOffset;
+    uint64_t referencesOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t fileSize;
+};
+
+// An indexed source file. size and mtime tell an update whether the file
+// changed since it was indexed.
+struct IndexedFile {
+    uint32_t pathOffset;
+    uint32_t pathLength;
+    uint64_t size;
+    int64_t mtime;          // nanoseconds since the epoch
+};
+
+struct IndexedName {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t firstDefinition;
+    uint32_t definitionCount;
+    uint32_t firstReference;
+    uint32_t referenceCount;
+};
+
+// A declared symbol, at its first occurrence.
+struct IndexedDefinition {
+    uint32_t file;
+    uint32_t line;
+    uint32_t offset;        // byte offset in the source, SYMBOL_NO_OFFSET if unknown
+    uint32_t scopeOffset;
+    uint32_t scopeLength;
+    uint32_t typeOffset;
+    uint32_t typeLength;
+};
+
+struct IndexedReference {
+    uint32_t file;
+    uint32_t line;
+    uint32_t offset;
+};
+
+static_assert(sizeof(SymbolIndexHeader) == 88, "SymbolIndexHeader layout is part of the file format");
+static_assert(sizeof(IndexedFile) == 24, "IndexedFile layout is part of the file format");
+static_assert(sizeof(IndexedName) == 24, "IndexedName layout is part of the file format");
+static_assert(sizeof(IndexedDefinition) == 28, "IndexedDefinition layout is part of the file format");
+static_assert(sizeof(IndexedReference) == 12, "IndexedReference layout is part of the file format");
+
+// Read-only view of a mapped index. open() checks the header only; call
+// validate() before trusting a file from elsewhere.
+class SymbolIndexView {
+public:
+    SymbolIndexView() = default;
+    ~SymbolIndexView();
+    SymbolIndexView(const SymbolIndexView&) = delete;
+    SymbolIndexView& operator=(const SymbolIndexView&) = delete;
+
+    bool open(const std::string& path, std::string& error);
+    void close();
+    bool validate(std::string& error) const;
+    bool isOpen() const { return header != nullptr; }
+
+    uint32_t fileCount() const { return header ? header->fileCount : 0; }
+    uint32_t nameCount() const { return header ? header->nameCount : 0; }
+    uint32_t definitionCount() const { return header ? header->definitionCount : 0; }
+    uint32_t referenceCount() const { return header ? header->referenceCount : 0; }
+
+    const IndexedFile& file(uint32_t index) const { return files[index]; }
+    std::string_view path(uint32_t file) const { return text(files[file].pathOffset, files[file].pathLength); }
+
+    // Record for name, or null. O(log names).
+    const IndexedName* find(std::string_view name) const;
+
+    const IndexedName& name(uint32_t index) const { return names[index]; }
+    std::string_view nameText(const IndexedName& name) const { return text(name.nameOffset, name.nameLength); }
+
+    // The definitionCount / referenceCount records of a name start here.
+    const IndexedDefinition* definitions(const IndexedName& name) const { return defs + name.firstDefinition; }
+    const IndexedReference* references(const IndexedName& name) const { return refs + name.firstReference; }
+
+    std::string_view scope(const IndexedDefinition& d) const { return text(d.scopeOffset, d.scopeLength); }
+    std::string_view type(const IndexedDefinition& d) const { return text(d.typeOffset, d.typeLength); }
+
+private:
+    const char* data = nullptr;
+    size_t length = 0;
+    const SymbolIndexHeader* header = nullptr;
+    const IndexedFile* files = nullptr;
+    const IndexedName* names = nullptr;
+    const IndexedDefinition* defs = nullptr;
+    const IndexedReference* refs = nullptr;
+    const char* strings = nullptr;
+
+    std::string_view text(uint32_t offset, uint32_t size) const { return std::string_view(strings + offset, size); }
+};
+
+// Size and modification time of a file on disk; false if it cannot be read.
+struct FileStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+};
+
+bool statFile(const std::string& path, FileStamp& stamp);
+
+// Collects files in memory and writes a new index. Records are grouped by
+// name when written, so files can be added in any order.
+class SymbolIndexBuilder {
+public:
+    // Indexes the symbols of one file.
+    void addFile(const std::string& path, const FileStamp& stamp, const SymbolTable& table);
+
+    // Copies the records of the files in old for which keep[file] is true,
+    // in one pass over the old index.
+    void copyFiles(const SymbolIndexView& old, const std::vector<bool>& keep);
+
+    // Written under a temporary name and renamed, so readers never map a
+    // partial file.
+    bool write(const std::string& path, std::string& error) const;
+
+    size_t fileCount() const { return files.size(); }
+
+private:
+    struct Definition {
+        uint32_t file, line, offset;
+        std::string scope, type;
+    };
+    struct Postings {
+        std::vector<Definition> definitions;
+        std::vector<IndexedReference> references;
+    };
+    struct File {
+        std::string path;
+        FileStamp stamp;
+    };
+    std::vector<File> files;
+    std::unordered_map<std::string, Postings> postings;
+
+    uint32_t addFileRecord(const std::string& path, const FileStamp& stamp);
+};
+
+struct SymbolIndexUpdate {
+    size_t reused = 0;      // unchanged files copied from the old index
+    size_t indexed = 0;     // new or changed files tokenized again
+    size_t removed = 0;     // files in the old index that were not listed
+    size_t unreadable = 0;  // listed files that could not be read
+};
+
+// Brings the index at indexPath up to date with paths. Files whose size and
+// modification time match the old index keep their records; only the others
+// are read and tokenized. Files not listed are dropped. A missing or
+// unreadable old index means everything is indexed.
+bool updateSymbolIndex(const std::string& indexPath, const std::vector<std::string>& paths,
+                       SymbolIndexUpdate& update, std::string& error);
+
+#endif // SYMBOL_INDEX_H
@@ -0,0 +1,122 @@
+// Symbol index tool: builds and queries the project-wide symbol index
+// (symbol_index.h) without tokenizing the project for every query.
+//
+//   g++ -std=c++17 -O2 -o symbol_index_tool symbol_index_tool.cpp symbol_index.cpp lexical_analyzer.cpp
+//   ./symbol_index_tool INDEX update FILE...     index new and changed files, drop unlisted ones
+//   ./symbol_index_tool INDEX def NAME           where NAME is declared
+//   ./symbol_index_tool INDEX refs NAME          every occurrence of NAME
+//   ./symbol_index_tool INDEX check              validate the file and print its size
+
+#include "symbol_index.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static int usage(const char* program) {
+    cerr << "Usage: " << program << " INDEX update FILE... | def NAME | refs NAME | check" << endl;
+    cerr << "       " << program << " INDEX update --list=FILE   (one path per line)" << endl;
+    return 1;
+}
+
+static int run_update(const string& indexPath, const vector<string>& paths) {
+    using Clock = chrono::steady_clock;
+    SymbolIndexUpdate update;
+    string error;
+    auto start = Clock::now();
+    bool written = updateSymbolIndex(indexPath, paths, update, error);
+    double ms = chrono::duration<double, milli>(Clock::now() - start).count();
+    if (!written) {
+        cerr << "Error updating index: " << error << endl;
+        return 1;
+    }
+    cout << indexPath << ": " << update.indexed << " files indexed, " << update.reused << " unchanged, "
+         << update.removed << " removed";
+    if (update.unreadable > 0) cout << ", " << update.unreadable << " unreadable";
+    cout << " in " << fixed << setprecision(3) << ms << " ms" << endl;
+    return 0;
+}
+
+static int run_query(const string& indexPath, const string& command, const string& name) {
+    using Clock = chrono::steady_clock;
+    SymbolIndexView index;
+    string error;
+    auto start = Clock::now();
+    bool loaded = index.open(indexPath, error);
+    double mapMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    if (!loaded) {
+        cerr << "Error loading index: " << error << endl;
+        return 1;
+    }
+
+    start = Clock::now();
+    const IndexedName* entry = index.find(name);
+    double lookupUs = chrono::duration<double, micro>(Clock::now() - start).count();
+
+    size_t found = 0;
+    if (entry && command == "def") {
+        const IndexedDefinition* defs = index.definitions(*entry);
+        for (uint32_t i = 0; i < entry->definitionCount; i++) {
+            cout << index.path(defs[i].file) << ":" << defs[i].line << ": " << index.type(defs[i])
+                 << " " << name << " (scope " << index.scope(defs[i]) << ")\n";
+        }
+        found = entry->definitionCount;
+    } else if (entry) {
+        const IndexedReference* refs = index.references(*entry);
+        for (uint32_t i = 0; i < entry->referenceCount; i++) {
+            cout << index.path(refs[i].file) << ":" << refs[i].line;
+            if (refs[i].offset != SYMBOL_NO_OFFSET) cout << " (offset " << refs[i].offset << ")";
+            cout << "\n";
+        }
+        found = entry->referenceCount;
+    }
+    cout << found << (command == "def" ? " definitions" : " references") << " of " << name
+         << "; mapped in " << fixed << setprecision(3) << mapMs << " ms, lookup " << lookupUs << " us" << endl;
+    return found > 0 ? 0 : 1;
+}
+
+static int run_check(const string& indexPath) {
+    SymbolIndexView index;
+    string error;
+    if (!index.open(indexPath, error) || !index.validate(error)) {
+        cerr << "Error loading index: " << error << endl;
+        return 1;
+    }
+    cout << indexPath << ": " << index.fileCount() << " files, " << index.nameCount() << " names, "
+         << index.definitionCount() << " definitions, " << index.referenceCount() << " references" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) return usage(argv[0]);
+    string indexPath = argv[1];
+    string command = argv[2];
+
+    if (command == "update") {
+        vector<string> paths;
+        for (int i = 3; i < argc; i++) {
+            string arg = argv[i];
+            if (arg.rfind("--list=", 0) == 0) {
+                ifstream list(arg.substr(7));
+                if (!list.is_open()) {
+                    cerr << "Error opening file list: " << arg.substr(7) << endl;
+                    return 1;
+                }
+                string line;
+                while (getline(list, line)) {
+                    if (!line.empty()) paths.push_back(line);
+                }
+            } else {
+                paths.push_back(arg);
+            }
+        }
+        return run_update(indexPath, paths);
+    }
+    if ((command == "def" || command == "refs") && argc == 4) return run_query(indexPath, command, argv[3]);
+    if (command == "check" && argc == 3) return run_check(indexPath);
+    return usage(argv[0]);
+}
@@ -0,0 +1,76 @@
+// Symbol table test: builds SymbolTables (lexical_analyzer.h) from small
+// programs and checks what iteration, lookup and the printed table report.
+//
+//   g++ -std=c++17 -O2 -o symbol_table_test symbol_table_test.cpp lexical_analyzer.cpp
+//   ./symbol_table_test     prints each failed check; exit status 1 if any failed
+
+#include "lexical_analyzer.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const string& what) {
+    if (ok) return;
+    cout << "FAILED: " << what << "\n";
+    failures++;
+}
+
+static vector<string> iteratedNames(const SymbolTable& table) {
+    vector<string> names;
+    for (const SymbolTable::Symbol& symbol : table) names.push_back(symbol.name);
+    return names;
+}
+
+static string printed(const SymbolTable& table) {
+    ostringstream out;
+    printSymbolTable(table, out);
+    return out.str();
+}
+
+// A function declared twice is one symbol: it is iterated and counted once,
+// in the place of its first declaration, with the entry of the last one.
+static void testRedeclaredFunction() {
+    SymbolTable table = generateSymbolTable(tokenize(
+        "def f(a):\n"
+        "    return a\n"
+        "def f(a):\n"
+        "    return a + 1\n"));
+    vector<string> names = iteratedNames(table);
+    check(names == vector<string>{"f", "a"}, "redeclared function: iterates f, a once each, got " +
+                                                 to_string(names.size()) + " symbols");
+    check(table.declaredCount() == 2, "redeclared function: declaredCount() is 2, got " +
+                                          to_string(table.declaredCount()));
+    check(printed(table).find("Total identifiers: 2\n") != string::npos,
+          "redeclared function: printed total is 2");
+    const SymbolEntry* f = table.find("f", "f");
+    check(f && f->lines.front() == 3, "redeclared function: entry is the second declaration");
+}
+
+// Every declared (name, scope) pair is iterated once, in order of occurrence.
+static void testDeclarationOrder() {
+    SymbolTable table = generateSymbolTable(tokenize(
+        "x = 1\n"
+        "def g(y):\n"
+        "    z = y + x\n"
+        "    return z\n"
+        "w = g(x)\n"));
+    vector<string> names = iteratedNames(table);
+    check(names == vector<string>{"x", "g", "y", "z", "x", "w", "g"}, "declaration order");
+    check(table.declaredCount() == names.size(), "declaration order: declaredCount() matches iteration");
+}
+
+int main() {
+    testRedeclaredFunction();
+    testDeclarationOrder();
+    if (failures > 0) {
+        cout << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "all symbol table checks passed" << endl;
+    return 0;
+}
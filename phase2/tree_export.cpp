@@ -0,0 +1,254 @@
+#include "tree_export.h"
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+using namespace std;
+
+OutputBuffer::OutputBuffer(ostream& out, size_t capacity) : out(out), capacity(capacity) {
+    buffer.reserve(capacity);
+}
+
+void OutputBuffer::flush() {
+    if (buffer.empty()) return;
+    out.write(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+void OutputBuffer::appendNumber(uint64_t n) {
+    char digits[20];
+    auto result = to_chars(digits, digits + sizeof(digits), n);
+    append(string_view(digits, result.ptr - digits));
+}
+
+void OutputBuffer::appendSpaces(size_t n) {
+    if (buffer.size() + n > capacity) flush();
+    buffer.append(n, ' ');
+}
+
+void OutputBuffer::appendDotEscaped(string_view s) {
+    if (s.find_first_of("\"\\\n\r\t") == string_view::npos) {
+        append(s);
+        return;
+    }
+    for (char c : s) {
+        switch (c) {
+            case '"': append("\\\""); break;
+            case '\\': append("\\\\"); break;
+            case '\n': append("\\n"); break;
+            case '\r': append("\\r"); break;
+            case '\t': append("\\t"); break;
+            default: append(c);
+        }
+    }
+}
+
+void OutputBuffer::appendJsonEscaped(string_view s) {
+    static const char hex[] = "0123456789abcdef";
+    bool plain = true;
+    for (char c : s) {
+        if (c == '"' || c == '\\' || (unsigned char)c < 0x20) {
+            plain = false;
+            break;
+        }
+    }
+    if (plain) {
+        append(s);
+        return;
+    }
+    for (char c : s) {
+        switch (c) {
+            case '"': append("\\\""); break;
+            case '\\': append("\\\\"); break;
+            case '\n': append("\\n"); break;
+            case '\r': append("\\r"); break;
+            case '\t': append("\\t"); break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    append("\\u00");
+                    append(hex[(unsigned char)c >> 4]);
+                    append(hex[c & 0xf]);
+                } else {
+                    append(c);
+                }
+        }
+    }
+}
+
+namespace {
+
+// Roots to export: the whole tree, or every outermost node of the kind.
+vector<const ParseTreeNode*> exportRoots(const shared_ptr<ParseTreeNode>& root, const TreeExportOptions& options) {
+    vector<const ParseTreeNode*> roots;
+    if (!root) return roots;
+    if (!options.filterKind) {
+        roots.push_back(root.get());
+        return roots;
+    }
+    vector<const ParseTreeNode*> pending = {root.get()};
+    while (!pending.empty()) {
+        const ParseTreeNode* node = pending.back();
+        pending.pop_back();
+        if (node->kind == options.subtreeKind) {
+            roots.push_back(node);
+            continue;
+        }
+        for (size_t i = node->children.size(); i > 0; i--) {
+            if (node->children[i - 1]) pending.push_back(node->children[i - 1].get());
+        }
+    }
+    return roots;
+}
+
+struct ExportFrame {
+    const ParseTreeNode* node;
+    size_t next;
+    int depth;
+};
+
+// Preorder walk calling enter(node, depth, truncated) and leave(node, depth,
+// expanded). Depth is relative to each export root.
+template <typename Enter, typename Leave>
+void walkForExport(const vector<const ParseTreeNode*>& roots, const TreeExportOptions& options,
+                   Enter enter, Leave leave) {
+    auto expanded = [&](const ParseTreeNode* node, int depth) {
+        return !node->children.empty() && (options.maxDepth < 0 || depth < options.maxDepth);
+    };
+    vector<ExportFrame> stack;
+    for (const ParseTreeNode* root : roots) {
+        enter(*root, 0, !root->children.empty() && !expanded(root, 0));
+        stack.push_back({root, 0, 0});
+        while (!stack.empty()) {
+            ExportFrame& frame = stack.back();
+            if (expanded(frame.node, frame.depth) && frame.next < frame.node->children.size()) {
+                const ParseTreeNode* child = frame.node->children[frame.next++].get();
+                if (!child) continue;
+                int depth = frame.depth + 1;
+                enter(*child, depth, !child->children.empty() && !expanded(child, depth));
+                stack.push_back({child, 0, depth});
+                continue;
+            }
+            leave(*frame.node, frame.depth, expanded(frame.node, frame.depth));
+            stack.pop_back();
+        }
+    }
+}
+
+void writeText(const vector<const ParseTreeNode*>& roots, OutputBuffer& out, const TreeExportOptions& options) {
+    walkForExport(roots, options,
+        [&](const ParseTreeNode& node, int depth, bool truncated) {
+            out.appendSpaces(depth * 2);
+            out.append(node.name);
+            if (!node.value.empty()) {
+                out.append(" (");
+                out.append(node.value);
+                out.append(')');
+            }
+            if (truncated) {
+                out.append(" [+");
+                out.appendNumber(node.children.size());
+                out.append(']');
+            }
+            out.append('\n');
+        },
+        [](const ParseTreeNode&, int, bool) {});
+}
+
+void writeDot(const vector<const ParseTreeNode*>& roots, OutputBuffer& out, const TreeExportOptions& options) {
+    out.append("digraph ParseTree {\n");
+    out.append("    node [shape=box, fontname=\"Arial\"];\n");
+    out.append("    edge [arrowhead=vee];\n");
+    out.append("    rankdir=TB;\n");
+    uint64_t counter = 0;
+    vector<uint64_t> ids;
+    walkForExport(roots, options,
+        [&](const ParseTreeNode& node, int depth, bool truncated) {
+            uint64_t current = counter++;
+            out.append("    node");
+            out.appendNumber(current);
+            out.append(" [label=\"");
+            out.appendDotEscaped(node.name);
+            if (!node.value.empty()) {
+                out.append("\\n");
+                out.appendDotEscaped(node.value);
+            }
+            out.append(truncated ? "\", style=dashed];\n" : "\"];\n");
+            if (depth > 0) {
+                out.append("    node");
+                out.appendNumber(ids.back());
+                out.append(" -> node");
+                out.appendNumber(current);
+                out.append(";\n");
+            }
+            ids.push_back(current);
+        },
+        [&](const ParseTreeNode&, int, bool) { ids.pop_back(); });
+    out.append("}\n");
+}
+
+void writeJson(const vector<const ParseTreeNode*>& roots, OutputBuffer& out, const TreeExportOptions& options) {
+    // One flag per open children array: whether the next element needs a comma
+    vector<bool> needComma = {false};
+    if (options.filterKind) out.append('[');
+    walkForExport(roots, options,
+        [&](const ParseTreeNode& node, int, bool truncated) {
+            if (needComma.back()) out.append(',');
+            needComma.back() = true;
+            out.append("{\"name\":\"");
+            out.appendJsonEscaped(node.name);
+            out.append('"');
+            if (!node.value.empty()) {
+                out.append(",\"value\":\"");
+                out.appendJsonEscaped(node.value);
+                out.append('"');
+            }
+            if (truncated) {
+                out.append(",\"truncated\":true");
+            } else if (!node.children.empty()) {
+                out.append(",\"children\":[");
+            }
+            needComma.push_back(false);
+        },
+        [&](const ParseTreeNode&, int, bool expanded) {
+            needComma.pop_back();
+            out.append(expanded ? "]}" : "}");
+        });
+    if (options.filterKind) out.append(']');
+    out.append('\n');
+}
+
+} // namespace
+
+void printParseTree(const shared_ptr<ParseTreeNode>& root, ostream& out, const TreeExportOptions& options) {
+    exportParseTree(root, out, TreeFormat::TEXT, options);
+}
+
+void exportParseTree(const shared_ptr<ParseTreeNode>& root, ostream& out, TreeFormat format,
+                     const TreeExportOptions& options) {
+    vector<const ParseTreeNode*> roots = exportRoots(root, options);
+    OutputBuffer buffer(out);
+    switch (format) {
+        case TreeFormat::TEXT: writeText(roots, buffer, options); break;
+        case TreeFormat::DOT: writeDot(roots, buffer, options); break;
+        case TreeFormat::JSON: writeJson(roots, buffer, options); break;
+    }
+    buffer.flush();
+    out.flush();
+}
+
+bool saveParseTree(const shared_ptr<ParseTreeNode>& root, const string& filename, TreeFormat format,
+                   const TreeExportOptions& options) {
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) {
+        cerr << "Error opening file for writing: " << filename << endl;
+        return false;
+    }
+    exportParseTree(root, out, format, options);
+    return out.good();
+}
+
+future<bool> renderDotToPng(const string& dotFile, const string& pngFile) {
+    string command = "dot -Tpng " + dotFile + " -o " + pngFile;
+    return async(launch::async, [command] { return system(command.c_str()) == 0; });
+}
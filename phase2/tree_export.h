@@ -0,0 +1,61 @@
+#ifndef TREE_EXPORT_H
+#define TREE_EXPORT_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+#include <cstdint>
+#include <future>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Collects output in one large block and hands it to the stream in a single
+// write when full, instead of one formatted insertion (or flush) per token.
+class OutputBuffer {
+public:
+    explicit OutputBuffer(std::ostream& out, size_t capacity = 1 << 20);
+    ~OutputBuffer() { flush(); }
+
+    void append(char c) {
+        if (buffer.size() == capacity) flush();
+        buffer.push_back(c);
+    }
+    void append(std::string_view s) {
+        if (buffer.size() + s.size() > capacity) flush();
+        buffer.append(s.data(), s.size());
+    }
+    void appendNumber(uint64_t n);
+    void appendSpaces(size_t n);
+    void appendDotEscaped(std::string_view s);
+    void appendJsonEscaped(std::string_view s);
+    void flush();
+
+private:
+    std::ostream& out;
+    std::string buffer;
+    size_t capacity;
+};
+
+enum class TreeFormat { TEXT, DOT, JSON };
+
+struct TreeExportOptions {
+    int maxDepth = -1;              // levels below each exported root; -1 for all
+    bool filterKind = false;        // export only the subtrees rooted at subtreeKind
+    NodeKind subtreeKind = NodeKind::other;
+};
+
+// All writers walk the tree with an explicit stack. Nodes cut off by maxDepth
+// are marked: "[+N]" in text, dashed in DOT, "truncated": true in JSON. JSON
+// output is one object for the whole tree, or an array of objects when
+// filtering by kind.
+void printParseTree(const shared_ptr<ParseTreeNode>& root, std::ostream& out,
+                    const TreeExportOptions& options = TreeExportOptions());
+void exportParseTree(const shared_ptr<ParseTreeNode>& root, std::ostream& out, TreeFormat format,
+                     const TreeExportOptions& options = TreeExportOptions());
+bool saveParseTree(const shared_ptr<ParseTreeNode>& root, const string& filename, TreeFormat format,
+                   const TreeExportOptions& options = TreeExportOptions());
+
+// Runs Graphviz in the background; the result is true if the PNG was written.
+std::future<bool> renderDotToPng(const string& dotFile, const string& pngFile);
+
+#endif // TREE_EXPORT_H
@@ -0,0 +1,924 @@
+#include "type_inference.h"
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+using namespace std;
+
+// A function called with more distinct argument signatures than this gets
+// one shared analysis with unknown arguments for the rest.
+const uint32_t MAX_SIGNATURES = 8;
+
+// Callees are analysed at the call while fewer than this many analyses are
+// in progress; deeper calls are queued instead, to bound the C++ stack.
+const int MAX_NESTED_ANALYSES = 64;
+
+static const char* const TYPE_NAMES[TYPE_BIT_COUNT] = {
+    "int", "float", "complex", "bool", "str", "None", "list", "dict",
+    "function", "class", "instance", "module", "unknown",
+};
+
+string type_set_name(TypeSet types) {
+    if (types == 0) return "never";
+    string name;
+    for (int bit = 0; bit < TYPE_BIT_COUNT; bit++) {
+        if (!(types & (1 << bit))) continue;
+        if (!name.empty()) name += '|';
+        name += TYPE_NAMES[bit];
+    }
+    return name;
+}
+
+// bool < int < float < complex, or -1 for other types.
+static int numeric_rank(TypeSet bit) {
+    switch (bit) {
+        case TYPE_BOOL: return 0;
+        case TYPE_INT: return 1;
+        case TYPE_FLOAT: return 2;
+        case TYPE_COMPLEX: return 3;
+        default: return -1;
+    }
+}
+
+static const TypeSet NUMERIC_BY_RANK[4] = {TYPE_BOOL, TYPE_INT, TYPE_FLOAT, TYPE_COMPLEX};
+
+// Result of op on two single types.
+static TypeSet operator_result(TypeSet a, const string& op, TypeSet b) {
+    if ((a | b) & (TYPE_UNKNOWN | TYPE_INSTANCE)) return TYPE_UNKNOWN;     // may be overloaded
+    int ra = numeric_rank(a), rb = numeric_rank(b);
+    if (ra >= 0 && rb >= 0) {
+        int rank = max(ra, rb);
+        if (op == "+" || op == "-" || op == "*") return NUMERIC_BY_RANK[max(rank, 1)];
+        if (op == "%" || op == "//") return rank == 3 ? 0 : NUMERIC_BY_RANK[max(rank, 1)];
+        if (op == "/") return NUMERIC_BY_RANK[max(rank, 2)];
+        if (op == "**") return rank <= 1 ? TYPE_INT | TYPE_FLOAT : NUMERIC_BY_RANK[rank];  // 2 ** -1 is a float
+        if (op == "&" || op == "|" || op == "^") return rank == 0 ? TYPE_BOOL : rank == 1 ? TYPE_INT : 0;
+        if (op == "<<" || op == ">>") return rank <= 1 ? TYPE_INT : 0;
+        return 0;
+    }
+    TypeSet sequences = TYPE_STR | TYPE_LIST;
+    if (op == "+" && a == b && (a & sequences)) return a;
+    if (op == "*" && (a & sequences) && rb >= 0 && rb <= 1) return a;
+    if (op == "*" && (b & sequences) && ra >= 0 && ra <= 1) return b;
+    if (op == "%" && a == TYPE_STR) return TYPE_STR;
+    if (op == "|" && a == TYPE_DICT && b == TYPE_DICT) return TYPE_DICT;
+    return 0;
+}
+
+static bool is_comparison(const string& op) {
+    return op == "==" || op == "!=" || op == "<" || op == ">" || op == "<=" || op == ">=" ||
+           op == "in" || op == "not in" || op == "is" || op == "is not";
+}
+
+TypeSet binary_result_type(TypeSet left, const string& op, TypeSet right) {
+    if (left == 0 || right == 0) return 0;
+    if (op == "and" || op == "or") return left | right;    // either operand is the result
+    if (is_comparison(op)) return TYPE_BOOL;
+    TypeSet result = 0;
+    for (TypeSet a = left; a; a &= a - 1) {
+        for (TypeSet b = right; b; b &= b - 1) {
+            result |= operator_result(a & -a, op, b & -b);
+        }
+    }
+    return result;
+}
+
+TypeSet unary_result_type(const string& op, TypeSet operand) {
+    if (operand == 0) return 0;
+    if (op == "not") return TYPE_BOOL;
+    TypeSet result = 0;
+    for (TypeSet a = operand; a; a &= a - 1) {
+        TypeSet bit = a & -a;
+        int rank = numeric_rank(bit);
+        if (bit & (TYPE_UNKNOWN | TYPE_INSTANCE)) result |= TYPE_UNKNOWN;
+        else if (op == "~" && rank >= 0 && rank <= 1) result |= TYPE_INT;
+        else if (op != "~" && rank >= 0) result |= NUMERIC_BY_RANK[max(rank, 1)];
+    }
+    return result;
+}
+
+// What a builtin name is, and what calling it returns.
+struct BuiltinType {
+    TypeSet value;
+    TypeSet result;
+};
+
+static BuiltinType builtin_type(const string& name) {
+    static const unordered_map<string, BuiltinType> builtins = {
+        {"int", {TYPE_CLASS, TYPE_INT}}, {"float", {TYPE_CLASS, TYPE_FLOAT}},
+        {"complex", {TYPE_CLASS, TYPE_COMPLEX}}, {"bool", {TYPE_CLASS, TYPE_BOOL}},
+        {"str", {TYPE_CLASS, TYPE_STR}}, {"list", {TYPE_CLASS, TYPE_LIST}}, {"dict", {TYPE_CLASS, TYPE_DICT}},
+        {"object", {TYPE_CLASS, TYPE_INSTANCE}}, {"len", {TYPE_FUNCTION, TYPE_INT}},
+        {"ord", {TYPE_FUNCTION, TYPE_INT}}, {"hash", {TYPE_FUNCTION, TYPE_INT}}, {"id", {TYPE_FUNCTION, TYPE_INT}},
+        {"chr", {TYPE_FUNCTION, TYPE_STR}}, {"repr", {TYPE_FUNCTION, TYPE_STR}}, {"ascii", {TYPE_FUNCTION, TYPE_STR}},
+        {"hex", {TYPE_FUNCTION, TYPE_STR}}, {"bin", {TYPE_FUNCTION, TYPE_STR}}, {"oct", {TYPE_FUNCTION, TYPE_STR}},
+        {"format", {TYPE_FUNCTION, TYPE_STR}}, {"input", {TYPE_FUNCTION, TYPE_STR}},
+        {"isinstance", {TYPE_FUNCTION, TYPE_BOOL}}, {"issubclass", {TYPE_FUNCTION, TYPE_BOOL}},
+        {"callable", {TYPE_FUNCTION, TYPE_BOOL}}, {"hasattr", {TYPE_FUNCTION, TYPE_BOOL}},
+        {"all", {TYPE_FUNCTION, TYPE_BOOL}}, {"any", {TYPE_FUNCTION, TYPE_BOOL}},
+        {"sorted", {TYPE_FUNCTION, TYPE_LIST}}, {"dir", {TYPE_FUNCTION, TYPE_LIST}},
+        {"globals", {TYPE_FUNCTION, TYPE_DICT}}, {"locals", {TYPE_FUNCTION, TYPE_DICT}},
+        {"vars", {TYPE_FUNCTION, TYPE_DICT}}, {"print", {TYPE_FUNCTION, TYPE_NONE}},
+        {"setattr", {TYPE_FUNCTION, TYPE_NONE}}, {"delattr", {TYPE_FUNCTION, TYPE_NONE}},
+        {"__name__", {TYPE_STR, TYPE_UNKNOWN}}, {"__file__", {TYPE_STR, TYPE_UNKNOWN}},
+        {"__doc__", {TYPE_STR | TYPE_NONE, TYPE_UNKNOWN}},
+    };
+    auto it = builtins.find(name);
+    if (it != builtins.end()) return it->second;
+    bool exception = name.size() > 5 && (name.compare(name.size() - 5, 5, "Error") == 0 ||
+                                         name.find("Exception") != string::npos);
+    if (exception || name == "StopIteration" || name == "KeyboardInterrupt" || name == "SystemExit") {
+        return {TYPE_CLASS, TYPE_INSTANCE};
+    }
+    return {is_builtin_name(name) ? TYPE_FUNCTION : TYPE_UNKNOWN, TYPE_UNKNOWN};
+}
+
+static const ParseTreeNode* child(const ParseTreeNode& node, size_t i) {
+    return i < node.children.size() ? node.children[i].get() : nullptr;
+}
+
+static const ParseTreeNode* find_child(const ParseTreeNode& node, NodeKind kind) {
+    for (const auto& c : node.children) {
+        if (c && c->kind == kind) return c.get();
+    }
+    return nullptr;
+}
+
+// The single node an expression reduces to, looking through parentheses.
+static const ParseTreeNode* innermost(const ParseTreeNode* node) {
+    while (node) {
+        if ((node->kind == NodeKind::expression || node->kind == NodeKind::factor) && node->children.size() == 1) {
+            node = child(*node, 0);
+        } else if (node->kind == NodeKind::factor && node->children.size() == 3 &&
+                   node->children[0]->kind == NodeKind::DELIMITER) {
+            node = child(*node, 1);
+        } else {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+static TypeSet number_type(const string& text) {
+    NumericLiteral literal;
+    if (!decodeNumber(text, literal)) return TYPE_UNKNOWN;
+    switch (literal.kind) {
+        case NumericLiteral::INT: return TYPE_INT;
+        case NumericLiteral::FLOAT: return TYPE_FLOAT;
+        case NumericLiteral::COMPLEX: return TYPE_COMPLEX;
+    }
+    return TYPE_UNKNOWN;
+}
+
+// Shared state of one inference: the cells analyses read and write, who
+// depends on each, and the cache of analyses by (scope, signature).
+struct TypeInference::Solver {
+    struct Param {
+        uint32_t symbol;
+        const ParseTreeNode* defaultValue;      // null if the parameter has none
+    };
+
+    TypeInference& result;
+    const ScopeTree& tree;
+    uint32_t symbolCount;
+    vector<TypeSet> cells;                      // symbol types, then one return type per analysis
+    vector<vector<uint32_t>> dependents;        // by cell: analyses that read it
+    PackedKeyMap<uint8_t> dependencies;         // pack_key(cell, analysis)
+    IdentifierInterner signatures;              // argument types, as bytes
+    PackedKeyMap<uint32_t> analysisOf;          // pack_key(scope, signature ID) -> analysis
+    vector<uint32_t> signatureCount;            // by scope
+    vector<int32_t> firstScopeNamed;            // by symbol: a def or class it names, or -1
+    vector<int32_t> nextScopeNamed;             // by scope: the next one named by the same symbol
+    vector<uint32_t> paramStart;                // by scope, into params
+    vector<Param> params;
+    PackedKeyMap<uint32_t> scopeOfNode;         // func_def / class_def address -> scope
+    PackedKeyMap<int32_t> resolved;             // IDENTIFIER address -> symbol or -1
+    vector<uint32_t> worklist;
+    size_t worklistHead = 0;
+    vector<bool> queued;
+    int nested = 0;
+
+    Solver(TypeInference& result, const ScopeTree& tree) : result(result), tree(tree) {}
+
+    void prepare() {
+        const vector<Scope>& scopes = tree.scopes();
+        symbolCount = tree.symbols().size();
+        cells.assign(symbolCount, 0);
+        dependents.assign(symbolCount, {});
+        signatureCount.assign(scopes.size(), 0);
+        firstScopeNamed.assign(symbolCount, -1);
+        nextScopeNamed.assign(scopes.size(), -1);
+        paramStart.assign(scopes.size() + 1, 0);
+        for (uint32_t s = 0; s < scopes.size(); s++) {
+            paramStart[s] = params.size();
+            if (s == 0) continue;
+            scopeOfNode.insert((uint64_t)(uintptr_t)scopes[s].node, s);
+            int32_t symbol = tree.lookup(scopes[s].parent, scopes[s].name);
+            if (symbol >= 0) {
+                nextScopeNamed[s] = firstScopeNamed[symbol];
+                firstScopeNamed[symbol] = s;
+            }
+            const ParseTreeNode* paramList = find_child(*scopes[s].node, NodeKind::param_list);
+            if (scopes[s].kind != ScopeKind::FUNCTION || !paramList) continue;
+            for (const auto& param : paramList->children) {
+                if (!param || param->kind != NodeKind::param || param->children.empty()) continue;
+                int32_t paramSymbol = tree.lookup(s, param->children[0]->value);
+                if (paramSymbol >= 0) params.push_back({(uint32_t)paramSymbol, child(*param, 2)});
+            }
+        }
+        paramStart[scopes.size()] = params.size();
+    }
+
+    uint32_t paramCount(uint32_t scope) const { return paramStart[scope + 1] - paramStart[scope]; }
+
+    // Symbol an identifier refers to as seen from scope, resolved once.
+    int32_t symbolOf(const ParseTreeNode& leaf, uint32_t scope) {
+        uint64_t key = (uint64_t)(uintptr_t)&leaf;
+        if (const int32_t* symbol = resolved.find(key)) return *symbol;
+        int32_t symbol;
+        tree.resolve(scope, leaf.value, symbol);
+        resolved.insert(key, symbol);
+        return symbol;
+    }
+
+    static string_view signatureBytes(const vector<TypeSet>& arguments) {
+        return string_view((const char*)arguments.data(), arguments.size() * sizeof(TypeSet));
+    }
+
+    // Arguments for an analysis nobody called: anything, except that the
+    // first parameter of a method is an instance.
+    vector<TypeSet> unknownArguments(uint32_t scope) const {
+        vector<TypeSet> arguments(paramCount(scope), TYPE_UNKNOWN);
+        int32_t parent = tree.scopes()[scope].parent;
+        if (!arguments.empty() && parent >= 0 && tree.scopes()[parent].kind == ScopeKind::CLASS) {
+            arguments[0] = TYPE_INSTANCE;
+        }
+        return arguments;
+    }
+
+    uint32_t analysisFor(uint32_t scope, const vector<TypeSet>& arguments, bool& created) {
+        uint32_t signature = signatures.intern(signatureBytes(arguments));
+        auto inserted = analysisOf.insert(pack_key(scope, signature), result.analysisList.size());
+        created = inserted.second;
+        if (!created) return *inserted.first;
+        result.analysisList.push_back({scope, arguments, 0, 0});
+        cells.push_back(0);
+        dependents.emplace_back();
+        queued.push_back(false);
+        signatureCount[scope]++;
+        return result.analysisList.size() - 1;
+    }
+
+    // Analyses a scope body now if the stack allows, otherwise later.
+    void start(uint32_t analysis) {
+        if (nested >= MAX_NESTED_ANALYSES) {
+            enqueue(analysis);
+            return;
+        }
+        nested++;
+        run(analysis);
+        nested--;
+    }
+
+    void enqueue(uint32_t analysis) {
+        if (queued[analysis]) return;
+        queued[analysis] = true;
+        worklist.push_back(analysis);
+    }
+
+    void depend(uint32_t cell, uint32_t analysis) {
+        if (dependencies.insert(pack_key(cell, analysis), 1).second) dependents[cell].push_back(analysis);
+    }
+
+    // Adds types to a cell and queues whoever read it if it grew.
+    void publish(uint32_t cell, TypeSet types) {
+        if ((cells[cell] | types) == cells[cell]) return;
+        cells[cell] |= types;
+        for (uint32_t analysis : dependents[cell]) enqueue(analysis);
+    }
+
+    // Return type of calling the function scope with these arguments.
+    TypeSet call(uint32_t scope, vector<TypeSet> arguments, uint32_t caller) {
+        if (arguments.size() > paramCount(scope)) arguments.resize(paramCount(scope));
+        uint32_t signature = signatures.find(signatureBytes(arguments));
+        const uint32_t* existing = signature == IdentifierInterner::NONE ? nullptr :
+            analysisOf.find(pack_key(scope, signature));
+        uint32_t analysis;
+        if (existing) {
+            analysis = *existing;
+        } else {
+            if (signatureCount[scope] >= MAX_SIGNATURES) arguments = unknownArguments(scope);
+            bool created;
+            analysis = analysisFor(scope, arguments, created);
+            if (created) start(analysis);
+        }
+        depend(symbolCount + analysis, caller);
+        return cells[symbolCount + analysis];
+    }
+
+    // A class body runs where the class statement is.
+    void defineClass(uint32_t scope) {
+        bool created;
+        uint32_t analysis = analysisFor(scope, {}, created);
+        if (created) start(analysis);
+    }
+
+    void run(uint32_t analysis);
+
+    void solve() {
+        prepare();
+        if (tree.scopes().empty()) return;
+        bool created;
+        enqueue(analysisFor(0, {}, created));
+        while (true) {
+            while (worklistHead < worklist.size()) {
+                uint32_t analysis = worklist[worklistHead++];
+                queued[analysis] = false;
+                run(analysis);
+            }
+            worklist.clear();
+            worklistHead = 0;
+            // Functions nothing calls, and classes inside them, are analysed as well
+            for (uint32_t s = 0; s < tree.scopes().size(); s++) {
+                if (signatureCount[s] == 0) enqueue(analysisFor(s, unknownArguments(s), created));
+            }
+            if (worklist.empty()) break;
+        }
+        result.symbolTypes.assign(cells.begin(), cells.begin() + symbolCount);
+        for (size_t a = 0; a < result.analysisList.size(); a++) {
+            ScopeAnalysis& analysis = result.analysisList[a];
+            analysis.returns = cells[symbolCount + a];
+            result.returnTypes[analysis.scope] |= analysis.returns;
+        }
+    }
+};
+
+// Walks one scope body. Types of the scope's own names live in env, which is
+// updated in place; every change is also pushed on a trail with the previous
+// type, so a branch is undone by popping the trail back to where it started
+// and its effect kept as a short list of changes. Joining branches then
+// costs what they changed, not the size of the scope.
+struct TypeInference::Walker {
+    struct Change {
+        uint32_t slot;
+        TypeSet types;
+    };
+    // The state at the end of one way through a statement, as changes
+    // against the state before it.
+    struct Path {
+        bool reachable;
+        vector<Change> changes;
+    };
+    struct Loop {
+        size_t mark;
+        vector<Path> breaks, continues;
+    };
+
+    Solver& solver;
+    uint32_t analysis;
+    uint32_t scope;
+    uint32_t evalScope;         // scope names are resolved in; the parent for defaults
+    uint32_t symbolBegin;
+    vector<TypeSet> env;        // by symbol - symbolBegin
+    vector<Change> trail;
+    bool reachable = true;
+    vector<Loop> loops;
+    vector<uint32_t> seen;      // scratch for joins, stamped per use
+    vector<TypeSet> joined;
+    vector<uint32_t> changedIn;
+    uint32_t stamp = 0;
+
+    Walker(Solver& solver, uint32_t analysis) : solver(solver), analysis(analysis) {
+        scope = evalScope = solver.result.analysisList[analysis].scope;
+        const Scope& s = solver.tree.scopes()[scope];
+        symbolBegin = s.symbolBegin;
+        size_t size = s.symbolEnd - s.symbolBegin;
+        env.assign(size, 0);
+        seen.assign(size, 0);
+        joined.assign(size, 0);
+        changedIn.assign(size, 0);
+    }
+
+    uint32_t returnCell() const { return solver.symbolCount + analysis; }
+
+    void run() {
+        const Scope& s = solver.tree.scopes()[scope];
+        if (s.kind == ScopeKind::MODULE) {
+            statements(s.node);
+            return;
+        }
+        if (s.kind == ScopeKind::CLASS) {
+            statements(find_child(*s.node, NodeKind::statement_list));
+            return;
+        }
+        // Copied: defaults may call functions, which adds analyses
+        vector<TypeSet> arguments = solver.result.analysisList[analysis].arguments;
+        for (uint32_t i = 0; i < solver.paramCount(scope); i++) {
+            const Solver::Param& param = solver.params[solver.paramStart[scope] + i];
+            TypeSet types = TYPE_UNKNOWN;
+            if (i < arguments.size()) {
+                types = arguments[i];
+            } else if (param.defaultValue) {
+                evalScope = s.parent;
+                types = value(param.defaultValue);
+                evalScope = scope;
+            }
+            set(param.symbol - symbolBegin, types);
+            solver.publish(param.symbol, types);
+        }
+        const ParseTreeNode* body = find_child(*s.node, NodeKind::statement_list);
+        if (!body) body = find_child(*s.node, NodeKind::lazy_body);
+        if (!body) body = find_child(*s.node, NodeKind::statement);     // def f(): return 1
+        if (body) statement(*body);
+        if (reachable) returned(TYPE_NONE);
+    }
+
+    // --- state ---
+
+    void set(uint32_t slot, TypeSet types) {
+        if (env[slot] == types) return;
+        trail.push_back({slot, env[slot]});
+        env[slot] = types;
+    }
+
+    // Binds a name of this scope.
+    void bind(const ParseTreeNode* leaf, TypeSet types) {
+        if (!leaf || leaf->kind != NodeKind::IDENTIFIER) return;
+        int32_t symbol = solver.symbolOf(*leaf, scope);
+        if (symbol < 0 || solver.tree.symbols()[symbol].scope != scope) return;
+        set(symbol - symbolBegin, types);
+        solver.publish(symbol, types);
+    }
+
+    TypeSet read(const ParseTreeNode& leaf) {
+        int32_t symbol = solver.symbolOf(leaf, evalScope);
+        if (symbol < 0) return builtin_type(leaf.value).value;
+        if (evalScope == scope && solver.tree.symbols()[symbol].scope == scope) return env[symbol - symbolBegin];
+        solver.depend(symbol, analysis);
+        return solver.cells[symbol];
+    }
+
+    void returned(TypeSet types) {
+        solver.publish(returnCell(), types);
+        reachable = false;
+    }
+
+    // Current types of the slots changed since mark, each once.
+    void changesSince(size_t mark, vector<Change>& out) {
+        stamp++;
+        for (size_t i = trail.size(); i-- > mark;) {
+            uint32_t slot = trail[i].slot;
+            if (seen[slot] == stamp) continue;
+            seen[slot] = stamp;
+            out.push_back({slot, env[slot]});
+        }
+    }
+
+    void rollback(size_t mark) {
+        for (; trail.size() > mark; trail.pop_back()) env[trail.back().slot] = trail.back().types;
+    }
+
+    // Ends a branch begun at mark: records it and restores the state.
+    Path endBranch(size_t mark) {
+        Path path{reachable, {}};
+        if (reachable) changesSince(mark, path.changes);
+        rollback(mark);
+        return path;
+    }
+
+    // Joins paths that all started from the current state.
+    void merge(const vector<Path>& paths) {
+        uint32_t live = 0;
+        for (const Path& path : paths) live += path.reachable;
+        reachable = live > 0;
+        if (!reachable) return;
+        stamp++;
+        vector<uint32_t> slots;
+        for (const Path& path : paths) {
+            if (!path.reachable) continue;
+            for (const Change& change : path.changes) {
+                if (seen[change.slot] != stamp) {
+                    seen[change.slot] = stamp;
+                    joined[change.slot] = 0;
+                    changedIn[change.slot] = 0;
+                    slots.push_back(change.slot);
+                }
+                joined[change.slot] |= change.types;
+                changedIn[change.slot]++;
+            }
+        }
+        // A path that left a slot alone contributes its current type
+        for (uint32_t slot : slots) set(slot, joined[slot] | (changedIn[slot] < live ? env[slot] : 0));
+    }
+
+    // --- statements ---
+
+    void statements(const ParseTreeNode* list) {
+        if (!list) return;
+        for (const auto& c : list->children) {
+            if (!reachable) return;
+            if (c) statement(*c);
+        }
+    }
+
+    void statement(const ParseTreeNode& node) {
+        switch (node.kind) {
+            case NodeKind::statement:
+            case NodeKind::statement_list:
+            case NodeKind::loop_statement:
+            case NodeKind::loop_statement_list:
+                statements(&node);
+                return;
+            case NodeKind::assignment: assignment(node); return;
+            case NodeKind::augmented_assignment: augmentedAssignment(node); return;
+            case NodeKind::return_stmt: returned(value(child(node, 1))); return;
+            case NodeKind::yield_stmt:
+                if (const ParseTreeNode* expr = find_child(node, NodeKind::expression)) value(expr);
+                solver.publish(returnCell(), TYPE_UNKNOWN);     // a generator
+                return;
+            case NodeKind::break_stmt: leaveLoop(true); return;
+            case NodeKind::continue_stmt: leaveLoop(false); return;
+            case NodeKind::del_stmt: deletion(node); return;
+            case NodeKind::if_stmt: ifStatement(node); return;
+            case NodeKind::while_stmt:
+                loop(child(node, 1), nullptr, 0, find_child(node, NodeKind::loop_statement_list));
+                return;
+            case NodeKind::for_stmt: forStatement(node); return;
+            case NodeKind::func_def: functionDefinition(node); return;
+            case NodeKind::class_def: classDefinition(node); return;
+            case NodeKind::try_stmt: tryStatement(node); return;
+            case NodeKind::import_stmt: importStatement(node); return;
+            case NodeKind::func_call: call(node); return;
+            case NodeKind::lazy_body: returned(TYPE_UNKNOWN); return;    // not parsed; could return anything
+            default: return;
+        }
+    }
+
+    void assignment(const ParseTreeNode& node) {
+        TypeSet types = value(child(node, 2));
+        const ParseTreeNode* target = child(node, 0);
+        const ParseTreeNode* primary = target ? child(*target, 0) : nullptr;
+        if (!primary) return;
+        const ParseTreeNode* tail = child(*target, 1);
+        if (primary->children.size() == 1 && (!tail || tail->children.empty())) {
+            bind(child(*primary, 0), types);
+            return;
+        }
+        // a[i] = v and a.b = v use a
+        if (const ParseTreeNode* name = child(*primary, 0)) read(*name);
+        if (const ParseTreeNode* index = find_child(*primary, NodeKind::expression)) value(index);
+    }
+
+    void augmentedAssignment(const ParseTreeNode& node) {
+        const ParseTreeNode* name = child(node, 0);
+        const ParseTreeNode* op = child(node, 1);
+        TypeSet operand = value(child(node, 2));
+        if (!name || !op || op->value.empty()) return;
+        string binaryOp = op->value.substr(0, op->value.size() - 1);    // "+=" -> "+"
+        bind(name, binary_result_type(read(*name), binaryOp, operand));
+    }
+
+    void deletion(const ParseTreeNode& node) {
+        const ParseTreeNode* target = find_child(node, NodeKind::del_target);
+        if (!target || target->children.empty()) return;
+        const ParseTreeNode* name = child(*target, 0);
+        if (target->children.size() == 1) {
+            int32_t symbol = solver.symbolOf(*name, scope);
+            if (symbol >= 0 && solver.tree.symbols()[symbol].scope == scope) set(symbol - symbolBegin, 0);
+            return;
+        }
+        read(*name);
+        if (const ParseTreeNode* index = find_child(*target, NodeKind::expression)) value(index);
+    }
+
+    void ifStatement(const ParseTreeNode& node) {
+        bool entry = reachable;
+        vector<Path> paths;
+        value(child(node, 1));
+        branch(find_child(node, NodeKind::statement_list), paths);
+        bool hasElse = false;
+        for (const auto& c : node.children) {
+            if (!c || c->children.empty()) continue;
+            if (c->kind == NodeKind::elif_stmt) {
+                value(child(*c, 1));
+                branch(find_child(*c, NodeKind::statement_list), paths);
+            } else if (c->kind == NodeKind::else_part) {
+                branch(find_child(*c, NodeKind::statement_list), paths);
+                hasElse = true;
+            }
+        }
+        if (!hasElse) paths.push_back({entry, {}});
+        merge(paths);
+    }
+
+    void branch(const ParseTreeNode* body, vector<Path>& paths) {
+        size_t mark = trail.size();
+        bool entry = reachable;
+        statements(body);
+        paths.push_back(endBranch(mark));
+        reachable = entry;
+    }
+
+    void forStatement(const ParseTreeNode& node) {
+        const ParseTreeNode* iterable = child(node, 3);
+        TypeSet types = value(iterable);
+        TypeSet element = 0;
+        const ParseTreeNode* call = innermost(iterable);
+        if (call && call->kind == NodeKind::func_call && !call->children.empty() &&
+            call->children[0]->value == "range" && solver.symbolOf(*call->children[0], evalScope) < 0) {
+            element = TYPE_INT;
+        } else {
+            if (types & TYPE_STR) element |= TYPE_STR;
+            if (types & ~TYPE_STR) element |= TYPE_UNKNOWN;
+        }
+        loop(nullptr, child(node, 1), element, find_child(node, NodeKind::loop_statement_list));
+    }
+
+    // Iterates the body until the types at the loop head stop growing. The
+    // loop exits at the head or at a break.
+    void loop(const ParseTreeNode* condition, const ParseTreeNode* target, TypeSet element, const ParseTreeNode* body) {
+        loops.push_back({0, {}, {}});
+        while (true) {
+            size_t mark = trail.size();
+            loops.back().mark = mark;
+            loops.back().breaks.clear();
+            loops.back().continues.clear();
+            if (condition) value(condition);
+            bind(target, element);
+            statements(body);
+            vector<Path> backEdges = move(loops.back().continues);
+            backEdges.push_back(endBranch(mark));
+            reachable = true;
+            bool grew = false;
+            for (const Path& path : backEdges) {
+                if (!path.reachable) continue;
+                for (const Change& change : path.changes) {
+                    TypeSet types = env[change.slot] | change.types;
+                    if (types == env[change.slot]) continue;
+                    set(change.slot, types);
+                    grew = true;
+                }
+            }
+            if (!grew) break;
+        }
+        vector<Path> exits = move(loops.back().breaks);
+        loops.pop_back();
+        exits.push_back({true, {}});
+        merge(exits);
+    }
+
+    void leaveLoop(bool isBreak) {
+        if (!loops.empty()) {
+            Path path{true, {}};
+            changesSince(loops.back().mark, path.changes);
+            (isBreak ? loops.back().breaks : loops.back().continues).push_back(move(path));
+        }
+        reachable = false;
+    }
+
+    void functionDefinition(const ParseTreeNode& node) {
+        if (const ParseTreeNode* paramList = find_child(node, NodeKind::param_list)) {
+            for (const auto& param : paramList->children) {
+                const ParseTreeNode* defaultValue = param ? child(*param, 2) : nullptr;
+                if (defaultValue) value(defaultValue);
+            }
+        }
+        bind(child(node, 1), TYPE_FUNCTION);
+    }
+
+    void classDefinition(const ParseTreeNode& node) {
+        if (const ParseTreeNode* bases = find_child(node, NodeKind::class_inheritance_opt)) {
+            if (const ParseTreeNode* base = find_child(*bases, NodeKind::IDENTIFIER)) read(*base);
+        }
+        if (const uint32_t* classScope = solver.scopeOfNode.find((uint64_t)(uintptr_t)&node)) {
+            solver.defineClass(*classScope);
+        }
+        bind(child(node, 1), TYPE_CLASS);
+    }
+
+    void tryStatement(const ParseTreeNode& node) {
+        bool entry = reachable;
+        size_t mark = trail.size();
+        statements(find_child(node, NodeKind::statement_list));
+
+        // A handler can start anywhere in the body, so it sees every type a
+        // name had there: the trail holds each one that was replaced
+        Path handlerEntry{entry, {}};
+        stamp++;
+        vector<uint32_t> slots;
+        for (size_t i = mark; i < trail.size(); i++) {
+            uint32_t slot = trail[i].slot;
+            if (seen[slot] != stamp) {
+                seen[slot] = stamp;
+                joined[slot] = env[slot];
+                slots.push_back(slot);
+            }
+            joined[slot] |= trail[i].types;
+        }
+        for (uint32_t slot : slots) handlerEntry.changes.push_back({slot, joined[slot]});
+
+        vector<Path> paths;
+        paths.push_back(endBranch(mark));
+        reachable = entry;
+        const ParseTreeNode* clauses = find_child(node, NodeKind::except_clauses);
+        for (size_t i = 0; entry && clauses && i < clauses->children.size(); i++) {
+            const ParseTreeNode* clause = clauses->children[i].get();
+            if (!clause || clause->kind != NodeKind::except_clause) continue;
+            size_t clauseMark = trail.size();
+            for (const Change& change : handlerEntry.changes) set(change.slot, change.types);
+            reachable = true;
+            exceptClause(*clause);
+            paths.push_back(endBranch(clauseMark));
+            reachable = entry;
+        }
+        merge(paths);
+
+        const ParseTreeNode* finally = find_child(node, NodeKind::finally_clause);
+        if (finally && entry) {
+            bool after = reachable;
+            reachable = true;
+            statements(find_child(*finally, NodeKind::statement_list));
+            reachable = reachable && after;
+        }
+    }
+
+    void exceptClause(const ParseTreeNode& clause) {
+        for (size_t i = 1; i < clause.children.size(); i++) {
+            const ParseTreeNode* c = clause.children[i].get();
+            if (!c) continue;
+            if (c->kind == NodeKind::expression) value(c);
+            const ParseTreeNode* previous = clause.children[i - 1].get();
+            if (c->kind == NodeKind::IDENTIFIER && previous && previous->value == "as") bind(c, TYPE_INSTANCE);
+        }
+        statements(find_child(clause, NodeKind::statement_list));
+    }
+
+    void importStatement(const ParseTreeNode& node) {
+        // 'from m import x' binds whatever x is; 'import m' binds a module
+        TypeSet types = !node.children.empty() && node.children[0]->value == "from" ? TYPE_UNKNOWN : TYPE_MODULE;
+        vector<const ParseTreeNode*> items;
+        for (const auto& c : node.children) {
+            if (c && c->kind == NodeKind::import_item) items.push_back(c.get());
+            if (c && c->kind == NodeKind::import_tail) {
+                for (const auto& item : c->children) {
+                    if (item && item->kind == NodeKind::import_item) items.push_back(item.get());
+                }
+            }
+        }
+        for (const ParseTreeNode* item : items) {
+            const ParseTreeNode* alias = find_child(*item, NodeKind::import_alias_opt);
+            const ParseTreeNode* aliasName = alias ? find_child(*alias, NodeKind::IDENTIFIER) : nullptr;
+            bind(aliasName ? aliasName : child(*item, 0), types);
+        }
+    }
+
+    // --- expressions ---
+
+    TypeSet value(const ParseTreeNode* node) {
+        if (!node) return TYPE_UNKNOWN;
+        switch (node->kind) {
+            case NodeKind::expression: {
+                TypeSet types = value(child(*node, 0));
+                const ParseTreeNode* inlineIf = child(*node, 1);
+                if (inlineIf && inlineIf->kind == NodeKind::inline_if_else) {
+                    value(child(*inlineIf, 1));
+                    types |= value(child(*inlineIf, 3));
+                }
+                return types;
+            }
+            case NodeKind::factor: {
+                const ParseTreeNode* first = child(*node, 0);
+                if (!first) return TYPE_UNKNOWN;
+                if (first->kind == NodeKind::DELIMITER) return value(child(*node, 1));     // ( expression )
+                if (first->kind == NodeKind::STRING_QUOTE) return TYPE_STR;
+                return value(first);
+            }
+            case NodeKind::binary_expr: return binary(*node);
+            case NodeKind::unary_expr: {
+                const ParseTreeNode* op = child(*node, 0);
+                TypeSet operand = value(child(*node, 1));
+                if (!op) return TYPE_UNKNOWN;
+                return unary_result_type(op->value, operand);
+            }
+            case NodeKind::func_call: return call(*node);
+            case NodeKind::list_literal: elements(*node); return TYPE_LIST;
+            case NodeKind::dict_literal: elements(*node); return TYPE_DICT;
+            case NodeKind::IDENTIFIER: return read(*node);
+            case NodeKind::NUMBER: return number_type(node->value);
+            case NodeKind::KEYWORD:
+                if (node->value == "True" || node->value == "False") return TYPE_BOOL;
+                if (node->value == "None") return TYPE_NONE;
+                return TYPE_UNKNOWN;
+            default: return TYPE_UNKNOWN;
+        }
+    }
+
+    TypeSet binary(const ParseTreeNode& node) {
+        TypeSet left = value(child(node, 0));
+        TypeSet right = value(child(node, 2));
+        const ParseTreeNode* op = child(node, 1);
+        if (!op) return TYPE_UNKNOWN;
+        TypeSet types = binary_result_type(left, op->value, right);
+        // int ** n is a float only for negative n
+        const ParseTreeNode* exponent = innermost(child(node, 2));
+        NumericLiteral literal;
+        if (op->value == "**" && exponent && exponent->kind == NodeKind::NUMBER &&
+            decodeNumber(exponent->value, literal) && literal.kind == NumericLiteral::INT &&
+            exponent->value[0] != '-' && !(left & (TYPE_FLOAT | TYPE_COMPLEX | TYPE_UNKNOWN | TYPE_INSTANCE))) {
+            types &= ~TYPE_FLOAT;
+        }
+        return types;
+    }
+
+    // Evaluates the items of a list or dict literal, or the arguments of a
+    // call, into arguments if given. The "prime" chains are followed in a
+    // loop, so long literals do not recurse.
+    void elements(const ParseTreeNode& node, vector<TypeSet>* arguments = nullptr) {
+        const ParseTreeNode* current = &node;
+        bool inString = false;      // a bare string argument: STRING_QUOTE STRING_LITERAL STRING_QUOTE
+        while (current) {
+            const ParseTreeNode* next = nullptr;
+            for (const auto& c : current->children) {
+                if (!c) continue;
+                switch (c->kind) {
+                    case NodeKind::expression: {
+                        TypeSet types = value(c.get());
+                        if (arguments) arguments->push_back(types);
+                        break;
+                    }
+                    case NodeKind::STRING_QUOTE:
+                        if (!inString && arguments) arguments->push_back(TYPE_STR);
+                        inString = !inString;
+                        break;
+                    case NodeKind::dict_pair: {
+                        const ParseTreeNode* key = child(*c, 0);
+                        if (key && (key->kind == NodeKind::IDENTIFIER || key->kind == NodeKind::func_call)) value(key);
+                        value(find_child(*c, NodeKind::expression));
+                        break;
+                    }
+                    case NodeKind::list_items_prime:
+                    case NodeKind::dict_items_prime:
+                    case NodeKind::argument_list_prime:
+                        next = c.get();
+                        break;
+                    default:
+                        break;
+                }
+            }
+            current = next;
+        }
+    }
+
+    TypeSet call(const ParseTreeNode& node) {
+        vector<TypeSet> arguments;
+        if (const ParseTreeNode* list = find_child(node, NodeKind::argument_list)) elements(*list, &arguments);
+        const ParseTreeNode* name = child(node, 0);
+        if (!name || name->kind != NodeKind::IDENTIFIER) return TYPE_UNKNOWN;
+        int32_t symbol = solver.symbolOf(*name, evalScope);
+        if (symbol < 0) return builtin_type(name->value).result;
+
+        TypeSet callee = read(*name);
+        TypeSet types = 0;
+        if (callee & TYPE_FUNCTION) {
+            bool known = false;
+            for (int32_t s = solver.firstScopeNamed[symbol]; s >= 0; s = solver.nextScopeNamed[s]) {
+                if (solver.tree.scopes()[s].kind != ScopeKind::FUNCTION) continue;
+                known = true;
+                types |= solver.call(s, arguments, analysis);
+            }
+            if (!known) types |= TYPE_UNKNOWN;      // f = g, then f()
+        }
+        if (callee & TYPE_CLASS) types |= TYPE_INSTANCE;
+        if (callee & (TYPE_UNKNOWN | TYPE_INSTANCE | TYPE_MODULE)) types |= TYPE_UNKNOWN;
+        return types;
+    }
+};
+
+void TypeInference::Solver::run(uint32_t analysis) {
+    result.runs++;
+    result.analysisList[analysis].runs++;
+    Walker walker(*this, analysis);
+    walker.run();
+}
+
+void TypeInference::infer(const ScopeTree& scopes) {
+    symbolTypes.clear();
+    analysisList.clear();
+    returnTypes.assign(scopes.scopes().size(), 0);
+    runs = 0;
+    Solver solver(*this, scopes);
+    solver.solve();
+}
+
+void recordInferredTypes(SymbolTable& table, const ScopeTree& scopes, const TypeInference& types) {
+    for (const SymbolTable::Symbol& symbol : table) {
+        SymbolEntry* entry = table.find(symbol.name, symbol.scope);
+        for (const SymbolReference& ref : entry->references) {
+            int32_t found = ref.offset < 0 ? -1 : scopes.symbolAt(ref.offset);
+            if (found < 0) continue;
+            TypeSet inferred = types.symbolType(found);
+            if (inferred != 0 && inferred != TYPE_UNKNOWN) entry->type = type_set_name(inferred);
+            break;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef TYPE_INFERENCE_H
+#define TYPE_INFERENCE_H
+
+#include "lexical_analyzer.h"
+#include "parser_tree.h"
+#include "scope_tree.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Type inference over the scope tree. A type is a set of the kinds below,
+// one bit each, so a union is an OR and the lattice join is cheap. An empty
+// set means no value reaches that point; TYPE_UNKNOWN is "could be anything"
+// (calls to unknown code, attributes, parameters nobody passes).
+typedef uint16_t TypeSet;
+
+enum TypeBit : TypeSet {
+    TYPE_INT = 1 << 0,
+    TYPE_FLOAT = 1 << 1,
+    TYPE_COMPLEX = 1 << 2,
+    TYPE_BOOL = 1 << 3,
+    TYPE_STR = 1 << 4,
+    TYPE_NONE = 1 << 5,
+    TYPE_LIST = 1 << 6,
+    TYPE_DICT = 1 << 7,
+    TYPE_FUNCTION = 1 << 8,
+    TYPE_CLASS = 1 << 9,
+    TYPE_INSTANCE = 1 << 10,
+    TYPE_MODULE = 1 << 11,
+    TYPE_UNKNOWN = 1 << 12,
+};
+
+const int TYPE_BIT_COUNT = 13;
+
+// "int|str"; "never" for the empty set.
+std::string type_set_name(TypeSet types);
+
+// Types after applying a binary operator ("+", "and", "not in", ...) or a
+// prefix operator to operands of the given types. Combinations Python
+// rejects contribute nothing.
+TypeSet binary_result_type(TypeSet left, const std::string& op, TypeSet right);
+TypeSet unary_result_type(const std::string& op, TypeSet operand);
+
+// One analysis of a scope body. The module and each class body get one;
+// a function gets one per distinct argument signature it is called with,
+// plus one with unknown arguments if nothing calls it.
+struct ScopeAnalysis {
+    uint32_t scope;
+    std::vector<TypeSet> arguments;     // types passed; missing ones take the defaults
+    TypeSet returns;                    // functions only
+    uint32_t runs;                      // times the body was walked
+};
+
+// Within a scope body the analysis is flow sensitive: each statement sees
+// the types its scope's own names have at that point, branches of if/elif/
+// else and try/except are joined where they meet, and loops are iterated to
+// a fixed point, with break and continue joining the exit and the loop head.
+// Names from other scopes are seen as the union of everything bound to them
+// (they may change at any call).
+//
+// Scope analyses are solved with a worklist. An analysis records which
+// symbols and return types it read; when one of them grows, it is queued to
+// run again. Types only grow and each set has 13 bits, so this terminates.
+// A call analyses the callee at once with the argument types, and the result
+// is cached per (function, signature): later calls with the same types reuse
+// it. Functions called with many different signatures fall back to one with
+// unknown arguments, so a module is solved in near-linear time.
+//
+// There is no separate control-flow graph: the grammar's control flow is
+// structured, so the statement tree is walked directly. Lazy bodies must be
+// expanded first (see ScopeTree).
+class TypeInference {
+public:
+    TypeInference() = default;
+    explicit TypeInference(const ScopeTree& scopes) { infer(scopes); }
+
+    void infer(const ScopeTree& scopes);
+
+    // Union of every type bound to the symbol in its scope.
+    TypeSet symbolType(uint32_t symbol) const { return symbolTypes[symbol]; }
+
+    const std::vector<ScopeAnalysis>& analyses() const { return analysisList; }
+
+    // Union of what the function returns over all its analyses.
+    TypeSet returnType(uint32_t scope) const { return returnTypes[scope]; }
+
+    // Body walks in total; analyses().size() of them were first runs.
+    size_t runCount() const { return runs; }
+
+private:
+    std::vector<TypeSet> symbolTypes;
+    std::vector<ScopeAnalysis> analysisList;
+    std::vector<TypeSet> returnTypes;   // by scope
+    size_t runs = 0;
+
+    struct Solver;
+    struct Walker;
+};
+
+// Fills the type column of table from the inferred types, for every entry
+// whose occurrences map to a scope-tree symbol with a known type.
+void recordInferredTypes(SymbolTable& table, const ScopeTree& scopes, const TypeInference& types);
+
+#endif // TYPE_INFERENCE_H
@@ -0,0 +1,91 @@
+#ifndef VALUE_H
+#define VALUE_H
+
+#include <cstdint>
+#include <cstring>
+
+struct Object;
+
+// A runtime value of the bytecode VM in one 64-bit word, NaN-boxed. A float
+// is its own IEEE-754 bits; every NaN is stored as the positive canonical
+// one, which frees the negative quiet NaNs for everything else:
+//
+//   below 0xFFF9 << 48         float
+//   0xFFF9 + 48-bit payload    int in [-2^47, 2^47), two's complement
+//   0xFFFA + 48-bit payload    pointer to a heap object
+//   0xFFFB + 0, 1, 2 or 3      unbound, None, False, True
+//
+// So operand stacks and lists hold 8 bytes per value, and floats and ints
+// in the inline range never allocate; ints outside it are left to the VM to
+// box on the heap. Pointers must fit in 48 bits, as user-space addresses do
+// on x86-64 and AArch64. UNBOUND marks a local, cell or global that holds
+// nothing yet; it never reaches the operand stack.
+class Value {
+public:
+    enum Tag : uint8_t { UNBOUND, NONE, BOOL, INT, FLOAT, OBJECT };
+
+    static constexpr int64_t MIN_INLINE_INT = -((int64_t)1 << 47);
+    static constexpr int64_t MAX_INLINE_INT = ((int64_t)1 << 47) - 1;
+
+    Value() : bits(UNBOUND_BITS) {}
+
+    static Value none() { return Value(NONE_BITS); }
+    static Value boolean(bool b) { return Value(FALSE_BITS + b); }
+    static bool fitsInline(int64_t i) { return i >= MIN_INLINE_INT && i <= MAX_INLINE_INT; }
+    // i must fit inline.
+    static Value integer(int64_t i) { return Value(INT_TAG | ((uint64_t)i & PAYLOAD)); }
+    static Value real(double d) {
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof d);
+        return Value(d == d ? bits : CANONICAL_NAN);
+    }
+    static Value object(Object* o) { return Value(OBJECT_TAG | (uint64_t)(uintptr_t)o); }
+
+    Tag kind() const {
+        if (isFloat()) return FLOAT;
+        switch (bits & TAG_MASK) {
+            case INT_TAG: return INT;
+            case OBJECT_TAG: return OBJECT;
+            default: return bits == UNBOUND_BITS ? UNBOUND : bits == NONE_BITS ? NONE : BOOL;
+        }
+    }
+    bool isUnbound() const { return bits == UNBOUND_BITS; }
+    bool isNone() const { return bits == NONE_BITS; }
+    bool isBool() const { return (bits | 1) == TRUE_BITS; }
+    bool isInt() const { return (bits & TAG_MASK) == INT_TAG; }     // inline ints only
+    bool isFloat() const { return bits < INT_TAG; }
+    bool isObject() const { return (bits & TAG_MASK) == OBJECT_TAG; }
+
+    bool asBool() const { return bits == TRUE_BITS; }
+    int64_t asInt() const { return (int64_t)(bits << 16) >> 16; }
+    double asFloat() const {
+        double d;
+        memcpy(&d, &bits, sizeof d);
+        return d;
+    }
+    Object* asObject() const { return (Object*)(uintptr_t)(bits & PAYLOAD); }
+
+    // Same word: "is" for objects, and for everything else the same value
+    // (0.0 and -0.0 differ).
+    bool identical(Value other) const { return bits == other.bits; }
+
+private:
+    static constexpr uint64_t TAG_MASK = 0xFFFFull << 48;
+    static constexpr uint64_t PAYLOAD = ~TAG_MASK;
+    static constexpr uint64_t INT_TAG = 0xFFF9ull << 48;
+    static constexpr uint64_t OBJECT_TAG = 0xFFFAull << 48;
+    static constexpr uint64_t UNBOUND_BITS = 0xFFFBull << 48;
+    static constexpr uint64_t NONE_BITS = UNBOUND_BITS + 1;
+    static constexpr uint64_t FALSE_BITS = UNBOUND_BITS + 2;
+    static constexpr uint64_t TRUE_BITS = UNBOUND_BITS + 3;
+    static constexpr uint64_t CANONICAL_NAN = 0x7FF8ull << 48;
+
+    explicit Value(uint64_t bits) : bits(bits) {}
+
+    uint64_t bits;
+};
+
+static_assert(sizeof(Value) == 8, "a Value is one word");
+static_assert(sizeof(void*) <= 8, "pointers must fit a Value's payload");
+
+#endif // VALUE_H
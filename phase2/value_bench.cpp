@@ -0,0 +1,187 @@
+// Value benchmark: times the VM's NaN-boxed Value (value.h) against naive
+// std::variant representations on the work an interpreter does most: int
+// and float arithmetic through an operand stack, and scanning a list.
+//
+//   g++ -std=c++17 -O2 -o value_bench value_bench.cpp
+//   ./value_bench [N]       N operations per kernel (default 10000000)
+//
+// "variant" holds the same alternatives inline; "boxed variant" is a
+// shared_ptr to one, so every result allocates, as in a runtime that boxes
+// all values. Each kernel prints a checksum, which must agree. The operand
+// stack is kept in memory between instructions, as in the VM, so it needs
+// GCC or Clang.
+
+#include "value.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace std;
+
+struct Object {
+    int64_t payload;
+};
+
+// Each representation: how to build and inspect ints and floats.
+struct NanBoxed {
+    typedef Value V;
+    static const char* name() { return "NaN-boxed"; }
+    static V integer(int64_t i) { return Value::integer(i); }
+    static V real(double d) { return Value::real(d); }
+    static bool isInt(const V& v) { return v.isInt(); }
+    static bool isFloat(const V& v) { return v.isFloat(); }
+    static int64_t asInt(const V& v) { return v.asInt(); }
+    static double asFloat(const V& v) { return v.asFloat(); }
+};
+
+typedef variant<monostate, bool, int64_t, double, Object*> Variant;
+
+struct InlineVariant {
+    typedef Variant V;
+    static const char* name() { return "variant"; }
+    static V integer(int64_t i) { return V(i); }
+    static V real(double d) { return V(d); }
+    static bool isInt(const V& v) { return holds_alternative<int64_t>(v); }
+    static bool isFloat(const V& v) { return holds_alternative<double>(v); }
+    static int64_t asInt(const V& v) { return get<int64_t>(v); }
+    static double asFloat(const V& v) { return get<double>(v); }
+};
+
+struct BoxedVariant {
+    typedef shared_ptr<const Variant> V;
+    static const char* name() { return "boxed variant"; }
+    static V integer(int64_t i) { return make_shared<const Variant>(i); }
+    static V real(double d) { return make_shared<const Variant>(d); }
+    static bool isInt(const V& v) { return holds_alternative<int64_t>(*v); }
+    static bool isFloat(const V& v) { return holds_alternative<double>(*v); }
+    static int64_t asInt(const V& v) { return get<int64_t>(*v); }
+    static double asFloat(const V& v) { return get<double>(*v); }
+};
+
+// Makes the compiler assume p, and after clobber() any memory, is read, so
+// stack slots are really stored and reloaded around each instruction.
+static void escape(void* p) { asm volatile("" : : "g"(p) : "memory"); }
+static void clobber() { asm volatile("" : : : "memory"); }
+
+struct Modulo {
+    int64_t operator()(int64_t x, int64_t y) const { return x % y; }
+    double operator()(double x, double y) const { return std::fmod(x, y); }
+};
+
+// a op b as the VM's fast path does it: same-kind operands only.
+template <class R, class Op>
+static typename R::V arithmetic(const typename R::V& a, const typename R::V& b, Op op) {
+    if (R::isInt(a) && R::isInt(b)) return R::integer(op(R::asInt(a), R::asInt(b)));
+    if (R::isFloat(a) && R::isFloat(b)) return R::real(op(R::asFloat(a), R::asFloat(b)));
+    abort();
+}
+
+// h = (h * 31 + i) % 1000003, one push or pop per bytecode instruction.
+template <class R>
+static double int_kernel(int64_t n) {
+    vector<typename R::V> stack(8);
+    typename R::V* sp = stack.data();
+    escape(sp);
+    *sp++ = R::integer(17);
+    for (int64_t i = 0; i < n; i++) {
+        *sp++ = R::integer(31);
+        clobber();
+        sp[-2] = arithmetic<R>(sp[-2], sp[-1], [](auto x, auto y) { return x * y; });
+        sp--;
+        clobber();
+        *sp++ = R::integer(i);
+        clobber();
+        sp[-2] = arithmetic<R>(sp[-2], sp[-1], [](auto x, auto y) { return x + y; });
+        sp--;
+        clobber();
+        *sp++ = R::integer(1000003);
+        clobber();
+        sp[-2] = arithmetic<R>(sp[-2], sp[-1], Modulo());
+        sp--;
+        clobber();
+    }
+    return (double)R::asInt(sp[-1]);
+}
+
+// x = x * 0.5 + i, in floats.
+template <class R>
+static double float_kernel(int64_t n) {
+    vector<typename R::V> stack(8);
+    typename R::V* sp = stack.data();
+    escape(sp);
+    *sp++ = R::real(1.0);
+    for (int64_t i = 0; i < n; i++) {
+        *sp++ = R::real(0.5);
+        clobber();
+        sp[-2] = arithmetic<R>(sp[-2], sp[-1], [](auto a, auto b) { return a * b; });
+        sp--;
+        clobber();
+        *sp++ = R::real((double)(i & 1023));
+        clobber();
+        sp[-2] = arithmetic<R>(sp[-2], sp[-1], [](auto a, auto b) { return a + b; });
+        sp--;
+        clobber();
+    }
+    return R::asFloat(sp[-1]);
+}
+
+// Sums a list of alternating ints and floats; the list is built untimed.
+template <class R>
+static double list_kernel(const vector<typename R::V>& list) {
+    int64_t ints = 0;
+    double floats = 0;
+    for (const typename R::V& v : list) {
+        if (R::isInt(v)) {
+            ints += R::asInt(v);
+        } else if (R::isFloat(v)) {
+            floats += R::asFloat(v);
+        }
+    }
+    return (double)ints + floats;
+}
+
+template <class R>
+static void run(int64_t n) {
+    using Clock = chrono::steady_clock;
+    cout << left << setw(15) << R::name() << right << setw(6) << sizeof(typename R::V);
+
+    auto start = Clock::now();
+    double intSum = int_kernel<R>(n);
+    double intNs = chrono::duration<double, nano>(Clock::now() - start).count() / n;
+
+    start = Clock::now();
+    double floatSum = float_kernel<R>(n);
+    double floatNs = chrono::duration<double, nano>(Clock::now() - start).count() / n;
+
+    vector<typename R::V> list;
+    list.reserve(n);
+    for (int64_t i = 0; i < n; i++) list.push_back(i & 1 ? R::real(0.25 * (i & 255)) : R::integer(i & 255));
+    start = Clock::now();
+    double listSum = list_kernel<R>(list);
+    double listNs = chrono::duration<double, nano>(Clock::now() - start).count() / n;
+
+    cout << fixed << setprecision(2) << setw(11) << intNs << setw(11) << floatNs << setw(11) << listNs << "   "
+         << setprecision(0) << intSum << " " << setprecision(4) << floatSum << " " << setprecision(0) << listSum
+         << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int64_t n = argc > 1 ? atoll(argv[1]) : 10000000;
+    if (n < 1) {
+        cerr << "Usage: " << argv[0] << " [N]" << endl;
+        return 1;
+    }
+    cout << n << " operations per kernel, ns per operation\n";
+    cout << left << setw(15) << "representation" << right << setw(6) << "bytes" << setw(11) << "int" << setw(11)
+         << "float" << setw(11) << "list" << "   checksums" << endl;
+    run<NanBoxed>(n);
+    run<InlineVariant>(n);
+    run<BoxedVariant>(n);
+    return 0;
+}
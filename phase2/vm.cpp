@@ -0,0 +1,2804 @@
+#include "vm.h"
+#include "identifier_table.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cctype>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Handlers end in their own jump through a table of label addresses when the
+// compiler has them; VM_SWITCH_DISPATCH forces the portable switch.
+#if defined(__GNUC__) && !defined(VM_SWITCH_DISPATCH)
+#define VM_THREADED_DISPATCH
+#endif
+
+const size_t VALUE_STACK_SIZE = 1 << 20;           // values shared by all frames
+const size_t MAX_FRAMES = 1000;                     // deeper calls raise RecursionError
+const size_t MAX_NESTING = 1000;                    // repr and == of nested lists and dicts
+const size_t MIN_COLLECTION_THRESHOLD = 1 << 16;    // objects allocated before the first collection
+const size_t MAX_SEQUENCE_SIZE = (size_t)1 << 28;   // longest string or list * may build
+
+// --- heap objects ---
+
+enum class ObjectKind : uint8_t {
+    INT, STRING, LIST, DICT, RANGE, FUNCTION, CELL, CLASS, INSTANCE, BUILTIN, MODULE,
+    RANGE_ITERATOR, SEQUENCE_ITERATOR, GENERATOR
+};
+
+// Every object is on one list, which the collector sweeps.
+struct Object {
+    ObjectKind kind;
+    bool marked = false;
+    Object* next = nullptr;
+
+    explicit Object(ObjectKind kind) : kind(kind) {}
+    virtual ~Object() = default;
+};
+
+// An int outside the range Value holds inline.
+struct IntObject : Object {
+    int64_t value;
+    explicit IntObject(int64_t value) : Object(ObjectKind::INT), value(value) {}
+};
+
+struct StringObject : Object {
+    string text;
+    uint64_t hash;
+    size_t length = 0;      // code points; text is UTF-8
+
+    explicit StringObject(string s) : Object(ObjectKind::STRING), text(move(s)) {
+        hash = hash_identifier(text);
+        for (char c : text) length += ((unsigned char)c & 0xc0) != 0x80;
+    }
+    bool ascii() const { return length == text.size(); }
+};
+
+struct ListObject : Object {
+    vector<Value> items;
+    ListObject() : Object(ObjectKind::LIST) {}
+};
+
+struct DictEntry {
+    Value key, value;       // key is unbound once the entry is deleted
+    uint64_t hash;
+};
+
+// Entries in insertion order, found through an open-addressed index of
+// entry numbers plus one (0 is empty). Deleted entries stay until the index
+// is rebuilt, so lookups probe past them.
+struct DictObject : Object {
+    vector<DictEntry> entries;
+    vector<uint32_t> index;     // power-of-two size
+    size_t live = 0;
+    DictObject() : Object(ObjectKind::DICT) {}
+};
+
+struct RangeObject : Object {
+    int64_t start, stop, step;
+    RangeObject(int64_t start, int64_t stop, int64_t step)
+        : Object(ObjectKind::RANGE), start(start), stop(stop), step(step) {}
+
+    uint64_t length() const {
+        if (step > 0) return stop > start ? ((uint64_t)stop - (uint64_t)start - 1) / (uint64_t)step + 1 : 0;
+        return start > stop ? ((uint64_t)start - (uint64_t)stop - 1) / (0 - (uint64_t)step) + 1 : 0;
+    }
+    int64_t at(uint64_t i) const { return (int64_t)((uint64_t)start + i * (uint64_t)step); }
+};
+
+struct CellObject : Object {
+    Value value;
+    explicit CellObject(Value value) : Object(ObjectKind::CELL), value(value) {}
+};
+
+struct FunctionObject : Object {
+    uint32_t codeIndex;
+    const CodeObject* code;
+    vector<Value> defaults;
+    vector<Value> cells;        // the cells the function captured, as CellObjects
+    FunctionObject(uint32_t codeIndex, const CodeObject* code)
+        : Object(ObjectKind::FUNCTION), codeIndex(codeIndex), code(code) {}
+};
+
+struct ClassObject : Object {
+    string name;
+    ClassObject* base;
+    unordered_map<string, Value> attributes;
+    bool exception;             // BaseException or a subclass of it
+    ClassObject(string name, ClassObject* base)
+        : Object(ObjectKind::CLASS), name(move(name)), base(base), exception(base && base->exception) {}
+
+    const Value* lookup(const string& attribute) const {
+        for (const ClassObject* c = this; c; c = c->base) {
+            auto it = c->attributes.find(attribute);
+            if (it != c->attributes.end()) return &it->second;
+        }
+        return nullptr;
+    }
+    bool derivesFrom(const ClassObject* other) const {
+        for (const ClassObject* c = this; c; c = c->base) {
+            if (c == other) return true;
+        }
+        return false;
+    }
+};
+
+struct InstanceObject : Object {
+    ClassObject* cls;
+    unordered_map<string, Value> attributes;
+    Value payload;              // an exception's argument, if it was given one
+    explicit InstanceObject(ClassObject* cls) : Object(ObjectKind::INSTANCE), cls(cls) {}
+};
+
+struct BuiltinObject : Object {
+    int id;
+    const char* name;
+    BuiltinObject(int id, const char* name) : Object(ObjectKind::BUILTIN), id(id), name(name) {}
+};
+
+struct ModuleObject : Object {
+    string name;
+    unordered_map<string, Value> attributes;
+    explicit ModuleObject(string name) : Object(ObjectKind::MODULE), name(move(name)) {}
+};
+
+struct RangeIteratorObject : Object {
+    uint64_t current;           // as unsigned, so stepping past the end cannot overflow
+    uint64_t step;
+    uint64_t remaining;
+    explicit RangeIteratorObject(const RangeObject& range)
+        : Object(ObjectKind::RANGE_ITERATOR), current((uint64_t)range.start), step((uint64_t)range.step),
+          remaining(range.length()) {}
+};
+
+// Over a list, the keys of a dict or the code points of a string; index is
+// an item, entry or byte position.
+struct SequenceIteratorObject : Object {
+    Value sequence;
+    size_t index = 0;
+    explicit SequenceIteratorObject(Value sequence) : Object(ObjectKind::SEQUENCE_ITERATOR), sequence(sequence) {}
+};
+
+// While suspended, the frame's locals, cells and operand stack are kept in
+// saved and put back on the value stack to resume.
+struct GeneratorObject : Object {
+    enum State : uint8_t { CREATED, SUSPENDED, RUNNING, DONE };
+    FunctionObject* function;
+    vector<Value> saved;
+    uint32_t pc = 0;
+    State state = CREATED;
+    explicit GeneratorObject(FunctionObject* function) : Object(ObjectKind::GENERATOR), function(function) {}
+};
+
+template <class T>
+static T* as(Value v) {
+    return static_cast<T*>(v.asObject());
+}
+
+static bool is_kind(Value v, ObjectKind kind) {
+    return v.isObject() && v.asObject()->kind == kind;
+}
+
+// Ints, inline or boxed, and bools, as Python treats bool as an int.
+static bool int_value(Value v, int64_t& out) {
+    if (v.isInt()) {
+        out = v.asInt();
+        return true;
+    }
+    if (v.isBool()) {
+        out = v.asBool();
+        return true;
+    }
+    if (is_kind(v, ObjectKind::INT)) {
+        out = as<IntObject>(v)->value;
+        return true;
+    }
+    return false;
+}
+
+static bool number_value(Value v, double& out) {
+    if (v.isFloat()) {
+        out = v.asFloat();
+        return true;
+    }
+    int64_t i;
+    if (!int_value(v, i)) return false;
+    out = (double)i;
+    return true;
+}
+
+// The double is a whole number that an int64_t holds exactly.
+static bool float_to_int(double d, int64_t& out) {
+    if (!(d >= -9223372036854775808.0 && d < 9223372036854775808.0) || d != std::floor(d)) return false;
+    out = (int64_t)d;
+    return true;
+}
+
+// ==, without lists or dicts: what dict keys need.
+static bool keys_equal(Value a, Value b) {
+    if (a.identical(b)) return true;
+    if (a.isFloat() || b.isFloat()) {
+        double x, y;
+        return number_value(a, x) && number_value(b, y) && x == y;
+    }
+    int64_t x, y;
+    if (int_value(a, x) && int_value(b, y)) return x == y;
+    return is_kind(a, ObjectKind::STRING) && is_kind(b, ObjectKind::STRING) &&
+           as<StringObject>(a)->text == as<StringObject>(b)->text;
+}
+
+// --- dicts ---
+
+static int64_t dict_find(const DictObject& dict, Value key, uint64_t hash) {
+    if (dict.index.empty()) return -1;
+    size_t mask = dict.index.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        uint32_t slot = dict.index[i];
+        if (!slot) return -1;
+        const DictEntry& entry = dict.entries[slot - 1];
+        if (entry.hash == hash && !entry.key.isUnbound() && keys_equal(entry.key, key)) return slot - 1;
+    }
+}
+
+static void dict_place(DictObject& dict, uint32_t entry) {
+    size_t mask = dict.index.size() - 1;
+    size_t i = dict.entries[entry].hash & mask;
+    while (dict.index[i]) i = (i + 1) & mask;
+    dict.index[i] = entry + 1;
+}
+
+// Drops deleted entries and sizes the index for needed entries at a load
+// of at most 3/8.
+static void dict_rebuild(DictObject& dict, size_t needed) {
+    size_t kept = 0;
+    for (size_t i = 0; i < dict.entries.size(); i++) {
+        if (!dict.entries[i].key.isUnbound()) dict.entries[kept++] = dict.entries[i];
+    }
+    dict.entries.resize(kept);
+    size_t capacity = 8;
+    while (capacity * 3 < needed * 8) capacity *= 2;
+    dict.index.assign(capacity, 0);
+    for (uint32_t i = 0; i < kept; i++) dict_place(dict, i);
+}
+
+static void dict_set(DictObject& dict, Value key, uint64_t hash, Value value) {
+    int64_t found = dict_find(dict, key, hash);
+    if (found >= 0) {
+        dict.entries[found].value = value;
+        return;
+    }
+    if ((dict.entries.size() + 1) * 4 > dict.index.size() * 3) dict_rebuild(dict, dict.live + 1);
+    dict.entries.push_back({key, value, hash});
+    dict_place(dict, (uint32_t)dict.entries.size() - 1);
+    dict.live++;
+}
+
+static void dict_erase(DictObject& dict, size_t entry) {
+    dict.entries[entry].key = Value();
+    dict.entries[entry].value = Value();
+    dict.live--;
+}
+
+// --- strings ---
+
+static size_t utf8_sequence_length(unsigned char lead) {
+    return lead < 0xc0 ? 1 : lead < 0xe0 ? 2 : lead < 0xf0 ? 3 : 4;
+}
+
+// Byte offset of code point index, which is below the length.
+static size_t utf8_offset(const StringObject& s, size_t index) {
+    if (s.ascii()) return index;
+    size_t offset = 0;
+    for (; index > 0; index--) offset += utf8_sequence_length((unsigned char)s.text[offset]);
+    return offset;
+}
+
+static void append_utf8(string& out, uint32_t c) {
+    if (c < 0x80) {
+        out += (char)c;
+    } else if (c < 0x800) {
+        out += (char)(0xc0 | (c >> 6));
+        out += (char)(0x80 | (c & 0x3f));
+    } else if (c < 0x10000) {
+        out += (char)(0xe0 | (c >> 12));
+        out += (char)(0x80 | ((c >> 6) & 0x3f));
+        out += (char)(0x80 | (c & 0x3f));
+    } else {
+        out += (char)(0xf0 | (c >> 18));
+        out += (char)(0x80 | ((c >> 12) & 0x3f));
+        out += (char)(0x80 | ((c >> 6) & 0x3f));
+        out += (char)(0x80 | (c & 0x3f));
+    }
+}
+
+static uint32_t decode_utf8(const string& s, size_t offset) {
+    unsigned char lead = s[offset];
+    size_t length = utf8_sequence_length(lead);
+    if (length == 1 || offset + length > s.size()) return lead;
+    uint32_t c = lead & (0xff >> (length + 1));
+    for (size_t i = 1; i < length; i++) c = (c << 6) | ((unsigned char)s[offset + i] & 0x3f);
+    return c;
+}
+
+static const char* operator_symbol(Opcode op) {
+    switch (op) {
+        case Opcode::BINARY_ADD: return "+";
+        case Opcode::INPLACE_ADD: return "+=";
+        case Opcode::BINARY_SUBTRACT: return "-";
+        case Opcode::BINARY_MULTIPLY: return "*";
+        case Opcode::BINARY_TRUE_DIVIDE: return "/";
+        case Opcode::BINARY_FLOOR_DIVIDE: return "//";
+        case Opcode::BINARY_MODULO: return "%";
+        case Opcode::BINARY_POWER: return "** or pow()";
+        case Opcode::BINARY_LSHIFT: return "<<";
+        case Opcode::BINARY_RSHIFT: return ">>";
+        case Opcode::BINARY_AND: return "&";
+        case Opcode::BINARY_OR: return "|";
+        case Opcode::BINARY_XOR: return "^";
+        case Opcode::COMPARE_LT: return "<";
+        case Opcode::COMPARE_LE: return "<=";
+        case Opcode::COMPARE_GT: return ">";
+        case Opcode::COMPARE_GE: return ">=";
+        default: return "?";
+    }
+}
+
+static bool is_bitwise(Opcode op) {
+    return op == Opcode::BINARY_LSHIFT || op == Opcode::BINARY_RSHIFT || op == Opcode::BINARY_AND ||
+           op == Opcode::BINARY_OR || op == Opcode::BINARY_XOR;
+}
+
+// --- builtins ---
+
+#define BUILTIN_FUNCTIONS(X) \
+    X(print, "print") X(len, "len") X(range, "range") X(str, "str") X(repr, "repr") \
+    X(int, "int") X(float, "float") X(bool, "bool") X(abs, "abs") X(min, "min") X(max, "max") \
+    X(sum, "sum") X(list, "list") X(dict, "dict") X(isinstance, "isinstance") X(chr, "chr") \
+    X(ord, "ord") X(round, "round") X(iter, "iter") X(next, "next")
+
+// Functions of the math module, the one module import finds.
+#define MATH_FUNCTIONS(X) \
+    X(math_sqrt, "sqrt") X(math_floor, "floor") X(math_ceil, "ceil") X(math_fabs, "fabs")
+
+enum BuiltinId {
+#define X(id, name) BUILTIN_##id,
+    BUILTIN_FUNCTIONS(X) MATH_FUNCTIONS(X)
+#undef X
+};
+
+enum class FrameKind : uint8_t {
+    NORMAL,
+    CONSTRUCTOR,    // __init__: the call returns the instance
+    CLASS_BODY,     // names go to the class; the body returns the class
+    GENERATOR,      // runs in a nested execute(), from resume()
+};
+
+// Locals, then cells (own cells, then captured ones), then the operand
+// stack, all on the value stack.
+struct Frame {
+    const CodeObject* code;
+    const Value* constants;
+    FunctionObject* function;   // null for the module body
+    Object* owner;              // the instance, class or generator of the kinds above
+    FrameKind kind;
+    const uint8_t* pc;
+    Value* base;
+    Value* cells;
+    Value* stack;
+    Value* sp;
+    Value* result;              // where the caller wants the return value
+};
+
+struct TraceEntry {
+    size_t depth;
+    const CodeObject* code;
+    uint32_t offset;
+};
+
+struct VirtualMachine::State {
+    const BytecodeModule& module;
+    ostream& output;
+    vector<Value> values;
+    vector<Frame> frames;                       // reserved, so a Frame* stays valid
+    vector<vector<Value>> pools;                // constants by code object
+
+    vector<Value> globals;                      // by global slot
+    vector<Value> builtins;                     // the builtin named like each global slot
+    unordered_map<string, uint32_t> globalSlot;
+    unordered_map<string, Value> builtinNames;
+    unordered_map<string, ModuleObject*> modules;
+
+    Value pending;                              // the exception being raised
+    vector<TraceEntry> trace;                   // innermost frame first
+
+    ClassObject* baseException;
+    ClassObject* exception;
+    ClassObject* arithmeticError;
+    ClassObject* zeroDivisionError;
+    ClassObject* overflowError;
+    ClassObject* lookupError;
+    ClassObject* indexError;
+    ClassObject* keyError;
+    ClassObject* nameError;
+    ClassObject* unboundLocalError;
+    ClassObject* typeError;
+    ClassObject* valueError;
+    ClassObject* attributeError;
+    ClassObject* importError;
+    ClassObject* runtimeError;
+    ClassObject* recursionError;
+    ClassObject* stopIteration;
+    ClassObject* memoryError;
+
+    Object* objects = nullptr;
+    size_t objectCount = 0;
+    size_t collectAt = MIN_COLLECTION_THRESHOLD;
+    bool collectPending = false;
+    int nativeDepth = 0;                        // builtins running: no collection until they return
+    size_t collections = 0;
+
+    uint64_t instructions = 0;
+    vector<Object*> reprStack;                  // lists and dicts being printed
+    size_t nesting = 0;                         // depth of == and < on lists and dicts
+
+    State(const BytecodeModule& module, ostream& output)
+        : module(module), output(output), values(VALUE_STACK_SIZE) {
+        frames.reserve(MAX_FRAMES + 1);
+
+        baseException = exceptionClass("BaseException", nullptr);
+        exception = exceptionClass("Exception", baseException);
+        arithmeticError = exceptionClass("ArithmeticError", exception);
+        zeroDivisionError = exceptionClass("ZeroDivisionError", arithmeticError);
+        overflowError = exceptionClass("OverflowError", arithmeticError);
+        lookupError = exceptionClass("LookupError", exception);
+        indexError = exceptionClass("IndexError", lookupError);
+        keyError = exceptionClass("KeyError", lookupError);
+        nameError = exceptionClass("NameError", exception);
+        unboundLocalError = exceptionClass("UnboundLocalError", nameError);
+        typeError = exceptionClass("TypeError", exception);
+        valueError = exceptionClass("ValueError", exception);
+        attributeError = exceptionClass("AttributeError", exception);
+        importError = exceptionClass("ImportError", exception);
+        runtimeError = exceptionClass("RuntimeError", exception);
+        recursionError = exceptionClass("RecursionError", runtimeError);
+        stopIteration = exceptionClass("StopIteration", exception);
+        memoryError = exceptionClass("MemoryError", exception);
+#define X(id, name) builtinNames[name] = Value::object(allocate<BuiltinObject>(BUILTIN_##id, name));
+        BUILTIN_FUNCTIONS(X)
+#undef X
+
+        globals.resize(module.globalNames.size());
+        builtins.resize(module.globalNames.size());
+        for (uint32_t slot = 0; slot < module.globalNames.size(); slot++) {
+            globalSlot[module.globalNames[slot]] = slot;
+            auto builtin = builtinNames.find(module.globalNames[slot]);
+            if (builtin != builtinNames.end()) builtins[slot] = builtin->second;
+        }
+
+        pools.resize(module.code.size());
+        for (size_t i = 0; i < module.code.size(); i++) {
+            for (const ConstantValue& constant : module.code[i].constants) {
+                switch (constant.kind) {
+                    case ConstantValue::INT: pools[i].push_back(makeInt(constant.intValue)); break;
+                    case ConstantValue::FLOAT: pools[i].push_back(Value::real(constant.floatValue)); break;
+                    case ConstantValue::BOOL: pools[i].push_back(Value::boolean(constant.intValue != 0)); break;
+                    case ConstantValue::STR: pools[i].push_back(newString(constant.text)); break;
+                    case ConstantValue::NONE: pools[i].push_back(Value::none()); break;
+                }
+            }
+        }
+    }
+
+    ~State() {
+        while (objects) {
+            Object* next = objects->next;
+            delete objects;
+            objects = next;
+        }
+    }
+
+    template <class T, class... Args>
+    T* allocate(Args&&... args) {
+        T* object = new T(std::forward<Args>(args)...);
+        object->next = objects;
+        objects = object;
+        if (++objectCount >= collectAt) collectPending = true;
+        return object;
+    }
+
+    ClassObject* exceptionClass(const char* name, ClassObject* base) {
+        ClassObject* c = allocate<ClassObject>(name, base);
+        c->exception = true;
+        builtinNames[name] = Value::object(c);
+        return c;
+    }
+
+    Value newString(string text) { return Value::object(allocate<StringObject>(move(text))); }
+
+    // Inline when it fits, which is what the handlers' fast paths build.
+    Value makeInt(int64_t i) {
+        return Value::fitsInline(i) ? Value::integer(i) : Value::object(allocate<IntObject>(i));
+    }
+
+    // --- raising ---
+
+    // Starts a new exception; always false, for "return raise(...)".
+    bool raise(ClassObject* type, const string& message) {
+        InstanceObject* instance = allocate<InstanceObject>(type);
+        instance->payload = newString(message);
+        pending = Value::object(instance);
+        trace.clear();
+        return false;
+    }
+
+    bool overflow() { return raise(overflowError, "int does not fit in 64 bits"); }
+
+    bool typeMismatch(const char* what, Value v) {
+        return raise(typeError, string(what) + ", not '" + typeName(v) + "'");
+    }
+
+    static string typeName(Value v) {
+        switch (v.kind()) {
+            case Value::UNBOUND: return "unbound";
+            case Value::NONE: return "NoneType";
+            case Value::BOOL: return "bool";
+            case Value::INT: return "int";
+            case Value::FLOAT: return "float";
+            case Value::OBJECT: break;
+        }
+        switch (v.asObject()->kind) {
+            case ObjectKind::INT: return "int";
+            case ObjectKind::STRING: return "str";
+            case ObjectKind::LIST: return "list";
+            case ObjectKind::DICT: return "dict";
+            case ObjectKind::RANGE: return "range";
+            case ObjectKind::FUNCTION: return "function";
+            case ObjectKind::CELL: return "cell";
+            case ObjectKind::CLASS: return "type";
+            case ObjectKind::INSTANCE: return as<InstanceObject>(v)->cls->name;
+            case ObjectKind::BUILTIN: return "builtin_function_or_method";
+            case ObjectKind::MODULE: return "module";
+            case ObjectKind::RANGE_ITERATOR: return "range_iterator";
+            case ObjectKind::SEQUENCE_ITERATOR: return "iterator";
+            case ObjectKind::GENERATOR: return "generator";
+        }
+        return "object";
+    }
+
+    // Name of cell i of code: its own cells, then the captured ones.
+    static const string& derefName(const CodeObject& code, uint32_t i) {
+        return i < code.cellNames.size() ? code.cellNames[i] : code.freeNames[i - code.cellNames.size()];
+    }
+
+    bool unboundLocal(const string& name) {
+        return raise(unboundLocalError, "cannot access local variable '" + name + "' where it is not associated with a value");
+    }
+
+    bool undefinedName(const string& name) { return raise(nameError, "name '" + name + "' is not defined"); }
+
+    // --- conversions ---
+
+    static bool truthy(Value v) {
+        switch (v.kind()) {
+            case Value::UNBOUND:
+            case Value::NONE: return false;
+            case Value::BOOL: return v.asBool();
+            case Value::INT: return v.asInt() != 0;
+            case Value::FLOAT: return v.asFloat() != 0;
+            case Value::OBJECT: break;
+        }
+        Object* o = v.asObject();
+        switch (o->kind) {
+            case ObjectKind::STRING: return !static_cast<StringObject*>(o)->text.empty();
+            case ObjectKind::LIST: return !static_cast<ListObject*>(o)->items.empty();
+            case ObjectKind::DICT: return static_cast<DictObject*>(o)->live != 0;
+            case ObjectKind::RANGE: return static_cast<RangeObject*>(o)->length() != 0;
+            default: return true;
+        }
+    }
+
+    // The int a float holds, truncated, or an exception.
+    bool truncate(double d, Value& result) {
+        if (std::isnan(d)) return raise(valueError, "cannot convert float NaN to integer");
+        if (std::isinf(d)) return raise(overflowError, "cannot convert float infinity to integer");
+        int64_t i;
+        if (!float_to_int(std::trunc(d), i)) return overflow();
+        result = makeInt(i);
+        return true;
+    }
+
+    // Appends repr(v).
+    bool repr(Value v, string& out) {
+        switch (v.kind()) {
+            case Value::UNBOUND: out += "<unbound>"; return true;
+            case Value::NONE: out += "None"; return true;
+            case Value::BOOL: out += v.asBool() ? "True" : "False"; return true;
+            case Value::INT: out += to_string(v.asInt()); return true;
+            case Value::FLOAT: out += float_repr(v.asFloat()); return true;
+            case Value::OBJECT: break;
+        }
+        Object* o = v.asObject();
+        switch (o->kind) {
+            case ObjectKind::INT: out += to_string(static_cast<IntObject*>(o)->value); return true;
+            case ObjectKind::STRING: {
+                ConstantValue constant;
+                constant.kind = ConstantValue::STR;
+                constant.text = static_cast<StringObject*>(o)->text;
+                out += constant_repr(constant);
+                return true;
+            }
+            case ObjectKind::LIST:
+            case ObjectKind::DICT: {
+                bool list = o->kind == ObjectKind::LIST;
+                if (find(reprStack.begin(), reprStack.end(), o) != reprStack.end()) {
+                    out += list ? "[...]" : "{...}";
+                    return true;
+                }
+                if (reprStack.size() >= MAX_NESTING) {
+                    return raise(recursionError, "maximum recursion depth exceeded while getting the repr of an object");
+                }
+                reprStack.push_back(o);
+                bool ok = list ? reprList(*static_cast<ListObject*>(o), out) : reprDict(*static_cast<DictObject*>(o), out);
+                reprStack.pop_back();
+                return ok;
+            }
+            case ObjectKind::RANGE: {
+                const RangeObject& r = *static_cast<RangeObject*>(o);
+                out += "range(" + to_string(r.start) + ", " + to_string(r.stop);
+                if (r.step != 1) out += ", " + to_string(r.step);
+                out += ')';
+                return true;
+            }
+            case ObjectKind::FUNCTION: out += "<function " + static_cast<FunctionObject*>(o)->code->name + ">"; return true;
+            case ObjectKind::CELL: out += "<cell>"; return true;
+            case ObjectKind::CLASS: out += "<class '" + static_cast<ClassObject*>(o)->name + "'>"; return true;
+            case ObjectKind::INSTANCE: {
+                const InstanceObject& instance = *static_cast<InstanceObject*>(o);
+                if (!instance.cls->exception) {
+                    out += "<" + instance.cls->name + " object>";
+                    return true;
+                }
+                out += instance.cls->name + "(";
+                if (!instance.payload.isUnbound() && !repr(instance.payload, out)) return false;
+                out += ')';
+                return true;
+            }
+            case ObjectKind::BUILTIN: out += string("<built-in function ") + static_cast<BuiltinObject*>(o)->name + ">"; return true;
+            case ObjectKind::MODULE: out += "<module '" + static_cast<ModuleObject*>(o)->name + "'>"; return true;
+            case ObjectKind::RANGE_ITERATOR:
+            case ObjectKind::SEQUENCE_ITERATOR: out += "<" + typeName(v) + " object>"; return true;
+            case ObjectKind::GENERATOR:
+                out += "<generator object " + static_cast<GeneratorObject*>(o)->function->code->name + ">";
+                return true;
+        }
+        return true;
+    }
+
+    bool reprList(const ListObject& list, string& out) {
+        out += '[';
+        for (size_t i = 0; i < list.items.size(); i++) {
+            if (i) out += ", ";
+            if (!repr(list.items[i], out)) return false;
+        }
+        out += ']';
+        return true;
+    }
+
+    bool reprDict(const DictObject& dict, string& out) {
+        out += '{';
+        bool first = true;
+        for (size_t i = 0; i < dict.entries.size(); i++) {
+            const DictEntry& entry = dict.entries[i];
+            if (entry.key.isUnbound()) continue;
+            if (!first) out += ", ";
+            first = false;
+            if (!repr(entry.key, out)) return false;
+            out += ": ";
+            if (!repr(entry.value, out)) return false;
+        }
+        out += '}';
+        return true;
+    }
+
+    // Appends str(v): strings as they are, an exception as its argument.
+    bool str(Value v, string& out) {
+        if (is_kind(v, ObjectKind::STRING)) {
+            out += as<StringObject>(v)->text;
+            return true;
+        }
+        if (is_kind(v, ObjectKind::INSTANCE) && as<InstanceObject>(v)->cls->exception) {
+            Value payload = as<InstanceObject>(v)->payload;
+            return payload.isUnbound() || str(payload, out);
+        }
+        return repr(v, out);
+    }
+
+    // --- comparison and hashing ---
+
+    bool equal(Value a, Value b, bool& result) {
+        double x, y;
+        if (number_value(a, x) && number_value(b, y)) {
+            int64_t i, j;
+            result = a.isFloat() || b.isFloat() ? x == y : int_value(a, i) && int_value(b, j) && i == j;
+            return true;
+        }
+        if (a.identical(b) || !a.isObject() || !b.isObject() || a.asObject()->kind != b.asObject()->kind) {
+            result = a.identical(b);
+            return true;
+        }
+        switch (a.asObject()->kind) {
+            case ObjectKind::STRING:
+                result = as<StringObject>(a)->text == as<StringObject>(b)->text;
+                return true;
+            case ObjectKind::LIST:
+            case ObjectKind::DICT: {
+                if (nesting >= MAX_NESTING) return raise(recursionError, "maximum recursion depth exceeded in comparison");
+                nesting++;
+                bool ok = a.asObject()->kind == ObjectKind::LIST
+                              ? listsEqual(*as<ListObject>(a), *as<ListObject>(b), result)
+                              : dictsEqual(*as<DictObject>(a), *as<DictObject>(b), result);
+                nesting--;
+                return ok;
+            }
+            case ObjectKind::RANGE: {
+                const RangeObject& r = *as<RangeObject>(a);
+                const RangeObject& s = *as<RangeObject>(b);
+                result = r.length() == s.length() &&
+                         (r.length() == 0 || (r.start == s.start && (r.length() == 1 || r.step == s.step)));
+                return true;
+            }
+            default:
+                result = false;
+                return true;
+        }
+    }
+
+    bool listsEqual(const ListObject& a, const ListObject& b, bool& result) {
+        result = a.items.size() == b.items.size();
+        for (size_t i = 0; result && i < a.items.size() && i < b.items.size(); i++) {
+            if (a.items[i].identical(b.items[i])) continue;
+            if (!equal(a.items[i], b.items[i], result)) return false;
+        }
+        return true;
+    }
+
+    bool dictsEqual(const DictObject& a, const DictObject& b, bool& result) {
+        result = a.live == b.live;
+        for (size_t i = 0; result && i < a.entries.size(); i++) {
+            const DictEntry& entry = a.entries[i];
+            if (entry.key.isUnbound()) continue;
+            int64_t found = dict_find(b, entry.key, entry.hash);
+            if (found < 0) {
+                result = false;
+            } else if (!equal(entry.value, b.entries[found].value, result)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Equal numbers hash alike across int, float and bool.
+    bool hash(Value v, uint64_t& out) {
+        int64_t i;
+        switch (v.kind()) {
+            case Value::UNBOUND:
+            case Value::NONE: out = hash_packed_key(0x9e3779b97f4a7c15ull); return true;
+            case Value::BOOL:
+            case Value::INT: int_value(v, i); out = hash_packed_key((uint64_t)i); return true;
+            case Value::FLOAT: {
+                double d = v.asFloat();
+                if (float_to_int(d, i)) {
+                    out = hash_packed_key((uint64_t)i);
+                } else {
+                    uint64_t bits;
+                    memcpy(&bits, &d, sizeof d);
+                    out = hash_packed_key(bits);
+                }
+                return true;
+            }
+            case Value::OBJECT: break;
+        }
+        switch (v.asObject()->kind) {
+            case ObjectKind::INT: out = hash_packed_key((uint64_t)as<IntObject>(v)->value); return true;
+            case ObjectKind::STRING: out = as<StringObject>(v)->hash; return true;
+            case ObjectKind::LIST:
+            case ObjectKind::DICT: return raise(typeError, "unhashable type: '" + typeName(v) + "'");
+            default: out = hash_packed_key((uint64_t)(uintptr_t)v.asObject()); return true;
+        }
+    }
+
+    // a op b for <, <=, > and >=.
+    bool order(Opcode op, Value a, Value b, bool& result) {
+        double x, y;
+        int64_t i, j;
+        if (int_value(a, i) && int_value(b, j)) {
+            result = op == Opcode::COMPARE_LT ? i < j : op == Opcode::COMPARE_LE ? i <= j : op == Opcode::COMPARE_GT ? i > j : i >= j;
+            return true;
+        }
+        if (number_value(a, x) && number_value(b, y)) {
+            result = op == Opcode::COMPARE_LT ? x < y : op == Opcode::COMPARE_LE ? x <= y : op == Opcode::COMPARE_GT ? x > y : x >= y;
+            return true;
+        }
+        if (is_kind(a, ObjectKind::STRING) && is_kind(b, ObjectKind::STRING)) {
+            int c = as<StringObject>(a)->text.compare(as<StringObject>(b)->text);
+            result = op == Opcode::COMPARE_LT ? c < 0 : op == Opcode::COMPARE_LE ? c <= 0 : op == Opcode::COMPARE_GT ? c > 0 : c >= 0;
+            return true;
+        }
+        if (is_kind(a, ObjectKind::LIST) && is_kind(b, ObjectKind::LIST)) {
+            // The first items that differ decide; otherwise the lengths
+            const vector<Value>& p = as<ListObject>(a)->items;
+            const vector<Value>& q = as<ListObject>(b)->items;
+            if (nesting >= MAX_NESTING) return raise(recursionError, "maximum recursion depth exceeded in comparison");
+            nesting++;
+            size_t k = 0;
+            bool same = true;
+            for (; k < p.size() && k < q.size(); k++) {
+                if (!equal(p[k], q[k], same)) {
+                    nesting--;
+                    return false;
+                }
+                if (!same) break;
+            }
+            bool ok = true;
+            if (k < p.size() && k < q.size()) {
+                ok = order(op, p[k], q[k], result);
+            } else {
+                size_t m = p.size(), n = q.size();
+                result = op == Opcode::COMPARE_LT ? m < n : op == Opcode::COMPARE_LE ? m <= n : op == Opcode::COMPARE_GT ? m > n : m >= n;
+            }
+            nesting--;
+            return ok;
+        }
+        return raise(typeError, string("'") + operator_symbol(op) + "' not supported between instances of '" +
+                                    typeName(a) + "' and '" + typeName(b) + "'");
+    }
+
+    bool contains(Value container, Value item, bool& result) {
+        result = false;
+        if (is_kind(container, ObjectKind::LIST)) {
+            for (Value v : as<ListObject>(container)->items) {
+                if (v.identical(item)) {
+                    result = true;
+                    return true;
+                }
+                if (!equal(v, item, result)) return false;
+                if (result) return true;
+            }
+            return true;
+        }
+        if (is_kind(container, ObjectKind::DICT)) {
+            uint64_t h;
+            if (!hash(item, h)) return false;
+            result = dict_find(*as<DictObject>(container), item, h) >= 0;
+            return true;
+        }
+        if (is_kind(container, ObjectKind::STRING)) {
+            if (!is_kind(item, ObjectKind::STRING)) return typeMismatch("'in <string>' requires string as left operand", item);
+            result = as<StringObject>(container)->text.find(as<StringObject>(item)->text) != string::npos;
+            return true;
+        }
+        if (is_kind(container, ObjectKind::RANGE)) {
+            const RangeObject& r = *as<RangeObject>(container);
+            int64_t i;
+            if (!int_value(item, i) && !(item.isFloat() && float_to_int(item.asFloat(), i))) return true;
+            bool inside = r.step > 0 ? i >= r.start && i < r.stop : i <= r.start && i > r.stop;
+            result = inside && ((uint64_t)i - (uint64_t)r.start) % (r.step > 0 ? (uint64_t)r.step : 0 - (uint64_t)r.step) == 0;
+            return true;
+        }
+        if (container.isObject() && (container.asObject()->kind == ObjectKind::RANGE_ITERATOR ||
+                                     container.asObject()->kind == ObjectKind::SEQUENCE_ITERATOR ||
+                                     container.asObject()->kind == ObjectKind::GENERATOR)) {
+            for (;;) {
+                Value next;
+                bool done;
+                if (!advance(container, next, done)) return false;
+                if (done) return true;
+                if (!equal(next, item, result)) return false;
+                if (result) return true;
+            }
+        }
+        return raise(typeError, "argument of type '" + typeName(container) + "' is not iterable");
+    }
+
+    bool compare(Opcode op, Value a, Value b, Value& result) {
+        bool r;
+        switch (op) {
+            case Opcode::COMPARE_EQ:
+            case Opcode::COMPARE_NE:
+                if (!equal(a, b, r)) return false;
+                result = Value::boolean(r == (op == Opcode::COMPARE_EQ));
+                return true;
+            case Opcode::COMPARE_IS: result = Value::boolean(a.identical(b)); return true;
+            case Opcode::COMPARE_IS_NOT: result = Value::boolean(!a.identical(b)); return true;
+            case Opcode::COMPARE_IN:
+            case Opcode::COMPARE_NOT_IN:
+                if (!contains(b, a, r)) return false;
+                result = Value::boolean(r == (op == Opcode::COMPARE_IN));
+                return true;
+            default:
+                if (!order(op, a, b, r)) return false;
+                result = Value::boolean(r);
+                return true;
+        }
+    }
+
+    // --- arithmetic ---
+
+    // Python's int operators on 64 bits: // and % round toward negative
+    // infinity, and a result that does not fit raises OverflowError.
+    bool intBinary(Opcode op, int64_t a, int64_t b, Value& result) {
+        int64_t r;
+        switch (op) {
+            case Opcode::BINARY_ADD:
+            case Opcode::INPLACE_ADD:
+                if (__builtin_add_overflow(a, b, &r)) return overflow();
+                break;
+            case Opcode::BINARY_SUBTRACT:
+                if (__builtin_sub_overflow(a, b, &r)) return overflow();
+                break;
+            case Opcode::BINARY_MULTIPLY:
+                if (__builtin_mul_overflow(a, b, &r)) return overflow();
+                break;
+            case Opcode::BINARY_TRUE_DIVIDE:
+                if (b == 0) return raise(zeroDivisionError, "division by zero");
+                result = Value::real((double)a / (double)b);
+                return true;
+            case Opcode::BINARY_FLOOR_DIVIDE:
+                if (b == 0) return raise(zeroDivisionError, "integer division or modulo by zero");
+                if (a == INT64_MIN && b == -1) return overflow();
+                r = a / b;
+                if (a % b != 0 && (a < 0) != (b < 0)) r--;
+                break;
+            case Opcode::BINARY_MODULO:
+                if (b == 0) return raise(zeroDivisionError, "integer modulo by zero");
+                r = b == -1 ? 0 : a % b;
+                if (r != 0 && (r < 0) != (b < 0)) r += b;
+                break;
+            case Opcode::BINARY_POWER: {
+                if (b < 0) {
+                    if (a == 0) return raise(zeroDivisionError, "0.0 cannot be raised to a negative power");
+                    result = Value::real(std::pow((double)a, (double)b));
+                    return true;
+                }
+                int64_t base = a;
+                r = 1;
+                for (int64_t exponent = b; exponent > 0; exponent >>= 1) {
+                    if ((exponent & 1) && __builtin_mul_overflow(r, base, &r)) return overflow();
+                    if (exponent > 1 && __builtin_mul_overflow(base, base, &base)) return overflow();
+                }
+                break;
+            }
+            case Opcode::BINARY_LSHIFT:
+                if (b < 0) return raise(valueError, "negative shift count");
+                if (a == 0) {
+                    r = 0;
+                    break;
+                }
+                if (b >= 63) return overflow();
+                r = (int64_t)((uint64_t)a << b);
+                if (r >> b != a) return overflow();
+                break;
+            case Opcode::BINARY_RSHIFT:
+                if (b < 0) return raise(valueError, "negative shift count");
+                r = b >= 63 ? (a < 0 ? -1 : 0) : a >> b;
+                break;
+            case Opcode::BINARY_AND: r = a & b; break;
+            case Opcode::BINARY_OR: r = a | b; break;
+            case Opcode::BINARY_XOR: r = a ^ b; break;
+            default: return false;
+        }
+        result = makeInt(r);
+        return true;
+    }
+
+    // Python's float operators, with CPython's floor division and modulo;
+    // not the bitwise ones.
+    bool floatBinary(Opcode op, double a, double b, Value& result) {
+        switch (op) {
+            case Opcode::BINARY_ADD:
+            case Opcode::INPLACE_ADD: result = Value::real(a + b); return true;
+            case Opcode::BINARY_SUBTRACT: result = Value::real(a - b); return true;
+            case Opcode::BINARY_MULTIPLY: result = Value::real(a * b); return true;
+            case Opcode::BINARY_TRUE_DIVIDE:
+                if (b == 0) return raise(zeroDivisionError, "float division by zero");
+                result = Value::real(a / b);
+                return true;
+            case Opcode::BINARY_FLOOR_DIVIDE:
+            case Opcode::BINARY_MODULO: {
+                if (b == 0) {
+                    return raise(zeroDivisionError, op == Opcode::BINARY_MODULO ? "float modulo" : "float floor division by zero");
+                }
+                double mod = std::fmod(a, b);
+                double div = (a - mod) / b;
+                if (mod != 0) {
+                    if ((b < 0) != (mod < 0)) {
+                        mod += b;
+                        div -= 1.0;
+                    }
+                } else {
+                    mod = std::copysign(0.0, b);
+                }
+                double floorDiv;
+                if (div != 0) {
+                    floorDiv = std::floor(div);
+                    if (div - floorDiv > 0.5) floorDiv += 1.0;
+                } else {
+                    floorDiv = std::copysign(0.0, a / b);
+                }
+                result = Value::real(op == Opcode::BINARY_MODULO ? mod : floorDiv);
+                return true;
+            }
+            default: {
+                if (a == 0 && b < 0) return raise(zeroDivisionError, "0.0 cannot be raised to a negative power");
+                if (a < 0 && b != std::floor(b) && std::isfinite(b)) {
+                    return raise(valueError, "negative number cannot be raised to a fractional power");
+                }
+                double r = std::pow(a, b);
+                if (std::isinf(r) && std::isfinite(a) && std::isfinite(b)) {
+                    return raise(overflowError, "(34, 'Numerical result out of range')");
+                }
+                result = Value::real(r);
+                return true;
+            }
+        }
+    }
+
+    // s * n and list * n.
+    bool repeat(Value sequence, int64_t count, Value& result) {
+        if (count < 0) count = 0;
+        if (is_kind(sequence, ObjectKind::STRING)) {
+            const string& text = as<StringObject>(sequence)->text;
+            if (!text.empty() && (uint64_t)count > MAX_SEQUENCE_SIZE / text.size()) return raise(memoryError, "");
+            string out;
+            out.reserve(text.size() * count);
+            for (int64_t i = 0; i < count; i++) out += text;
+            result = newString(move(out));
+            return true;
+        }
+        const vector<Value>& items = as<ListObject>(sequence)->items;
+        if (!items.empty() && (uint64_t)count > MAX_SEQUENCE_SIZE / items.size()) return raise(memoryError, "");
+        ListObject* list = allocate<ListObject>();
+        list->items.reserve(items.size() * count);
+        for (int64_t i = 0; i < count; i++) list->items.insert(list->items.end(), items.begin(), items.end());
+        result = Value::object(list);
+        return true;
+    }
+
+    bool binary(Opcode op, Value a, Value b, Value& result) {
+        int64_t i, j;
+        double x, y;
+        if (int_value(a, i) && int_value(b, j)) {
+            bool logical = op == Opcode::BINARY_AND || op == Opcode::BINARY_OR || op == Opcode::BINARY_XOR;
+            if (!intBinary(op, i, j, result)) return false;
+            if (logical && a.isBool() && b.isBool()) result = Value::boolean(result.asInt() != 0);
+            return true;
+        }
+        if (!is_bitwise(op) && number_value(a, x) && number_value(b, y)) return floatBinary(op, x, y, result);
+        bool adding = op == Opcode::BINARY_ADD || op == Opcode::INPLACE_ADD;
+        if (adding && is_kind(a, ObjectKind::STRING) && is_kind(b, ObjectKind::STRING)) {
+            const string& s = as<StringObject>(a)->text;
+            const string& t = as<StringObject>(b)->text;
+            if (s.size() + t.size() > MAX_SEQUENCE_SIZE) return raise(memoryError, "");
+            result = newString(s + t);
+            return true;
+        }
+        if (adding && is_kind(a, ObjectKind::LIST)) {
+            if (op == Opcode::INPLACE_ADD) {
+                // Extends in place, taking any iterable
+                vector<Value> items;
+                if (!is_kind(b, ObjectKind::LIST) && !collect(b, items)) return false;
+                vector<Value>& target = as<ListObject>(a)->items;
+                const vector<Value>& source = is_kind(b, ObjectKind::LIST) ? as<ListObject>(b)->items : items;
+                target.insert(target.end(), source.begin(), source.end());
+                result = a;
+                return true;
+            }
+            if (is_kind(b, ObjectKind::LIST)) {
+                ListObject* list = allocate<ListObject>();
+                list->items = as<ListObject>(a)->items;
+                const vector<Value>& more = as<ListObject>(b)->items;
+                list->items.insert(list->items.end(), more.begin(), more.end());
+                result = Value::object(list);
+                return true;
+            }
+        }
+        if (op == Opcode::BINARY_MULTIPLY) {
+            bool sequenceA = is_kind(a, ObjectKind::STRING) || is_kind(a, ObjectKind::LIST);
+            bool sequenceB = is_kind(b, ObjectKind::STRING) || is_kind(b, ObjectKind::LIST);
+            if (sequenceA && int_value(b, j)) return repeat(a, j, result);
+            if (sequenceB && int_value(a, i)) return repeat(b, i, result);
+        }
+        return raise(typeError, string("unsupported operand type(s) for ") + operator_symbol(op) + ": '" +
+                                    typeName(a) + "' and '" + typeName(b) + "'");
+    }
+
+    bool unary(Opcode op, Value v, Value& result) {
+        int64_t i;
+        if (op == Opcode::UNARY_NOT) {
+            result = Value::boolean(!truthy(v));
+            return true;
+        }
+        if (int_value(v, i)) {
+            if (op == Opcode::UNARY_NEGATIVE) {
+                if (i == INT64_MIN) return overflow();
+                i = -i;
+            } else if (op == Opcode::UNARY_INVERT) {
+                i = ~i;
+            }
+            result = makeInt(i);
+            return true;
+        }
+        if (v.isFloat() && op != Opcode::UNARY_INVERT) {
+            result = op == Opcode::UNARY_NEGATIVE ? Value::real(-v.asFloat()) : v;
+            return true;
+        }
+        const char* symbol = op == Opcode::UNARY_NEGATIVE ? "-" : op == Opcode::UNARY_POSITIVE ? "+" : "~";
+        return raise(typeError, string("bad operand type for unary ") + symbol + ": '" + typeName(v) + "'");
+    }
+
+    // --- items and attributes ---
+
+    // index as a position in a sequence of size items; negative counts from
+    // the end.
+    bool position(Value container, Value index, size_t size, const char* outOfRange, size_t& out) {
+        int64_t i;
+        if (!int_value(index, i)) {
+            return raise(typeError, typeName(container) + " indices must be integers, not " + typeName(index));
+        }
+        if (i < 0) i += (int64_t)size;
+        if (i < 0 || (uint64_t)i >= size) return raise(indexError, outOfRange);
+        out = (size_t)i;
+        return true;
+    }
+
+    // KeyError's message is the repr of the key, as in Python.
+    bool keyMissing(Value key) {
+        string text;
+        if (!repr(key, text)) return false;
+        return raise(keyError, text);
+    }
+
+    bool subscript(Value container, Value index, Value& result) {
+        size_t i;
+        if (!container.isObject()) return raise(typeError, "'" + typeName(container) + "' object is not subscriptable");
+        switch (container.asObject()->kind) {
+            case ObjectKind::LIST: {
+                const vector<Value>& items = as<ListObject>(container)->items;
+                if (!position(container, index, items.size(), "list index out of range", i)) return false;
+                result = items[i];
+                return true;
+            }
+            case ObjectKind::STRING: {
+                const StringObject& s = *as<StringObject>(container);
+                if (!position(container, index, s.length, "string index out of range", i)) return false;
+                size_t offset = utf8_offset(s, i);
+                result = newString(s.text.substr(offset, utf8_sequence_length((unsigned char)s.text[offset])));
+                return true;
+            }
+            case ObjectKind::RANGE: {
+                const RangeObject& r = *as<RangeObject>(container);
+                if (!position(container, index, r.length(), "range object index out of range", i)) return false;
+                result = makeInt(r.at(i));
+                return true;
+            }
+            case ObjectKind::DICT: {
+                const DictObject& dict = *as<DictObject>(container);
+                uint64_t h;
+                if (!hash(index, h)) return false;
+                int64_t found = dict_find(dict, index, h);
+                if (found < 0) return keyMissing(index);
+                result = dict.entries[found].value;
+                return true;
+            }
+            default:
+                return raise(typeError, "'" + typeName(container) + "' object is not subscriptable");
+        }
+    }
+
+    bool storeSubscript(Value container, Value index, Value value) {
+        if (is_kind(container, ObjectKind::LIST)) {
+            vector<Value>& items = as<ListObject>(container)->items;
+            size_t i;
+            if (!position(container, index, items.size(), "list assignment index out of range", i)) return false;
+            items[i] = value;
+            return true;
+        }
+        if (is_kind(container, ObjectKind::DICT)) {
+            uint64_t h;
+            if (!hash(index, h)) return false;
+            dict_set(*as<DictObject>(container), index, h, value);
+            return true;
+        }
+        return raise(typeError, "'" + typeName(container) + "' object does not support item assignment");
+    }
+
+    bool deleteSubscript(Value container, Value index) {
+        if (is_kind(container, ObjectKind::LIST)) {
+            vector<Value>& items = as<ListObject>(container)->items;
+            size_t i;
+            if (!position(container, index, items.size(), "list assignment index out of range", i)) return false;
+            items.erase(items.begin() + i);
+            return true;
+        }
+        if (is_kind(container, ObjectKind::DICT)) {
+            DictObject& dict = *as<DictObject>(container);
+            uint64_t h;
+            if (!hash(index, h)) return false;
+            int64_t found = dict_find(dict, index, h);
+            if (found < 0) return keyMissing(index);
+            dict_erase(dict, found);
+            return true;
+        }
+        return raise(typeError, "'" + typeName(container) + "' object doesn't support item deletion");
+    }
+
+    // The attribute table of an instance, class or module, or null.
+    static unordered_map<string, Value>* attributeTable(Value v) {
+        if (!v.isObject()) return nullptr;
+        switch (v.asObject()->kind) {
+            case ObjectKind::INSTANCE: return &as<InstanceObject>(v)->attributes;
+            case ObjectKind::CLASS: return &as<ClassObject>(v)->attributes;
+            case ObjectKind::MODULE: return &as<ModuleObject>(v)->attributes;
+            default: return nullptr;
+        }
+    }
+
+    bool noAttribute(Value v, const string& name) {
+        if (is_kind(v, ObjectKind::CLASS)) {
+            return raise(attributeError, "type object '" + as<ClassObject>(v)->name + "' has no attribute '" + name + "'");
+        }
+        return raise(attributeError, "'" + typeName(v) + "' object has no attribute '" + name + "'");
+    }
+
+    // Instances fall back to their class and classes to their bases.
+    bool getAttribute(Value v, const string& name, Value& result) {
+        if (unordered_map<string, Value>* table = attributeTable(v)) {
+            auto it = table->find(name);
+            if (it != table->end()) {
+                result = it->second;
+                return true;
+            }
+        }
+        const ClassObject* cls = is_kind(v, ObjectKind::INSTANCE) ? as<InstanceObject>(v)->cls
+                                 : is_kind(v, ObjectKind::CLASS) ? as<ClassObject>(v)->base : nullptr;
+        if (const Value* found = cls ? cls->lookup(name) : nullptr) {
+            result = *found;
+            return true;
+        }
+        return noAttribute(v, name);
+    }
+
+    bool setAttribute(Value v, const string& name, Value value) {
+        unordered_map<string, Value>* table = attributeTable(v);
+        if (!table) return noAttribute(v, name);
+        (*table)[name] = value;
+        return true;
+    }
+
+    bool deleteAttribute(Value v, const string& name) {
+        unordered_map<string, Value>* table = attributeTable(v);
+        if (!table || !table->erase(name)) return noAttribute(v, name);
+        return true;
+    }
+
+    // --- iteration ---
+
+    static bool isIterator(Value v) {
+        return is_kind(v, ObjectKind::RANGE_ITERATOR) || is_kind(v, ObjectKind::SEQUENCE_ITERATOR) ||
+               is_kind(v, ObjectKind::GENERATOR);
+    }
+
+    bool getIterator(Value v, Value& result) {
+        if (isIterator(v)) {
+            result = v;
+            return true;
+        }
+        if (is_kind(v, ObjectKind::RANGE)) {
+            result = Value::object(allocate<RangeIteratorObject>(*as<RangeObject>(v)));
+            return true;
+        }
+        if (is_kind(v, ObjectKind::LIST) || is_kind(v, ObjectKind::DICT) || is_kind(v, ObjectKind::STRING)) {
+            result = Value::object(allocate<SequenceIteratorObject>(v));
+            return true;
+        }
+        return raise(typeError, "'" + typeName(v) + "' object is not iterable");
+    }
+
+    // The next item of an iterator, or done. Resuming a generator needs the
+    // top frame's sp to be current.
+    bool advance(Value iterator, Value& item, bool& done) {
+        done = false;
+        switch (iterator.asObject()->kind) {
+            case ObjectKind::RANGE_ITERATOR: {
+                RangeIteratorObject& range = *as<RangeIteratorObject>(iterator);
+                if (!range.remaining) {
+                    done = true;
+                    return true;
+                }
+                range.remaining--;
+                item = makeInt((int64_t)range.current);
+                range.current += range.step;
+                return true;
+            }
+            case ObjectKind::SEQUENCE_ITERATOR: {
+                SequenceIteratorObject& it = *as<SequenceIteratorObject>(iterator);
+                Value sequence = it.sequence;
+                if (is_kind(sequence, ObjectKind::LIST)) {
+                    const vector<Value>& items = as<ListObject>(sequence)->items;
+                    if (it.index >= items.size()) {
+                        done = true;
+                    } else {
+                        item = items[it.index++];
+                    }
+                } else if (is_kind(sequence, ObjectKind::DICT)) {
+                    const vector<DictEntry>& entries = as<DictObject>(sequence)->entries;
+                    while (it.index < entries.size() && entries[it.index].key.isUnbound()) it.index++;
+                    if (it.index >= entries.size()) {
+                        done = true;
+                    } else {
+                        item = entries[it.index++].key;
+                    }
+                } else {
+                    const string& text = as<StringObject>(sequence)->text;
+                    if (it.index >= text.size()) {
+                        done = true;
+                    } else {
+                        size_t length = utf8_sequence_length((unsigned char)text[it.index]);
+                        item = newString(text.substr(it.index, length));
+                        it.index += length;
+                    }
+                }
+                return true;
+            }
+            case ObjectKind::GENERATOR:
+                return resume(as<GeneratorObject>(iterator), item, done);
+            default:
+                return raise(typeError, "'" + typeName(iterator) + "' object is not an iterator");
+        }
+    }
+
+    // Every item of an iterable.
+    bool collect(Value iterable, vector<Value>& items) {
+        if (is_kind(iterable, ObjectKind::LIST)) {
+            const vector<Value>& source = as<ListObject>(iterable)->items;
+            items.insert(items.end(), source.begin(), source.end());
+            return true;
+        }
+        Value iterator;
+        if (!getIterator(iterable, iterator)) return false;
+        for (;;) {
+            Value item;
+            bool done;
+            if (!advance(iterator, item, done)) return false;
+            if (done) return true;
+            items.push_back(item);
+        }
+    }
+
+    // --- calls ---
+
+    static string plural(size_t n, const char* word) {
+        return to_string(n) + " " + word + (n == 1 ? "" : "s");
+    }
+
+    // Lays out a call at base, where the caller pushed count arguments:
+    // fills in defaults, clears the other locals and creates the cells.
+    bool bindArguments(FunctionObject* function, Value* base, uint32_t count) {
+        const CodeObject& code = *function->code;
+        uint32_t required = code.argCount - code.defaultCount;
+        if (count > code.argCount) {
+            string takes = code.defaultCount ? "from " + to_string(required) + " to " + to_string(code.argCount)
+                                             : to_string(code.argCount);
+            return raise(typeError, code.name + "() takes " + takes + " positional argument" +
+                                        (code.argCount == 1 ? "" : "s") + " but " + to_string(count) +
+                                        (count == 1 ? " was" : " were") + " given");
+        }
+        if (count < required) {
+            return raise(typeError, code.name + "() missing " + plural(required - count, "required positional argument"));
+        }
+        size_t locals = code.localNames.size();
+        if (frames.size() >= MAX_FRAMES ||
+            base + locals + code.derefCount() + code.maxStack + 1 > values.data() + values.size()) {
+            return raise(recursionError, "maximum recursion depth exceeded");
+        }
+        for (uint32_t i = count; i < code.argCount; i++) base[i] = function->defaults[i - required];
+        for (size_t i = code.argCount; i < locals; i++) base[i] = Value();
+        Value* cells = base + locals;
+        for (size_t i = 0; i < code.cellNames.size(); i++) {
+            int32_t argument = code.cellArguments[i];
+            cells[i] = Value::object(allocate<CellObject>(argument >= 0 ? base[argument] : Value()));
+        }
+        copy(function->cells.begin(), function->cells.end(), cells + code.cellNames.size());
+        return true;
+    }
+
+    void pushFrame(FunctionObject* function, Value* base, Value* result, FrameKind kind, Object* owner) {
+        const CodeObject& code = *function->code;
+        Frame frame;
+        frame.code = &code;
+        frame.constants = pools[function->codeIndex].data();
+        frame.function = function;
+        frame.owner = owner;
+        frame.kind = kind;
+        frame.pc = code.code.data();
+        frame.base = base;
+        frame.cells = base + code.localNames.size();
+        frame.stack = frame.cells + code.derefCount();
+        frame.sp = frame.stack;
+        frame.result = result;
+        frames.push_back(frame);
+    }
+
+    // Calls what is not a Python function: a builtin, or a class, whose
+    // __init__ gets a frame of its own. The result replaces the callee.
+    bool callObject(Value* callee, uint32_t count) {
+        if (is_kind(*callee, ObjectKind::BUILTIN)) {
+            nativeDepth++;
+            Value result;
+            bool ok = callBuiltin(as<BuiltinObject>(*callee)->id, callee + 1, count, result);
+            nativeDepth--;
+            if (ok) *callee = result;
+            return ok;
+        }
+        if (!is_kind(*callee, ObjectKind::CLASS)) {
+            return raise(typeError, "'" + typeName(*callee) + "' object is not callable");
+        }
+        ClassObject* cls = as<ClassObject>(*callee);
+        InstanceObject* instance = allocate<InstanceObject>(cls);
+        if (cls->exception && count > 0) instance->payload = callee[1];
+        const Value* init = cls->lookup("__init__");
+        if (init && is_kind(*init, ObjectKind::FUNCTION)) {
+            FunctionObject* function = as<FunctionObject>(*init);
+            *callee = Value::object(instance);
+            if (!bindArguments(function, callee, count + 1)) return false;
+            pushFrame(function, callee, callee, FrameKind::CONSTRUCTOR, instance);
+            return true;
+        }
+        if (count > 0 && !cls->exception) return raise(typeError, cls->name + "() takes no arguments");
+        *callee = Value::object(instance);
+        return true;
+    }
+
+    // A generator function's call: the bound locals and cells move into a
+    // generator, which runs when iterated.
+    GeneratorObject* makeGenerator(FunctionObject* function, Value* base) {
+        const CodeObject& code = *function->code;
+        GeneratorObject* generator = allocate<GeneratorObject>(function);
+        generator->saved.assign(base, base + code.localNames.size() + code.derefCount());
+        return generator;
+    }
+
+    // Runs a generator to its next yield, on top of the current top frame,
+    // whose sp must be current.
+    bool resume(GeneratorObject* generator, Value& item, bool& done) {
+        done = false;
+        if (generator->state == GeneratorObject::RUNNING) return raise(valueError, "generator already executing");
+        if (generator->state == GeneratorObject::DONE) {
+            done = true;
+            return true;
+        }
+        const CodeObject& code = *generator->function->code;
+        Value* base = frames.back().sp;
+        if (frames.size() >= MAX_FRAMES ||
+            base + generator->saved.size() + code.maxStack + 1 > values.data() + values.size()) {
+            return raise(recursionError, "maximum recursion depth exceeded");
+        }
+        copy(generator->saved.begin(), generator->saved.end(), base);
+        pushFrame(generator->function, base, nullptr, FrameKind::GENERATOR, generator);
+        Frame& frame = frames.back();
+        frame.sp = base + generator->saved.size();
+        frame.pc = code.code.data() + generator->pc;
+        if (generator->state == GeneratorObject::SUSPENDED) *frame.sp++ = Value::none();    // what yield evaluates to
+        generator->state = GeneratorObject::RUNNING;
+        generator->saved.clear();
+        Value out;
+        if (!execute(out)) return false;
+        done = generator->state == GeneratorObject::DONE;
+        item = out;
+        return true;
+    }
+
+    static const ExceptionHandler* findHandler(const CodeObject& code, uint32_t offset) {
+        for (const ExceptionHandler& handler : code.handlers) {
+            if (offset >= handler.start && offset < handler.end) return &handler;
+        }
+        return nullptr;
+    }
+
+    // --- names and imports ---
+
+    // Class bodies: the class namespace, then globals and builtins.
+    bool loadName(const Frame& frame, const string& name, Value& result) {
+        const unordered_map<string, Value>& attributes = static_cast<ClassObject*>(frame.owner)->attributes;
+        auto it = attributes.find(name);
+        if (it != attributes.end()) {
+            result = it->second;
+            return true;
+        }
+        auto slot = globalSlot.find(name);
+        if (slot != globalSlot.end() && !globals[slot->second].isUnbound()) {
+            result = globals[slot->second];
+            return true;
+        }
+        auto builtin = builtinNames.find(name);
+        if (builtin == builtinNames.end()) return undefinedName(name);
+        result = builtin->second;
+        return true;
+    }
+
+    bool importModule(const string& name, Value& result) {
+        auto found = modules.find(name);
+        if (found != modules.end()) {
+            result = Value::object(found->second);
+            return true;
+        }
+        if (name != "math") return raise(importError, "No module named '" + name + "'");
+        ModuleObject* math = allocate<ModuleObject>(name);
+#define X(id, name) math->attributes[name] = Value::object(allocate<BuiltinObject>(BUILTIN_##id, name));
+        MATH_FUNCTIONS(X)
+#undef X
+        math->attributes["pi"] = Value::real(3.141592653589793);
+        math->attributes["e"] = Value::real(2.718281828459045);
+        modules[name] = math;
+        result = Value::object(math);
+        return true;
+    }
+
+    // --- collection ---
+
+    void mark(Value v, vector<Object*>& gray) {
+        if (v.isObject()) mark(v.asObject(), gray);
+    }
+
+    void mark(Object* o, vector<Object*>& gray) {
+        if (!o || o->marked) return;
+        o->marked = true;
+        gray.push_back(o);
+    }
+
+    // What o refers to, for the mark phase.
+    void markChildren(Object* o, vector<Object*>& gray) {
+        switch (o->kind) {
+            case ObjectKind::LIST:
+                for (Value v : static_cast<ListObject*>(o)->items) mark(v, gray);
+                break;
+            case ObjectKind::DICT:
+                for (const DictEntry& entry : static_cast<DictObject*>(o)->entries) {
+                    mark(entry.key, gray);
+                    mark(entry.value, gray);
+                }
+                break;
+            case ObjectKind::FUNCTION:
+                for (Value v : static_cast<FunctionObject*>(o)->defaults) mark(v, gray);
+                for (Value v : static_cast<FunctionObject*>(o)->cells) mark(v, gray);
+                break;
+            case ObjectKind::CELL: mark(static_cast<CellObject*>(o)->value, gray); break;
+            case ObjectKind::CLASS:
+                mark(static_cast<ClassObject*>(o)->base, gray);
+                for (const auto& attribute : static_cast<ClassObject*>(o)->attributes) mark(attribute.second, gray);
+                break;
+            case ObjectKind::INSTANCE:
+                mark(static_cast<InstanceObject*>(o)->cls, gray);
+                mark(static_cast<InstanceObject*>(o)->payload, gray);
+                for (const auto& attribute : static_cast<InstanceObject*>(o)->attributes) mark(attribute.second, gray);
+                break;
+            case ObjectKind::MODULE:
+                for (const auto& attribute : static_cast<ModuleObject*>(o)->attributes) mark(attribute.second, gray);
+                break;
+            case ObjectKind::SEQUENCE_ITERATOR: mark(static_cast<SequenceIteratorObject*>(o)->sequence, gray); break;
+            case ObjectKind::GENERATOR:
+                mark(static_cast<GeneratorObject*>(o)->function, gray);
+                for (Value v : static_cast<GeneratorObject*>(o)->saved) mark(v, gray);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Mark and sweep. Runs only at safe points, where the top frame's sp is
+    // current and no builtin holds values outside the roots. The gray list
+    // keeps deep structures off the C++ stack.
+    void collect() {
+        vector<Object*> gray;
+        if (!frames.empty()) {
+            for (Value* v = values.data(); v < frames.back().sp; v++) mark(*v, gray);
+        }
+        for (const Frame& frame : frames) {
+            mark(frame.function, gray);
+            mark(frame.owner, gray);
+        }
+        for (Value v : globals) mark(v, gray);
+        for (Value v : builtins) mark(v, gray);
+        for (const auto& builtin : builtinNames) mark(builtin.second, gray);
+        for (const auto& module : modules) mark(module.second, gray);
+        for (const vector<Value>& pool : pools) {
+            for (Value v : pool) mark(v, gray);
+        }
+        mark(pending, gray);
+        while (!gray.empty()) {
+            Object* o = gray.back();
+            gray.pop_back();
+            markChildren(o, gray);
+        }
+
+        size_t live = 0;
+        for (Object** link = &objects; *link;) {
+            Object* o = *link;
+            if (o->marked) {
+                o->marked = false;
+                live++;
+                link = &o->next;
+            } else {
+                *link = o->next;
+                delete o;
+            }
+        }
+        objectCount = live;
+        collectAt = max(MIN_COLLECTION_THRESHOLD, 2 * live);
+        collectPending = false;
+        collections++;
+    }
+
+    // --- the dispatch loop ---
+
+    // Runs the top frame until it returns or yields, with out its value, or
+    // until an exception leaves it (false, with the exception pending).
+    // Frames it calls run in the same loop.
+    bool execute(Value& out) {
+        const size_t entry = frames.size();
+        Frame* frame;
+        const uint8_t* codeStart;
+        const uint8_t* pc;
+        Value* sp;
+        Value* locals;
+        const Value* constants;
+        uint64_t executed = 0;
+        Opcode slowOp = Opcode::NOP;
+
+#define LOAD_FRAME() \
+    (frame = &frames.back(), codeStart = frame->code->code.data(), pc = frame->pc, sp = frame->sp, \
+     locals = frame->base, constants = frame->constants)
+#define SAVE_FRAME() (frame->pc = pc, frame->sp = sp)
+#define SAFE_POINT() \
+    do { \
+        if (collectPending && nativeDepth == 0) { \
+            SAVE_FRAME(); \
+            collect(); \
+        } \
+    } while (0)
+#define JUMP_TARGET() (codeStart + read_varint(pc))
+
+        LOAD_FRAME();
+#ifdef VM_THREADED_DISPATCH
+        static void* const targets[OPCODE_COUNT] = {
+#define X(name, operand) &&op_##name,
+            OPCODES(X)
+#undef X
+        };
+#define TARGET(op) op_##op:
+#define DISPATCH() \
+    do { \
+        executed++; \
+        goto *targets[*pc++]; \
+    } while (0)
+        DISPATCH();
+#else
+#define TARGET(op) case Opcode::op:
+#define DISPATCH() continue
+        for (;;) {
+            executed++;
+            switch ((Opcode)*pc++) {
+#endif
+
+        TARGET(NOP) { DISPATCH(); }
+        TARGET(POP_TOP) {
+            sp--;
+            DISPATCH();
+        }
+        TARGET(DUP_TOP) {
+            *sp = sp[-1];
+            sp++;
+            DISPATCH();
+        }
+        TARGET(ROT_TWO) {
+            swap(sp[-1], sp[-2]);
+            DISPATCH();
+        }
+        TARGET(ROT_THREE) {
+            Value top = sp[-1];
+            sp[-1] = sp[-2];
+            sp[-2] = sp[-3];
+            sp[-3] = top;
+            DISPATCH();
+        }
+        TARGET(LOAD_CONST) {
+            *sp++ = constants[read_varint(pc)];
+            DISPATCH();
+        }
+        TARGET(LOAD_SMALL_INT) {
+            *sp++ = Value::integer(read_int16(pc));
+            DISPATCH();
+        }
+        TARGET(LOAD_NONE) {
+            *sp++ = Value::none();
+            DISPATCH();
+        }
+        TARGET(LOAD_TRUE) {
+            *sp++ = Value::boolean(true);
+            DISPATCH();
+        }
+        TARGET(LOAD_FALSE) {
+            *sp++ = Value::boolean(false);
+            DISPATCH();
+        }
+        TARGET(LOAD_FAST) {
+            uint32_t slot = read_varint(pc);
+            Value v = locals[slot];
+            if (v.isUnbound()) {
+                unboundLocal(frame->code->localNames[slot]);
+                goto error;
+            }
+            *sp++ = v;
+            DISPATCH();
+        }
+        TARGET(STORE_FAST) {
+            locals[read_varint(pc)] = *--sp;
+            DISPATCH();
+        }
+        TARGET(DELETE_FAST) {
+            uint32_t slot = read_varint(pc);
+            if (locals[slot].isUnbound()) {
+                unboundLocal(frame->code->localNames[slot]);
+                goto error;
+            }
+            locals[slot] = Value();
+            DISPATCH();
+        }
+        TARGET(LOAD_DEREF) {
+            uint32_t i = read_varint(pc);
+            Value v = as<CellObject>(frame->cells[i])->value;
+            if (v.isUnbound()) {
+                if (i < frame->code->cellNames.size()) {
+                    unboundLocal(frame->code->cellNames[i]);
+                } else {
+                    raise(nameError, "cannot access free variable '" + derefName(*frame->code, i) +
+                                         "' where it is not associated with a value in enclosing scope");
+                }
+                goto error;
+            }
+            *sp++ = v;
+            DISPATCH();
+        }
+        TARGET(STORE_DEREF) {
+            as<CellObject>(frame->cells[read_varint(pc)])->value = *--sp;
+            DISPATCH();
+        }
+        TARGET(DELETE_DEREF) {
+            uint32_t i = read_varint(pc);
+            CellObject* cell = as<CellObject>(frame->cells[i]);
+            if (cell->value.isUnbound()) {
+                unboundLocal(derefName(*frame->code, i));
+                goto error;
+            }
+            cell->value = Value();
+            DISPATCH();
+        }
+        TARGET(LOAD_CLOSURE) {
+            *sp++ = frame->cells[read_varint(pc)];
+            DISPATCH();
+        }
+        TARGET(LOAD_GLOBAL) {
+            uint32_t slot = read_varint(pc);
+            Value v = globals[slot];
+            if (v.isUnbound()) {
+                v = builtins[slot];
+                if (v.isUnbound()) {
+                    undefinedName(module.globalNames[slot]);
+                    goto error;
+                }
+            }
+            *sp++ = v;
+            DISPATCH();
+        }
+        TARGET(STORE_GLOBAL) {
+            globals[read_varint(pc)] = *--sp;
+            DISPATCH();
+        }
+        TARGET(DELETE_GLOBAL) {
+            uint32_t slot = read_varint(pc);
+            if (globals[slot].isUnbound()) {
+                undefinedName(module.globalNames[slot]);
+                goto error;
+            }
+            globals[slot] = Value();
+            DISPATCH();
+        }
+        TARGET(LOAD_NAME) {
+            Value v;
+            if (!loadName(*frame, frame->code->names[read_varint(pc)], v)) goto error;
+            *sp++ = v;
+            DISPATCH();
+        }
+        TARGET(STORE_NAME) {
+            const string& name = frame->code->names[read_varint(pc)];
+            static_cast<ClassObject*>(frame->owner)->attributes[name] = *--sp;
+            DISPATCH();
+        }
+        TARGET(DELETE_NAME) {
+            const string& name = frame->code->names[read_varint(pc)];
+            if (!static_cast<ClassObject*>(frame->owner)->attributes.erase(name)) {
+                undefinedName(name);
+                goto error;
+            }
+            DISPATCH();
+        }
+        TARGET(LOAD_ATTR) {
+            if (!getAttribute(sp[-1], frame->code->names[read_varint(pc)], sp[-1])) goto error;
+            DISPATCH();
+        }
+        TARGET(STORE_ATTR) {
+            if (!setAttribute(sp[-1], frame->code->names[read_varint(pc)], sp[-2])) goto error;
+            sp -= 2;
+            DISPATCH();
+        }
+        TARGET(DELETE_ATTR) {
+            if (!deleteAttribute(sp[-1], frame->code->names[read_varint(pc)])) goto error;
+            sp--;
+            DISPATCH();
+        }
+        TARGET(BINARY_SUBSCR) {
+            Value container = sp[-2], index = sp[-1];
+            if (is_kind(container, ObjectKind::LIST) && index.isInt()) {
+                const vector<Value>& items = as<ListObject>(container)->items;
+                uint64_t i = (uint64_t)(index.asInt() < 0 ? index.asInt() + (int64_t)items.size() : index.asInt());
+                if (i < items.size()) {
+                    sp[-2] = items[i];
+                    sp--;
+                    DISPATCH();
+                }
+            }
+            if (!subscript(container, index, sp[-2])) goto error;
+            sp--;
+            DISPATCH();
+        }
+        TARGET(STORE_SUBSCR) {
+            if (!storeSubscript(sp[-2], sp[-1], sp[-3])) goto error;
+            sp -= 3;
+            DISPATCH();
+        }
+        TARGET(DELETE_SUBSCR) {
+            if (!deleteSubscript(sp[-2], sp[-1])) goto error;
+            sp -= 2;
+            DISPATCH();
+        }
+
+        // Inline int and float operands of the same kind are handled here;
+        // anything else, and int results too wide to stay inline, goes to
+        // binary().
+#define ARITHMETIC(op, overflows, floatExpression) \
+    TARGET(op) { \
+        Value a = sp[-2], b = sp[-1]; \
+        int64_t r; \
+        if (a.isInt() && b.isInt() && !overflows(a.asInt(), b.asInt(), &r) && Value::fitsInline(r)) { \
+            sp[-2] = Value::integer(r); \
+            sp--; \
+            DISPATCH(); \
+        } \
+        if (a.isFloat() && b.isFloat()) { \
+            double x = a.asFloat(), y = b.asFloat(); \
+            sp[-2] = Value::real(floatExpression); \
+            sp--; \
+            DISPATCH(); \
+        } \
+        slowOp = Opcode::op; \
+        goto binary_slow; \
+    }
+        ARITHMETIC(BINARY_ADD, __builtin_add_overflow, x + y)
+        ARITHMETIC(INPLACE_ADD, __builtin_add_overflow, x + y)
+        ARITHMETIC(BINARY_SUBTRACT, __builtin_sub_overflow, x - y)
+        ARITHMETIC(BINARY_MULTIPLY, __builtin_mul_overflow, x * y)
+#undef ARITHMETIC
+        TARGET(BINARY_TRUE_DIVIDE) {
+            Value a = sp[-2], b = sp[-1];
+            if (a.isFloat() && b.isFloat() && b.asFloat() != 0) {
+                sp[-2] = Value::real(a.asFloat() / b.asFloat());
+                sp--;
+                DISPATCH();
+            }
+            if (a.isInt() && b.isInt() && b.asInt() != 0) {
+                sp[-2] = Value::real((double)a.asInt() / (double)b.asInt());
+                sp--;
+                DISPATCH();
+            }
+            slowOp = Opcode::BINARY_TRUE_DIVIDE;
+            goto binary_slow;
+        }
+        TARGET(BINARY_FLOOR_DIVIDE) {
+            Value a = sp[-2], b = sp[-1];
+            if (a.isInt() && b.isInt() && b.asInt() > 0) {
+                int64_t x = a.asInt(), y = b.asInt();
+                int64_t q = x / y;
+                if (x % y < 0) q--;
+                sp[-2] = Value::integer(q);
+                sp--;
+                DISPATCH();
+            }
+            slowOp = Opcode::BINARY_FLOOR_DIVIDE;
+            goto binary_slow;
+        }
+        TARGET(BINARY_MODULO) {
+            Value a = sp[-2], b = sp[-1];
+            if (a.isInt() && b.isInt() && b.asInt() > 0) {
+                int64_t r = a.asInt() % b.asInt();
+                if (r < 0) r += b.asInt();
+                sp[-2] = Value::integer(r);
+                sp--;
+                DISPATCH();
+            }
+            slowOp = Opcode::BINARY_MODULO;
+            goto binary_slow;
+        }
+        // &, | and ^ of inline ints cannot leave the inline range
+#define BITWISE(op, operator) \
+    TARGET(op) { \
+        if (sp[-2].isInt() && sp[-1].isInt()) { \
+            sp[-2] = Value::integer(sp[-2].asInt() operator sp[-1].asInt()); \
+            sp--; \
+            DISPATCH(); \
+        } \
+        slowOp = Opcode::op; \
+        goto binary_slow; \
+    }
+        BITWISE(BINARY_AND, &)
+        BITWISE(BINARY_OR, |)
+        BITWISE(BINARY_XOR, ^)
+#undef BITWISE
+        TARGET(BINARY_POWER) {
+            slowOp = Opcode::BINARY_POWER;
+            goto binary_slow;
+        }
+        TARGET(BINARY_LSHIFT) {
+            slowOp = Opcode::BINARY_LSHIFT;
+            goto binary_slow;
+        }
+        TARGET(BINARY_RSHIFT) {
+            slowOp = Opcode::BINARY_RSHIFT;
+            goto binary_slow;
+        }
+
+#define COMPARISON(op, operator) \
+    TARGET(op) { \
+        Value a = sp[-2], b = sp[-1]; \
+        if (a.isInt() && b.isInt()) { \
+            sp[-2] = Value::boolean(a.asInt() operator b.asInt()); \
+            sp--; \
+            DISPATCH(); \
+        } \
+        if (a.isFloat() && b.isFloat()) { \
+            sp[-2] = Value::boolean(a.asFloat() operator b.asFloat()); \
+            sp--; \
+            DISPATCH(); \
+        } \
+        slowOp = Opcode::op; \
+        goto compare_slow; \
+    }
+        COMPARISON(COMPARE_EQ, ==)
+        COMPARISON(COMPARE_NE, !=)
+        COMPARISON(COMPARE_LT, <)
+        COMPARISON(COMPARE_LE, <=)
+        COMPARISON(COMPARE_GT, >)
+        COMPARISON(COMPARE_GE, >=)
+#undef COMPARISON
+        TARGET(COMPARE_IN) {
+            slowOp = Opcode::COMPARE_IN;
+            goto compare_slow;
+        }
+        TARGET(COMPARE_NOT_IN) {
+            slowOp = Opcode::COMPARE_NOT_IN;
+            goto compare_slow;
+        }
+        TARGET(COMPARE_IS) {
+            sp[-2] = Value::boolean(sp[-2].identical(sp[-1]));
+            sp--;
+            DISPATCH();
+        }
+        TARGET(COMPARE_IS_NOT) {
+            sp[-2] = Value::boolean(!sp[-2].identical(sp[-1]));
+            sp--;
+            DISPATCH();
+        }
+
+        TARGET(UNARY_NEGATIVE) {
+            Value v = sp[-1];
+            if (v.isInt() && Value::fitsInline(-v.asInt())) {
+                sp[-1] = Value::integer(-v.asInt());
+                DISPATCH();
+            }
+            if (!unary(Opcode::UNARY_NEGATIVE, v, sp[-1])) goto error;
+            DISPATCH();
+        }
+        TARGET(UNARY_POSITIVE) {
+            if (!unary(Opcode::UNARY_POSITIVE, sp[-1], sp[-1])) goto error;
+            DISPATCH();
+        }
+        TARGET(UNARY_INVERT) {
+            if (!unary(Opcode::UNARY_INVERT, sp[-1], sp[-1])) goto error;
+            DISPATCH();
+        }
+        TARGET(UNARY_NOT) {
+            Value v = sp[-1];
+            sp[-1] = Value::boolean(v.isBool() ? !v.asBool() : !truthy(v));
+            DISPATCH();
+        }
+
+        // Taken jumps are safe points, so loops collect
+        TARGET(JUMP) {
+            pc = JUMP_TARGET();
+            SAFE_POINT();
+            DISPATCH();
+        }
+        TARGET(POP_JUMP_IF_FALSE) {
+            const uint8_t* target = JUMP_TARGET();
+            Value v = *--sp;
+            if (!(v.isBool() ? v.asBool() : truthy(v))) {
+                pc = target;
+                SAFE_POINT();
+            }
+            DISPATCH();
+        }
+        TARGET(POP_JUMP_IF_TRUE) {
+            const uint8_t* target = JUMP_TARGET();
+            Value v = *--sp;
+            if (v.isBool() ? v.asBool() : truthy(v)) {
+                pc = target;
+                SAFE_POINT();
+            }
+            DISPATCH();
+        }
+        TARGET(JUMP_IF_FALSE_OR_POP) {
+            const uint8_t* target = JUMP_TARGET();
+            if (!truthy(sp[-1])) {
+                pc = target;
+            } else {
+                sp--;
+            }
+            DISPATCH();
+        }
+        TARGET(JUMP_IF_TRUE_OR_POP) {
+            const uint8_t* target = JUMP_TARGET();
+            if (truthy(sp[-1])) {
+                pc = target;
+            } else {
+                sp--;
+            }
+            DISPATCH();
+        }
+        TARGET(GET_ITER) {
+            if (!getIterator(sp[-1], sp[-1])) goto error;
+            DISPATCH();
+        }
+        TARGET(FOR_ITER) {
+            const uint8_t* exit = JUMP_TARGET();
+            Value iterator = sp[-1];
+            if (is_kind(iterator, ObjectKind::RANGE_ITERATOR)) {
+                RangeIteratorObject* range = as<RangeIteratorObject>(iterator);
+                if (range->remaining) {
+                    range->remaining--;
+                    *sp++ = makeInt((int64_t)range->current);
+                    range->current += range->step;
+                } else {
+                    sp--;
+                    pc = exit;
+                }
+                DISPATCH();
+            }
+            Value item;
+            bool done;
+            SAVE_FRAME();
+            if (!advance(iterator, item, done)) goto error;
+            if (done) {
+                sp--;
+                pc = exit;
+            } else {
+                *sp++ = item;
+            }
+            DISPATCH();
+        }
+
+        TARGET(BUILD_LIST) {
+            uint32_t count = read_varint(pc);
+            ListObject* list = allocate<ListObject>();
+            list->items.assign(sp - count, sp);
+            sp -= count;
+            *sp++ = Value::object(list);
+            DISPATCH();
+        }
+        TARGET(LIST_APPEND) {
+            Value item = *--sp;
+            as<ListObject>(sp[-1])->items.push_back(item);
+            DISPATCH();
+        }
+        TARGET(BUILD_MAP) {
+            uint32_t count = read_varint(pc);
+            DictObject* dict = allocate<DictObject>();
+            Value* pairs = sp - 2 * count;
+            for (uint32_t i = 0; i < count; i++) {
+                uint64_t h;
+                if (!hash(pairs[2 * i], h)) goto error;
+                dict_set(*dict, pairs[2 * i], h, pairs[2 * i + 1]);
+            }
+            sp = pairs;
+            *sp++ = Value::object(dict);
+            DISPATCH();
+        }
+        TARGET(MAP_ADD) {
+            uint64_t h;
+            if (!hash(sp[-2], h)) goto error;
+            dict_set(*as<DictObject>(sp[-3]), sp[-2], h, sp[-1]);
+            sp -= 2;
+            DISPATCH();
+        }
+
+        TARGET(CALL) {
+            uint32_t count = read_varint(pc);
+            Value* callee = sp - count - 1;
+            SAVE_FRAME();
+            SAFE_POINT();
+            if (is_kind(*callee, ObjectKind::FUNCTION)) {
+                FunctionObject* function = as<FunctionObject>(*callee);
+                if (!bindArguments(function, callee + 1, count)) goto error;
+                if (function->code->flags & CODE_GENERATOR) {
+                    *callee = Value::object(makeGenerator(function, callee + 1));
+                    sp = callee + 1;
+                    DISPATCH();
+                }
+                pushFrame(function, callee + 1, callee, FrameKind::NORMAL, nullptr);
+                LOAD_FRAME();
+                DISPATCH();
+            }
+            if (!callObject(callee, count)) goto error;
+            if (&frames.back() != frame) {
+                LOAD_FRAME();       // __init__
+            } else {
+                sp = callee + 1;
+            }
+            DISPATCH();
+        }
+        TARGET(RETURN_VALUE) {
+            Value value = sp[-1];
+            switch (frame->kind) {
+                case FrameKind::CONSTRUCTOR:
+                    if (!value.isNone()) {
+                        raise(typeError, "__init__() should return None, not '" + typeName(value) + "'");
+                        goto error;
+                    }
+                    value = Value::object(frame->owner);
+                    break;
+                case FrameKind::CLASS_BODY:
+                    value = Value::object(frame->owner);
+                    break;
+                case FrameKind::GENERATOR:
+                    static_cast<GeneratorObject*>(frame->owner)->state = GeneratorObject::DONE;
+                    break;
+                case FrameKind::NORMAL:
+                    break;
+            }
+            Value* result = frame->result;
+            frames.pop_back();
+            if (frames.size() < entry) {
+                out = value;
+                instructions += executed;
+                return true;
+            }
+            *result = value;
+            LOAD_FRAME();
+            sp = result + 1;
+            DISPATCH();
+        }
+        TARGET(YIELD_VALUE) {
+            // Generator frames run alone in a nested loop, from resume()
+            GeneratorObject* generator = static_cast<GeneratorObject*>(frame->owner);
+            out = *--sp;
+            generator->saved.assign(frame->base, sp);
+            generator->pc = (uint32_t)(pc - codeStart);
+            generator->state = GeneratorObject::SUSPENDED;
+            frames.pop_back();
+            instructions += executed;
+            return true;
+        }
+        TARGET(MAKE_FUNCTION) {
+            uint32_t index = read_varint(pc);
+            const CodeObject& code = module.code[index];
+            FunctionObject* function = allocate<FunctionObject>(index, &code);
+            sp -= code.freeNames.size();
+            function->cells.assign(sp, sp + code.freeNames.size());
+            sp -= code.defaultCount;
+            function->defaults.assign(sp, sp + code.defaultCount);
+            *sp++ = Value::object(function);
+            DISPATCH();
+        }
+        TARGET(BUILD_CLASS) {
+            // The body runs as a frame whose names go to the new class
+            uint32_t hasBase = read_varint(pc);
+            FunctionObject* body = as<FunctionObject>(sp[-1]);
+            ClassObject* base = nullptr;
+            if (hasBase) {
+                if (!is_kind(sp[-2], ObjectKind::CLASS)) {
+                    typeMismatch("a class base must be a class", sp[-2]);
+                    goto error;
+                }
+                base = as<ClassObject>(sp[-2]);
+            }
+            sp -= 1 + hasBase;
+            ClassObject* cls = allocate<ClassObject>(body->code->name, base);
+            Value* result = sp;
+            *sp++ = Value::object(cls);
+            if (!bindArguments(body, sp, 0)) goto error;
+            SAVE_FRAME();
+            pushFrame(body, sp, result, FrameKind::CLASS_BODY, cls);
+            LOAD_FRAME();
+            DISPATCH();
+        }
+        TARGET(CHECK_EXC_MATCH) {
+            Value type = *--sp;
+            if (!is_kind(type, ObjectKind::CLASS) || !as<ClassObject>(type)->exception) {
+                raise(typeError, "catching classes that do not inherit from BaseException is not allowed");
+                goto error;
+            }
+            Value raised = sp[-1];
+            *sp++ = Value::boolean(is_kind(raised, ObjectKind::INSTANCE) &&
+                                   as<InstanceObject>(raised)->cls->derivesFrom(as<ClassObject>(type)));
+            DISPATCH();
+        }
+        TARGET(RERAISE) {
+            pending = *--sp;
+            goto error;
+        }
+        TARGET(IMPORT_NAME) {
+            Value imported;
+            if (!importModule(frame->code->names[read_varint(pc)], imported)) goto error;
+            *sp++ = imported;
+            DISPATCH();
+        }
+        TARGET(IMPORT_FROM) {
+            const string& name = frame->code->names[read_varint(pc)];
+            ModuleObject* imported = as<ModuleObject>(sp[-1]);
+            auto it = imported->attributes.find(name);
+            if (it == imported->attributes.end()) {
+                raise(importError, "cannot import name '" + name + "' from '" + imported->name + "'");
+                goto error;
+            }
+            *sp++ = it->second;
+            DISPATCH();
+        }
+        TARGET(IMPORT_STAR) {
+            // Only names the program mentions have global slots
+            ModuleObject* imported = as<ModuleObject>(*--sp);
+            for (const auto& attribute : imported->attributes) {
+                auto slot = globalSlot.find(attribute.first);
+                if (slot != globalSlot.end()) globals[slot->second] = attribute.second;
+            }
+            DISPATCH();
+        }
+
+#ifndef VM_THREADED_DISPATCH
+            }
+#endif
+        binary_slow: {
+            Value result;
+            if (!binary(slowOp, sp[-2], sp[-1], result)) goto error;
+            sp[-2] = result;
+            sp--;
+            DISPATCH();
+        }
+        compare_slow: {
+            Value result;
+            if (!compare(slowOp, sp[-2], sp[-1], result)) goto error;
+            sp[-2] = result;
+            sp--;
+            DISPATCH();
+        }
+        error: {
+            // pc is past the failing instruction, or a call in a caller
+            for (;;) {
+                uint32_t offset = (uint32_t)(pc - 1 - codeStart);
+                if (trace.empty() || trace.back().depth != frames.size()) {
+                    trace.push_back({frames.size(), frame->code, offset});
+                }
+                if (const ExceptionHandler* handler = findHandler(*frame->code, offset)) {
+                    sp = frame->stack + handler->depth;
+                    *sp++ = pending;
+                    pending = Value();
+                    pc = codeStart + handler->handler;
+                    break;
+                }
+                if (frame->kind == FrameKind::GENERATOR) {
+                    GeneratorObject* generator = static_cast<GeneratorObject*>(frame->owner);
+                    generator->state = GeneratorObject::DONE;
+                    generator->saved.clear();
+                }
+                frames.pop_back();
+                if (frames.size() < entry) {
+                    instructions += executed;
+                    return false;
+                }
+                LOAD_FRAME();
+            }
+            DISPATCH();
+        }
+#ifndef VM_THREADED_DISPATCH
+        }
+#endif
+#undef LOAD_FRAME
+#undef SAVE_FRAME
+#undef SAFE_POINT
+#undef JUMP_TARGET
+#undef TARGET
+#undef DISPATCH
+    }
+
+    // --- builtins ---
+
+    bool callBuiltin(int id, Value* args, uint32_t count, Value& result) {
+        switch (id) {
+#define X(id, name) \
+    case BUILTIN_##id: return builtin_##id(args, count, result);
+            BUILTIN_FUNCTIONS(X)
+            MATH_FUNCTIONS(X)
+#undef X
+        }
+        return raise(runtimeError, "unknown builtin");
+    }
+
+    bool arity(const char* name, uint32_t count, uint32_t least, uint32_t most) {
+        if (count >= least && count <= most) return true;
+        string expected = least == most ? "exactly " + plural(least, "argument")
+                          : count < least ? "at least " + plural(least, "argument")
+                                          : "at most " + plural(most, "argument");
+        return raise(typeError, string(name) + "() takes " + expected + " (" + to_string(count) + " given)");
+    }
+
+    bool builtin_print(Value* args, uint32_t count, Value& result) {
+        string line;
+        for (uint32_t i = 0; i < count; i++) {
+            if (i) line += ' ';
+            if (!str(args[i], line)) return false;
+        }
+        line += '\n';
+        output << line;
+        result = Value::none();
+        return true;
+    }
+
+    bool builtin_len(Value* args, uint32_t count, Value& result) {
+        if (!arity("len", count, 1, 1)) return false;
+        Value v = args[0];
+        if (v.isObject()) {
+            switch (v.asObject()->kind) {
+                case ObjectKind::STRING: result = Value::integer((int64_t)as<StringObject>(v)->length); return true;
+                case ObjectKind::LIST: result = Value::integer((int64_t)as<ListObject>(v)->items.size()); return true;
+                case ObjectKind::DICT: result = Value::integer((int64_t)as<DictObject>(v)->live); return true;
+                case ObjectKind::RANGE: {
+                    uint64_t length = as<RangeObject>(v)->length();
+                    if (length > (uint64_t)INT64_MAX) return overflow();
+                    result = makeInt((int64_t)length);
+                    return true;
+                }
+                default: break;
+            }
+        }
+        return raise(typeError, "object of type '" + typeName(v) + "' has no len()");
+    }
+
+    bool builtin_range(Value* args, uint32_t count, Value& result) {
+        if (!arity("range", count, 1, 3)) return false;
+        int64_t bounds[3] = {0, 0, 1};
+        for (uint32_t i = 0; i < count; i++) {
+            if (!int_value(args[i], bounds[count == 1 ? 1 : i])) {
+                return raise(typeError, "'" + typeName(args[i]) + "' object cannot be interpreted as an integer");
+            }
+        }
+        if (bounds[2] == 0) return raise(valueError, "range() arg 3 must not be zero");
+        result = Value::object(allocate<RangeObject>(bounds[0], bounds[1], bounds[2]));
+        return true;
+    }
+
+    bool builtin_str(Value* args, uint32_t count, Value& result) {
+        if (!arity("str", count, 0, 1)) return false;
+        string text;
+        if (count && !str(args[0], text)) return false;
+        result = count && is_kind(args[0], ObjectKind::STRING) ? args[0] : newString(move(text));
+        return true;
+    }
+
+    bool builtin_repr(Value* args, uint32_t count, Value& result) {
+        if (!arity("repr", count, 1, 1)) return false;
+        string text;
+        if (!repr(args[0], text)) return false;
+        result = newString(move(text));
+        return true;
+    }
+
+    static string strip(const string& s) {
+        size_t begin = s.find_first_not_of(" \t\n\r\f\v");
+        if (begin == string::npos) return "";
+        return s.substr(begin, s.find_last_not_of(" \t\n\r\f\v") - begin + 1);
+    }
+
+    bool builtin_int(Value* args, uint32_t count, Value& result) {
+        if (!arity("int", count, 0, 1)) return false;
+        int64_t i = 0;
+        if (count == 0 || int_value(args[0], i)) {
+            result = makeInt(i);
+            return true;
+        }
+        if (args[0].isFloat()) return truncate(args[0].asFloat(), result);
+        if (!is_kind(args[0], ObjectKind::STRING)) {
+            return typeMismatch("int() argument must be a string or a real number", args[0]);
+        }
+        // Decimal digits, with a sign and underscores between digits
+        string text = strip(as<StringObject>(args[0])->text);
+        size_t p = text.empty() || (text[0] != '+' && text[0] != '-') ? 0 : 1;
+        bool negative = p && text[0] == '-';
+        bool valid = p < text.size();
+        int64_t value = 0;
+        for (size_t k = p; valid && k < text.size(); k++) {
+            char c = text[k];
+            if (c == '_' && k > p && k + 1 < text.size() && isdigit((unsigned char)text[k - 1]) &&
+                isdigit((unsigned char)text[k + 1])) {
+                continue;
+            }
+            if (!isdigit((unsigned char)c)) {
+                valid = false;
+            } else if (__builtin_mul_overflow(value, 10, &value) || __builtin_sub_overflow(value, c - '0', &value)) {
+                return overflow();
+            }
+        }
+        if (!valid) {
+            string quoted;
+            repr(args[0], quoted);
+            return raise(valueError, "invalid literal for int() with base 10: " + quoted);
+        }
+        if (!negative && value == INT64_MIN) return overflow();
+        result = makeInt(negative ? value : -value);
+        return true;
+    }
+
+    bool builtin_float(Value* args, uint32_t count, Value& result) {
+        if (!arity("float", count, 0, 1)) return false;
+        double d = 0;
+        if (count == 0 || number_value(args[0], d)) {
+            result = Value::real(d);
+            return true;
+        }
+        if (!is_kind(args[0], ObjectKind::STRING)) {
+            return typeMismatch("float() argument must be a string or a real number", args[0]);
+        }
+        string text = strip(as<StringObject>(args[0])->text);
+        string lower = text;
+        for (char& c : lower) c = (char)tolower((unsigned char)c);
+        size_t sign = !lower.empty() && (lower[0] == '+' || lower[0] == '-');
+        string word = lower.substr(sign);
+        if (word == "inf" || word == "infinity" || word == "nan") {
+            d = word == "nan" ? NAN : INFINITY;
+            result = Value::real(sign && lower[0] == '-' ? -d : d);
+            return true;
+        }
+        char* end = nullptr;
+        bool valid = !word.empty() && word.find_first_not_of("0123456789.e+-") == string::npos;
+        if (valid) {
+            d = strtod(text.c_str(), &end);
+            valid = end == text.c_str() + text.size();
+        }
+        if (!valid) {
+            string quoted;
+            repr(args[0], quoted);
+            return raise(valueError, "could not convert string to float: " + quoted);
+        }
+        result = Value::real(d);
+        return true;
+    }
+
+    bool builtin_bool(Value* args, uint32_t count, Value& result) {
+        if (!arity("bool", count, 0, 1)) return false;
+        result = Value::boolean(count && truthy(args[0]));
+        return true;
+    }
+
+    bool builtin_abs(Value* args, uint32_t count, Value& result) {
+        if (!arity("abs", count, 1, 1)) return false;
+        int64_t i;
+        if (int_value(args[0], i)) {
+            if (i == INT64_MIN) return overflow();
+            result = makeInt(i < 0 ? -i : i);
+            return true;
+        }
+        if (args[0].isFloat()) {
+            result = Value::real(std::fabs(args[0].asFloat()));
+            return true;
+        }
+        return raise(typeError, "bad operand type for abs(): '" + typeName(args[0]) + "'");
+    }
+
+    // min() and max(): of one iterable, or of the arguments. The first of
+    // equal extremes wins.
+    bool extreme(const char* name, Opcode better, Value* args, uint32_t count, Value& result) {
+        if (count == 0) return raise(typeError, string(name) + " expected at least 1 argument, got 0");
+        vector<Value> items;
+        if (count == 1) {
+            if (!collect(args[0], items)) return false;
+        } else {
+            items.assign(args, args + count);
+        }
+        if (items.empty()) return raise(valueError, string(name) + "() arg is an empty sequence");
+        result = items[0];
+        for (size_t i = 1; i < items.size(); i++) {
+            bool replace;
+            if (!order(better, items[i], result, replace)) return false;
+            if (replace) result = items[i];
+        }
+        return true;
+    }
+
+    bool builtin_min(Value* args, uint32_t count, Value& result) {
+        return extreme("min", Opcode::COMPARE_LT, args, count, result);
+    }
+
+    bool builtin_max(Value* args, uint32_t count, Value& result) {
+        return extreme("max", Opcode::COMPARE_GT, args, count, result);
+    }
+
+    bool builtin_sum(Value* args, uint32_t count, Value& result) {
+        if (!arity("sum", count, 1, 2)) return false;
+        result = count == 2 ? args[1] : Value::integer(0);
+        if (is_kind(result, ObjectKind::STRING)) return raise(typeError, "sum() can't sum strings [use ''.join(seq) instead]");
+        vector<Value> items;
+        if (!collect(args[0], items)) return false;
+        for (Value item : items) {
+            int64_t r;
+            if (result.isInt() && item.isInt() && !__builtin_add_overflow(result.asInt(), item.asInt(), &r)) {
+                result = makeInt(r);
+            } else if (!binary(Opcode::BINARY_ADD, result, item, result)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool builtin_list(Value* args, uint32_t count, Value& result) {
+        if (!arity("list", count, 0, 1)) return false;
+        vector<Value> items;
+        if (count && !collect(args[0], items)) return false;
+        ListObject* list = allocate<ListObject>();
+        list->items = move(items);
+        result = Value::object(list);
+        return true;
+    }
+
+    bool builtin_dict(Value* args, uint32_t count, Value& result) {
+        if (!arity("dict", count, 0, 1)) return false;
+        if (count && !is_kind(args[0], ObjectKind::DICT)) return typeMismatch("dict() argument must be a dict", args[0]);
+        DictObject* dict = allocate<DictObject>();
+        if (count) {
+            for (const DictEntry& entry : as<DictObject>(args[0])->entries) {
+                if (!entry.key.isUnbound()) dict_set(*dict, entry.key, entry.hash, entry.value);
+            }
+        }
+        result = Value::object(dict);
+        return true;
+    }
+
+    // Classes, or the builtins that name a type: int, float, str, bool,
+    // list and dict.
+    bool builtin_isinstance(Value* args, uint32_t count, Value& result) {
+        if (!arity("isinstance", count, 2, 2)) return false;
+        Value v = args[0], type = args[1];
+        if (is_kind(type, ObjectKind::CLASS)) {
+            result = Value::boolean(is_kind(v, ObjectKind::INSTANCE) && as<InstanceObject>(v)->cls->derivesFrom(as<ClassObject>(type)));
+            return true;
+        }
+        if (is_kind(type, ObjectKind::BUILTIN)) {
+            switch (as<BuiltinObject>(type)->id) {
+                case BUILTIN_int: result = Value::boolean(v.isInt() || v.isBool() || is_kind(v, ObjectKind::INT)); return true;
+                case BUILTIN_float: result = Value::boolean(v.isFloat()); return true;
+                case BUILTIN_bool: result = Value::boolean(v.isBool()); return true;
+                case BUILTIN_str: result = Value::boolean(is_kind(v, ObjectKind::STRING)); return true;
+                case BUILTIN_list: result = Value::boolean(is_kind(v, ObjectKind::LIST)); return true;
+                case BUILTIN_dict: result = Value::boolean(is_kind(v, ObjectKind::DICT)); return true;
+                default: break;
+            }
+        }
+        return raise(typeError, "isinstance() arg 2 must be a type");
+    }
+
+    bool builtin_chr(Value* args, uint32_t count, Value& result) {
+        if (!arity("chr", count, 1, 1)) return false;
+        int64_t c;
+        if (!int_value(args[0], c)) return typeMismatch("an integer is required", args[0]);
+        if (c < 0 || c > 0x10ffff) return raise(valueError, "chr() arg not in range(0x110000)");
+        string text;
+        append_utf8(text, (uint32_t)c);
+        result = newString(move(text));
+        return true;
+    }
+
+    bool builtin_ord(Value* args, uint32_t count, Value& result) {
+        if (!arity("ord", count, 1, 1)) return false;
+        if (!is_kind(args[0], ObjectKind::STRING)) return typeMismatch("ord() expected string of length 1", args[0]);
+        const StringObject& s = *as<StringObject>(args[0]);
+        if (s.length != 1) {
+            return raise(typeError, "ord() expected a character, but string of length " + to_string(s.length) + " found");
+        }
+        result = Value::integer(decode_utf8(s.text, 0));
+        return true;
+    }
+
+    // Halves round to even, as in Python.
+    bool builtin_round(Value* args, uint32_t count, Value& result) {
+        if (!arity("round", count, 1, 2)) return false;
+        int64_t digits = 0;
+        bool hasDigits = count == 2 && !args[1].isNone();
+        if (hasDigits && !int_value(args[1], digits)) {
+            return raise(typeError, "'" + typeName(args[1]) + "' object cannot be interpreted as an integer");
+        }
+        int64_t i;
+        if (int_value(args[0], i)) {
+            if (digits >= 0) {
+                result = makeInt(i);
+                return true;
+            }
+            if (digits < -18) {
+                result = Value::integer(0);
+                return true;
+            }
+            int64_t unit = 1;
+            for (int64_t k = 0; k < -digits; k++) unit *= 10;
+            int64_t quotient = i / unit, remainder = i % unit;
+            if (remainder < 0) {
+                quotient--;
+                remainder += unit;
+            }
+            if (2 * remainder > unit || (2 * remainder == unit && (quotient & 1))) quotient++;
+            if (__builtin_mul_overflow(quotient, unit, &i)) return overflow();
+            result = makeInt(i);
+            return true;
+        }
+        if (!args[0].isFloat()) return raise(typeError, "type " + typeName(args[0]) + " doesn't define __round__ method");
+        double d = args[0].asFloat();
+        if (!hasDigits) return truncate(std::nearbyint(d), result);
+        if (!std::isfinite(d) || digits > 308) {
+            result = args[0];
+            return true;
+        }
+        double scale = std::pow(10.0, (double)std::abs(digits));
+        double scaled = digits >= 0 ? d * scale : d / scale;
+        if (!std::isfinite(scaled)) {
+            result = args[0];
+            return true;
+        }
+        double rounded = std::nearbyint(scaled);
+        result = Value::real(digits >= 0 ? rounded / scale : rounded * scale);
+        return true;
+    }
+
+    bool builtin_iter(Value* args, uint32_t count, Value& result) {
+        if (!arity("iter", count, 1, 1)) return false;
+        return getIterator(args[0], result);
+    }
+
+    bool builtin_next(Value* args, uint32_t count, Value& result) {
+        if (!arity("next", count, 1, 2)) return false;
+        if (!isIterator(args[0])) return raise(typeError, "'" + typeName(args[0]) + "' object is not an iterator");
+        bool done;
+        if (!advance(args[0], result, done)) return false;
+        if (!done) return true;
+        if (count == 2) {
+            result = args[1];
+            return true;
+        }
+        return raise(stopIteration, "");
+    }
+
+    bool mathArgument(const char* name, Value* args, uint32_t count, double& d) {
+        if (!arity(name, count, 1, 1)) return false;
+        if (!number_value(args[0], d)) return typeMismatch("must be real number", args[0]);
+        return true;
+    }
+
+    bool builtin_math_sqrt(Value* args, uint32_t count, Value& result) {
+        double d = 0;
+        if (!mathArgument("sqrt", args, count, d)) return false;
+        if (d < 0) return raise(valueError, "math domain error");
+        result = Value::real(std::sqrt(d));
+        return true;
+    }
+
+    bool builtin_math_floor(Value* args, uint32_t count, Value& result) {
+        double d = 0;
+        if (!mathArgument("floor", args, count, d)) return false;
+        int64_t i;
+        if (int_value(args[0], i)) {
+            result = makeInt(i);
+            return true;
+        }
+        return truncate(std::floor(d), result);
+    }
+
+    bool builtin_math_ceil(Value* args, uint32_t count, Value& result) {
+        double d = 0;
+        if (!mathArgument("ceil", args, count, d)) return false;
+        int64_t i;
+        if (int_value(args[0], i)) {
+            result = makeInt(i);
+            return true;
+        }
+        return truncate(std::ceil(d), result);
+    }
+
+    bool builtin_math_fabs(Value* args, uint32_t count, Value& result) {
+        double d = 0;
+        if (!mathArgument("fabs", args, count, d)) return false;
+        result = Value::real(std::fabs(d));
+        return true;
+    }
+
+    // --- entry ---
+
+    bool run(string& error) {
+        if (module.code.empty()) return true;
+        const CodeObject& code = module.code[0];
+        Frame frame;
+        frame.code = &code;
+        frame.constants = pools[0].data();
+        frame.function = nullptr;
+        frame.owner = nullptr;
+        frame.kind = FrameKind::NORMAL;
+        frame.pc = code.code.data();
+        frame.base = values.data();
+        frame.cells = frame.base + code.localNames.size();
+        frame.stack = frame.cells + code.derefCount();
+        frame.sp = frame.stack;
+        frame.result = nullptr;
+        frames.clear();
+        frames.push_back(frame);
+        trace.clear();
+        pending = Value();
+
+        Value result;
+        if (execute(result)) return true;
+        error = "Traceback (most recent call last):\n";
+        for (size_t i = trace.size(); i-- > 0;) {
+            error += "  line " + to_string(trace[i].code->lineAt(trace[i].offset)) + ", in " + trace[i].code->name + "\n";
+        }
+        error += typeName(pending);
+        string message;
+        if (str(pending, message) && !message.empty()) error += ": " + message;
+        pending = Value();
+        return false;
+    }
+};
+
+VirtualMachine::VirtualMachine(const BytecodeModule& module, ostream& output)
+    : state(new State(module, output)) {}
+
+VirtualMachine::~VirtualMachine() = default;
+
+bool VirtualMachine::run() {
+    errorText.clear();
+    return state->run(errorText);
+}
+
+uint64_t VirtualMachine::instructionCount() const { return state->instructions; }
+
+size_t VirtualMachine::collectionCount() const { return state->collections; }
+
+const char* VirtualMachine::dispatchMode() {
+#ifdef VM_THREADED_DISPATCH
+    return "computed goto";
+#else
+    return "switch";
+#endif
+}
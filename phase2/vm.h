@@ -0,0 +1,55 @@
+#ifndef VM_H
+#define VM_H
+
+#include "bytecode.h"
+#include "value.h"
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Interpreter for BytecodeModule (bytecode.h).
+//
+// Dispatch is threaded with GCC and Clang: each handler ends in its own
+// indirect jump through a table of label addresses ("computed goto"), which
+// predicts better than one shared jump. Other compilers, or building with
+// VM_SWITCH_DISPATCH defined, get a switch in a loop instead.
+//
+// All frames share one contiguous value stack of one-word NaN-boxed values
+// (value.h). A frame's locals start at the arguments its caller pushed,
+// followed by its cells and its operand stack, so a call copies nothing.
+// Float arithmetic never allocates, nor does int arithmetic while results
+// stay within 48 bits. Python calls do not recurse in C++; only resuming a
+// generator runs a nested dispatch loop.
+//
+// Heap objects are reclaimed by a mark-and-sweep collector. It runs only at
+// calls and loop back-edges, where every live value is in a root: the value
+// stack, the globals or a constant pool.
+//
+// Ints are 64 bits, boxed on the heap beyond the inline range; a result
+// that does not fit 64 bits raises OverflowError rather than growing. The bytecode is trusted to come from BytecodeCompiler.
+class VirtualMachine {
+public:
+    explicit VirtualMachine(const BytecodeModule& module, std::ostream& output = std::cout);
+    ~VirtualMachine();
+
+    // Runs the module body. False if an exception escaped it; error() then
+    // holds the traceback.
+    bool run();
+
+    const std::string& error() const { return errorText; }
+
+    // Instructions dispatched so far, in every frame.
+    uint64_t instructionCount() const;
+    size_t collectionCount() const;
+
+    // "computed goto" or "switch".
+    static const char* dispatchMode();
+
+private:
+    struct State;
+    std::unique_ptr<State> state;
+    std::string errorText;
+};
+
+#endif // VM_H
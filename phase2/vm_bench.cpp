@@ -0,0 +1,129 @@
+// VM benchmark: compiles Python scripts to bytecode and times the virtual
+// machine (vm.h) on them, reporting nanoseconds per executed instruction.
+//
+//   g++ -std=c++17 -O2 -pthread -o vm_bench vm_bench.cpp parser_core.cpp lexical_analyzer.cpp grammar.cpp ast_binary.cpp scope_tree.cpp constant_folding.cpp bytecode.cpp bytecode_compiler.cpp vm.cpp
+//   ./vm_bench [--runs=N] [--fold] SCRIPT...      e.g. ./vm_bench benchmarks/*.py
+//
+// Add -DVM_SWITCH_DISPATCH to the build to time the switch loop instead of
+// computed goto. Each script runs N times (default 5) on a fresh machine;
+// the best run is reported. The program's first output line is shown as a
+// checksum, so both builds can be checked to compute the same thing.
+
+#include "parser_core.h"
+#include "scope_tree.h"
+#include "constant_folding.h"
+#include "bytecode_compiler.h"
+#include "vm.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static int usage(const char* program) {
+    cerr << "Usage: " << program << " [--runs=N] [--fold] SCRIPT..." << endl;
+    return 1;
+}
+
+// Parses and compiles path into module; the parser's own output is discarded.
+static bool compile_script(const string& path, bool fold, BytecodeModule& module, string& error) {
+    ifstream in(path);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    stringstream source;
+    source << in.rdbuf();
+
+    NullBuffer discard;
+    streambuf* console = cout.rdbuf(&discard);
+    tokens = tokenize(source.str());
+    matchTable = buildMatchTable(tokens);
+    reset_parser_state();
+    shared_ptr<ParseTreeNode> root = TreeParser::parse_program();
+    cout.rdbuf(console);
+    if (!diagnostics.empty()) {
+        error = format_diagnostic(diagnostics[0]);
+        return false;
+    }
+
+    expand_lazy_bodies(root);
+    if (fold) {
+        ScopeTree scopes(root);
+        ConstantFolder folder(root, scopes);
+    }
+    ScopeTree scopes(root);
+    BytecodeCompiler compiler(root, scopes, tokens);
+    if (!compiler.errors().empty()) {
+        const CompileError& first = compiler.errors()[0];
+        error = "line " + to_string(first.line) + ": " + first.message;
+        return false;
+    }
+    module = compiler.module();
+    return true;
+}
+
+static bool run_script(const string& path, int runs, bool fold) {
+    using Clock = chrono::steady_clock;
+    BytecodeModule module;
+    string error;
+    if (!compile_script(path, fold, module, error)) {
+        cerr << path << ": " << error << endl;
+        return false;
+    }
+
+    double bestMs = 0;
+    uint64_t instructions = 0;
+    string checksum;
+    for (int r = 0; r < runs; r++) {
+        ostringstream output;
+        VirtualMachine vm(module, output);
+        auto start = Clock::now();
+        bool ok = vm.run();
+        double ms = chrono::duration<double, milli>(Clock::now() - start).count();
+        if (!ok) {
+            cerr << path << ": " << vm.error() << endl;
+            return false;
+        }
+        if (r == 0 || ms < bestMs) bestMs = ms;
+        instructions = vm.instructionCount();
+        checksum = output.str().substr(0, output.str().find('\n'));
+    }
+
+    double nsPerInstruction = instructions ? bestMs * 1e6 / instructions : 0;
+    cout << left << setw(28) << path << right << setw(12) << instructions << setw(11) << fixed << setprecision(3)
+         << bestMs << setw(9) << setprecision(2) << nsPerInstruction << "  " << checksum << endl;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int runs = 5;
+    bool fold = false;
+    vector<string> scripts;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.rfind("--runs=", 0) == 0) {
+            runs = atoi(arg.c_str() + 7);
+            if (runs < 1) return usage(argv[0]);
+        } else if (arg == "--fold") {
+            fold = true;
+        } else if (arg.rfind("--", 0) == 0) {
+            return usage(argv[0]);
+        } else {
+            scripts.push_back(arg);
+        }
+    }
+    if (scripts.empty()) return usage(argv[0]);
+
+    cout << VirtualMachine::dispatchMode() << " dispatch, best of " << runs << " runs" << (fold ? ", folded" : "")
+         << "\n";
+    cout << left << setw(28) << "script" << right << setw(12) << "instructions" << setw(11) << "ms" << setw(9)
+         << "ns/instr" << "  output" << endl;
+    bool ok = true;
+    for (const string& path : scripts) ok = run_script(path, runs, fold) && ok;
+    return ok ? 0 : 1;
+}